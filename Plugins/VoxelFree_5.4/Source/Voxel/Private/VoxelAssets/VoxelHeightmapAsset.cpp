@@ -19,6 +19,28 @@
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelHeightmapAssetMemory);
 
+static TAutoConsoleVariable<int32> CVarHeightmapTileCacheSize(
+	TEXT("voxel.heightmaps.TileCacheSize"),
+	256,
+	TEXT("Size in MB of the decompressed tiles each heightmap asset keeps in memory. Other tiles stay compressed until sampled"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarHeightmapCompressedMemoryWarningThreshold(
+	TEXT("voxel.heightmaps.CompressedMemoryWarningThreshold"),
+	1024,
+	TEXT("Size in MB of compressed tiles above which a heightmap asset logs a warning. Compressed tiles are never paged out. 0 to disable"),
+	ECVF_Default);
+
+int64 FVoxelHeightmapAssetTiles::GetMaxResidentMemory()
+{
+	return int64(FMath::Max(CVarHeightmapTileCacheSize.GetValueOnAnyThread(), 1)) << 20;
+}
+
+int64 FVoxelHeightmapAssetTiles::GetCompressedMemoryWarningThreshold()
+{
+	return int64(FMath::Max(CVarHeightmapCompressedMemoryWarningThreshold.GetValueOnAnyThread(), 0)) << 20;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -28,6 +50,8 @@ VOXEL_API TVoxelHeightmapAssetSamplerWrapper<uint16>::TVoxelHeightmapAssetSample
 	: Scale(Asset ? FMath::Max(SMALL_NUMBER, Asset->Scale) : 1)
 	, HeightScale(Asset ? Asset->HeightScale : 1)
 	, HeightOffset(Asset ? Asset->HeightOffset : 0)
+	, bUseHeightMips(Asset ? Asset->bUseHeightMips : false)
+	, LODToMipOffset(Asset ? FMath::CeilToInt(FMath::Log2(FMath::Max(SMALL_NUMBER, Asset->Scale))) : 0)
 	, Data(Asset ? CastChecked<UVoxelHeightmapAssetUINT16>(Asset)->GetDataSharedPtr() : MakeVoxelShared<TVoxelHeightmapAssetData<uint16>>())
 {
 }
@@ -36,6 +60,8 @@ VOXEL_API TVoxelHeightmapAssetSamplerWrapper<float>::TVoxelHeightmapAssetSampler
 	: Scale(Asset ? FMath::Max(SMALL_NUMBER, Asset->Scale) : 1)
 	, HeightScale(Asset ? Asset->HeightScale : 1)
 	, HeightOffset(Asset ? Asset->HeightOffset : 0)
+	, bUseHeightMips(Asset ? Asset->bUseHeightMips : false)
+	, LODToMipOffset(Asset ? FMath::CeilToInt(FMath::Log2(FMath::Max(SMALL_NUMBER, Asset->Scale))) : 0)
 	, Data(Asset ? CastChecked<UVoxelHeightmapAssetFloat>(Asset)->GetDataSharedPtr() : MakeVoxelShared<TVoxelHeightmapAssetData<float>>())
 {
 }
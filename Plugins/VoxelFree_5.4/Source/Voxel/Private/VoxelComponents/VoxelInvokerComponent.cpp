@@ -52,6 +52,8 @@ void UVoxelInvokerComponentBase::EnableInvoker()
 	Array.RemoveAllSwap([](auto& X) { return !X.IsValid(); });
 
 	LOG_VOXEL(Log, TEXT("Voxel Invoker enabled; Name: %s; Owner: %s"), *GetName(), *GetOwner()->GetName());
+
+	OnInvokerChanged.Broadcast(this);
 }
 
 void UVoxelInvokerComponentBase::DisableInvoker()
@@ -67,6 +69,8 @@ void UVoxelInvokerComponentBase::DisableInvoker()
 	Array.RemoveAllSwap([this](auto& X) { return !X.IsValid() || X == this; });
 
 	LOG_VOXEL(Log, TEXT("Voxel Invoker disabled; Name: %s"), *GetName());
+
+	OnInvokerChanged.Broadcast(this);
 }
 
 bool UVoxelInvokerComponentBase::IsInvokerEnabled() const
@@ -74,6 +78,28 @@ bool UVoxelInvokerComponentBase::IsInvokerEnabled() const
 	return bIsInvokerEnabled;
 }
 
+void UVoxelInvokerComponentBase::NotifyInvokerChanged()
+{
+	if (bIsInvokerEnabled)
+	{
+		OnInvokerChanged.Broadcast(this);
+	}
+}
+
+void UVoxelInvokerComponentBase::SetUseForPriorities(bool bNewUseForPriorities)
+{
+	SetInvokerProperty(bUseForPriorities, bNewUseForPriorities);
+}
+
+bool UVoxelInvokerComponentBase::NeedsPolling() const
+{
+	const UClass* Class = GetClass();
+	return
+		Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UVoxelInvokerComponentBase, IsLocalInvoker)) ||
+		Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UVoxelInvokerComponentBase, GetInvokerVoxelPosition)) ||
+		Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UVoxelInvokerComponentBase, GetInvokerSettings));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -96,6 +122,24 @@ void UVoxelInvokerComponentBase::OnUnregister()
 	}
 }
 
+void UVoxelInvokerComponentBase::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	// Voxel worlds are in charge of the thresholds: this is only queuing the invoker
+	NotifyInvokerChanged();
+}
+
+#if WITH_EDITOR
+void UVoxelInvokerComponentBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Settings edited while playing
+	NotifyInvokerChanged();
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -114,6 +158,7 @@ const TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>>& UVoxelInvokerComponent
 }
 
 FSimpleMulticastDelegate UVoxelInvokerComponentBase::OnForceRefreshInvokers;
+FVoxelOnInvokerChanged UVoxelInvokerComponentBase::OnInvokerChanged;
 TMap<TWeakObjectPtr<UWorld>, TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>>> UVoxelInvokerComponentBase::Components;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -151,6 +196,48 @@ FVoxelInvokerSettings UVoxelSimpleInvokerComponent::GetInvokerSettings_Implement
 	return Settings;
 }
 
+void UVoxelSimpleInvokerComponent::SetUseForLOD(bool bNewUseForLOD)
+{
+	SetInvokerProperty(bUseForLOD, bNewUseForLOD);
+}
+
+void UVoxelSimpleInvokerComponent::SetLODToSet(int32 NewLODToSet)
+{
+	SetInvokerProperty(LODToSet, FMath::Clamp(NewLODToSet, 0, 26));
+}
+
+void UVoxelSimpleInvokerComponent::SetLODRange(float NewLODRange)
+{
+	SetInvokerProperty(LODRange, FMath::Max(NewLODRange, 0.f));
+}
+
+void UVoxelSimpleInvokerComponent::SetUseForCollisions(bool bNewUseForCollisions)
+{
+	SetInvokerProperty(bUseForCollisions, bNewUseForCollisions);
+}
+
+void UVoxelSimpleInvokerComponent::SetCollisionsRange(float NewCollisionsRange)
+{
+	SetInvokerProperty(CollisionsRange, FMath::Max(NewCollisionsRange, 0.f));
+}
+
+void UVoxelSimpleInvokerComponent::SetUseForNavmesh(bool bNewUseForNavmesh)
+{
+	SetInvokerProperty(bUseForNavmesh, bNewUseForNavmesh);
+}
+
+void UVoxelSimpleInvokerComponent::SetNavmeshRange(float NewNavmeshRange)
+{
+	SetInvokerProperty(NavmeshRange, FMath::Max(NewNavmeshRange, 0.f));
+}
+
+bool UVoxelSimpleInvokerComponent::NeedsPolling() const
+{
+	return
+		Super::NeedsPolling() ||
+		GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UVoxelSimpleInvokerComponent, GetInvokerGlobalPosition));
+}
+
 FVector UVoxelSimpleInvokerComponent::GetInvokerGlobalPosition_Implementation() const
 {
 	return GetComponentLocation();
@@ -160,6 +247,18 @@ FVector UVoxelSimpleInvokerComponent::GetInvokerGlobalPosition_Implementation()
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+void UVoxelInvokerWithPredictionComponent::SetEnablePrediction(bool bNewEnablePrediction)
+{
+	// Also updates whether the invoker is polled
+	SetInvokerProperty(bEnablePrediction, bNewEnablePrediction);
+}
+
+bool UVoxelInvokerWithPredictionComponent::NeedsPolling() const
+{
+	// The velocity can change without the component moving
+	return Super::NeedsPolling() || bEnablePrediction;
+}
+
 FVector UVoxelInvokerWithPredictionComponent::GetInvokerGlobalPosition_Implementation() const
 {
 	FVector Position = GetComponentLocation();
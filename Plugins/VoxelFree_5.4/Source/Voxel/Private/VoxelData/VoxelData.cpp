@@ -7,6 +7,7 @@
 #include "VoxelData/VoxelDataOctree.h"
 #include "VoxelData/VoxelSaveUtilities.h"
 #include "VoxelData/VoxelDataUtilities.h"
+#include "VoxelData/VoxelGeneratedDataCache.h"
 
 #include "VoxelDiff.h"
 #include "VoxelEnums.h"
@@ -31,6 +32,12 @@ VOXEL_API TAutoConsoleVariable<int32> CVarStoreSpecialValueForGeneratorValuesInS
 		TEXT("Important: must be the same when saving & loading!"),
 		ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarCompressIdleLeavesAfterFrames(
+		TEXT("voxel.data.CompressIdleLeavesAfterFrames"),
+		60,
+		TEXT("Edited leaves are compressed to a single value or to a palette once they haven't been edited for this many voxel world ticks. Lowers memory usage a lot on edited worlds. 0 to disable"),
+		ECVF_Default);
+
 DEFINE_STAT(STAT_NumVoxelAssetItems);
 DEFINE_STAT(STAT_NumVoxelDisableEditsItems);
 DEFINE_STAT(STAT_NumVoxelDataItems);
@@ -95,6 +102,7 @@ FVoxelDataSettings::FVoxelDataSettings(
 FVoxelData::FVoxelData(const FVoxelDataSettings& Settings)
 	: IVoxelData(Settings.Depth, Settings.WorldBounds, Settings.bEnableMultiplayer, Settings.bEnableUndoRedo, Settings.Generator)
 	, Octree(MakeUnique<FVoxelDataOctreeParent>(Depth))
+	, GeneratedDataCache(MakeUnique<FVoxelGeneratedDataCache>())
 {
 	check(Depth > 0);
 	check(Octree->GetBounds().Contains(WorldBounds));
@@ -244,12 +252,25 @@ private:
 				!LockedOctrees.IsValidIndex(LockedOctreesIndex) ||
 				!Octree.IsInOctree(LockedOctrees[LockedOctreesIndex].Position));
 
+			if (LockType == EVoxelLockType::Write)
+			{
+				// Must be done before unlocking, else a reader could cache an outdated range
+				Octree.ClearCachedRanges();
+			}
+
 			Octree.Mutex.Unlock(LockType);
 		}
 		else if (Octree.IsInOctree(LockedOctrees[LockedOctreesIndex].Position))
 		{
 			checkVoxelSlow(LockedOctrees[LockedOctreesIndex].Height < Octree.Height);
 			checkVoxelSlow(!Octree.IsLeaf());
+
+			if (LockType == EVoxelLockType::Write)
+			{
+				// The cached ranges of the parents depend on their children
+				Octree.ClearCachedRanges();
+			}
+
 			auto& Parent = Octree.AsParent();
 			for (auto& Child : Parent.GetChildren())
 			{
@@ -310,10 +331,13 @@ void FVoxelData::ClearData()
 		ensure(GetCachedMemory().Materials.GetValue() == 0);
 
 		Octree = MakeUnique<FVoxelDataOctreeParent>(Depth);
+		// The items are destroyed
+		GeneratedDataCache->Empty();
 	}
 	MainLock.Unlock(EVoxelLockType::Write);
 
 	UndoRedo = {};
+	ResetLeavesWithUndoRedo();
 	MarkAsDirty();
 
 #define CLEAR(Type, Stat) \
@@ -372,48 +396,46 @@ template VOXEL_API void FVoxelData::CheckIsSingle<FVoxelValue   >(const FVoxelIn
 template VOXEL_API void FVoxelData::CheckIsSingle<FVoxelMaterial>(const FVoxelIntBox&);
 
 template<typename T>
-void FVoxelData::Get(TVoxelQueryZone<T>& GlobalQueryZone, int32 LOD) const
+inline void CopyLeafData(const FVoxelDataOctreeLeaf& Leaf, const TVoxelDataOctreeLeafData<T>& Data, TVoxelQueryZone<T>& QueryZone)
 {
-	VOXEL_ASYNC_FUNCTION_COUNTER();
-
-	// TODO this is very inefficient for high LODs as we don't early exit when we already know we won't be reading any data in the chunk
-	// TODO BUG: this is also querying data multiple times if we have edited data!
-	FVoxelOctreeUtilities::IterateTreeInBounds(GetOctree(), GlobalQueryZone.Bounds, [&](FVoxelDataOctreeBase& InOctree)
+	VOXEL_SLOW_SCOPE_COUNTER("Copy Data");
+	const FIntVector Min = Leaf.GetMin();
+	for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
 	{
-		if (!InOctree.IsLeafOrHasNoChildren()) return;
-		ensureThreadSafe(InOctree.IsLockedForRead());
-		
-		auto QueryZone = GlobalQueryZone.ShrinkTo(InOctree.GetBounds());
+		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
+			{
+				const int32 Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(Min, X, Y, Z);
+				QueryZone.Set(X, Y, Z, Data.Get(Index));
+			}
+		}
+	}
+}
 
-		if (InOctree.IsLeaf())
+template<typename T>
+inline void CopyBlockData(const FIntVector& Block, const TArray<T>& Data, TVoxelQueryZone<T>& QueryZone)
+{
+	VOXEL_SLOW_SCOPE_COUNTER("Copy Cached Generator Data");
+	for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
+	{
+		for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
 		{
-			auto& Data = InOctree.AsLeaf().GetData<T>();
-			if (Data.HasData())
+			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
 			{
-				VOXEL_SLOW_SCOPE_COUNTER("Copy Data");
-				const FIntVector Min = InOctree.GetMin();
-				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
-				{
-					for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
-					{
-						for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
-						{
-							const int32 Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(Min, X, Y, Z);
-							QueryZone.Set(X, Y, Z, Data.Get(Index));
-						}
-					}
-				}
-				return;
+				const int32 Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(Block, X, Y, Z);
+				QueryZone.Set(X, Y, Z, Data.GetData()[Index]);
 			}
 		}
-		
-		InOctree.GetFromGeneratorAndAssets<T>(*Generator, QueryZone, LOD);
-	});
+	}
+}
 
-	// Handle data outside of the world bounds
-	// Can happen on edges with marching cubes, as it's querying N + 1 voxels with N a power of 2
-	// Note that we should probably use WorldBounds here, but doing so with a correct handling of Step is quite complex
-	const FVoxelIntBox OctreeBounds = Octree->GetBounds();
+// Handle data outside of the world bounds
+// Can happen on edges with marching cubes, as it's querying N + 1 voxels with N a power of 2
+// Note that we should probably use WorldBounds here, but doing so with a correct handling of Step is quite complex
+template<typename T>
+void GetOutsideOfOctree(const FVoxelData& Data, const FVoxelIntBox& OctreeBounds, TVoxelQueryZone<T>& GlobalQueryZone, int32 LOD)
+{
 	check(OctreeBounds.IsMultipleOf(GlobalQueryZone.Step));
 	if (!OctreeBounds.Contains(GlobalQueryZone.Bounds))
 	{
@@ -428,7 +450,7 @@ void FVoxelData::Get(TVoxelQueryZone<T>& GlobalQueryZone, int32 LOD) const
 					for (VOXEL_QUERY_ZONE_ITERATE(LocalQueryZone, Z))
 					{
 						// Get will handle clamping to the world bounds
-						LocalQueryZone.Set(X, Y, Z, Get<T>(X, Y, Z, LOD));
+						LocalQueryZone.Set(X, Y, Z, Data.Get<T>(X, Y, Z, LOD));
 					}
 				}
 			}
@@ -436,90 +458,477 @@ void FVoxelData::Get(TVoxelQueryZone<T>& GlobalQueryZone, int32 LOD) const
 	}
 }
 
-template VOXEL_API void FVoxelData::Get<FVoxelValue   >(TVoxelQueryZone<FVoxelValue   >&, int32) const;
-template VOXEL_API void FVoxelData::Get<FVoxelMaterial>(TVoxelQueryZone<FVoxelMaterial>&, int32) const;
+template<typename T>
+inline FVoxelGeneratedDataCache::TBlockData<T> GenerateBlock(const FVoxelDataOctreeBase& Node, const FVoxelGeneratorInstance& Generator, const FIntVector& Block)
+{
+	TArray<T> Data;
+	Data.SetNumUninitialized(VOXELS_PER_DATA_CHUNK);
+	TVoxelQueryZone<T> QueryZone(FVoxelGeneratedDataCache::GetBlockBounds(Block), Data);
+	Node.GetFromGeneratorAndAssets<T>(Generator, QueryZone, 0);
+	return MakeVoxelShared<const TArray<T>>(MoveTemp(Data));
+}
 
-TVoxelRange<FVoxelValue> FVoxelData::GetValueRange(const FVoxelIntBox& InBounds, int32 LOD) const
+template<typename T>
+void FVoxelData::GetFromGenerator(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& LockedBounds, TVoxelQueryZone<T>& QueryZone, int32 LOD) const
 {
-	VOXEL_ASYNC_FUNCTION_COUNTER();
-	ensure(InBounds.IsValid());
-	
-	const auto Apply = [&](FVoxelDataOctreeBase& Tree)
+	// Only LOD 0 queries are worth caching: higher LODs would need to generate 8x more data or more
+	// The LOD is checked too, as the generator is allowed to return different data for a step 1 query made at a higher LOD
+	if (QueryZone.Step != 1 || LOD != 0 || !FVoxelGeneratedDataCache::IsEnabled())
 	{
-		const auto TreeBounds = Tree.GetBounds();
-		ensureVoxelSlowNoSideEffects(InBounds.Intersect(TreeBounds));
-		
-		const auto QueryBounds = InBounds.Overlap(TreeBounds);
-		ensureVoxelSlowNoSideEffects(QueryBounds.IsValid());
+		Node.GetFromGeneratorAndAssets<T>(*Generator, QueryZone, LOD);
+		return;
+	}
+
+	VOXEL_SLOW_FUNCTION_COUNTER();
+
+	const FVoxelIntBox BlocksBounds = QueryZone.Bounds.MakeMultipleOfBigger(DATA_CHUNK_SIZE);
+	BlocksBounds.Iterate(DATA_CHUNK_SIZE, [&](int32 X, int32 Y, int32 Z)
+	{
+		const FIntVector Block(X, Y, Z);
+		const FVoxelIntBox BlockBounds = FVoxelGeneratedDataCache::GetBlockBounds(Block);
+		auto BlockQueryZone = QueryZone.ShrinkTo(BlockBounds);
+
+		auto Data = GeneratedDataCache->Find<T>(Block);
+		// Only add blocks that are entirely locked: else an item could be added to the rest of the block while we are generating it
+		if (!Data.IsValid() && LockedBounds.Contains(BlockBounds))
+		{
+			Data = GenerateBlock<T>(Node, *Generator, Block);
+			GeneratedDataCache->Add<T>(Block, Data);
+		}
+
+		if (Data.IsValid())
+		{
+			CopyBlockData(Block, *Data, BlockQueryZone);
+		}
+		else
+		{
+			Node.GetFromGeneratorAndAssets<T>(*Generator, BlockQueryZone, LOD);
+		}
+	});
+}
+
+void FVoxelData::GetFromGenerator(
+	const FVoxelDataOctreeBase& Node, 
+	const FVoxelIntBox& LockedBounds, 
+	TVoxelQueryZone<FVoxelValue>& ValueQueryZone, 
+	TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, 
+	int32 LOD) const
+{
+	if (ValueQueryZone.Step != 1 || LOD != 0 || !FVoxelGeneratedDataCache::IsEnabled())
+	{
+		Node.GetFromGeneratorAndAssets(*Generator, ValueQueryZone, MaterialQueryZone, LOD);
+		return;
+	}
+
+	VOXEL_SLOW_FUNCTION_COUNTER();
+
+	const FVoxelIntBox BlocksBounds = ValueQueryZone.Bounds.MakeMultipleOfBigger(DATA_CHUNK_SIZE);
+	BlocksBounds.Iterate(DATA_CHUNK_SIZE, [&](int32 X, int32 Y, int32 Z)
+	{
+		const FIntVector Block(X, Y, Z);
+		const FVoxelIntBox BlockBounds = FVoxelGeneratedDataCache::GetBlockBounds(Block);
+		auto BlockValueQueryZone = ValueQueryZone.ShrinkTo(BlockBounds);
+
+		if (!MaterialQueryZone.Bounds.Intersect(BlockBounds))
+		{
+			GetFromGenerator<FVoxelValue>(Node, LockedBounds, BlockValueQueryZone, LOD);
+			return;
+		}
+		auto BlockMaterialQueryZone = MaterialQueryZone.ShrinkTo(BlockBounds);
 		
-		if (Tree.IsLeaf())
+		auto Values = GeneratedDataCache->Find<FVoxelValue>(Block);
+		auto Materials = GeneratedDataCache->Find<FVoxelMaterial>(Block);
+
+		if (LockedBounds.Contains(BlockBounds))
 		{
-			auto& Data = Tree.AsLeaf().GetData<FVoxelValue>();
-			if (Data.IsSingleValue())
+			if (!Values.IsValid() && !Materials.IsValid())
+			{
+				TArray<FVoxelValue> NewValues;
+				TArray<FVoxelMaterial> NewMaterials;
+				NewValues.SetNumUninitialized(VOXELS_PER_DATA_CHUNK);
+				NewMaterials.SetNumUninitialized(VOXELS_PER_DATA_CHUNK);
+				
+				TVoxelQueryZone<FVoxelValue> NewValueQueryZone(BlockBounds, NewValues);
+				TVoxelQueryZone<FVoxelMaterial> NewMaterialQueryZone(BlockBounds, NewMaterials);
+				Node.GetFromGeneratorAndAssets(*Generator, NewValueQueryZone, NewMaterialQueryZone, 0);
+				
+				Values = MakeVoxelShared<const TArray<FVoxelValue>>(MoveTemp(NewValues));
+				Materials = MakeVoxelShared<const TArray<FVoxelMaterial>>(MoveTemp(NewMaterials));
+				GeneratedDataCache->Add<FVoxelValue>(Block, Values);
+				GeneratedDataCache->Add<FVoxelMaterial>(Block, Materials);
+			}
+			else if (!Values.IsValid())
 			{
-				return TVoxelRange<FVoxelValue>(Data.GetSingleValue());
+				Values = GenerateBlock<FVoxelValue>(Node, *Generator, Block);
+				GeneratedDataCache->Add<FVoxelValue>(Block, Values);
 			}
-			if (Data.IsDirty())
+			else if (!Materials.IsValid())
 			{
-				// Could also store the data bounds, but that would require to track it when editing. Probably not worth the added cost.
-				return TVoxelRange<FVoxelValue>::Infinite();
+				Materials = GenerateBlock<FVoxelMaterial>(Node, *Generator, Block);
+				GeneratedDataCache->Add<FVoxelMaterial>(Block, Materials);
 			}
 		}
 
-		auto& ItemHolder = Tree.GetItemHolder();
+		if (Values.IsValid())
+		{
+			CopyBlockData(Block, *Values, BlockValueQueryZone);
+		}
+		if (Materials.IsValid())
+		{
+			CopyBlockData(Block, *Materials, BlockMaterialQueryZone);
+		}
 
-		TOptional<TVoxelRange<FVoxelValue>> Range;
-		for (int32 Index = ItemHolder.GetAssetItems().Num() - 1; Index >= 0; Index--)
+		if (!Values.IsValid() && !Materials.IsValid())
 		{
-			auto& Asset = *ItemHolder.GetAssetItems()[Index];
+			Node.GetFromGeneratorAndAssets(*Generator, BlockValueQueryZone, BlockMaterialQueryZone, LOD);
+		}
+		else if (!Values.IsValid())
+		{
+			Node.GetFromGeneratorAndAssets<FVoxelValue>(*Generator, BlockValueQueryZone, LOD);
+		}
+		else if (!Materials.IsValid())
+		{
+			Node.GetFromGeneratorAndAssets<FVoxelMaterial>(*Generator, BlockMaterialQueryZone, LOD);
+		}
+	});
+}
 
-			if (!Asset.Bounds.Intersect(QueryBounds)) continue;
+template<typename T>
+void FVoxelData::Get(TVoxelQueryZone<T>& GlobalQueryZone, int32 LOD) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
 
-			const auto AssetRangeFlt = Asset.Generator->GetValueRange_Transform(
-				Asset.LocalToWorld,
-				Asset.Bounds.Overlap(QueryBounds),
-				LOD,
-				FVoxelItemStack(ItemHolder, *Generator, Index));
-			const auto AssetRange = TVoxelRange<FVoxelValue>(AssetRangeFlt);
+	// TODO this is very inefficient for high LODs as we don't early exit when we already know we won't be reading any data in the chunk
+	// TODO BUG: this is also querying data multiple times if we have edited data!
+	FVoxelOctreeUtilities::IterateTreeInBounds(GetOctree(), GlobalQueryZone.Bounds, [&](FVoxelDataOctreeBase& InOctree)
+	{
+		if (!InOctree.IsLeafOrHasNoChildren()) return;
+		ensureThreadSafe(InOctree.IsLockedForRead());
+		
+		auto QueryZone = GlobalQueryZone.ShrinkTo(InOctree.GetBounds());
 
-			if (!Range.IsSet())
+		if (InOctree.IsLeaf())
+		{
+			auto& Data = InOctree.AsLeaf().GetData<T>();
+			if (Data.HasData())
 			{
-				Range = AssetRange;
+				CopyLeafData(InOctree.AsLeaf(), Data, QueryZone);
+				return;
+			}
+		}
+		
+		GetFromGenerator<T>(InOctree, GlobalQueryZone.Bounds, QueryZone, LOD);
+	});
+
+	GetOutsideOfOctree(*this, Octree->GetBounds(), GlobalQueryZone, LOD);
+}
+
+template VOXEL_API void FVoxelData::Get<FVoxelValue   >(TVoxelQueryZone<FVoxelValue   >&, int32) const;
+template VOXEL_API void FVoxelData::Get<FVoxelMaterial>(TVoxelQueryZone<FVoxelMaterial>&, int32) const;
+
+void FVoxelData::GetValuesAndMaterials(TVoxelQueryZone<FVoxelValue>& GlobalValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& GlobalMaterialQueryZone, int32 LOD) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	check(GlobalValueQueryZone.Step == GlobalMaterialQueryZone.Step);
+	check(GlobalValueQueryZone.Bounds.Contains(GlobalMaterialQueryZone.Bounds));
+
+	FVoxelOctreeUtilities::IterateTreeInBounds(GetOctree(), GlobalValueQueryZone.Bounds, [&](FVoxelDataOctreeBase& InOctree)
+	{
+		if (!InOctree.IsLeafOrHasNoChildren()) return;
+		ensureThreadSafe(InOctree.IsLockedForRead());
+
+		auto ValueQueryZone = GlobalValueQueryZone.ShrinkTo(InOctree.GetBounds());
+		
+		if (!GlobalMaterialQueryZone.Bounds.Intersect(ValueQueryZone.Bounds))
+		{
+			// No materials needed here
+			if (InOctree.IsLeaf() && InOctree.AsLeaf().GetData<FVoxelValue>().HasData())
+			{
+				CopyLeafData(InOctree.AsLeaf(), InOctree.AsLeaf().GetData<FVoxelValue>(), ValueQueryZone);
 			}
 			else
 			{
-				Range = TVoxelRange<FVoxelValue>::Union(Range.GetValue(), AssetRange);
+				GetFromGenerator<FVoxelValue>(InOctree, GlobalValueQueryZone.Bounds, ValueQueryZone, LOD);
 			}
+			return;
+		}
+		
+		auto MaterialQueryZone = GlobalMaterialQueryZone.ShrinkTo(InOctree.GetBounds());
 
-			if (Asset.Bounds.Contains(QueryBounds))
+		bool bHasValues = false;
+		bool bHasMaterials = false;
+		if (InOctree.IsLeaf())
+		{
+			const FVoxelDataOctreeLeaf& Leaf = InOctree.AsLeaf();
+			
+			auto& Values = Leaf.GetData<FVoxelValue>();
+			if (Values.HasData())
 			{
-				// This one is covering everything, no need to continue deeper in the stack nor to check the generator
-				return Range.GetValue();
+				CopyLeafData(Leaf, Values, ValueQueryZone);
+				bHasValues = true;
+			}
+			
+			auto& Materials = Leaf.GetData<FVoxelMaterial>();
+			if (Materials.HasData())
+			{
+				CopyLeafData(Leaf, Materials, MaterialQueryZone);
+				bHasMaterials = true;
 			}
 		}
-		
-		// Note: need to query individual bounds as ItemHolder might be different
-		const auto GeneratorRangeFlt = Generator->GetValueRange(QueryBounds, LOD, FVoxelItemStack(ItemHolder));
-		const auto GeneratorRange = TVoxelRange<FVoxelValue>(GeneratorRangeFlt);
+
+		if (!bHasValues && !bHasMaterials)
+		{
+			GetFromGenerator(InOctree, GlobalValueQueryZone.Bounds, ValueQueryZone, MaterialQueryZone, LOD);
+		}
+		else if (!bHasValues)
+		{
+			GetFromGenerator<FVoxelValue>(InOctree, GlobalValueQueryZone.Bounds, ValueQueryZone, LOD);
+		}
+		else if (!bHasMaterials)
+		{
+			GetFromGenerator<FVoxelMaterial>(InOctree, GlobalValueQueryZone.Bounds, MaterialQueryZone, LOD);
+		}
+	});
+
+	const FVoxelIntBox OctreeBounds = Octree->GetBounds();
+	GetOutsideOfOctree(*this, OctreeBounds, GlobalValueQueryZone, LOD);
+	GetOutsideOfOctree(*this, OctreeBounds, GlobalMaterialQueryZone, LOD);
+}
+
+TVoxelRange<FVoxelValue> FVoxelData::GetValueRange(const FVoxelIntBox& InBounds, int32 LOD) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	ensure(InBounds.IsValid());
+	
+	// Note: even if WorldBounds doesn't contain InBounds, we don't need to check other values are the queries are always clamped to world bounds
+	return GetNodeValueRangeCached(GetOctree(), WorldBounds.Clamp(InBounds), LOD);
+}
+
+inline EVoxelDataRangeState GetRangeStateFromRange(const TVoxelRange<FVoxelValue>& Range)
+{
+	if (Range.Min.IsEmpty())
+	{
+		return EVoxelDataRangeState::Empty;
+	}
+	if (!Range.Max.IsEmpty())
+	{
+		return EVoxelDataRangeState::Full;
+	}
+	return EVoxelDataRangeState::Surface;
+}
+
+inline EVoxelDataRangeState CombineRangeStates(EVoxelDataRangeState A, EVoxelDataRangeState B)
+{
+	if (A == EVoxelDataRangeState::Unknown) return B;
+	if (B == EVoxelDataRangeState::Unknown) return A;
+	return A == B ? A : EVoxelDataRangeState::Surface;
+}
+
+EVoxelDataRangeState FVoxelData::GetRangeState(const FVoxelIntBox& InBounds, int32 LOD) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	ensure(InBounds.IsValid());
+
+	// Queries are always clamped to world bounds
+	const FVoxelIntBox Bounds = WorldBounds.Clamp(InBounds);
+	const EVoxelDataRangeState State = GetNodeRangeState(GetOctree(), Bounds, LOD);
+	ensure(State != EVoxelDataRangeState::Unknown);
+	return State;
+}
+
+TVoxelRange<FVoxelValue> FVoxelData::GetNodeValueRange(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& QueryBounds, int32 LOD) const
+{
+	ensureVoxelSlowNoSideEffects(QueryBounds.IsValid());
+	ensureVoxelSlowNoSideEffects(Node.GetBounds().Contains(QueryBounds));
+	ensureThreadSafe(Node.IsLockedForRead());
+	
+	if (Node.IsLeaf())
+	{
+		auto& Data = Node.AsLeaf().GetData<FVoxelValue>();
+		if (Data.IsSingleValue())
+		{
+			return TVoxelRange<FVoxelValue>(Data.GetSingleValue());
+		}
+		if (Data.HasData() && Data.IsRangeValid() && QueryBounds.Contains(Node.GetBounds()))
+		{
+			return { Data.GetRangeMin(), Data.GetRangeMax() };
+		}
+		if (Data.HasData())
+		{
+			VOXEL_SLOW_SCOPE_COUNTER("Scan leaf values");
+			
+			const FIntVector Min = Node.GetMin();
+			FVoxelValue RangeMin = FVoxelValue::Empty();
+			FVoxelValue RangeMax = FVoxelValue::Full();
+			QueryBounds.Iterate([&](int32 X, int32 Y, int32 Z)
+			{
+				const FVoxelValue Value = Data.Get(FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(Min, X, Y, Z));
+				RangeMin = FMath::Min(RangeMin, Value);
+				RangeMax = FMath::Max(RangeMax, Value);
+			});
+			return { RangeMin, RangeMax };
+		}
+	}
+
+	auto& ItemHolder = Node.GetItemHolder();
+
+	TOptional<TVoxelRange<FVoxelValue>> Range;
+	for (int32 Index = ItemHolder.GetAssetItems().Num() - 1; Index >= 0; Index--)
+	{
+		auto& Asset = *ItemHolder.GetAssetItems()[Index];
+
+		if (!Asset.Bounds.Intersect(QueryBounds)) continue;
+
+		const auto AssetRangeFlt = Asset.Generator->GetValueRange_Transform(
+			Asset.LocalToWorld,
+			Asset.Bounds.Overlap(QueryBounds),
+			LOD,
+			FVoxelItemStack(ItemHolder, *Generator, Index));
+		const auto AssetRange = TVoxelRange<FVoxelValue>(AssetRangeFlt);
+
 		if (!Range.IsSet())
 		{
-			return GeneratorRange;
+			Range = AssetRange;
 		}
 		else
 		{
-			return TVoxelRange<FVoxelValue>::Union(Range.GetValue(), GeneratorRange);
+			Range = TVoxelRange<FVoxelValue>::Union(Range.GetValue(), AssetRange);
 		}
-	};
-	const auto Reduction = [](auto RangeA, auto RangeB)
+
+		if (Asset.Bounds.Contains(QueryBounds))
+		{
+			// This one is covering everything, no need to continue deeper in the stack nor to check the generator
+			return Range.GetValue();
+		}
+	}
+	
+	// Note: need to query individual bounds as ItemHolder might be different
+	const auto GeneratorRangeFlt = Generator->GetValueRange(QueryBounds, LOD, FVoxelItemStack(ItemHolder));
+	const auto GeneratorRange = TVoxelRange<FVoxelValue>(GeneratorRangeFlt);
+	if (!Range.IsSet())
 	{
-		return TVoxelRange<FVoxelValue>::Union(RangeA, RangeB);
-	};
+		return GeneratorRange;
+	}
+	else
+	{
+		return TVoxelRange<FVoxelValue>::Union(Range.GetValue(), GeneratorRange);
+	}
+}
+
+TVoxelRange<FVoxelValue> FVoxelData::GetNodeValueRangeCached(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& Bounds, int32 LOD) const
+{
+	const FVoxelIntBox NodeBounds = Node.GetBounds().Overlap(WorldBounds);
+	checkVoxelSlow(NodeBounds.Intersect(Bounds));
+
+	const bool bIsBottomNode = Node.IsLeafOrHasNoChildren();
+	const bool bIsContained = Bounds.Contains(NodeBounds);
+
+	if (!bIsContained)
+	{
+		if (bIsBottomNode)
+		{
+			return GetNodeValueRange(Node, NodeBounds.Overlap(Bounds), LOD);
+		}
+		
+		TOptional<TVoxelRange<FVoxelValue>> Range;
+		for (auto& Child : Node.AsParent().GetChildren())
+		{
+			if (!Child.GetBounds().Intersect(Bounds)) continue;
+
+			const auto ChildRange = GetNodeValueRangeCached(Child, Bounds, LOD);
+			Range = Range.IsSet() ? TVoxelRange<FVoxelValue>::Union(Range.GetValue(), ChildRange) : ChildRange;
+		}
+		return Range.GetValue();
+	}
+
+	// The entire node is locked: can use its cache
+	FVoxelValue CachedMin;
+	FVoxelValue CachedMax;
+	if (Node.GetCachedValueRange(LOD, CachedMin, CachedMax))
+	{
+		return { CachedMin, CachedMax };
+	}
+
+	TVoxelRange<FVoxelValue> Range;
+	if (bIsBottomNode)
+	{
+		Range = GetNodeValueRange(Node, NodeBounds, LOD);
+	}
+	else
+	{
+		TOptional<TVoxelRange<FVoxelValue>> ChildrenRange;
+		for (auto& Child : Node.AsParent().GetChildren())
+		{
+			if (!Child.GetBounds().Intersect(Bounds)) continue;
+
+			const auto ChildRange = GetNodeValueRangeCached(Child, Bounds, LOD);
+			ChildrenRange = ChildrenRange.IsSet() ? TVoxelRange<FVoxelValue>::Union(ChildrenRange.GetValue(), ChildRange) : ChildRange;
+		}
+		Range = ChildrenRange.GetValue();
+	}
 	
-	// Note: even if WorldBounds doesn't contain InBounds, we don't need to check other values are the queries are always clamped to world bounds
-	const auto Result = FVoxelOctreeUtilities::ReduceInBounds<TVoxelRange<FVoxelValue>>(GetOctree(), WorldBounds.Clamp(InBounds), Apply, Reduction);
+	Node.SetCachedValueRange(LOD, Range.Min, Range.Max);
+	return Range;
+}
+
+EVoxelDataRangeState FVoxelData::GetNodeRangeState(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& Bounds, int32 LOD) const
+{
+	const FVoxelIntBox NodeBounds = Node.GetBounds().Overlap(WorldBounds);
+	checkVoxelSlow(NodeBounds.Intersect(Bounds));
+
+	const bool bIsBottomNode = Node.IsLeafOrHasNoChildren();
+	const bool bIsContained = Bounds.Contains(NodeBounds);
 	
-	ensure(Result.IsSet());
-	return Result.Get(FVoxelValue::Empty());
+	// Bottom nodes are always entirely locked. Parents are only if all their children are in Bounds
+	const bool bCanUseCache = bIsBottomNode || bIsContained;
+	
+	if (bCanUseCache)
+	{
+		const EVoxelDataRangeState CachedState = Node.GetCachedRangeState(LOD);
+		// If the entire node is empty or full, so is any part of it
+		if (CachedState == EVoxelDataRangeState::Empty ||
+			CachedState == EVoxelDataRangeState::Full ||
+			(CachedState == EVoxelDataRangeState::Surface && bIsContained))
+		{
+			return CachedState;
+		}
+	}
+
+	if (bIsBottomNode)
+	{
+		EVoxelDataRangeState State = Node.GetCachedRangeState(LOD);
+		if (State == EVoxelDataRangeState::Unknown)
+		{
+			State = GetRangeStateFromRange(GetNodeValueRange(Node, NodeBounds, LOD));
+			Node.SetCachedRangeState(LOD, State);
+		}
+		if (State == EVoxelDataRangeState::Surface && !bIsContained)
+		{
+			// The range might be smaller on the part we're querying
+			State = GetRangeStateFromRange(GetNodeValueRange(Node, NodeBounds.Overlap(Bounds), LOD));
+		}
+		return State;
+	}
+
+	EVoxelDataRangeState State = EVoxelDataRangeState::Unknown;
+	for (auto& Child : Node.AsParent().GetChildren())
+	{
+		if (!Child.GetBounds().Intersect(Bounds)) continue;
+
+		State = CombineRangeStates(State, GetNodeRangeState(Child, Bounds, LOD));
+		if (State == EVoxelDataRangeState::Surface)
+		{
+			break;
+		}
+	}
+	checkVoxelSlow(State != EVoxelDataRangeState::Unknown);
+
+	if (bIsContained)
+	{
+		Node.SetCachedRangeState(LOD, State);
+	}
+	return State;
 }
 
 TVoxelRange<v_flt> FVoxelData::GetCustomOutputRange(TVoxelRange<v_flt> DefaultValue, FName Name, const FVoxelIntBox& InBounds, int32 LOD) const
@@ -725,11 +1134,13 @@ bool FVoxelData::LoadFromSave(const FVoxelUncompressedWorldSaveImpl& Save, const
 								Value = Generator->Get<FVoxelValue>(X, Y, Z, 0, FVoxelItemStack::Empty);
 							}
 						});
-
-						Leaf.Values.TryCompressToSingleValue(*this);
+						Leaf.Values.ComputeRange();
 					}
 				}
 
+				// Saves are storing uncompressed buffers, compress them back
+				Leaf.Values.Compress(*this);
+
 				ChunkIndex++;
 				if (OutBoundsToUpdate)
 				{
@@ -780,12 +1191,18 @@ static TAutoConsoleVariable<int32> CVarResetDataChunksWhenUndoingAddItem(
 	TEXT("If true, will reset all data chunks affected by AddItem when undoing it. If false, these chunks will be left untouched. In both cases, undo is imperfect"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarUndoRedoMemoryBudgetMB(
+	TEXT("voxel.data.UndoRedoMemoryBudgetMB"),
+	1024,
+	TEXT("Max memory used by the undo redo history of a voxel world, in MB. When exceeded, the oldest frames are evicted on SaveFrame. 0 to disable"),
+	ECVF_Default);
+
 bool FVoxelData::Undo(TArray<FVoxelIntBox>& OutBoundsToUpdate)
 {
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_UNDO_REDO();
 
-	if (UndoRedo.HistoryPosition <= 0)
+	if (UndoRedo.HistoryPosition <= UndoRedo.MinHistoryPosition)
 	{
 		return false;
 	}
@@ -817,7 +1234,10 @@ bool FVoxelData::Undo(TArray<FVoxelIntBox>& OutBoundsToUpdate)
 #endif
 				LeavesWithRedoStack.Add(&Leaf);
 			}
+			UndoRedo.HistoryMemory -= Leaf.UndoRedo->GetHistoryAllocatedSize();
 			Leaf.UndoRedo->UndoRedo<EVoxelUndoRedo::Undo>(*this, Leaf, UndoRedo.HistoryPosition);
+			UndoRedo.HistoryMemory += Leaf.UndoRedo->GetHistoryAllocatedSize();
+			AddLeafToCompress(Leaf.GetMin());
 			OutBoundsToUpdate.Add(Leaf.GetBounds());
 		}
 	});
@@ -852,7 +1272,10 @@ bool FVoxelData::Redo(TArray<FVoxelIntBox>& OutBoundsToUpdate)
 	{
 		if (Leaf.UndoRedo.IsValid() && Leaf.UndoRedo->CanUndoRedo<EVoxelUndoRedo::Redo>(UndoRedo.HistoryPosition))
 		{
+			UndoRedo.HistoryMemory -= Leaf.UndoRedo->GetHistoryAllocatedSize();
 			Leaf.UndoRedo->UndoRedo<EVoxelUndoRedo::Redo>(*this, Leaf, UndoRedo.HistoryPosition);
+			UndoRedo.HistoryMemory += Leaf.UndoRedo->GetHistoryAllocatedSize();
+			AddLeafToCompress(Leaf.GetMin());
 			OutBoundsToUpdate.Add(Leaf.GetBounds());
 		}
 	});
@@ -868,12 +1291,10 @@ void FVoxelData::ClearFrames()
 	UndoRedo = {};
 
 	FVoxelWriteScopeLock Lock(*this, FVoxelIntBox::Infinite, FUNCTION_FNAME);
-	FVoxelOctreeUtilities::IterateAllLeaves(GetOctree(), [&](FVoxelDataOctreeLeaf& Leaf)
+	IterateLeavesWithUndoRedo([&](FVoxelDataOctreeLeaf& Leaf)
 	{
-		if (Leaf.UndoRedo.IsValid())
-		{
-			Leaf.UndoRedo->ClearFrames(Leaf);
-		}
+		check(Leaf.UndoRedo.IsValid());
+		Leaf.UndoRedo->ClearFrames(Leaf);
 	});
 }
 
@@ -885,9 +1306,9 @@ void FVoxelData::SaveFrame(const FVoxelIntBox& Bounds)
 	{
 #if VOXEL_DEBUG
 		// Not thread safe, but for debug only so should be ok
-		FVoxelOctreeUtilities::IterateAllLeaves(GetOctree(), [&](FVoxelDataOctreeLeaf& Leaf)
+		IterateLeavesWithUndoRedo([&](FVoxelDataOctreeLeaf& Leaf)
 		{
-			if (Leaf.UndoRedo.IsValid() && !Leaf.UndoRedo->IsCurrentFrameEmpty() && !Leaf.GetBounds().Intersect(Bounds))
+			if (!Leaf.UndoRedo->IsCurrentFrameEmpty() && !Leaf.GetBounds().Intersect(Bounds))
 			{
 				ensureMsgf(false, TEXT("Save Frame called on too small bounds! Input Bounds: %s; Leaf Bounds: %s"), *Bounds.ToString(), *Leaf.GetBounds().ToString());
 			}
@@ -896,15 +1317,18 @@ void FVoxelData::SaveFrame(const FVoxelIntBox& Bounds)
 
 		// Call SaveFrame on the leaves
 		{
-			FVoxelReadScopeLock Lock(*this, Bounds, FUNCTION_FNAME);
+			auto LockInfo = Lock(EVoxelLockType::Read, Bounds, FUNCTION_FNAME);
 			FVoxelOctreeUtilities::IterateLeavesInBounds(GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
 			{
 				ensureThreadSafe(Leaf.IsLockedForRead());
 				if (Leaf.UndoRedo.IsValid())
 				{
-					Leaf.UndoRedo->SaveFrame(Leaf, UndoRedo.HistoryPosition);
+					UndoRedo.HistoryMemory -= Leaf.UndoRedo->GetHistoryAllocatedSize();
+					Leaf.UndoRedo->SaveFrame(*this, Leaf, UndoRedo.HistoryPosition);
+					UndoRedo.HistoryMemory += Leaf.UndoRedo->GetHistoryAllocatedSize();
 				}
 			});
+			Unlock(MoveTemp(LockInfo));
 		}
 
 		// Clear redo histories
@@ -916,7 +1340,9 @@ void FVoxelData::SaveFrame(const FVoxelIntBox& Bounds)
 				{
 					// Note: might be empty if we called Redo already
 					// Note: no need to lock, frame stacks are game thread only and a leaf cannot be destroyed without a global lock
-					Leaf->UndoRedo->GetFramesStack<EVoxelUndoRedo::Redo>().Reset();
+					UndoRedo.HistoryMemory -= Leaf->UndoRedo->GetHistoryAllocatedSize();
+					Leaf->UndoRedo->ClearRedoFrames();
+					UndoRedo.HistoryMemory += Leaf->UndoRedo->GetHistoryAllocatedSize();
 				}
 			}
 		}
@@ -924,13 +1350,10 @@ void FVoxelData::SaveFrame(const FVoxelIntBox& Bounds)
 
 #if VOXEL_DEBUG
 		// Not thread safe, but for debug only so should be ok
-		FVoxelOctreeUtilities::IterateAllLeaves(GetOctree(), [&](FVoxelDataOctreeLeaf& Leaf)
+		IterateLeavesWithUndoRedo([&](FVoxelDataOctreeLeaf& Leaf)
 		{
-			if (Leaf.UndoRedo.IsValid())
-			{
-				ensure(Leaf.UndoRedo->GetFramesStack<EVoxelUndoRedo::Redo>().Num() == 0);
-				ensure(Leaf.UndoRedo->IsCurrentFrameEmpty());
-			}
+			ensure(Leaf.UndoRedo->GetFramesStack<EVoxelUndoRedo::Redo>().Num() == 0);
+			ensure(Leaf.UndoRedo->IsCurrentFrameEmpty());
 		});
 #endif
 	}
@@ -950,8 +1373,10 @@ void FVoxelData::SaveFrame(const FVoxelIntBox& Bounds)
 	// Assign new unique id to this frame
 	UndoRedo.CurrentFrameUniqueId = UndoRedo.FrameUniqueIdCounter++;
 
-	ensure(UndoRedo.UndoFramesBounds.Num() == UndoRedo.HistoryPosition);
-	ensure(UndoRedo.UndoUniqueIds.Num() == UndoRedo.HistoryPosition);
+	TrimHistory();
+
+	ensure(UndoRedo.UndoFramesBounds.Num() == UndoRedo.HistoryPosition - UndoRedo.MinHistoryPosition);
+	ensure(UndoRedo.UndoUniqueIds.Num() == UndoRedo.HistoryPosition - UndoRedo.MinHistoryPosition);
 }
 
 bool FVoxelData::IsCurrentFrameEmpty()
@@ -961,16 +1386,91 @@ bool FVoxelData::IsCurrentFrameEmpty()
 
 	FVoxelReadScopeLock Lock(*this, FVoxelIntBox::Infinite, "IsCurrentFrameEmpty");
 	bool bValue = true;
-	FVoxelOctreeUtilities::IterateLeavesByPred(GetOctree(), [&](auto&) { return bValue; }, [&](auto& Leaf)
+	IterateLeavesWithUndoRedo([&](FVoxelDataOctreeLeaf& Leaf)
 	{
-		if (Leaf.UndoRedo.IsValid())
-		{
-			bValue &= Leaf.UndoRedo->IsCurrentFrameEmpty();
-		}
+		bValue = bValue && Leaf.UndoRedo->IsCurrentFrameEmpty();
 	});
 	return bValue;
 }
 
+void FVoxelData::TrimHistory()
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	const int64 MemoryBudget = int64(CVarUndoRedoMemoryBudgetMB.GetValueOnGameThread()) * 1024 * 1024;
+	if (MemoryBudget <= 0)
+	{
+		return;
+	}
+
+	if (UndoRedo.HistoryMemory <= MemoryBudget || UndoRedo.MinHistoryPosition >= UndoRedo.HistoryPosition)
+	{
+		return;
+	}
+
+	// Note: no need to lock, frame stacks are game thread only and a leaf cannot be destroyed without a global lock
+
+	// Memory used by each undo frame, oldest first
+	TArray<int64> FramesSizes;
+	FramesSizes.SetNumZeroed(UndoRedo.HistoryPosition - UndoRedo.MinHistoryPosition);
+	IterateLeavesWithUndoRedo([&](FVoxelDataOctreeLeaf& Leaf)
+	{
+		Leaf.UndoRedo->AddUndoFramesAllocatedSize(UndoRedo.MinHistoryPosition, FramesSizes);
+	});
+
+	int32 NumFramesToRemove = 0;
+	for (int64 Memory = UndoRedo.HistoryMemory; Memory > MemoryBudget && NumFramesToRemove < FramesSizes.Num(); NumFramesToRemove++)
+	{
+		Memory -= FramesSizes[NumFramesToRemove];
+	}
+	check(NumFramesToRemove > 0);
+
+	// Evict the oldest undo frames in a single pass. Frames are only stored as deltas to the next frame, so removing the oldest ones is safe
+	const int32 NewMinHistoryPosition = UndoRedo.MinHistoryPosition + NumFramesToRemove;
+	IterateLeavesWithUndoRedo([&](FVoxelDataOctreeLeaf& Leaf)
+	{
+		UndoRedo.HistoryMemory -= Leaf.UndoRedo->GetHistoryAllocatedSize();
+		Leaf.UndoRedo->ClearUndoFramesUpTo(NewMinHistoryPosition - 1);
+		UndoRedo.HistoryMemory += Leaf.UndoRedo->GetHistoryAllocatedSize();
+	});
+
+	UndoRedo.UndoFramesBounds.RemoveAt(0, NumFramesToRemove);
+	UndoRedo.UndoUniqueIds.RemoveAt(0, NumFramesToRemove);
+	UndoRedo.MinHistoryPosition = NewMinHistoryPosition;
+}
+
+void FVoxelData::CompressIdleLeaves()
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	const int32 NumIdleFrames = CVarCompressIdleLeavesAfterFrames.GetValueOnGameThread();
+
+	TArray<FIntVector> IdleLeaves;
+	PopIdleLeavesToCompress(NumIdleFrames, IdleLeaves);
+	if (NumIdleFrames <= 0)
+	{
+		// Disabled
+		return;
+	}
+
+	// Lock the leaves one by one: locking the union of their bounds could lock most of the world
+	for (const FIntVector& Min : IdleLeaves)
+	{
+		const FVoxelIntBox Bounds(Min, Min + DATA_CHUNK_SIZE);
+		FVoxelWriteScopeLock Lock(*this, Bounds, FUNCTION_FNAME);
+		FVoxelOctreeUtilities::IterateLeavesInBounds(GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+		{
+			// The leaf might have been destroyed since
+			if (Leaf.GetBounds().Min == Min && Leaf.Values.IsDirty())
+			{
+				Leaf.Values.Compress(*this);
+			}
+		});
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
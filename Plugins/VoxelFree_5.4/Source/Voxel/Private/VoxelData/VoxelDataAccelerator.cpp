@@ -3,6 +3,13 @@
 #include "VoxelData/VoxelDataAccelerator.h"
 #include "HAL/IConsoleManager.h"
 
+DEFINE_STAT(STAT_VoxelDataAcceleratorReads);
+DEFINE_STAT(STAT_VoxelDataAcceleratorWrites);
+DEFINE_STAT(STAT_VoxelDataAcceleratorCacheHits);
+DEFINE_STAT(STAT_VoxelDataAcceleratorCacheMisses);
+DEFINE_STAT(STAT_VoxelDataAcceleratorMapHits);
+DEFINE_STAT(STAT_VoxelDataAcceleratorMapMisses);
+
 static TAutoConsoleVariable<int32> CVarCacheSize(
 	TEXT("voxel.data.DataAccelerator.CacheSize"),
 	8,
@@ -13,6 +20,11 @@ static TAutoConsoleVariable<int32> CVarUseAcceleratorMap(
 	1,
 	TEXT("Whether to cache the leaves in a map"),
 	ECVF_Default);
+static TAutoConsoleVariable<int32> CVarMaxDenseMapSize(
+	TEXT("voxel.data.DataAccelerator.MaxDenseMapSize"),
+	32768,
+	TEXT("Max number of data chunks in the bounds of an accelerator for its map to be stored as a dense array of leaves. Bigger bounds use a hash map instead"),
+	ECVF_Default);
 static TAutoConsoleVariable<int32> CVarShowStats(
 	TEXT("voxel.data.DataAccelerator.LogStats"),
 	0,
@@ -27,6 +39,10 @@ bool FVoxelDataAcceleratorParameters::GetUseAcceleratorMap()
 {
 	return CVarUseAcceleratorMap.GetValueOnAnyThread() != 0;
 }
+int32 FVoxelDataAcceleratorParameters::GetMaxDenseMapSize()
+{
+	return CVarMaxDenseMapSize.GetValueOnAnyThread();
+}
 bool FVoxelDataAcceleratorParameters::GetShowStats()
 {
 	return CVarShowStats.GetValueOnAnyThread() != 0;
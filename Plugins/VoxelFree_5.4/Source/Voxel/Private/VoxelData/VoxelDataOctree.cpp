@@ -16,6 +16,8 @@ DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelDataOctreeDirtyMaterialsMemory);
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelDataOctreeCachedValuesMemory);
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelDataOctreeCachedMaterialsMemory);
 
+DEFINE_STAT(STAT_VoxelDataOctreePaletteValuesCount);
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -103,6 +105,28 @@ void FVoxelDataOctreeBase::GetFromGeneratorAndAssets(const FVoxelGeneratorInstan
 template VOXEL_API void FVoxelDataOctreeBase::GetFromGeneratorAndAssets<FVoxelValue   >(const FVoxelGeneratorInstance& Generator, TVoxelQueryZone<FVoxelValue   >& QueryZone, int32 LOD) const;
 template VOXEL_API void FVoxelDataOctreeBase::GetFromGeneratorAndAssets<FVoxelMaterial>(const FVoxelGeneratorInstance& Generator, TVoxelQueryZone<FVoxelMaterial>& QueryZone, int32 LOD) const;
 
+void FVoxelDataOctreeBase::GetFromGeneratorAndAssets(
+	const FVoxelGeneratorInstance& Generator,
+	TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+	TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+	int32 LOD) const
+{
+	ensureThreadSafe(IsLockedForRead());
+	check(IsLeafOrHasNoChildren());
+	check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+
+	if (ItemHolder->GetAssetItems().Num() == 0)
+	{
+		VOXEL_SLOW_SCOPE_COUNTER("Query Generator Values & Materials");
+		Generator.GetValuesAndMaterials(ValueQueryZone, MaterialQueryZone, LOD, FVoxelItemStack(*ItemHolder));
+		return;
+	}
+
+	// Assets can cover only one of the zones: let each query pick its own source
+	GetFromGeneratorAndAssets<FVoxelValue>(Generator, ValueQueryZone, LOD);
+	GetFromGeneratorAndAssets<FVoxelMaterial>(Generator, MaterialQueryZone, LOD);
+}
+
 template <typename T>
 T FVoxelDataOctreeBase::GetCustomOutput(const FVoxelGeneratorInstance& Generator, T DefaultValue, FName Name, v_flt X, v_flt Y, v_flt Z, int32 LOD) const
 {
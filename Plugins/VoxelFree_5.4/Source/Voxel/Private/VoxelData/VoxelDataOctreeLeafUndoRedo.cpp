@@ -2,6 +2,151 @@
 
 #include "VoxelData/VoxelDataOctreeLeafUndoRedo.h"
 #include "VoxelData/VoxelDataOctree.h"
+#include "VoxelData/IVoxelData.h"
+
+namespace FVoxelUndoRedoDeltas
+{
+	template<typename T>
+	FORCEINLINE T Xor(const T& A, const T& B)
+	{
+		T Result;
+		const uint8* RESTRICT const APtr = reinterpret_cast<const uint8*>(&A);
+		const uint8* RESTRICT const BPtr = reinterpret_cast<const uint8*>(&B);
+		uint8* RESTRICT const ResultPtr = reinterpret_cast<uint8*>(&Result);
+		for (int32 Index = 0; Index < sizeof(T); Index++)
+		{
+			ResultPtr[Index] = APtr[Index] ^ BPtr[Index];
+		}
+		return Result;
+	}
+
+	class FWriter
+	{
+	public:
+		explicit FWriter(TArray<uint8>& Data)
+			: Data(Data)
+		{
+		}
+
+		void WriteVarInt(uint32 Value)
+		{
+			checkVoxelSlow(NumPendingZeros == 0);
+			while (Value >= 0x80)
+			{
+				Data.Add(uint8(Value) | 0x80);
+				Value >>= 7;
+			}
+			Data.Add(uint8(Value));
+		}
+		FORCEINLINE void WriteDeltaByte(uint8 Byte)
+		{
+			if (Byte == 0)
+			{
+				NumPendingZeros++;
+				if (NumPendingZeros == 256)
+				{
+					FlushZeros();
+				}
+			}
+			else
+			{
+				FlushZeros();
+				Data.Add(Byte);
+			}
+		}
+		void FlushZeros()
+		{
+			if (NumPendingZeros > 0)
+			{
+				// A zero is followed by the number of additional zeros
+				Data.Add(0);
+				Data.Add(uint8(NumPendingZeros - 1));
+				NumPendingZeros = 0;
+			}
+		}
+
+	private:
+		TArray<uint8>& Data;
+		int32 NumPendingZeros = 0;
+	};
+
+	class FReader
+	{
+	public:
+		explicit FReader(const TArray<uint8>& Data)
+			: Data(Data)
+		{
+		}
+
+		FORCEINLINE bool IsDone() const
+		{
+			return Position == Data.Num();
+		}
+		uint32 ReadVarInt()
+		{
+			checkVoxelSlow(NumPendingZeros == 0);
+			uint32 Value = 0;
+			for (int32 Shift = 0; ; Shift += 7)
+			{
+				const uint8 Byte = Data[Position++];
+				Value |= uint32(Byte & 0x7F) << Shift;
+				if (!(Byte & 0x80))
+				{
+					return Value;
+				}
+			}
+		}
+		FORCEINLINE uint8 ReadDeltaByte()
+		{
+			if (NumPendingZeros > 0)
+			{
+				NumPendingZeros--;
+				return 0;
+			}
+			const uint8 Byte = Data[Position++];
+			if (Byte == 0)
+			{
+				NumPendingZeros = Data[Position++];
+			}
+			return Byte;
+		}
+
+	private:
+		const TArray<uint8>& Data;
+		int32 Position = 0;
+		int32 NumPendingZeros = 0;
+	};
+
+	// Lambda: (FVoxelCellIndex Index, T Delta)
+	template<typename T, typename TLambda>
+	void Iterate(const TArray<uint8>& CompressedDeltas, TLambda Lambda)
+	{
+		FReader Reader(CompressedDeltas);
+
+		FVoxelCellIndex Index = 0;
+		while (!Reader.IsDone())
+		{
+			Index += Reader.ReadVarInt();
+			const uint32 Count = Reader.ReadVarInt();
+			for (uint32 RunIndex = 0; RunIndex < Count; RunIndex++)
+			{
+				T Delta;
+				uint8* RESTRICT const DeltaPtr = reinterpret_cast<uint8*>(&Delta);
+				for (int32 ByteIndex = 0; ByteIndex < sizeof(T); ByteIndex++)
+				{
+					DeltaPtr[ByteIndex] = Reader.ReadDeltaByte();
+				}
+				checkVoxelSlow(Index < VOXELS_PER_DATA_CHUNK);
+				Lambda(Index, Delta);
+				Index++;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
 
 FVoxelDataOctreeLeafUndoRedo::FVoxelDataOctreeLeafUndoRedo(const FVoxelDataOctreeLeaf& Leaf)
 	: CurrentFrame(MakeUnique<FFrame>(Leaf))
@@ -17,16 +162,23 @@ FVoxelDataOctreeLeafUndoRedo::~FVoxelDataOctreeLeafUndoRedo()
 void FVoxelDataOctreeLeafUndoRedo::ClearFrames(const FVoxelDataOctreeLeaf& Leaf)
 {
 	CurrentFrame = MakeUnique<FFrame>(Leaf);
+	AlreadyModified.Values.Clear();
+	AlreadyModified.Materials.Clear();
+
 	UndoFramesStack.Empty();
 	RedoFramesStack.Empty();
+	HistoryAllocatedSize = 0;
 }
 
-void FVoxelDataOctreeLeafUndoRedo::SaveFrame(const FVoxelDataOctreeLeaf& Leaf, int32 HistoryPosition)
+void FVoxelDataOctreeLeafUndoRedo::SaveFrame(const IVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, int32 HistoryPosition)
 {
 	VOXEL_SLOW_FUNCTION_COUNTER();
-	
+
 	if (!CurrentFrame->IsEmpty())
 	{
+		CompressFrameDeltas<FVoxelValue>(Data, Leaf, *CurrentFrame);
+		CompressFrameDeltas<FVoxelMaterial>(Data, Leaf, *CurrentFrame);
+
 		CurrentFrame->HistoryPosition = HistoryPosition;
 		AddFrameToStack<EVoxelUndoRedo::Undo>(CurrentFrame);
 		check(!CurrentFrame);
@@ -36,28 +188,69 @@ void FVoxelDataOctreeLeafUndoRedo::SaveFrame(const FVoxelDataOctreeLeaf& Leaf, i
 		AlreadyModified.Values.Clear();
 		AlreadyModified.Materials.Clear();
 	}
-	if (RedoFramesStack.Num() > 0)
+	ClearRedoFrames();
+}
+
+void FVoxelDataOctreeLeafUndoRedo::ClearRedoFrames()
+{
+	while (RedoFramesStack.Num() > 0)
+	{
+		PopFrameFromStack<EVoxelUndoRedo::Redo>();
+	}
+	RedoFramesStack.Empty();
+}
+
+void FVoxelDataOctreeLeafUndoRedo::ClearUndoFramesUpTo(int32 HistoryPosition)
+{
+	int32 NumToRemove = 0;
+	while (NumToRemove < UndoFramesStack.Num() && UndoFramesStack[NumToRemove]->HistoryPosition <= HistoryPosition)
+	{
+		HistoryAllocatedSize -= UndoFramesStack[NumToRemove]->AllocatedSize;
+		NumToRemove++;
+	}
+	// Deltas are relative to the next frame, so the oldest frames can be removed without touching the others
+	UndoFramesStack.RemoveAt(0, NumToRemove);
+	ensureVoxelSlowNoSideEffects(HistoryAllocatedSize >= 0);
+}
+
+void FVoxelDataOctreeLeafUndoRedo::AddUndoFramesAllocatedSize(int32 MinHistoryPosition, TArray<int64>& OutFramesSizes) const
+{
+	for (auto& Frame : UndoFramesStack)
 	{
-		RedoFramesStack.Empty();
+		const int32 Index = Frame->HistoryPosition - MinHistoryPosition;
+		if (ensureVoxelSlow(OutFramesSizes.IsValidIndex(Index)))
+		{
+			OutFramesSizes[Index] += Frame->AllocatedSize;
+		}
 	}
 }
 
 template<typename T>
 void FVoxelDataOctreeLeafUndoRedo::ClearFramesOfType()
 {
-	const auto ClearFrame = [](FFrame& Frame)
+	const auto ClearFrame = [&](FFrame& Frame, bool bIsInStack)
 	{
 		FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Frame).Empty();
+		FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Frame.Deltas).Empty();
+
+		if (bIsInStack)
+		{
+			HistoryAllocatedSize -= Frame.AllocatedSize;
+			Frame.UpdateStats();
+			HistoryAllocatedSize += Frame.AllocatedSize;
+		}
 	};
-	
-	ClearFrame(*CurrentFrame);
+
+	ClearFrame(*CurrentFrame, false);
+	FVoxelUtilities::TValuesMaterialsSelector<T>::Get(AlreadyModified).Clear();
+
 	for (auto& Frame : UndoFramesStack)
 	{
-		ClearFrame(*Frame);
+		ClearFrame(*Frame, true);
 	}
 	for (auto& Frame : RedoFramesStack)
 	{
-		ClearFrame(*Frame);
+		ClearFrame(*Frame, true);
 	}
 }
 
@@ -70,9 +263,9 @@ void FVoxelDataOctreeLeafUndoRedo::UndoRedo(const IVoxelData& Data, FVoxelDataOc
 	check(CurrentFrame->IsEmpty());
 	check(CanUndoRedo<Type>(HistoryPosition));
 
-	const TUniquePtr<const FFrame> Frame = GetFramesStack<Type>().Pop(false);
+	const TUniquePtr<FFrame> Frame = PopFrameFromStack<Type>();
 	check(Frame->HistoryPosition == HistoryPosition);
-	
+
 	TUniquePtr<FFrame> NewFrame = MakeUnique<FFrame>(Leaf);
 	// If Type is Undo NewFrame is a redo frame, so + 1. Else it's an undo frame so -1
 	NewFrame->HistoryPosition = HistoryPosition + (Type == EVoxelUndoRedo::Undo ? 1 : -1);
@@ -83,16 +276,15 @@ void FVoxelDataOctreeLeafUndoRedo::UndoRedo(const IVoxelData& Data, FVoxelDataOc
 	{
 		using T = decltype(TypeInst);
 
-		const TArray<TModifiedValue<T>>& FrameData = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(*Frame);
-		TArray<TModifiedValue<T>>& NewFrameData = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(*NewFrame);
+		TArray<uint8>& FrameDeltas = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Frame->Deltas);
 		TVoxelDataOctreeLeafData<T>& DataHolder = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Leaf);
-		
-		if (FrameData.Num() == 0) return;
+
+		if (FrameDeltas.Num() == 0) return;
 
 		if (!DataHolder.HasData())
 		{
 			// Data was reverted to generator value
-			
+
 			DataHolder.CreateData(Data, [&](T* RESTRICT DataPtr)
 			{
 				TVoxelQueryZone<T> QueryZone(Leaf.GetBounds(), DataPtr);
@@ -101,25 +293,16 @@ void FVoxelDataOctreeLeafUndoRedo::UndoRedo(const IVoxelData& Data, FVoxelDataOc
 		}
 		DataHolder.PrepareForWrite(Data);
 
-		NewFrameData.SetNumUninitialized(FrameData.Num());
-
-		const TModifiedValue<T>* RESTRICT const FrameDataPtr = FrameData.GetData();
-		TModifiedValue<T>* RESTRICT const NewFrameDataPtr = NewFrameData.GetData();
-
-		checkVoxelSlow(FrameDataPtr);
-		checkVoxelSlow(NewFrameDataPtr);
-		
-		for (int32 Index = 0; Index < FrameData.Num(); Index++)
+		FVoxelUndoRedoDeltas::Iterate<T>(FrameDeltas, [&](FVoxelCellIndex Index, const T& Delta)
 		{
-			checkVoxelSlow(FrameData.IsValidIndex(Index));
-			checkVoxelSlow(NewFrameData.IsValidIndex(Index));
+			T& ValueRef = DataHolder.GetRef(Index);
+			ValueRef = FVoxelUndoRedoDeltas::Xor(ValueRef, Delta);
+		});
+		// XOR deltas can shrink the range as well as extend it
+		DataHolder.ComputeRange();
 
-			const auto ModifiedValue = FrameDataPtr[Index];
-			auto& ValueRef = DataHolder.GetRef(ModifiedValue.Index);
-			
-			NewFrameDataPtr[Index] = TModifiedValue<T>(ModifiedValue.Index, ValueRef);
-			ValueRef = ModifiedValue.Value;
-		}
+		// XOR deltas are symmetric: the same deltas revert the frame we just applied
+		FVoxelUtilities::TValuesMaterialsSelector<T>::Get(NewFrame->Deltas) = MoveTemp(FrameDeltas);
 
 		if (std::is_same_v<T, FVoxelValue>) DataHolder.SetIsDirty(Frame->bValuesDirty, Data);
 		if (std::is_same_v<T, FVoxelMaterial>) DataHolder.SetIsDirty(Frame->bMaterialsDirty, Data);
@@ -134,10 +317,35 @@ void FVoxelDataOctreeLeafUndoRedo::UndoRedo(const IVoxelData& Data, FVoxelDataOc
 template VOXEL_API void FVoxelDataOctreeLeafUndoRedo::UndoRedo<EVoxelUndoRedo::Undo>(const IVoxelData&, FVoxelDataOctreeLeaf&, int32);
 template VOXEL_API void FVoxelDataOctreeLeafUndoRedo::UndoRedo<EVoxelUndoRedo::Redo>(const IVoxelData&, FVoxelDataOctreeLeaf&, int32);
 
+template<typename T>
+void FVoxelDataOctreeLeafUndoRedo::RevertValues(int32 HistoryPosition, T* RESTRICT Values, bool* RESTRICT IsValueSet) const
+{
+	// First revert the edits that are not saved yet, as the deltas are relative to the last saved frame
+	for (const TModifiedValue<T>& ModifiedValue : FVoxelUtilities::TValuesMaterialsSelector<T>::Get(*CurrentFrame))
+	{
+		Values[ModifiedValue.Index] = ModifiedValue.Value;
+	}
+
+	for (int32 Index = UndoFramesStack.Num() - 1; Index >= 0; --Index)
+	{
+		const FFrame& Frame = *UndoFramesStack[Index];
+		if (Frame.HistoryPosition < HistoryPosition) break;
+
+		FVoxelUndoRedoDeltas::Iterate<T>(FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Frame.Deltas), [&](FVoxelCellIndex ValueIndex, const T& Delta)
+		{
+			IsValueSet[ValueIndex] = true;
+			Values[ValueIndex] = FVoxelUndoRedoDeltas::Xor(Values[ValueIndex], Delta);
+		});
+	}
+}
+
+template VOXEL_API void FVoxelDataOctreeLeafUndoRedo::RevertValues<FVoxelValue>(int32, FVoxelValue* RESTRICT, bool* RESTRICT) const;
+template VOXEL_API void FVoxelDataOctreeLeafUndoRedo::RevertValues<FVoxelMaterial>(int32, FVoxelMaterial* RESTRICT, bool* RESTRICT) const;
+
 void FVoxelDataOctreeLeafUndoRedo::FFrame::UpdateStats() const
 {
 	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelUndoRedoMemory, AllocatedSize);
-	AllocatedSize = sizeof(FFrame) + Values.GetAllocatedSize() + Materials.GetAllocatedSize();
+	AllocatedSize = sizeof(FFrame) + Values.GetAllocatedSize() + Materials.GetAllocatedSize() + Deltas.Values.GetAllocatedSize() + Deltas.Materials.GetAllocatedSize();
 	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelUndoRedoMemory, AllocatedSize);
 }
 
@@ -146,12 +354,85 @@ void FVoxelDataOctreeLeafUndoRedo::AddFrameToStack(TUniquePtr<FFrame>& Frame)
 {
 	{
 		VOXEL_SLOW_SCOPE_COUNTER("Shrink");
-		Frame->Values.Shrink();
-		Frame->Materials.Shrink();
+		Frame->Deltas.Values.Shrink();
+		Frame->Deltas.Materials.Shrink();
 	}
 
 	Frame->UpdateStats();
-	
+	HistoryAllocatedSize += Frame->AllocatedSize;
+
 	GetFramesStack<Type>().Add(MoveTemp(Frame));
 	check(!Frame);
 }
+
+template<EVoxelUndoRedo Type>
+TUniquePtr<FVoxelDataOctreeLeafUndoRedo::FFrame> FVoxelDataOctreeLeafUndoRedo::PopFrameFromStack()
+{
+	TUniquePtr<FFrame> Frame = GetFramesStack<Type>().Pop(false);
+	HistoryAllocatedSize -= Frame->AllocatedSize;
+	ensureVoxelSlowNoSideEffects(HistoryAllocatedSize >= 0);
+	return Frame;
+}
+
+template<typename T>
+void FVoxelDataOctreeLeafUndoRedo::CompressFrameDeltas(const IVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, FFrame& Frame)
+{
+	VOXEL_SLOW_FUNCTION_COUNTER();
+
+	TArray<TModifiedValue<T>>& ModifiedValues = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Frame);
+	TArray<uint8>& CompressedDeltas = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Frame.Deltas);
+	check(CompressedDeltas.Num() == 0);
+
+	if (ModifiedValues.Num() == 0)
+	{
+		return;
+	}
+
+	ModifiedValues.Sort([](const TModifiedValue<T>& A, const TModifiedValue<T>& B) { return A.Index < B.Index; });
+
+	const TVoxelDataOctreeLeafData<T>& DataHolder = Leaf.GetData<T>();
+	const FIntVector Min = Leaf.GetMin();
+	const auto GetNewValue = [&](FVoxelCellIndex Index)
+	{
+		if (DataHolder.HasData())
+		{
+			return DataHolder.Get(Index);
+		}
+		// Data was reverted to generator value
+		const FIntVector Position = Min + FVoxelDataOctreeUtilities::CoordinatesFromIndex(Index);
+		return Leaf.GetFromGeneratorAndAssets<T>(*Data.Generator, Position.X, Position.Y, Position.Z, 0);
+	};
+
+	FVoxelUndoRedoDeltas::FWriter Writer(CompressedDeltas);
+
+	int32 RunStart = 0;
+	FVoxelCellIndex PreviousRunEnd = 0;
+	while (RunStart < ModifiedValues.Num())
+	{
+		int32 RunEnd = RunStart + 1;
+		while (RunEnd < ModifiedValues.Num() && ModifiedValues[RunEnd].Index == ModifiedValues[RunEnd - 1].Index + 1)
+		{
+			RunEnd++;
+		}
+
+		Writer.WriteVarInt(ModifiedValues[RunStart].Index - PreviousRunEnd);
+		Writer.WriteVarInt(RunEnd - RunStart);
+		for (int32 Index = RunStart; Index < RunEnd; Index++)
+		{
+			const TModifiedValue<T>& ModifiedValue = ModifiedValues[Index];
+			const T Delta = FVoxelUndoRedoDeltas::Xor(ModifiedValue.Value, GetNewValue(ModifiedValue.Index));
+
+			const uint8* RESTRICT const DeltaPtr = reinterpret_cast<const uint8*>(&Delta);
+			for (int32 ByteIndex = 0; ByteIndex < sizeof(T); ByteIndex++)
+			{
+				Writer.WriteDeltaByte(DeltaPtr[ByteIndex]);
+			}
+		}
+		Writer.FlushZeros();
+
+		PreviousRunEnd = ModifiedValues[RunEnd - 1].Index + 1;
+		RunStart = RunEnd;
+	}
+
+	ModifiedValues.Empty();
+}
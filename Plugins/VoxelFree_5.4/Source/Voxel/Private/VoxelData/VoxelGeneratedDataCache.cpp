@@ -0,0 +1,259 @@
+// Copyright Voxel Plugin SAS. All Rights Reserved.
+
+#include "VoxelData/VoxelGeneratedDataCache.h"
+#include "VoxelUtilities/VoxelMiscUtilities.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelGeneratedDataCacheMemory);
+
+DEFINE_STAT(STAT_VoxelGeneratedDataCacheBlocks);
+DEFINE_STAT(STAT_VoxelGeneratedDataCacheHits);
+DEFINE_STAT(STAT_VoxelGeneratedDataCacheMisses);
+
+static TAutoConsoleVariable<int32> CVarGeneratedDataCacheSize(
+	TEXT("voxel.data.GeneratedDataCacheSize"),
+	64,
+	TEXT("Size in MB of the cache of generated values & materials of each voxel data. Used by unedited areas queried at LOD 0 (meshing, collisions, navmesh, tools). 0 to disable"),
+	ECVF_Default);
+
+FVoxelGeneratedDataCache::~FVoxelGeneratedDataCache()
+{
+	Empty();
+}
+
+bool FVoxelGeneratedDataCache::IsEnabled()
+{
+	return CVarGeneratedDataCacheSize.GetValueOnAnyThread() > 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FVoxelGeneratedDataCache::TBlockData<T> FVoxelGeneratedDataCache::Find(const FIntVector& Block)
+{
+	checkVoxelSlow(GetBlockBounds(Block).IsMultipleOf(DATA_CHUNK_SIZE));
+
+	TBlockData<T> Data;
+	{
+		FScopeLock Lock(&Section);
+		if (const int32* Index = BlockToEntry.Find(Block))
+		{
+			Data = FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Entries[*Index]);
+			if (Data.IsValid())
+			{
+				Unlink(*Index);
+				LinkAsMostRecent(*Index);
+			}
+		}
+	}
+
+	if (Data.IsValid())
+	{
+		NumHits++;
+		INC_DWORD_STAT(STAT_VoxelGeneratedDataCacheHits);
+	}
+	else
+	{
+		NumMisses++;
+		INC_DWORD_STAT(STAT_VoxelGeneratedDataCacheMisses);
+	}
+	return Data;
+}
+
+template<typename T>
+void FVoxelGeneratedDataCache::Add(const FIntVector& Block, const TBlockData<T>& Data)
+{
+	checkVoxelSlow(GetBlockBounds(Block).IsMultipleOf(DATA_CHUNK_SIZE));
+	check(Data.IsValid() && Data->Num() == VOXELS_PER_DATA_CHUNK);
+
+	const int64 MaxMemory = int64(CVarGeneratedDataCacheSize.GetValueOnAnyThread()) << 20;
+
+	FScopeLock Lock(&Section);
+
+	int32 Index;
+	if (const int32* ExistingIndex = BlockToEntry.Find(Block))
+	{
+		Index = *ExistingIndex;
+		Unlink(Index);
+	}
+	else
+	{
+		Index = Entries.Add({});
+		Entries[Index].Block = Block;
+		BlockToEntry.Add(Block, Index);
+		INC_DWORD_STAT(STAT_VoxelGeneratedDataCacheBlocks);
+	}
+
+	FEntry& Entry = Entries[Index];
+
+	const int64 OldMemory = Entry.GetMemory();
+	FVoxelUtilities::TValuesMaterialsSelector<T>::Get(Entry) = Data;
+	const int64 NewMemory = Entry.GetMemory();
+
+	TotalMemory += NewMemory - OldMemory;
+	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGeneratedDataCacheMemory, NewMemory - OldMemory);
+
+	LinkAsMostRecent(Index);
+	EvictToFit(MaxMemory);
+}
+
+template VOXEL_API FVoxelGeneratedDataCache::TBlockData<FVoxelValue   > FVoxelGeneratedDataCache::Find<FVoxelValue   >(const FIntVector&);
+template VOXEL_API FVoxelGeneratedDataCache::TBlockData<FVoxelMaterial> FVoxelGeneratedDataCache::Find<FVoxelMaterial>(const FIntVector&);
+
+template VOXEL_API void FVoxelGeneratedDataCache::Add<FVoxelValue   >(const FIntVector&, const TBlockData<FVoxelValue   >&);
+template VOXEL_API void FVoxelGeneratedDataCache::Add<FVoxelMaterial>(const FIntVector&, const TBlockData<FVoxelMaterial>&);
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelGeneratedDataCache::Invalidate(const FVoxelIntBox& Bounds)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	const FVoxelIntBox BlocksBounds = Bounds.MakeMultipleOfBigger(DATA_CHUNK_SIZE);
+
+	FScopeLock Lock(&Section);
+
+	if (BlocksBounds.Count() / VOXELS_PER_DATA_CHUNK > uint64(Entries.Num()))
+	{
+		// Cheaper to go through all the entries
+		TArray<int32> IndicesToRemove;
+		for (auto It = Entries.CreateConstIterator(); It; ++It)
+		{
+			if (BlocksBounds.Intersect(GetBlockBounds(It->Block)))
+			{
+				IndicesToRemove.Add(It.GetIndex());
+			}
+		}
+		for (const int32 Index : IndicesToRemove)
+		{
+			Remove(Index);
+		}
+	}
+	else
+	{
+		BlocksBounds.Iterate(DATA_CHUNK_SIZE, [&](int32 X, int32 Y, int32 Z)
+		{
+			if (const int32* Index = BlockToEntry.Find(FIntVector(X, Y, Z)))
+			{
+				Remove(*Index);
+			}
+		});
+	}
+}
+
+void FVoxelGeneratedDataCache::Empty()
+{
+	FScopeLock Lock(&Section);
+
+	DEC_DWORD_STAT_BY(STAT_VoxelGeneratedDataCacheBlocks, Entries.Num());
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGeneratedDataCacheMemory, TotalMemory);
+
+	Entries.Empty();
+	BlockToEntry.Empty();
+	MostRecent = -1;
+	LeastRecent = -1;
+	TotalMemory = 0;
+}
+
+FVoxelGeneratedDataCache::FStats FVoxelGeneratedDataCache::GetStats() const
+{
+	FScopeLock Lock(&Section);
+
+	FStats Stats;
+	Stats.Hits = NumHits;
+	Stats.Misses = NumMisses;
+	Stats.Memory = TotalMemory;
+	Stats.NumBlocks = Entries.Num();
+	return Stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int64 FVoxelGeneratedDataCache::FEntry::GetMemory() const
+{
+	int64 Memory = 0;
+	if (Values.IsValid())
+	{
+		Memory += Values->GetAllocatedSize();
+	}
+	if (Materials.IsValid())
+	{
+		Memory += Materials->GetAllocatedSize();
+	}
+	return Memory;
+}
+
+void FVoxelGeneratedDataCache::Unlink(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+
+	if (Entry.Previous != -1)
+	{
+		Entries[Entry.Previous].Next = Entry.Next;
+	}
+	else
+	{
+		checkVoxelSlow(MostRecent == Index);
+		MostRecent = Entry.Next;
+	}
+
+	if (Entry.Next != -1)
+	{
+		Entries[Entry.Next].Previous = Entry.Previous;
+	}
+	else
+	{
+		checkVoxelSlow(LeastRecent == Index);
+		LeastRecent = Entry.Previous;
+	}
+
+	Entry.Previous = -1;
+	Entry.Next = -1;
+}
+
+void FVoxelGeneratedDataCache::LinkAsMostRecent(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	checkVoxelSlow(Entry.Previous == -1 && Entry.Next == -1);
+
+	Entry.Next = MostRecent;
+	if (MostRecent != -1)
+	{
+		Entries[MostRecent].Previous = Index;
+	}
+	MostRecent = Index;
+
+	if (LeastRecent == -1)
+	{
+		LeastRecent = Index;
+	}
+}
+
+void FVoxelGeneratedDataCache::Remove(int32 Index)
+{
+	Unlink(Index);
+
+	const FEntry& Entry = Entries[Index];
+	const int64 Memory = Entry.GetMemory();
+	TotalMemory -= Memory;
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelGeneratedDataCacheMemory, Memory);
+	DEC_DWORD_STAT(STAT_VoxelGeneratedDataCacheBlocks);
+
+	const int32 NumRemoved = BlockToEntry.Remove(Entry.Block);
+	ensureVoxelSlow(NumRemoved == 1);
+	Entries.RemoveAt(Index);
+}
+
+void FVoxelGeneratedDataCache::EvictToFit(int64 MaxMemory)
+{
+	while (TotalMemory > MaxMemory && LeastRecent != -1)
+	{
+		Remove(LeastRecent);
+	}
+}
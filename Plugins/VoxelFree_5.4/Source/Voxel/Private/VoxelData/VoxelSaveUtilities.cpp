@@ -37,8 +37,8 @@ void FVoxelSaveBuilder::Save(FVoxelUncompressedWorldSaveImpl& OutSave, TArray<FV
 		{
 			if (Chunk.Values->IsDirty())
 			{
-				NumValueBuffers += Chunk.Values->DataPtr != nullptr;
-				NumSingleValues += Chunk.Values->DataPtr == nullptr;
+				NumValueBuffers += !Chunk.Values->bIsSingleValue;
+				NumSingleValues += Chunk.Values->bIsSingleValue;
 			}
 
 			if (Chunk.Materials->IsDirty())
@@ -74,10 +74,11 @@ void FVoxelSaveBuilder::Save(FVoxelUncompressedWorldSaveImpl& OutSave, TArray<FV
 		
 		if (Chunk.Values->IsDirty())
 		{
-			if (Chunk.Values->DataPtr)
+			if (!Chunk.Values->bIsSingleValue)
 			{
+				// Palette compressed chunks are saved uncompressed
 				NewChunk.ValuesIndex = OutSave.ValueBuffers.AddUninitialized(VOXELS_PER_DATA_CHUNK);
-				FMemory::Memcpy(&OutSave.ValueBuffers[NewChunk.ValuesIndex], Chunk.Values->DataPtr, sizeof(FVoxelValue) * VOXELS_PER_DATA_CHUNK);
+				Chunk.Values->CopyTo(&OutSave.ValueBuffers[NewChunk.ValuesIndex]);
 			}
 			else
 			{
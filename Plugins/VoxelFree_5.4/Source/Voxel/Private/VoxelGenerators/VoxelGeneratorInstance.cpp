@@ -0,0 +1,31 @@
+// Copyright Voxel Plugin SAS. All Rights Reserved.
+
+#include "VoxelGenerators/VoxelGeneratorInstance.h"
+#include "VoxelQueryZone.h"
+
+void FVoxelGeneratorInstance::GetValuesAndMaterials(
+	TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+	TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+	int32 LOD,
+	const FVoxelItemStack& Items) const
+{
+	check(ValueQueryZone.Step == MaterialQueryZone.Step);
+	check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+	
+	GetValues(ValueQueryZone, LOD, Items);
+	GetMaterials(MaterialQueryZone, LOD, Items);
+}
+
+void FVoxelTransformableGeneratorInstance::GetValuesAndMaterials_Transform(
+	const FTransform& LocalToWorld,
+	TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+	TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+	int32 LOD,
+	const FVoxelItemStack& Items) const
+{
+	check(ValueQueryZone.Step == MaterialQueryZone.Step);
+	check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+	
+	GetValues_Transform(LocalToWorld, ValueQueryZone, LOD, Items);
+	GetMaterials_Transform(LocalToWorld, MaterialQueryZone, LOD, Items);
+}
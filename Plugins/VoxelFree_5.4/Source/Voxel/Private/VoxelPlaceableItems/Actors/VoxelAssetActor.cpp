@@ -51,6 +51,8 @@ void AVoxelAssetActor::AddItemToWorld(AVoxelWorld* World)
 		return;
 	}
 
+	// AddItem is applied immediately: apply the queued edits first to keep edits in order
+	World->FlushEditBatch();
 	AddItemToData(World, &World->GetData());
 }
 
@@ -37,6 +37,9 @@ void UVoxelPlaceableItemActorHelper::AddActor(AVoxelDataItemActor& Actor)
 
 	FActorData& ActorData = ActorsData.FindOrAdd(&Actor);
 
+	// Items are added immediately: apply the queued edits first to keep edits in order
+	VoxelWorld.FlushEditBatch();
+
 	PlaceableItemManager.Clear();
 	Actor.CallAddItemToWorld(&VoxelWorld);
 
@@ -69,6 +72,8 @@ void UVoxelPlaceableItemActorHelper::OnActorUpdated(TWeakObjectPtr<AVoxelDataIte
 	if (!ensure(VoxelWorld.PlaceableItemManager)) return;
 	UVoxelPlaceableItemManager& PlaceableItemManager = *VoxelWorld.PlaceableItemManager;
 
+	// Items are added & removed immediately: apply the queued edits first to keep edits in order
+	VoxelWorld.FlushEditBatch();
 	FVoxelData& Data = VoxelWorld.GetData();
 
 	TArray<FVoxelIntBox> BoundsToUpdate;
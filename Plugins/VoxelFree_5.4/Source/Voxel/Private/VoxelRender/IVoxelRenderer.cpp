@@ -12,6 +12,7 @@
 #include "VoxelUtilities/VoxelMaterialUtilities.h"
 
 #include "Logging/MessageLog.h"
+#include "Misc/App.h"
 
 FVoxelRendererSettingsBase::FVoxelRendererSettingsBase(
 	const AVoxelWorld* InWorld,
@@ -43,6 +44,7 @@ FVoxelRendererSettingsBase::FVoxelRendererSettingsBase(
 	, CollisionTraceFlag(InWorld->CollisionTraceFlag)
 	, NumConvexHullsPerAxis(InWorld->NumConvexHullsPerAxis)
 	, bCleanCollisionMeshes(InWorld->bCleanCollisionMeshes)
+	, CollisionSimplificationTolerance(FMath::Max(0.f, InWorld->CollisionSimplificationTolerance))
 
 	, RenderType(InWorld->RenderType)
 	, RenderSharpness(FMath::Max(0, InWorld->RenderSharpness))
@@ -54,12 +56,14 @@ FVoxelRendererSettingsBase::FVoxelRendererSettingsBase(
 
 	, bOptimizeIndices(InWorld->bOptimizeIndices)
 
-	, MaxDistanceFieldLOD(InWorld->bGenerateDistanceFields ? InWorld->MaxDistanceFieldLOD : -1)
+	// Merged chunks can't hold a distance field, and they are only used for rendering: don't build them when they would be thrown away
+	, MaxDistanceFieldLOD(InWorld->bGenerateDistanceFields && !InWorld->bMergeChunks && FApp::CanEverRender() ? InWorld->MaxDistanceFieldLOD : -1)
 	, DistanceFieldBoundsExtension(InWorld->DistanceFieldBoundsExtension)
 	, DistanceFieldResolutionDivisor(InWorld->DistanceFieldResolutionDivisor)
 	, DistanceFieldSelfShadowBias(InWorld->DistanceFieldSelfShadowBias)
 
 	, bOneMaterialPerCubeSide(InWorld->MaterialConfig == EVoxelMaterialConfig::SingleIndex && InWorld->bOneMaterialPerCubeSide)
+	, bGreedyCubicMeshing(InWorld->bGreedyCubicMeshing)
 	, bHalfPrecisionCoordinates(InWorld->bHalfPrecisionCoordinates)
 	, bInterpolateColors(InWorld->bInterpolateColors)
 	, bInterpolateUVs(InWorld->bInterpolateUVs)
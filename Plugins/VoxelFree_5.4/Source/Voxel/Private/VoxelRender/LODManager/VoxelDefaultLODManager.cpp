@@ -7,6 +7,7 @@
 #include "IVoxelPool.h"
 #include "VoxelWorldInterface.h"
 #include "VoxelComponents/VoxelInvokerComponent.h"
+#include "Algo/BinarySearch.h"
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("Voxel Chunk Updates"), STAT_VoxelChunkUpdates, STATGROUP_VoxelCounters);
 
@@ -16,6 +17,12 @@ static TAutoConsoleVariable<int32> CVarFreezeLODs(
 	TEXT("Stops LOD manager tick"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarCullEmptyChunks(
+	TEXT("voxel.lod.CullEmptyChunks"),
+	1,
+	TEXT("If true, the render octree will use the data range analysis to not subdivide chunks with no surface in them. Edits will trigger a LOD update"),
+	ECVF_Default);
+
 TVoxelSharedRef<FVoxelDefaultLODManager> FVoxelDefaultLODManager::Create(
 	const FVoxelLODSettings& LODSettings,
 	TWeakObjectPtr<const AVoxelWorldInterface> VoxelWorldInterface,
@@ -28,6 +35,7 @@ TVoxelSharedRef<FVoxelDefaultLODManager> FVoxelDefaultLODManager::Create(
 			DynamicSettings));
 
 	UVoxelInvokerComponentBase::OnForceRefreshInvokers.AddThreadSafeSP(Result, &FVoxelDefaultLODManager::ClearInvokerComponents);
+	UVoxelInvokerComponentBase::OnInvokerChanged.AddThreadSafeSP(Result, &FVoxelDefaultLODManager::OnInvokerChanged);
 	return Result;
 }
 
@@ -72,6 +80,13 @@ int32 FVoxelDefaultLODManager::UpdateBounds(const FVoxelIntBox& Bounds, const FV
 		return 0;
 	}
 
+	if (bCullEmptyChunks)
+	{
+		// Edits might have added a surface in a chunk that wasn't subdivided
+		bLODUpdateQueued = true;
+		AddEditedBounds(Bounds);
+	}
+
 	TArray<uint64> ChunksToUpdate;
 	Octree->GetChunksToUpdateForBounds(GetBoundsToUpdate(Bounds), ChunksToUpdate, OnChunkUpdate);
 	return Settings.Renderer->UpdateChunks(Bounds, ChunksToUpdate, FinishDelegate);
@@ -87,6 +102,16 @@ int32 FVoxelDefaultLODManager::UpdateBounds(const TArray<FVoxelIntBox>& Bounds,
 		return 0;
 	}
 
+	if (bCullEmptyChunks)
+	{
+		// Edits might have added a surface in a chunk that wasn't subdivided
+		bLODUpdateQueued = true;
+		for (auto& BoundsToUpdate : Bounds)
+		{
+			AddEditedBounds(BoundsToUpdate);
+		}
+	}
+
 	TArray<uint64> ChunksToUpdate;
 	FVoxelIntBox GlobalBounds = Bounds[0];
 	for (auto& BoundsToUpdate : Bounds)
@@ -196,67 +221,76 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 	}
 
 	ensure(SortedInvokerComponents.Num() == InvokerComponentsInfos.Num());
-	
-	bool bNeedUpdate = false;
-	
-	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> NewSortedInvokerComponents = UVoxelInvokerComponentBase::GetInvokers(Settings.World.Get());
-	NewSortedInvokerComponents.Sort([](auto& A, auto& B) { return A.Get() < B.Get(); });
-	
-	if (SortedInvokerComponents != NewSortedInvokerComponents)
+
+	const FTransform VoxelWorldTransform = VoxelWorldInterface->GetActorTransform();
+	if (!VoxelWorldTransform.Equals(LastVoxelWorldTransform, 0.f))
 	{
-		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Components Array changed"));
-		bNeedUpdate = true;
+		// The voxel positions of all the invokers changed
+		LastVoxelWorldTransform = VoxelWorldTransform;
+		bRefreshAllInvokers = true;
 	}
 
-	TMap<TWeakObjectPtr<UVoxelInvokerComponentBase>, FVoxelInvokerInfo> NewInvokerComponentsInfos;
-	NewInvokerComponentsInfos.Reserve(NewSortedInvokerComponents.Num());
-	
-	const uint64 SquaredDistanceThreshold = FMath::Square(FMath::Max(DynamicSettings->InvokerDistanceThreshold / Settings.VoxelSize, 0.f)); // Truncate
-	for (const auto& InvokerComponent : NewSortedInvokerComponents)
+	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> InvokerComponentsToUpdate;
+	if (bRefreshAllInvokers)
 	{
-		FVoxelInvokerSettings InvokerSettings = InvokerComponent->GetInvokerSettings(VoxelWorldInterface.Get());
-		InvokerSettings.bUseForLOD &= InvokerComponent->IsLocalInvoker();
+		bRefreshAllInvokers = false;
+		ChangedInvokerComponents.Empty();
 
-		const FIntVector InvokerPosition = InvokerComponent->GetInvokerVoxelPosition(VoxelWorldInterface.Get());
-		
-		FVoxelInvokerInfo Info;
-		Info.LocalPosition = InvokerPosition;
-		Info.Settings = InvokerSettings;
+		InvokerComponentsToUpdate = SortedInvokerComponents;
+		InvokerComponentsToUpdate.Append(UVoxelInvokerComponentBase::GetInvokers(Settings.World.Get()));
+	}
+	else
+	{
+		TWeakObjectPtr<UVoxelInvokerComponentBase> InvokerComponent;
+		while (ChangedInvokerComponents.Dequeue(InvokerComponent))
+		{
+			InvokerComponentsToUpdate.Add(InvokerComponent);
+		}
+		InvokerComponentsToUpdate.Append(PolledInvokerComponents);
+	}
+
+	bool bNeedUpdate = false;
 
-		NewInvokerComponentsInfos.Add(InvokerComponent, Info);
+	if (InvokerComponentsToUpdate.Num() > 0)
+	{
+		VOXEL_SCOPE_COUNTER("Update invokers");
 
-		if (!bNeedUpdate)
+		if (InvokerComponentsToUpdate.ContainsByPredicate([](auto& X) { return !X.IsValid(); }))
 		{
-			auto* ExistingInfo = InvokerComponentsInfos.Find(InvokerComponent);
-			if (ensure(ExistingInfo)) // Should be valid if bNeedUpdate is false (would be set to true if invoker components array changed)
+			// Destroyed invokers: the sorted set needs to be cleaned up before searching it
+			const int32 NumRemoved = SortedInvokerComponents.RemoveAll([](auto& X) { return !X.IsValid(); });
+			if (NumRemoved > 0)
 			{
-				const auto& OldSettings = ExistingInfo->Settings;
-				const auto& NewSettings = Info.Settings;
-				if (OldSettings.bUseForLOD != NewSettings.bUseForLOD)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForLOD changed"));
-					bNeedUpdate = true;
-				}
-				else if (OldSettings.LODToSet != NewSettings.LODToSet)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: LODToSet changed"));
-					bNeedUpdate = true;
-				}
-				else if (OldSettings.bUseForCollisions != NewSettings.bUseForCollisions)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForCollisions changed"));
-					bNeedUpdate = true;
-				}
-				else if (OldSettings.bUseForNavmesh != NewSettings.bUseForNavmesh)
-				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForNavmesh changed"));
-					bNeedUpdate = true;
-				}
-				else if (FVoxelUtilities::SquaredSize(ExistingInfo->LocalPosition - Info.LocalPosition) > SquaredDistanceThreshold)
+				LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component destroyed"));
+				bNeedUpdate = true;
+
+				for (auto It = InvokerComponentsInfos.CreateIterator(); It; ++It)
 				{
-					LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component moved"));
-					bNeedUpdate = true;
+					if (!It.Key().IsValid())
+					{
+						It.RemoveCurrent();
+					}
 				}
+				PolledInvokerComponents.RemoveAllSwap([](auto& X) { return !X.IsValid(); });
+			}
+		}
+
+		InvokerComponentsToUpdate.Sort([](auto& A, auto& B) { return A.Get() < B.Get(); });
+
+		const uint64 SquaredDistanceThreshold = FMath::Square(FMath::Max(DynamicSettings->InvokerDistanceThreshold / Settings.VoxelSize, 0.f)); // Truncate
+		const UVoxelInvokerComponentBase* PreviousInvokerComponent = nullptr;
+		for (const auto& InvokerComponent : InvokerComponentsToUpdate)
+		{
+			// Invokers are usually queued many times
+			if (!InvokerComponent.IsValid() || InvokerComponent.Get() == PreviousInvokerComponent)
+			{
+				continue;
+			}
+			PreviousInvokerComponent = InvokerComponent.Get();
+
+			if (InvokerComponent->GetWorld() == Settings.World.Get())
+			{
+				bNeedUpdate |= UpdateInvoker(*InvokerComponent, SquaredDistanceThreshold);
 			}
 		}
 	}
@@ -268,9 +302,6 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 			bLODUpdateQueued = true;
 		}
 
-		SortedInvokerComponents = MoveTemp(NewSortedInvokerComponents);
-		InvokerComponentsInfos = MoveTemp(NewInvokerComponentsInfos);
-
 		TArray<FIntVector> InvokersPositionsForPriorities;
 		for (auto& It : InvokerComponentsInfos)
 		{
@@ -293,6 +324,102 @@ void FVoxelDefaultLODManager::UpdateInvokers()
 	}
 }
 
+bool FVoxelDefaultLODManager::UpdateInvoker(UVoxelInvokerComponentBase& InvokerComponent, uint64 SquaredDistanceThreshold)
+{
+	const int32 Index = Algo::LowerBound(SortedInvokerComponents, &InvokerComponent, [](const TWeakObjectPtr<UVoxelInvokerComponentBase>& A, const UVoxelInvokerComponentBase* B) { return A.Get() < B; });
+	const bool bIsInSet = SortedInvokerComponents.IsValidIndex(Index) && SortedInvokerComponents[Index].Get() == &InvokerComponent;
+
+	if (!InvokerComponent.IsInvokerEnabled())
+	{
+		if (!bIsInSet)
+		{
+			return false;
+		}
+
+		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component disabled"));
+		InvokerComponentsInfos.Remove(SortedInvokerComponents[Index]);
+		PolledInvokerComponents.RemoveSwap(SortedInvokerComponents[Index]);
+		SortedInvokerComponents.RemoveAt(Index);
+		return true;
+	}
+
+	if (InvokerComponent.NeedsPolling())
+	{
+		PolledInvokerComponents.AddUnique(&InvokerComponent);
+	}
+	else
+	{
+		PolledInvokerComponents.RemoveSwap(&InvokerComponent);
+	}
+
+	FVoxelInvokerSettings InvokerSettings = InvokerComponent.GetInvokerSettings(VoxelWorldInterface.Get());
+	InvokerSettings.bUseForLOD &= InvokerComponent.IsLocalInvoker();
+
+	// Render octree chunks are aligned on RENDER_CHUNK_SIZE: snapping the bounds doesn't change which chunks they intersect,
+	// but makes them only change when crossing a chunk boundary
+	InvokerSettings.LODBounds = InvokerSettings.LODBounds.MakeMultipleOfBigger(RENDER_CHUNK_SIZE);
+	InvokerSettings.CollisionsBounds = InvokerSettings.CollisionsBounds.MakeMultipleOfBigger(RENDER_CHUNK_SIZE);
+	InvokerSettings.NavmeshBounds = InvokerSettings.NavmeshBounds.MakeMultipleOfBigger(RENDER_CHUNK_SIZE);
+
+	FVoxelInvokerInfo Info;
+	Info.LocalPosition = InvokerComponent.GetInvokerVoxelPosition(VoxelWorldInterface.Get());
+	Info.Settings = InvokerSettings;
+
+	if (!bIsInSet)
+	{
+		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component enabled"));
+		SortedInvokerComponents.Insert(&InvokerComponent, Index);
+		InvokerComponentsInfos.Add(&InvokerComponent, Info);
+		return true;
+	}
+
+	FVoxelInvokerInfo& ExistingInfo = InvokerComponentsInfos.FindChecked(&InvokerComponent);
+	const auto& OldSettings = ExistingInfo.Settings;
+	const auto& NewSettings = Info.Settings;
+
+	bool bNeedUpdate = false;
+	if (OldSettings.bUseForLOD != NewSettings.bUseForLOD)
+	{
+		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForLOD changed"));
+		bNeedUpdate = true;
+	}
+	else if (OldSettings.LODToSet != NewSettings.LODToSet)
+	{
+		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: LODToSet changed"));
+		bNeedUpdate = true;
+	}
+	else if (OldSettings.bUseForCollisions != NewSettings.bUseForCollisions)
+	{
+		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForCollisions changed"));
+		bNeedUpdate = true;
+	}
+	else if (OldSettings.bUseForNavmesh != NewSettings.bUseForNavmesh)
+	{
+		LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: bUseForNavmesh changed"));
+		bNeedUpdate = true;
+	}
+	else if (
+		OldSettings.LODBounds != NewSettings.LODBounds ||
+		OldSettings.CollisionsBounds != NewSettings.CollisionsBounds ||
+		OldSettings.NavmeshBounds != NewSettings.NavmeshBounds)
+	{
+		// Hysteresis: the invoker must also have moved far enough since the last update, unless its ranges changed
+		if (ExistingInfo.LocalPosition == Info.LocalPosition ||
+			FVoxelUtilities::SquaredSize(ExistingInfo.LocalPosition - Info.LocalPosition) > SquaredDistanceThreshold)
+		{
+			LOG_VOXEL(Verbose, TEXT("Tiggering LOD Update: Invoker Component crossed a chunk boundary"));
+			bNeedUpdate = true;
+		}
+	}
+
+	// Keep the info of the last update so that small movements add up
+	if (bNeedUpdate)
+	{
+		ExistingInfo = Info;
+	}
+	return bNeedUpdate;
+}
+
 void FVoxelDefaultLODManager::UpdateLODs()
 {
 	VOXEL_FUNCTION_COUNTER();
@@ -329,13 +456,43 @@ void FVoxelDefaultLODManager::UpdateLODs()
 	OctreeSettings.bComputeVisibleChunksNavmesh = DynamicSettings->bComputeVisibleChunksNavmesh;
 	OctreeSettings.VisibleChunksNavmeshMaxLOD = DynamicSettings->VisibleChunksNavmeshMaxLOD;
 
+	bCullEmptyChunks = CVarCullEmptyChunks.GetValueOnGameThread() != 0;
+	if (bCullEmptyChunks)
+	{
+		OctreeSettings.Data = Settings.Renderer->Settings.Data;
+		OctreeSettings.EditedBounds = MoveTemp(EditedBounds);
+	}
+	EditedBounds.Reset();
+
 	Task->Init(OctreeSettings, Octree);
 	Settings.Pool->QueueTask(EVoxelTaskType::RenderOctree, Task.Get());
 	bAsyncTaskWorking = true;
 }
 
+void FVoxelDefaultLODManager::AddEditedBounds(const FVoxelIntBox& Bounds)
+{
+	// Merge the bounds past a few edits: the render octree tests every chunk it re-evaluates against them
+	constexpr int32 MaxEditedBounds = 64;
+
+	if (EditedBounds.Num() < MaxEditedBounds)
+	{
+		EditedBounds.Add(Bounds);
+	}
+	else
+	{
+		EditedBounds.Last() = EditedBounds.Last() + Bounds;
+	}
+}
+
 void FVoxelDefaultLODManager::ClearInvokerComponents()
 {
 	SortedInvokerComponents.Reset();
 	InvokerComponentsInfos.Reset();
+	PolledInvokerComponents.Reset();
+	bRefreshAllInvokers = true;
+}
+
+void FVoxelDefaultLODManager::OnInvokerChanged(UVoxelInvokerComponentBase* InvokerComponent)
+{
+	ChangedInvokerComponents.Enqueue(InvokerComponent);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "VoxelInvokerSettings.h"
 #include "VoxelMinimal.h"
 #include "VoxelAsyncWork.h"
+#include "Containers/Queue.h"
 
 class FVoxelRenderOctreeAsyncBuilder;
 class FVoxelRenderOctree;
@@ -77,16 +78,33 @@ private:
 		FIntVector LocalPosition{ForceInit};
 		FVoxelInvokerSettings Settings;
 	};
+	// Info of the enabled invokers of the world, as of the last LOD update they triggered
 	TMap<TWeakObjectPtr<UVoxelInvokerComponentBase>, FVoxelInvokerInfo> InvokerComponentsInfos;
+	// Persistent set of the enabled invokers of the world, sorted by pointer
 	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> SortedInvokerComponents;
+	// Invokers that can change without notifying it, checked on every invokers update
+	TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>> PolledInvokerComponents;
+	// Filled by UVoxelInvokerComponentBase::OnInvokerChanged
+	TQueue<TWeakObjectPtr<UVoxelInvokerComponentBase>, EQueueMode::Mpsc> ChangedInvokerComponents;
+	// If true, all the invokers of the world are checked on the next invokers update
+	bool bRefreshAllInvokers = true;
+	FTransform LastVoxelWorldTransform;
 
 	bool bAsyncTaskWorking = false;
 	bool bLODUpdateQueued = true;
+	// Whether the current octree was built with voxel.lod.CullEmptyChunks
+	bool bCullEmptyChunks = false;
+	// Bounds edited since the last LOD update, if bCullEmptyChunks
+	TArray<FVoxelIntBox> EditedBounds;
 	double LastLODUpdateTime = 0;
 	double LastInvokersUpdateTime = 0;
 
 	void UpdateInvokers();
+	// Returns true if a LOD update is needed
+	bool UpdateInvoker(UVoxelInvokerComponentBase& InvokerComponent, uint64 SquaredDistanceThreshold);
 	void UpdateLODs();
+	void AddEditedBounds(const FVoxelIntBox& Bounds);
 
 	void ClearInvokerComponents();
+	void OnInvokerChanged(UVoxelInvokerComponentBase* InvokerComponent);
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 // Copyright Voxel Plugin SAS. All Rights Reserved.
 
 #include "VoxelRenderOctree.h"
+#include "VoxelData/VoxelDataIncludes.h"
 #include "VoxelDebug/VoxelDebugManager.h"
 #include "VoxelMessages.h"
 #include "Async/Async.h"
@@ -20,6 +21,49 @@ static TAutoConsoleVariable<int32> CVarLogRenderOctreeBuildTime(
 	TEXT("If true, will log the render octree build times"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarIncrementalRenderOctreeUpdates(
+	TEXT("voxel.renderer.IncrementalRenderOctreeUpdates"),
+	1,
+	TEXT("If true, render octree builds will only recompute the subdivision by distance of the chunks affected by invoker changes or edits. "
+		"Each build still walks the whole octree to clone it, to reuse or recompute the subdivisions by neighbors and by collision/navmesh invokers, and to compute the chunk updates: "
+		"the cost of a build stays linear in the number of chunks"),
+	ECVF_Default);
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Data queries of the subdivision by distance. Only done for chunks with no cached surface state
+// Each query only locks its own bounds, and only for the duration of the query: the build is async, and holding a lock
+// across the whole pass would stall any edit until the build is done
+class FVoxelRenderOctreeSurfaceQuery
+{
+public:
+	const TVoxelSharedPtr<const FVoxelData> Data;
+	int32 NumQueries = 0;
+
+	explicit FVoxelRenderOctreeSurfaceQuery(const TVoxelSharedPtr<const FVoxelData>& Data)
+		: Data(Data)
+	{
+	}
+
+	bool IsEmpty(const FVoxelIntBox& Bounds)
+	{
+		check(Data.IsValid());
+
+		if (!Bounds.Intersect(Data->WorldBounds))
+		{
+			return true;
+		}
+
+		const FVoxelIntBox LockedBounds = Bounds.Overlap(Data->WorldBounds);
+		FVoxelReadScopeLock Lock(*Data, LockedBounds, "Render Octree");
+
+		NumQueries++;
+		return Data->IsEmpty(LockedBounds, 0);
+	}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -93,23 +137,35 @@ void FVoxelRenderOctreeAsyncBuilder::DoWork()
 	}
 	
 	{
+		// The game thread keeps using the old octree while we build the new one: the whole tree has to be copied
 		VOXEL_ASYNC_SCOPE_COUNTER("Cloning octree");
 		NewOctree = OldOctree.IsValid() ? MakeVoxelShared<FVoxelRenderOctree>(&*OldOctree) : MakeVoxelShared<FVoxelRenderOctree>(OctreeDepth);
 		LOG_TIME("Cloning octree");
 	}
-	
+
+	FVoxelRenderOctreeDirtyRegion DirtyRegion;
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("ResetDivisionType");
-		NewOctree->ResetDivisionType();
-		LOG_TIME("ResetDivisionType");
+		VOXEL_ASYNC_SCOPE_COUNTER("ComputeDirtyRegion");
+		DirtyRegion = ComputeDirtyRegion();
+		LOG_TIME("ComputeDirtyRegion");
+		Log += "; Dirty: " + (DirtyRegion.bEverything ? FString("everything") : FString::Printf(TEXT("%d invokers bounds, %d edited bounds"), DirtyRegion.InvokersBounds.Num(), DirtyRegion.EditedBounds.Num()));
+	}
+
+	if (OctreeSettings.Data.IsValid())
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("InvalidateSurfaceStates");
+		NewOctree->InvalidateSurfaceStates(DirtyRegion);
+		LOG_TIME("InvalidateSurfaceStates");
 	}
 
 	bool bChanged;
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("UpdateSubdividedByDistance");
-		bChanged = NewOctree->UpdateSubdividedByDistance(OctreeSettings);
+		FVoxelRenderOctreeSurfaceQuery SurfaceQuery(OctreeSettings.Data);
+		bChanged = NewOctree->UpdateSubdividedByDistance(OctreeSettings, DirtyRegion, SurfaceQuery);
 		LOG_TIME("UpdateSubdividedByDistance");
 		Log += "; Need to recompute neighbors: " + FString(bChanged ? "true" : "false");
+		Log += "; Surface queries: " + FString::FromInt(SurfaceQuery.NumQueries);
 	}
 
 	if (bChanged)
@@ -132,12 +188,6 @@ void FVoxelRenderOctreeAsyncBuilder::DoWork()
 		LOG_TIME("UpdateSubdividedByOthers");
 	}
 	
-	{
-		VOXEL_ASYNC_SCOPE_COUNTER("DeleteChunks");
-		NewOctree->DeleteChunks(ChunkUpdates);
-		LOG_TIME("DeleteChunks");
-	}
-	
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("GetUpdates");
 		NewOctree->GetUpdates(NewOctree->UpdateIndex + 1, bChanged, OctreeSettings, ChunkUpdates);
@@ -176,6 +226,12 @@ void FVoxelRenderOctreeAsyncBuilder::DoWork()
 	if (bTooManyChunks)
 	{
 		NewOctree.Reset();
+		LastBuiltOctree.Reset();
+	}
+	else
+	{
+		LastBuiltOctree = NewOctree;
+		LastBuiltOctreeSettings = OctreeSettings;
 	}
 
 	LOG_TIME_IMPL("Total time working", WorkStartTime);
@@ -186,6 +242,85 @@ uint32 FVoxelRenderOctreeAsyncBuilder::GetPriority() const
 	return 0;
 }
 
+FVoxelRenderOctreeDirtyRegion FVoxelRenderOctreeAsyncBuilder::ComputeDirtyRegion() const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	FVoxelRenderOctreeDirtyRegion DirtyRegion;
+
+	if (!CVarIncrementalRenderOctreeUpdates.GetValueOnAnyThread() || 
+		!OldOctree.IsValid() ||
+		LastBuiltOctree.Pin() != OldOctree)
+	{
+		return DirtyRegion;
+	}
+
+	const FVoxelRenderOctreeSettings& Old = LastBuiltOctreeSettings;
+	const FVoxelRenderOctreeSettings& New = OctreeSettings;
+	if (Old.Data != New.Data)
+	{
+		return DirtyRegion;
+	}
+
+	// The edits since the last build are all in New.EditedBounds: the other cached surface states are still valid
+	DirtyRegion.bAllSurfaceStates = false;
+	if (New.Data.IsValid())
+	{
+		DirtyRegion.EditedBounds = New.EditedBounds;
+	}
+
+	if (Old.MinLOD != New.MinLOD ||
+		Old.MaxLOD != New.MaxLOD ||
+		Old.WorldBounds != New.WorldBounds ||
+		Old.bEnableRender != New.bEnableRender)
+	{
+		return DirtyRegion;
+	}
+
+	DirtyRegion.bEverything = false;
+
+	const auto GetLODInvokers = [](const TArray<FVoxelInvokerSettings>& Invokers)
+	{
+		TArray<FVoxelInvokerSettings> Result;
+		for (auto& Invoker : Invokers)
+		{
+			if (Invoker.bUseForLOD)
+			{
+				Result.Add(Invoker);
+			}
+		}
+		return Result;
+	};
+	const auto IsSameLOD = [](const FVoxelInvokerSettings& A, const FVoxelInvokerSettings& B)
+	{
+		return A.LODToSet == B.LODToSet && A.LODBounds == B.LODBounds;
+	};
+
+	// Invokers are not sorted: match the unchanged ones, everything left either moved, appeared or disappeared
+	TArray<FVoxelInvokerSettings> OldInvokers = GetLODInvokers(Old.Invokers);
+	TArray<FVoxelInvokerSettings> NewInvokers = GetLODInvokers(New.Invokers);
+	for (int32 NewIndex = 0; NewIndex < NewInvokers.Num(); NewIndex++)
+	{
+		const int32 OldIndex = OldInvokers.IndexOfByPredicate([&](const FVoxelInvokerSettings& Invoker) { return IsSameLOD(Invoker, NewInvokers[NewIndex]); });
+		if (OldIndex != INDEX_NONE)
+		{
+			OldInvokers.RemoveAtSwap(OldIndex, 1, false);
+			NewInvokers.RemoveAtSwap(NewIndex, 1, false);
+			NewIndex--;
+		}
+	}
+	for (auto& Invoker : OldInvokers)
+	{
+		DirtyRegion.InvokersBounds.Add(Invoker.LODBounds);
+	}
+	for (auto& Invoker : NewInvokers)
+	{
+		DirtyRegion.InvokersBounds.Add(Invoker.LODBounds);
+	}
+
+	return DirtyRegion;
+}
+
 #undef LOG_TIME
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -221,6 +356,8 @@ FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree* Source)
 	check(ChunkId <= Root->RootIdCounter);
 	Root->CurrentChunksCount++;
 	ChunkSettings = Source->ChunkSettings;
+	ChunkSettings.OldDivisionType = ChunkSettings.DivisionType;
+	ChunkSettings.DivisionType = EDivisionType::Uninitialized;
 	if (Source->HasChildren())
 	{
 		CreateChildren(Source->GetChildren());
@@ -257,6 +394,8 @@ FVoxelRenderOctree::FVoxelRenderOctree(const FVoxelRenderOctree& Parent, uint8 C
 
 	auto& Source = SourceChildren[ChildIndex];
 	ChunkSettings = Source.ChunkSettings;
+	ChunkSettings.OldDivisionType = ChunkSettings.DivisionType;
+	ChunkSettings.DivisionType = EDivisionType::Uninitialized;
 	if (Source.HasChildren())
 	{
 		CreateChildren(Source.GetChildren());
@@ -275,25 +414,47 @@ FVoxelRenderOctree::~FVoxelRenderOctree()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void FVoxelRenderOctree::ResetDivisionType()
+void FVoxelRenderOctree::InvalidateSurfaceStates(const FVoxelRenderOctreeDirtyRegion& DirtyRegion)
 {
-	ChunkSettings.OldDivisionType = ChunkSettings.DivisionType;
-	ChunkSettings.DivisionType = EDivisionType::Uninitialized;
+	if (!DirtyRegion.bAllSurfaceStates)
+	{
+		// Same bounds as MightHaveSurface. The bounds of the children are inside ours, no need to look further if we aren't touched
+		const FVoxelIntBox SurfaceBounds = OctreeBounds.Extend(2 << Height);
+		if (!DirtyRegion.EditedBounds.ContainsByPredicate([&](const FVoxelIntBox& Bounds) { return SurfaceBounds.Intersect(Bounds); }))
+		{
+			return;
+		}
+	}
 
-	if (!!HasChildren())
+	ChunkSettings.SurfaceState = ESurfaceState::Unknown;
+
+	if (HasChildren())
 	{
 		for (auto& Child : GetChildren())
 		{
-			Child.ResetDivisionType();
+			Child.InvalidateSurfaceStates(DirtyRegion);
 		}
 	}
 }
 
-bool FVoxelRenderOctree::UpdateSubdividedByDistance(const FVoxelRenderOctreeSettings& Settings)
+bool FVoxelRenderOctree::UpdateSubdividedByDistance(
+	const FVoxelRenderOctreeSettings& Settings,
+	const FVoxelRenderOctreeDirtyRegion& DirtyRegion,
+	FVoxelRenderOctreeSurfaceQuery& SurfaceQuery,
+	const FInvokers* ParentInvokers)
 {
 	CHECK_MAX_CHUNKS_COUNT_BOOL();
+
+	if (!IsDirty(DirtyRegion))
+	{
+		// Nothing that ShouldSubdivideByDistance depends on changed here
+		ReuseOldDivisionByDistance();
+		return false;
+	}
+
+	const FInvokers Invokers = GetInvokersInRange(Settings, ParentInvokers);
 	
-	if (ShouldSubdivideByDistance(Settings))
+	if (ShouldSubdivideByDistance(Settings, Invokers, SurfaceQuery))
 	{
 		ChunkSettings.DivisionType = EDivisionType::ByDistance;
 		
@@ -305,7 +466,7 @@ bool FVoxelRenderOctree::UpdateSubdividedByDistance(const FVoxelRenderOctreeSett
 		bool bChanged = ChunkSettings.OldDivisionType != EDivisionType::ByDistance;
 		for (auto& Child : GetChildren())
 		{
-			bChanged |= Child.UpdateSubdividedByDistance(Settings);
+			bChanged |= Child.UpdateSubdividedByDistance(Settings, DirtyRegion, SurfaceQuery, &Invokers);
 		}
 	
 		return bChanged;
@@ -361,11 +522,13 @@ void FVoxelRenderOctree::ReuseOldNeighbors()
 	}
 }
 
-void FVoxelRenderOctree::UpdateSubdividedByOthers(const FVoxelRenderOctreeSettings& Settings)
+void FVoxelRenderOctree::UpdateSubdividedByOthers(const FVoxelRenderOctreeSettings& Settings, const FInvokers* ParentInvokers)
 {
 	CHECK_MAX_CHUNKS_COUNT();
 
-	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized && ShouldSubdivideByOthers(Settings))
+	const FInvokers Invokers = GetInvokersInRange(Settings, ParentInvokers);
+
+	if (ChunkSettings.DivisionType == EDivisionType::Uninitialized && ShouldSubdivideByOthers(Settings, Invokers))
 	{
 		ChunkSettings.DivisionType = EDivisionType::ByOthers;
 
@@ -379,7 +542,7 @@ void FVoxelRenderOctree::UpdateSubdividedByOthers(const FVoxelRenderOctreeSettin
 	{
 		for (auto& Child : GetChildren())
 		{
-			Child.UpdateSubdividedByOthers(Settings);
+			Child.UpdateSubdividedByOthers(Settings, &Invokers);
 		}
 	}
 }
@@ -432,18 +595,29 @@ void FVoxelRenderOctree::GetUpdates(
 	bool bRecomputeTransitionMasks,
 	const FVoxelRenderOctreeSettings& Settings,
 	TArray<FVoxelChunkUpdate>& ChunkUpdates,
-	bool bInVisible)
+	bool bInVisible,
+	const FInvokers* ParentInvokers)
 {
 	CHECK_MAX_CHUNKS_COUNT();
 
 	UpdateIndex++;
 	check(UpdateIndex == InUpdateIndex);
 
+	// Delete the chunks that are no longer subdivided in the same pass
+	// Below a chunk outside of the world bounds, the children are not visited: delete the whole subtree
+	if (HasChildren() &&
+		(ChunkSettings.DivisionType == EDivisionType::Uninitialized || !OctreeBounds.Intersect(Settings.WorldBounds)))
+	{
+		DeleteChunks(ChunkUpdates);
+	}
+
 	if (!OctreeBounds.Intersect(Settings.WorldBounds))
 	{
 		return;
 	}
 
+	const FInvokers Invokers = GetInvokersInRange(Settings, ParentInvokers);
+
 	FVoxelChunkSettings NewSettings{};
 	
 	// NOTE: we DO want bEnableRender = false to disable VisibleChunks settings
@@ -471,28 +645,20 @@ void FVoxelRenderOctree::GetUpdates(
 
 		for (auto& Child : GetChildren())
 		{
-			Child.GetUpdates(UpdateIndex, bRecomputeTransitionMasks, Settings, ChunkUpdates, bChildrenVisible);
+			Child.GetUpdates(UpdateIndex, bRecomputeTransitionMasks, Settings, ChunkUpdates, bChildrenVisible, &Invokers);
 		}
 	}
 
 	NewSettings.bEnableCollisions =
 		Settings.bEnableCollisions &&
-		((Height == 0 &&
-			IsInvokerInRange(Settings.Invokers,
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForCollisions; },
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.CollisionsBounds; })
-		 )
+		((Height == 0 && Invokers.Collisions.Num() > 0)
 		 ||
 		 (NewSettings.bVisible && Settings.bComputeVisibleChunksCollisions && Height <= Settings.VisibleChunksCollisionsMaxLOD)
 	    );
 		
 	NewSettings.bEnableNavmesh = 
 		Settings.bEnableNavmesh &&
-		((Height == 0 &&
-			IsInvokerInRange(Settings.Invokers,
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForNavmesh; },
-				[](const FVoxelInvokerSettings& Invoker) { return Invoker.NavmeshBounds; })
-		)
+		((Height == 0 && Invokers.Navmesh.Num() > 0)
 		||
 		(NewSettings.bVisible && Settings.bComputeVisibleChunksNavmesh && Height <= Settings.VisibleChunksNavmeshMaxLOD)
 		);
@@ -598,7 +764,7 @@ FORCEINLINE bool FVoxelRenderOctree::IsCanceled() const
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool FVoxelRenderOctree::ShouldSubdivideByDistance(const FVoxelRenderOctreeSettings& Settings) const
+bool FVoxelRenderOctree::ShouldSubdivideByDistance(const FVoxelRenderOctreeSettings& Settings, const FInvokers& Invokers, FVoxelRenderOctreeSurfaceQuery& SurfaceQuery)
 {
 	if (!Settings.bEnableRender)
 	{
@@ -621,17 +787,81 @@ bool FVoxelRenderOctree::ShouldSubdivideByDistance(const FVoxelRenderOctreeSetti
 		return true;
 	}
 
-	for (auto& Invoker : Settings.Invokers)
+	if (Invokers.LOD.Num() > 0)
+	{
+		// No need to subdivide if there's nothing to render
+		// Chunks next to a surface will still be subdivided by neighbors
+		return MightHaveSurface(Settings, SurfaceQuery);
+	}
+
+	return false;
+}
+
+bool FVoxelRenderOctree::MightHaveSurface(const FVoxelRenderOctreeSettings& Settings, FVoxelRenderOctreeSurfaceQuery& SurfaceQuery)
+{
+	if (!Settings.Data.IsValid())
+	{
+		return true;
+	}
+
+	if (ChunkSettings.SurfaceState == ESurfaceState::Unknown)
+	{
+		// Extend the bounds to account for the neighbors used by the meshers of our children
+		const FVoxelIntBox Bounds = OctreeBounds.Extend(2 << Height);
+		ChunkSettings.SurfaceState = SurfaceQuery.IsEmpty(Bounds) ? ESurfaceState::Empty : ESurfaceState::Surface;
+	}
+
+	return ChunkSettings.SurfaceState == ESurfaceState::Surface;
+}
+
+bool FVoxelRenderOctree::IsDirty(const FVoxelRenderOctreeDirtyRegion& DirtyRegion) const
+{
+	if (DirtyRegion.bEverything)
+	{
+		return true;
+	}
+
+	for (auto& Bounds : DirtyRegion.InvokersBounds)
 	{
-		if (Invoker.bUseForLOD && OctreeBounds.Intersect(Invoker.LODBounds) && Height > Invoker.LODToSet)
+		if (OctreeBounds.Intersect(Bounds))
 		{
 			return true;
 		}
 	}
 
+	if (DirtyRegion.EditedBounds.Num() > 0)
+	{
+		// Same bounds as MightHaveSurface
+		const FVoxelIntBox SurfaceBounds = OctreeBounds.Extend(2 << Height);
+		for (auto& Bounds : DirtyRegion.EditedBounds)
+		{
+			if (SurfaceBounds.Intersect(Bounds))
+			{
+				return true;
+			}
+		}
+	}
+
 	return false;
 }
 
+void FVoxelRenderOctree::ReuseOldDivisionByDistance()
+{
+	// If a chunk is subdivided by distance, so is its parent: no need to look further
+	if (ChunkSettings.OldDivisionType != EDivisionType::ByDistance)
+	{
+		return;
+	}
+
+	ChunkSettings.DivisionType = EDivisionType::ByDistance;
+
+	check(HasChildren());
+	for (auto& Child : GetChildren())
+	{
+		Child.ReuseOldDivisionByDistance();
+	}
+}
+
 
 bool FVoxelRenderOctree::ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSettings& Settings) const
 {
@@ -669,7 +899,7 @@ bool FVoxelRenderOctree::ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSett
 }
 
 
-bool FVoxelRenderOctree::ShouldSubdivideByOthers(const FVoxelRenderOctreeSettings& Settings) const
+bool FVoxelRenderOctree::ShouldSubdivideByOthers(const FVoxelRenderOctreeSettings& Settings, const FInvokers& Invokers) const
 {
 	if (!Settings.bEnableCollisions && !Settings.bEnableNavmesh)
 	{
@@ -684,15 +914,11 @@ bool FVoxelRenderOctree::ShouldSubdivideByOthers(const FVoxelRenderOctreeSetting
 		return false;
 	}
 
-	if (Settings.bEnableCollisions && IsInvokerInRange(Settings.Invokers,
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForCollisions; },
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.CollisionsBounds; }))
+	if (Settings.bEnableCollisions && Invokers.Collisions.Num() > 0)
 	{
 		return true;
 	}
-	if (Settings.bEnableNavmesh && IsInvokerInRange(Settings.Invokers,
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.bUseForNavmesh; },
-		[](const FVoxelInvokerSettings& Invoker) { return Invoker.NavmeshBounds; }))
+	if (Settings.bEnableNavmesh && Invokers.Navmesh.Num() > 0)
 	{
 		return true;
 	}
@@ -776,20 +1002,49 @@ const FVoxelRenderOctree* FVoxelRenderOctree::GetVisibleAdjacentChunk(EVoxelDire
 	}
 }
 
-template<typename T1, typename T2>
-bool FVoxelRenderOctree::IsInvokerInRange(const TArray<FVoxelInvokerSettings>& Invokers, T1 SelectInvoker, T2 GetInvokerBounds) const
+FVoxelRenderOctree::FInvokers FVoxelRenderOctree::GetInvokersInRange(const FVoxelRenderOctreeSettings& Settings, const FInvokers* ParentInvokers) const
 {
-	for (auto& Invoker : Invokers)
+	FInvokers Result;
+
+	const auto Cull = [&](auto& OutIndices, const auto* ParentIndices, auto IsInRange)
 	{
-		if (SelectInvoker(Invoker))
+		if (ParentIndices)
 		{
-			if (OctreeBounds.Intersect(GetInvokerBounds(Invoker)))
+			for (const int32 Index : *ParentIndices)
 			{
-				return true;
+				if (IsInRange(Settings.Invokers[Index]))
+				{
+					OutIndices.Add(Index);
+				}
 			}
 		}
-	}
-	return false;
+		else
+		{
+			for (int32 Index = 0; Index < Settings.Invokers.Num(); Index++)
+			{
+				if (IsInRange(Settings.Invokers[Index]))
+				{
+					OutIndices.Add(Index);
+				}
+			}
+		}
+	};
+
+	// Children have a lower height than their parent: invokers with LODToSet >= Height can be culled too
+	Cull(Result.LOD, ParentInvokers ? &ParentInvokers->LOD : nullptr, [&](const FVoxelInvokerSettings& Invoker)
+	{
+		return Invoker.bUseForLOD && Height > Invoker.LODToSet && OctreeBounds.Intersect(Invoker.LODBounds);
+	});
+	Cull(Result.Collisions, ParentInvokers ? &ParentInvokers->Collisions : nullptr, [&](const FVoxelInvokerSettings& Invoker)
+	{
+		return Invoker.bUseForCollisions && OctreeBounds.Intersect(Invoker.CollisionsBounds);
+	});
+	Cull(Result.Navmesh, ParentInvokers ? &ParentInvokers->Navmesh : nullptr, [&](const FVoxelInvokerSettings& Invoker)
+	{
+		return Invoker.bUseForNavmesh && OctreeBounds.Intersect(Invoker.NavmeshBounds);
+	});
+
+	return Result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,7 +13,9 @@
 
 #include "HAL/ThreadSafeBool.h"
 
+class FVoxelData;
 class FVoxelRenderOctree;
+class FVoxelRenderOctreeSurfaceQuery;
 struct FVoxelLODSettings;
 class FVoxelDebugManager;
 
@@ -41,6 +43,25 @@ struct FVoxelRenderOctreeSettings
 	bool bEnableNavmesh;
 	bool bComputeVisibleChunksNavmesh;
 	int32 VisibleChunksNavmeshMaxLOD;
+
+	// If set, chunks with no surface in them won't be subdivided by distance
+	TVoxelSharedPtr<const FVoxelData> Data;
+	// Bounds edited since the previous build. Only used if Data is set, to know which chunks might have a new surface
+	TArray<FVoxelIntBox> EditedBounds;
+};
+
+// Parts of the octree whose subdivision by distance might have changed since the previous build
+struct FVoxelRenderOctreeDirtyRegion
+{
+	// If true, the whole octree is re-evaluated
+	bool bEverything = true;
+	// If true, the surface states cached by the previous builds can't be trusted
+	// Else only the ones around EditedBounds are invalidated
+	bool bAllSurfaceStates = true;
+	// Old and new LOD bounds of the invokers that changed
+	TArray<FVoxelIntBox> InvokersBounds;
+	// Bounds edited since the previous build
+	TArray<FVoxelIntBox> EditedBounds;
 };
 
 class FVoxelRenderOctreeAsyncBuilder : public FVoxelAsyncWork
@@ -78,6 +99,13 @@ private:
 
 	FVoxelRenderOctreeSettings OctreeSettings{};
 
+	// Octree built by the previous successful build, and the settings used to build it
+	// Used to only re-evaluate the parts of the octree that changed
+	TVoxelWeakPtr<FVoxelRenderOctree> LastBuiltOctree;
+	FVoxelRenderOctreeSettings LastBuiltOctreeSettings{};
+
+	FVoxelRenderOctreeDirtyRegion ComputeDirtyRegion() const;
+
 	bool bTooManyChunks = false;
 	double Counter = 0;
 	FString Log;
@@ -103,11 +131,20 @@ public:
 		ByOthers      = 3
 	};
 
+	enum class ESurfaceState : uint8
+	{
+		Unknown = 0,
+		Empty   = 1,
+		Surface = 2
+	};
+
 	struct FChunkSettings
 	{
 		FVoxelChunkSettings Settings{};
 		EDivisionType DivisionType = EDivisionType::Uninitialized;
 		EDivisionType OldDivisionType = EDivisionType::Uninitialized;
+		// Result of MightHaveSurface, kept across builds until an edit touches the chunk
+		ESurfaceState SurfaceState = ESurfaceState::Unknown;
 	}; 
 	FChunkSettings ChunkSettings;
 	int32 CurrentChunksCount = 0;
@@ -116,6 +153,7 @@ public:
 	inline const FVoxelChunkSettings& GetSettings() const { return ChunkSettings.Settings; }
 
 	FVoxelRenderOctree(uint8 LOD);
+	// Clones Source for a new build: the division types are reset in the same pass
 	FVoxelRenderOctree(const FVoxelRenderOctree* Source);
 
 	FVoxelRenderOctree(const FVoxelRenderOctree& Parent, uint8 ChildIndex);
@@ -123,19 +161,36 @@ public:
 
 	~FVoxelRenderOctree();
 
-	void ResetDivisionType();
-	bool UpdateSubdividedByDistance(const FVoxelRenderOctreeSettings& Settings);
+	// Indices in Settings.Invokers of the invokers whose bounds intersect a chunk
+	// Children only need to test the invokers of their parent: the octree is used as a spatial index of the invokers
+	struct FInvokers
+	{
+		TArray<int32, TInlineAllocator<8>> LOD;
+		TArray<int32, TInlineAllocator<8>> Collisions;
+		TArray<int32, TInlineAllocator<8>> Navmesh;
+	};
+
+	// Resets the cached surface states that DirtyRegion invalidates
+	void InvalidateSurfaceStates(const FVoxelRenderOctreeDirtyRegion& DirtyRegion);
+	// Subtrees outside of DirtyRegion reuse their previous subdivision by distance
+	bool UpdateSubdividedByDistance(
+		const FVoxelRenderOctreeSettings& Settings,
+		const FVoxelRenderOctreeDirtyRegion& DirtyRegion,
+		FVoxelRenderOctreeSurfaceQuery& SurfaceQuery,
+		const FInvokers* ParentInvokers = nullptr);
 	bool UpdateSubdividedByNeighbors(const FVoxelRenderOctreeSettings& Settings);
 	void ReuseOldNeighbors();
-	void UpdateSubdividedByOthers(const FVoxelRenderOctreeSettings& Settings);
+	void UpdateSubdividedByOthers(const FVoxelRenderOctreeSettings& Settings, const FInvokers* ParentInvokers = nullptr);
 	void DeleteChunks(TArray<FVoxelChunkUpdate>& ChunkUpdates);
 
+	// Also deletes the chunks that are no longer subdivided, see DeleteChunks
 	void GetUpdates(
 		uint32 InUpdateIndex,
 		bool bRecomputeTransitionMasks,
 		const FVoxelRenderOctreeSettings& Settings, 
 		TArray<FVoxelChunkUpdate>& ChunkUpdates, 
-		bool bVisible = true);
+		bool bVisible = true,
+		const FInvokers* ParentInvokers = nullptr);
 
 	void GetChunksToUpdateForBounds(const FVoxelIntBox& Bounds, TArray<uint64>& ChunksToUpdate, const FVoxelOnChunkUpdate& OnChunkUpdate) const;
 	void GetVisibleChunksOverlappingBounds(const FVoxelIntBox& Bounds, TArray<uint64, TInlineAllocator<8>>& VisibleChunks) const;
@@ -143,14 +198,18 @@ public:
 	bool IsCanceled() const;
 
 private:
-	bool ShouldSubdivideByDistance(const FVoxelRenderOctreeSettings& Settings) const;
+	bool ShouldSubdivideByDistance(const FVoxelRenderOctreeSettings& Settings, const FInvokers& Invokers, FVoxelRenderOctreeSurfaceQuery& SurfaceQuery);
 	bool ShouldSubdivideByNeighbors(const FVoxelRenderOctreeSettings& Settings) const;
-	bool ShouldSubdivideByOthers(const FVoxelRenderOctreeSettings& Settings) const;
+	bool ShouldSubdivideByOthers(const FVoxelRenderOctreeSettings& Settings, const FInvokers& Invokers) const;
+	bool MightHaveSurface(const FVoxelRenderOctreeSettings& Settings, FVoxelRenderOctreeSurfaceQuery& SurfaceQuery);
 	
+	bool IsDirty(const FVoxelRenderOctreeDirtyRegion& DirtyRegion) const;
+	void ReuseOldDivisionByDistance();
+
 	const FVoxelRenderOctree* GetVisibleAdjacentChunk(EVoxelDirectionFlag::Type Direction, int32 Index) const;
 
-	template<typename T1, typename T2>
-	bool IsInvokerInRange(const TArray<FVoxelInvokerSettings>& Invokers, T1 SelectInvoker, T2 GetInvokerBounds) const;
+	// If ParentInvokers is null, all the invokers are tested
+	FInvokers GetInvokersInRange(const FVoxelRenderOctreeSettings& Settings, const FInvokers* ParentInvokers) const;
 
 	uint64 GetId();
 };
\ No newline at end of file
@@ -35,7 +35,7 @@ struct FVoxelCubicFullVertex : FVoxelMesherVertex
 };
 static_assert(sizeof(FVoxelCubicFullVertex) == sizeof(FVoxelMesherVertex), "");
 
-struct FVoxelCubicGeometryVertex : FVector
+struct FVoxelCubicGeometryVertex : FVector3f
 {
 	static constexpr bool bComputeNormal = false;
 	static constexpr bool bComputeTangent = false;
@@ -44,7 +44,7 @@ struct FVoxelCubicGeometryVertex : FVector
 
 	FORCEINLINE void SetPosition(const FVector& InPosition)
 	{
-		static_cast<FVector&>(*this) = InPosition;
+		static_cast<FVector3f&>(*this) = FVector3f(InPosition);
 	}
 	FORCEINLINE void SetNormal(const FVector&)
 	{
@@ -63,13 +63,15 @@ struct FVoxelCubicGeometryVertex : FVector
 		checkVoxelSlow(false);
 	}
 };
-static_assert(sizeof(FVoxelCubicGeometryVertex) == sizeof(FVector), "");
+static_assert(sizeof(FVoxelCubicGeometryVertex) == sizeof(FVector3f), "");
 
 template<EVoxelDirectionFlag::Type Direction, typename TVertex, typename TMesher>
 FORCEINLINE void AddFace(
 	TMesher& Mesher, int32 Step, FVoxelMaterial Material, 
 	int32 X, int32 Y, int32 Z, 
-	TArray<uint32>& Indices, TArray<TVertex>& Vertices)
+	TArray<uint32>& Indices, TArray<TVertex>& Vertices,
+	// Size of the face in voxels, used when merging faces. Must be 1 along the face normal
+	const FIntVector& FaceSize = FIntVector(1))
 {
 	if (TVertex::bComputeMaterial && Mesher.Settings.bOneMaterialPerCubeSide)
 	{
@@ -159,10 +161,12 @@ FORCEINLINE void AddFace(
 		break;
 	}
 
+	const FVector Size = FVector(FaceSize);
+
 	int32 PositionsIndices[4];
 	for (int32 Index = 0; Index < 4; Index++)
 	{
-		const FVector VertexPositionInCube = Positions[Index];
+		const FVector VertexPositionInCube = Positions[Index] * Size;
 		const FVector VertexPosition = (VertexPositionInCube + FVector(X, Y, Z)) * Step - FVector(0.5f);
 		
 		TVertex Vertex;
@@ -204,11 +208,13 @@ FORCEINLINE void AddFace(
 			}
 			else if (Mesher.Settings.UVConfig == EVoxelUVConfig::PackWorldUpInUVs)
 			{
-				TextureCoordinate = FVoxelMesherUtilities::GetUVs(Mesher, FVector(X, Y, Z));
+				// Sample the world up at the corners of merged faces
+				TextureCoordinate = FVoxelMesherUtilities::GetUVs(Mesher, FaceSize == FIntVector(1) ? FVector(X, Y, Z) : FVector(X, Y, Z) + VertexPositionInCube);
 			}
 			else
 			{
 				check(Mesher.Settings.UVConfig == EVoxelUVConfig::PerVoxelUVs);
+				// Merged faces go from 0 to their size, so that the UVs tile once per voxel
 				const auto& V = VertexPositionInCube;
 				switch (Direction)
 				{
@@ -216,10 +222,10 @@ FORCEINLINE void AddFace(
 					TextureCoordinate = { V.Y, V.Z };
 					break;
 				case EVoxelDirectionFlag::XMax:
-					TextureCoordinate = { 1 - V.Y, V.Z };
+					TextureCoordinate = { Size.Y - V.Y, V.Z };
 					break;
 				case EVoxelDirectionFlag::YMin:
-					TextureCoordinate = { 1 - V.X, V.Z };
+					TextureCoordinate = { Size.X - V.X, V.Z };
 					break;
 				case EVoxelDirectionFlag::YMax:
 					TextureCoordinate = { V.X, V.Z };
@@ -229,7 +235,7 @@ FORCEINLINE void AddFace(
 					break;
 				default:
 					check(Direction == EVoxelDirectionFlag::ZMax);
-					TextureCoordinate = { V.X, 1 - V.Y };
+					TextureCoordinate = { V.X, Size.Y - V.Y };
 					break;
 				}
 				TextureCoordinate.Y = 1 - TextureCoordinate.Y; // Y is down
@@ -281,7 +287,7 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelCubicMesher::CreateFullChunkImpl(FVoxelMe
 }
 
 
-void FVoxelCubicMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices)
+void FVoxelCubicMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices)
 {
 	CreateGeometryTemplate(Times, Indices, reinterpret_cast<TArray<FVoxelCubicGeometryVertex>&>(Vertices));
 	UnlockData();
@@ -294,13 +300,44 @@ void FVoxelCubicMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint
 template<typename T>
 void FVoxelCubicMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<T>& Vertices)
 {
+	TVoxelQueryZone<FVoxelValue> QueryZone(GetBoundsToCheckIsEmptyOn(), FIntVector(CUBIC_CHUNK_SIZE_WITH_NEIGHBORS), LOD, CachedValues);
+
+	if (Settings.bGreedyCubicMeshing && T::bComputeMaterial)
+	{
+		// Merging needs the materials of all the faces: generate them in the same pass as the values
+		CachedMaterials.SetNumUninitialized(RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE);
+		TVoxelQueryZone<FVoxelMaterial> MaterialsQueryZone(
+			FVoxelIntBox(ChunkPosition, ChunkPosition + RENDER_CHUNK_SIZE * Step), 
+			FIntVector(RENDER_CHUNK_SIZE),
+			LOD, 
+			CachedMaterials);
+#if ENABLE_MESHER_STATS
+		// The time is counted with the values
+		Times._MaterialsAccesses += RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE;
+#endif
+		MESHER_TIME_VALUES(CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS, Data.GetValuesAndMaterials(QueryZone, MaterialsQueryZone, LOD));
+	}
+	else
+	{
+		MESHER_TIME_VALUES(CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS, Data.Get<FVoxelValue>(QueryZone, LOD));
+	}
+
+	if (Settings.bGreedyCubicMeshing)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Greedy Iteration");
+		CreateGreedyFaces<EVoxelDirectionFlag::XMin>(Indices, Vertices);
+		CreateGreedyFaces<EVoxelDirectionFlag::XMax>(Indices, Vertices);
+		CreateGreedyFaces<EVoxelDirectionFlag::YMin>(Indices, Vertices);
+		CreateGreedyFaces<EVoxelDirectionFlag::YMax>(Indices, Vertices);
+		CreateGreedyFaces<EVoxelDirectionFlag::ZMin>(Indices, Vertices);
+		CreateGreedyFaces<EVoxelDirectionFlag::ZMax>(Indices, Vertices);
+		return;
+	}
+	
 	if (T::bComputeMaterial)
 	{
 		Accelerator = MakeUnique<FVoxelConstDataAccelerator>(Data, GetBoundsToLock());
 	}
-
-	TVoxelQueryZone<FVoxelValue> QueryZone(GetBoundsToCheckIsEmptyOn(), FIntVector(CUBIC_CHUNK_SIZE_WITH_NEIGHBORS), LOD, CachedValues);
-	MESHER_TIME_VALUES(CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS, Data.Get<FVoxelValue>(QueryZone, LOD));
 	
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("Iteration");
@@ -347,6 +384,136 @@ void FVoxelCubicMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<
 	}
 }
 
+template<EVoxelDirectionFlag::Type Direction, typename T>
+void FVoxelCubicMesher::CreateGreedyFaces(TArray<uint32>& Indices, TArray<T>& Vertices)
+{
+	constexpr bool bIsMax = Direction == EVoxelDirectionFlag::XMax || Direction == EVoxelDirectionFlag::YMax || Direction == EVoxelDirectionFlag::ZMax;
+	
+	// Axis of the face normal, and the two axes of the face plane
+	constexpr int32 NormalAxis =
+		Direction == EVoxelDirectionFlag::XMin || Direction == EVoxelDirectionFlag::XMax ? 0 :
+		Direction == EVoxelDirectionFlag::YMin || Direction == EVoxelDirectionFlag::YMax ? 1 : 2;
+	constexpr int32 AxisU = NormalAxis == 0 ? 1 : 0;
+	constexpr int32 AxisV = NormalAxis == 2 ? 1 : 2;
+
+	// Faces of the current slice, cleared as they are merged
+	TVoxelStaticBitArray<RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE> Faces;
+
+	for (int32 Slice = 0; Slice < RENDER_CHUNK_SIZE; Slice++)
+	{
+		const auto GetPosition = [&](int32 U, int32 V)
+		{
+			FIntVector Position;
+			Position[NormalAxis] = Slice;
+			Position[AxisU] = U;
+			Position[AxisV] = V;
+			return Position;
+		};
+		
+		Faces.Clear();
+		
+		bool bHasFaces = false;
+		for (int32 V = 0; V < RENDER_CHUNK_SIZE; V++)
+		{
+			for (int32 U = 0; U < RENDER_CHUNK_SIZE; U++)
+			{
+				const FIntVector Position = GetPosition(U, V);
+				FIntVector Neighbor = Position;
+				Neighbor[NormalAxis] += bIsMax ? 1 : -1;
+
+				const bool bHasFace = !GetValue(Position.X, Position.Y, Position.Z).IsEmpty() && GetValue(Neighbor.X, Neighbor.Y, Neighbor.Z).IsEmpty();
+				if (bHasFace)
+				{
+					Faces.Set(U + V * RENDER_CHUNK_SIZE);
+					bHasFaces = true;
+				}
+			}
+		}
+
+		if (!bHasFaces)
+		{
+			continue;
+		}
+
+		for (int32 V = 0; V < RENDER_CHUNK_SIZE; V++)
+		{
+			for (int32 U = 0; U < RENDER_CHUNK_SIZE; U++)
+			{
+				if (!Faces.Test(U + V * RENDER_CHUNK_SIZE))
+				{
+					continue;
+				}
+
+				const FIntVector Position = GetPosition(U, V);
+				const FVoxelMaterial Material = T::bComputeMaterial ? GetMaterial(Position.X, Position.Y, Position.Z) : FVoxelMaterial();
+
+				const auto CanMerge = [&](int32 OtherU, int32 OtherV)
+				{
+					if (!Faces.Test(OtherU + OtherV * RENDER_CHUNK_SIZE))
+					{
+						return false;
+					}
+					if (!T::bComputeMaterial)
+					{
+						return true;
+					}
+					const FIntVector OtherPosition = GetPosition(OtherU, OtherV);
+					return GetMaterial(OtherPosition.X, OtherPosition.Y, OtherPosition.Z) == Material;
+				};
+
+				int32 Width = 1;
+				while (U + Width < RENDER_CHUNK_SIZE && CanMerge(U + Width, V))
+				{
+					Width++;
+				}
+
+				int32 Height = 1;
+				while (V + Height < RENDER_CHUNK_SIZE)
+				{
+					bool bCanMergeRow = true;
+					for (int32 Index = 0; Index < Width && bCanMergeRow; Index++)
+					{
+						bCanMergeRow = CanMerge(U + Index, V + Height);
+					}
+					if (!bCanMergeRow)
+					{
+						break;
+					}
+					Height++;
+				}
+
+				for (int32 LocalV = V; LocalV < V + Height; LocalV++)
+				{
+					for (int32 LocalU = U; LocalU < U + Width; LocalU++)
+					{
+						Faces.Clear(LocalU + LocalV * RENDER_CHUNK_SIZE);
+					}
+				}
+
+				FIntVector FaceSize(1);
+				FaceSize[AxisU] = Width;
+				FaceSize[AxisV] = Height;
+				
+				AddFace<Direction>(*this, Step, Material, Position.X, Position.Y, Position.Z, Indices, Vertices, FaceSize);
+
+				U += Width - 1;
+			}
+		}
+	}
+}
+
+FORCEINLINE FVoxelMaterial FVoxelCubicMesher::GetMaterial(int32 X, int32 Y, int32 Z) const
+{
+	checkVoxelSlow(
+		0 <= X &&
+		0 <= Y &&
+		0 <= Z &&
+		X < RENDER_CHUNK_SIZE &&
+		Y < RENDER_CHUNK_SIZE &&
+		Z < RENDER_CHUNK_SIZE);
+	return CachedMaterials[X + Y * RENDER_CHUNK_SIZE + Z * RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE];
+}
+
 FORCEINLINE FVoxelValue FVoxelCubicMesher::GetValue(int32 X, int32 Y, int32 Z) const
 {
 	checkVoxelSlow(
@@ -19,18 +19,28 @@ protected:
 	virtual FVoxelIntBox GetBoundsToCheckIsEmptyOn() const override final;
 	virtual FVoxelIntBox GetBoundsToLock() const override final;
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunkImpl(FVoxelMesherTimes& Times) override final;
-	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices) override final;
+	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices) override final;
+	virtual FVoxelChunkDistanceFieldValues GetDistanceFieldValues() const override final
+	{
+		return { CachedValues.GetData(), CUBIC_CHUNK_SIZE_WITH_NEIGHBORS, -1 };
+	}
 	
 private:
 	TUniquePtr<FVoxelConstDataAccelerator> Accelerator;
 	TVoxelStaticArray<FVoxelValue, CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS * CUBIC_CHUNK_SIZE_WITH_NEIGHBORS> CachedValues;
+	// Only used by greedy meshing, RENDER_CHUNK_SIZE^3 without neighbors
+	TArray<FVoxelMaterial> CachedMaterials;
 
 private:
 	template<typename T>
 	void CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<T>& Vertices);
+	// Merge the coplanar faces with the same material into rectangles, one slice at a time
+	template<EVoxelDirectionFlag::Type Direction, typename T>
+	void CreateGreedyFaces(TArray<uint32>& Indices, TArray<T>& Vertices);
 
 private:
 	FVoxelValue GetValue(int32 X, int32 Y, int32 Z) const;
+	FVoxelMaterial GetMaterial(int32 X, int32 Y, int32 Z) const;
 };
 
 class FVoxelCubicTransitionsMesher : public FVoxelTransitionsMesher
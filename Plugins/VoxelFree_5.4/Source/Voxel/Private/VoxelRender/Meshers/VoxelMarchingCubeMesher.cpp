@@ -40,13 +40,39 @@ public:
 		return MesherVertices;
 	}
 	
+	template<typename T>
+	static FVoxelIntBox GetMaterialsBounds(const FVoxelMarchingCubeMesher& Mesher, const TArray<T>& Vertices)
+	{
+		check(Vertices.Num() > 0);
+		
+		FIntVector Min(MAX_int32);
+		FIntVector Max(MIN_int32);
+		for (auto& Vertex : Vertices)
+		{
+			Min = FVoxelUtilities::ComponentMin(Min, Vertex.MaterialPosition);
+			Max = FVoxelUtilities::ComponentMax(Max, Vertex.MaterialPosition);
+		}
+
+		// Interpolation also reads the other end of the edges
+		// Clamp to the locked bounds
+		const FIntVector CellMin = FVoxelUtilities::ComponentMax(FVoxelUtilities::DivideFloor(Min, Mesher.Step) - FIntVector(1), FIntVector(-1));
+		const FIntVector CellMax = FVoxelUtilities::ComponentMin(FVoxelUtilities::DivideCeil(Max, Mesher.Step) + FIntVector(2), FIntVector(CHUNK_SIZE_WITH_END_EDGE + 1));
+		
+		return FVoxelIntBox(CellMin * Mesher.Step, CellMax * Mesher.Step);
+	}
+	
 	template<typename T, typename TMesher>
-	static void ComputeMaterials(TMesher& Mesher, TArray<FVoxelMesherVertex>& MesherVertices, TArray<T>& Vertices)
+	static void ComputeMaterials(TMesher& Mesher, TArray<FVoxelMesherVertex>& MesherVertices, TArray<T>& Vertices, const FVoxelMesherMaterialGrid* MaterialGrid = nullptr)
 	{
 		VOXEL_ASYNC_FUNCTION_COUNTER();
 	
 		const auto GetMaterial = [&](const FIntVector& P)
 		{
+			// At LOD > 0, binary searches along the edges can give positions that are not on the grid
+			if (MaterialGrid && MaterialGrid->Contains(P))
+			{
+				return MaterialGrid->Get(P);
+			}
 			return Mesher.Accelerator->GetMaterial(
 				P.X + Mesher.ChunkPosition.X,
 				P.Y + Mesher.ChunkPosition.Y, 
@@ -129,7 +155,7 @@ public:
 		{
 			for (auto& Vertex : MesherVertices)
 			{
-				Vertex.Tangent.TangentX = FVector(FMath::FRandRange(-1., 1.), FMath::FRandRange(-1., 1.), FMath::FRandRange(-1., 1.)).GetSafeNormal();
+				Vertex.Tangent.TangentX = FVector3f(FMath::FRandRange(-1.f, 1.f), FMath::FRandRange(-1.f, 1.f), FMath::FRandRange(-1.f, 1.f)).GetSafeNormal();
 			}
 		}
 	}
@@ -333,13 +359,22 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMarchingCubeMesher::CreateFullChunkImpl(F
 	
 	TArray<uint32> Indices;
 	TArray<FLocalVertex> Vertices;
-	CreateGeometryTemplate(Times, Indices, Vertices);
+	FVoxelMesherMaterialGrid MaterialGrid;
+	CreateGeometryTemplate(Times, Indices, Vertices, &MaterialGrid);
 
 	FVoxelMesherUtilities::SanitizeMesh(Indices, Vertices);
 
 	TArray<FVoxelMesherVertex> MesherVertices = FMarchingCubeHelpers::CreateMesherVertices(Vertices);
 
-	MESHER_TIME_MATERIALS(MesherVertices.Num(), FMarchingCubeHelpers::ComputeMaterials(*this, MesherVertices, Vertices));
+	// Not needed if the materials were queried with the values
+	if (Vertices.Num() > 0 && MaterialGrid.Num() == 0)
+	{
+		// Query all the materials around the surface at once
+		const FVoxelIntBox MaterialsBounds = FMarchingCubeHelpers::GetMaterialsBounds(*this, Vertices);
+		MESHER_TIME_MATERIALS(MaterialsBounds.Count() >> (3 * LOD), MaterialGrid.Query(Data, ChunkPosition, LOD, MaterialsBounds));
+	}
+	
+	MESHER_TIME_MATERIALS(MesherVertices.Num(), FMarchingCubeHelpers::ComputeMaterials(*this, MesherVertices, Vertices, &MaterialGrid));
 	MESHER_TIME(Normals, FMarchingCubeHelpers::ComputeNormals(*this, MesherVertices, Indices));
 
 	UnlockData();
@@ -418,15 +453,15 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMarchingCubeMesher::CreateFullChunkImpl(F
 		MoveTemp(MesherVertices)));
 }
 
-void FVoxelMarchingCubeMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices)
+void FVoxelMarchingCubeMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 
-	struct FVectorVertex : FVector
+	struct FVectorVertex : FVector3f
 	{
 		FVectorVertex() = default;
 		FORCEINLINE FVectorVertex(const FVector& Position, const FIntVector&)
-			: FVector(Position)
+			: FVector3f(Position)
 		{
 		}
 	};
@@ -439,7 +474,7 @@ void FVoxelMarchingCubeMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArr
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-bool FVoxelMarchingCubeMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<T>& Vertices)
+bool FVoxelMarchingCubeMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<T>& Vertices, FVoxelMesherMaterialGrid* MaterialGrid)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 
@@ -452,10 +487,45 @@ bool FVoxelMarchingCubeMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times,
 		BoundsToQuery = BoundsToQuery.Extend(1);
 	}
 	TVoxelQueryZone<FVoxelValue> QueryZone(BoundsToQuery, FIntVector(DataSize), LOD, CachedValues);
-	MESHER_TIME_VALUES(DataSize * DataSize * DataSize, Data.Get<FVoxelValue>(QueryZone, LOD));
+	if (MaterialGrid && FVoxelMesherMaterialGrid::ShouldQueryWithValues())
+	{
+		// Generate the materials in the same pass as the values. They can only be queried inside the values bounds:
+		// the few material positions outside of them at LOD > 0 are read from the accelerator
+#if ENABLE_MESHER_STATS
+		// The time is counted with the values
+		Times._MaterialsAccesses += DataSize * DataSize * DataSize;
+#endif
+		MESHER_TIME_VALUES(DataSize * DataSize * DataSize, MaterialGrid->QueryWithValues(Data, ChunkPosition, LOD, BoundsToQuery.Translate(-ChunkPosition), QueryZone));
+	}
+	else
+	{
+		MESHER_TIME_VALUES(DataSize * DataSize * DataSize, Data.Get<FVoxelValue>(QueryZone, LOD));
+	}
 	
 	Accelerator = MakeUnique<FVoxelConstDataAccelerator>(Data, GetBoundsToLock());
 
+	// One bit per value along X telling if it's empty, so that the cases of a whole row of cells are computed at once
+	static_assert(CHUNK_SIZE_WITH_NORMALS <= 64, "");
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Compute Empty Masks");
+		for (int32 Row = 0; Row < DataSize * DataSize; Row++)
+		{
+			const FVoxelValue* RESTRICT const RowValues = CachedValues + Row * DataSize;
+			
+			uint64 Mask = 0;
+			for (int32 X = 0; X < DataSize; X++)
+			{
+				Mask |= uint64(RowValues[X].IsEmpty()) << X;
+			}
+			EmptyMasks[Row] = Mask;
+		}
+	}
+
+	// Padding for the normals
+	const int32 Offset = LOD == 0 ? 1 : 0;
+	// Bits used by the cells of a row, including the end edge
+	constexpr uint64 RowCellsMask = (uint64(1) << (RENDER_CHUNK_SIZE + 1)) - 1;
+
 	uint32 VoxelIndex = 0;
 	if (LOD == 0) VoxelIndex += DataSize * DataSize; // Additional voxel for normals
 	for (int32 LZ = 0; LZ < RENDER_CHUNK_SIZE; LZ++)
@@ -464,8 +534,32 @@ bool FVoxelMarchingCubeMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times,
 		for (int32 LY = 0; LY < RENDER_CHUNK_SIZE; LY++)
 		{
 			if (LOD == 0) VoxelIndex += 1; // Additional voxel for normals
+
+			const int32 RowIndex = (LY + Offset) + (LZ + Offset) * DataSize;
+			const uint64 RowMasks[4] =
+			{
+				EmptyMasks[RowIndex],
+				EmptyMasks[RowIndex + 1],
+				EmptyMasks[RowIndex + DataSize],
+				EmptyMasks[RowIndex + 1 + DataSize]
+			};
+			
+			const uint64 RowMasksAnd = RowMasks[0] & RowMasks[1] & RowMasks[2] & RowMasks[3];
+			const uint64 RowMasksOr = RowMasks[0] | RowMasks[1] | RowMasks[2] | RowMasks[3];
+			// If all the corners of the row are empty or all are full, no cell has a triangulation
+			const bool bIsTrivialRow =
+				((RowMasksOr >> Offset) & RowCellsMask) == 0 ||
+				((RowMasksAnd >> Offset) & RowCellsMask) == RowCellsMask;
+			
 			for (int32 LX = 0; LX < RENDER_CHUNK_SIZE; LX++)
 			{
+				if (bIsTrivialRow)
+				{
+					CurrentCache[GetCacheIndex(0, LX, LY)] = -1;
+					VoxelIndex++;
+					continue;
+				}
+				
 				{
 					CurrentCache[GetCacheIndex(0, LX, LY)] = -1; // Set EdgeIndex 0 to -1 if the cell isn't voxelized, eg all corners = 0
 
@@ -488,7 +582,14 @@ bool FVoxelMarchingCubeMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times,
 					checkVoxelSlow(CubeIndices[6] < uint32(DataSize * DataSize * DataSize));
 					checkVoxelSlow(CubeIndices[7] < uint32(DataSize * DataSize * DataSize));
 
+					const int32 X = LX + Offset;
 					const uint32 CaseCode =
+						(((RowMasks[0] >> X) & 0x3) << 0) |
+						(((RowMasks[1] >> X) & 0x3) << 2) |
+						(((RowMasks[2] >> X) & 0x3) << 4) |
+						(((RowMasks[3] >> X) & 0x3) << 6);
+					
+					checkVoxelSlow(CaseCode == uint32(
 						(CachedValues[CubeIndices[0]].IsEmpty() << 0) |
 						(CachedValues[CubeIndices[1]].IsEmpty() << 1) |
 						(CachedValues[CubeIndices[2]].IsEmpty() << 2) |
@@ -496,7 +597,7 @@ bool FVoxelMarchingCubeMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times,
 						(CachedValues[CubeIndices[4]].IsEmpty() << 4) |
 						(CachedValues[CubeIndices[5]].IsEmpty() << 5) |
 						(CachedValues[CubeIndices[6]].IsEmpty() << 6) |
-						(CachedValues[CubeIndices[7]].IsEmpty() << 7);
+						(CachedValues[CubeIndices[7]].IsEmpty() << 7)));
 
 					if (CaseCode != 0 && CaseCode != 255)
 					{
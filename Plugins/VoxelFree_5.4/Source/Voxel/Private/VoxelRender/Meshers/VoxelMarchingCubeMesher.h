@@ -12,6 +12,8 @@
 
 #define EDGE_INDEX_COUNT 4
 
+class FVoxelMesherMaterialGrid;
+
 class FVoxelMarchingCubeMesher : public FVoxelMesher
 {
 public:
@@ -22,7 +24,12 @@ protected:
 	virtual FVoxelIntBox GetBoundsToLock() const override final;
 
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunkImpl(FVoxelMesherTimes& Times) override final;
-	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices) override final;
+	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices) override final;
+	virtual FVoxelChunkDistanceFieldValues GetDistanceFieldValues() const override final
+	{
+		// Normals need an extra value on each side at LOD 0
+		return { CachedValues, LOD == 0 ? CHUNK_SIZE_WITH_NORMALS : CHUNK_SIZE_WITH_END_EDGE, LOD == 0 ? -1 : 0 };
+	}
 
 public:	
 	// For GetGradient template
@@ -40,14 +47,18 @@ private:
 	// Use LOD0 size as it's bigger
 	using FCachedValues = TVoxelStaticArray<FVoxelValue, CHUNK_SIZE_WITH_NORMALS * CHUNK_SIZE_WITH_NORMALS * CHUNK_SIZE_WITH_NORMALS>;
 	using FCache = TVoxelStaticArray<int32, RENDER_CHUNK_SIZE * RENDER_CHUNK_SIZE * EDGE_INDEX_COUNT>;
+	// For each row of CachedValues, one bit per X set if the value is empty
+	using FEmptyMasks = TVoxelStaticArray<uint64, CHUNK_SIZE_WITH_NORMALS * CHUNK_SIZE_WITH_NORMALS>;
 
 	TUniquePtr<FCachedValues> CachedValuesStorage = MakeUnique<FCachedValues>();
+	TUniquePtr<FEmptyMasks> EmptyMasksStorage = MakeUnique<FEmptyMasks>();
 	TUniquePtr<FCache> CacheStorageA = MakeUnique<FCache>();
 	TUniquePtr<FCache> CacheStorageB = MakeUnique<FCache>();
 	
 	TUniquePtr<FVoxelConstDataAccelerator> Accelerator;
 
 	FVoxelValue* RESTRICT const CachedValues = CachedValuesStorage->GetData();
+	uint64* RESTRICT const EmptyMasks = EmptyMasksStorage->GetData();
 
 	// Cache to get index of already created vertices
 	int32* RESTRICT CurrentCache = CacheStorageA->GetData();
@@ -55,8 +66,9 @@ private:
 
 private:
 	// T: will be created as T(IntersectionPoint, MaterialPosition)
+	// If MaterialGrid is not null, the materials of the chunk might be queried into it along with the values
 	template<typename T>
-	bool CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<T>& Vertices);
+	bool CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<T>& Vertices, FVoxelMesherMaterialGrid* MaterialGrid = nullptr);
 
 private:
 	static int32 GetCacheIndex(int32 EdgeIndex, int32 LX, int32 LY);
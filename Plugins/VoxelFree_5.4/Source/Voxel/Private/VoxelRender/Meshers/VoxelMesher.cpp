@@ -341,7 +341,7 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesher::CreateFullChunk()
 			if (LOD <= Settings.MaxDistanceFieldLOD)
 			{
 				MESHER_TIME_SCOPE(DistanceField)
-				Chunk->BuildDistanceField(LOD, ChunkPosition, Data, Settings);
+				Chunk->BuildDistanceField(LOD, GetDistanceFieldValues(), Settings);
 			}
 		}
 
@@ -352,7 +352,7 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesher::CreateFullChunk()
 	return Chunk;
 }
 
-void FVoxelMesher::CreateGeometry(TArray<uint32>& Indices, TArray<FVector>& Vertices)
+void FVoxelMesher::CreateGeometry(TArray<uint32>& Indices, TArray<FVector3f>& Vertices)
 {
 	VOXEL_SCOPE_COUNTER_FORMAT("Creating Geometry LOD=%d", LOD);
 
@@ -430,7 +430,7 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelTransitionsMesher::CreateFullChunk()
 	return Chunk;
 }
 
-void FVoxelTransitionsMesher::CreateGeometry(TArray<uint32>& Indices, TArray<FVector>& Vertices)
+void FVoxelTransitionsMesher::CreateGeometry(TArray<uint32>& Indices, TArray<FVector3f>& Vertices)
 {
 	unimplemented();
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "VoxelIntBox.h"
 #include "VoxelMinimal.h"
+#include "VoxelRender/VoxelChunkMesh.h"
 
 struct FVoxelRendererSettings;
 struct FVoxelChunkMesh;
@@ -87,7 +88,7 @@ public:
 	virtual ~FVoxelMesherBase();
 
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunk() = 0;
-	virtual void CreateGeometry(TArray<uint32>& Indices, TArray<FVector>& Vertices) = 0;
+	virtual void CreateGeometry(TArray<uint32>& Indices, TArray<FVector3f>& Vertices) = 0;
 	
 	TVoxelSharedPtr<FVoxelChunkMesh> CreateEmptyChunk() const;
 
@@ -117,13 +118,15 @@ public:
 		const FVoxelRendererSettings& Settings);
 
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunk() override final;
-	virtual void CreateGeometry(TArray<uint32>& Indices, TArray<FVector>& Vertices) override final;
+	virtual void CreateGeometry(TArray<uint32>& Indices, TArray<FVector3f>& Vertices) override final;
 
 protected:
 	// Need to call UnlockData
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunkImpl(FVoxelMesherTimes& Times) = 0;
 	// Need to call UnlockData
-	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices) = 0;
+	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices) = 0;
+	// Values cached by CreateFullChunkImpl, used to build the distance field
+	virtual FVoxelChunkDistanceFieldValues GetDistanceFieldValues() const { return {}; }
 };
 
 class FVoxelTransitionsMesher : public FVoxelMesherBase
@@ -140,7 +143,7 @@ public:
 		uint8 TransitionsMask);
 
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunk() override final;
-	virtual void CreateGeometry(TArray<uint32>& Indices, TArray<FVector>& Vertices) override final;
+	virtual void CreateGeometry(TArray<uint32>& Indices, TArray<FVector3f>& Vertices) override final;
 	
 protected:
 	// Need to call UnlockData
@@ -3,6 +3,54 @@
 #include "VoxelRender/Meshers/VoxelMesherUtilities.h"
 #include "VoxelRender/IVoxelRenderer.h"
 #include "VoxelRender/VoxelChunkMesh.h"
+#include "VoxelData/VoxelDataIncludes.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarQueryMaterialsWithValues(
+	TEXT("voxel.mesher.QueryMaterialsWithValues"),
+	1,
+	TEXT("If true, the marching cubes and surface nets meshers will generate the materials of the whole chunk along with the values. ")
+	TEXT("If false, they will only query the materials around the surface once the geometry is done"),
+	ECVF_Default);
+
+void FVoxelMesherMaterialGrid::Query(const FVoxelData& Data, const FIntVector& ChunkPosition, int32 LOD, const FVoxelIntBox& LocalBounds)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	Allocate(LOD, LocalBounds);
+	
+	TVoxelQueryZone<FVoxelMaterial> QueryZone(Bounds.Translate(ChunkPosition), Size, LOD, Materials);
+	Data.Get<FVoxelMaterial>(QueryZone, LOD);
+}
+
+void FVoxelMesherMaterialGrid::QueryWithValues(const FVoxelData& Data, const FIntVector& ChunkPosition, int32 LOD, const FVoxelIntBox& LocalBounds, TVoxelQueryZone<FVoxelValue>& ValueQueryZone)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	
+	Allocate(LOD, LocalBounds);
+	
+	TVoxelQueryZone<FVoxelMaterial> QueryZone(Bounds.Translate(ChunkPosition), Size, LOD, Materials);
+	Data.GetValuesAndMaterials(ValueQueryZone, QueryZone, LOD);
+}
+
+bool FVoxelMesherMaterialGrid::ShouldQueryWithValues()
+{
+	return CVarQueryMaterialsWithValues.GetValueOnAnyThread() != 0;
+}
+
+void FVoxelMesherMaterialGrid::Allocate(int32 LOD, const FVoxelIntBox& LocalBounds)
+{
+	Step = 1 << LOD;
+	Bounds = LocalBounds;
+	Size = Bounds.Size() / Step;
+	checkVoxelSlow(Size * Step == Bounds.Size());
+	
+	Materials.SetNumUninitialized(Size.X * Size.Y * Size.Z);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
 
 FORCEINLINE int32 AddVertexToBuffer(
 	const FVoxelMesherVertex& Vertex,
@@ -12,7 +60,7 @@ FORCEINLINE int32 AddVertexToBuffer(
 	const FColor* Color = nullptr,
 	const FVector2D* UV = nullptr)
 {
-	const int32 Index = Buffer.Positions.Emplace(Vertex.Position);
+	const int32 Index = Buffer.Positions.Emplace(FVector3f(Vertex.Position));
 	if (Settings.bRenderWorld)
 	{
 		const auto GetColor = [&](FColor InColor)
@@ -29,25 +77,25 @@ FORCEINLINE int32 AddVertexToBuffer(
 			}
 		};
 		
-		Buffer.Normals.Emplace(Vertex.Normal);
+		Buffer.Normals.Emplace(FVoxelPackedNormal(Vertex.Normal));
 		Buffer.Tangents.Emplace(Vertex.Tangent);
-		Buffer.TextureCoordinates[0].Emplace(Vertex.TextureCoordinate);
+		Buffer.TextureCoordinates[0].Emplace(FVector2f(Vertex.TextureCoordinate));
 
 		if (MaterialConfig == EVoxelMaterialConfig::MultiIndex)
 		{
 			check(Color && UV);
 			Buffer.Colors.Emplace(GetColor(*Color));
-			Buffer.TextureCoordinates[1].Emplace(*UV);
-			if (VOXEL_MATERIAL_ENABLE_UV2) Buffer.TextureCoordinates[2].Emplace(Vertex.Material.GetUV_AsFloat(2));
-			if (VOXEL_MATERIAL_ENABLE_UV3) Buffer.TextureCoordinates[3].Emplace(Vertex.Material.GetUV_AsFloat(3));
+			Buffer.TextureCoordinates[1].Emplace(FVector2f(*UV));
+			if (VOXEL_MATERIAL_ENABLE_UV2) Buffer.TextureCoordinates[2].Emplace(FVector2f(Vertex.Material.GetUV_AsFloat(2)));
+			if (VOXEL_MATERIAL_ENABLE_UV3) Buffer.TextureCoordinates[3].Emplace(FVector2f(Vertex.Material.GetUV_AsFloat(3)));
 		}
 		else
 		{
 			Buffer.Colors.Emplace(GetColor(Vertex.Material.GetColor()));
-			if (VOXEL_MATERIAL_ENABLE_UV0) Buffer.TextureCoordinates[1].Emplace(Vertex.Material.GetUV_AsFloat(0));
-			if (VOXEL_MATERIAL_ENABLE_UV1) Buffer.TextureCoordinates[2].Emplace(Vertex.Material.GetUV_AsFloat(1));
-			if (VOXEL_MATERIAL_ENABLE_UV2) Buffer.TextureCoordinates[3].Emplace(Vertex.Material.GetUV_AsFloat(2));
-			if (VOXEL_MATERIAL_ENABLE_UV3) Buffer.TextureCoordinates[4].Emplace(Vertex.Material.GetUV_AsFloat(3));
+			if (VOXEL_MATERIAL_ENABLE_UV0) Buffer.TextureCoordinates[1].Emplace(FVector2f(Vertex.Material.GetUV_AsFloat(0)));
+			if (VOXEL_MATERIAL_ENABLE_UV1) Buffer.TextureCoordinates[2].Emplace(FVector2f(Vertex.Material.GetUV_AsFloat(1)));
+			if (VOXEL_MATERIAL_ENABLE_UV2) Buffer.TextureCoordinates[3].Emplace(FVector2f(Vertex.Material.GetUV_AsFloat(2)));
+			if (VOXEL_MATERIAL_ENABLE_UV3) Buffer.TextureCoordinates[4].Emplace(FVector2f(Vertex.Material.GetUV_AsFloat(3)));
 		}
 	}
 	return Index;
@@ -56,35 +104,44 @@ FORCEINLINE int32 AddVertexToBuffer(
 inline void ReserveBuffer(
 	FVoxelChunkMeshBuffers& Buffer,
 	int32 Num,
+	int32 NumIndices,
 	const FVoxelRendererSettings& Settings,
 	EVoxelMaterialConfig MaterialConfig)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	// Take the allocations from the pool: the same chunks are rebuilt over and over when editing
+	using FPool = FVoxelChunkMeshBufferPool;
 	
-	Buffer.Positions.Reserve(Num);
+	// NumIndices is 0 if the indices are moved in
+	if (NumIndices > 0)
+	{
+		FPool::Allocate(Buffer.Indices, NumIndices);
+	}
+	FPool::Allocate(Buffer.Positions, Num);
 	if (Settings.bRenderWorld)
 	{
-		Buffer.Normals.Reserve(Num);
-		Buffer.Tangents.Reserve(Num);
-		Buffer.Colors.Reserve(Num);
+		FPool::Allocate(Buffer.Normals, Num);
+		FPool::Allocate(Buffer.Tangents, Num);
+		FPool::Allocate(Buffer.Colors, Num);
 
 		if (MaterialConfig == EVoxelMaterialConfig::MultiIndex)
 		{
 			Buffer.TextureCoordinates.SetNum(2 + VOXEL_MATERIAL_ENABLE_UV2 + VOXEL_MATERIAL_ENABLE_UV3);
-			Buffer.TextureCoordinates[0].Reserve(Num);
+			FPool::Allocate(Buffer.TextureCoordinates[0], Num);
 			// Note: we always create the additional UV channel, else it creates issues when merging chunks
-			Buffer.TextureCoordinates[1].Reserve(Num);
-			if (VOXEL_MATERIAL_ENABLE_UV2) Buffer.TextureCoordinates[2].Reserve(Num);
-			if (VOXEL_MATERIAL_ENABLE_UV3) Buffer.TextureCoordinates[3].Reserve(Num);
+			FPool::Allocate(Buffer.TextureCoordinates[1], Num);
+			if (VOXEL_MATERIAL_ENABLE_UV2) FPool::Allocate(Buffer.TextureCoordinates[2], Num);
+			if (VOXEL_MATERIAL_ENABLE_UV3) FPool::Allocate(Buffer.TextureCoordinates[3], Num);
 		}
 		else
 		{
 			Buffer.TextureCoordinates.SetNum(1 + VOXEL_MATERIAL_ENABLE_UV0 + VOXEL_MATERIAL_ENABLE_UV1 + VOXEL_MATERIAL_ENABLE_UV2 + VOXEL_MATERIAL_ENABLE_UV3);
-			Buffer.TextureCoordinates[0].Reserve(Num);
-			if (VOXEL_MATERIAL_ENABLE_UV0) Buffer.TextureCoordinates[1].Reserve(Num);
-			if (VOXEL_MATERIAL_ENABLE_UV1) Buffer.TextureCoordinates[2].Reserve(Num);
-			if (VOXEL_MATERIAL_ENABLE_UV2) Buffer.TextureCoordinates[3].Reserve(Num);
-			if (VOXEL_MATERIAL_ENABLE_UV3) Buffer.TextureCoordinates[4].Reserve(Num);
+			FPool::Allocate(Buffer.TextureCoordinates[0], Num);
+			if (VOXEL_MATERIAL_ENABLE_UV0) FPool::Allocate(Buffer.TextureCoordinates[1], Num);
+			if (VOXEL_MATERIAL_ENABLE_UV1) FPool::Allocate(Buffer.TextureCoordinates[2], Num);
+			if (VOXEL_MATERIAL_ENABLE_UV2) FPool::Allocate(Buffer.TextureCoordinates[3], Num);
+			if (VOXEL_MATERIAL_ENABLE_UV3) FPool::Allocate(Buffer.TextureCoordinates[4], Num);
 		}
 	}
 }
@@ -181,9 +238,10 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesherUtilities::CreateChunkFromVertices(
 		Chunk->SetIsSingle(true);
 		FVoxelChunkMeshBuffers& Buffers = Chunk->CreateSingleBuffers();
 
+		// No need to copy the indices, they are used as-is
 		Buffers.Indices = MoveTemp(Indices);
 
-		ReserveBuffer(Buffers, Vertices.Num(), Settings, EVoxelMaterialConfig::RGB);
+		ReserveBuffer(Buffers, Vertices.Num(), 0, Settings, EVoxelMaterialConfig::RGB);
 		for (auto& Vertex : Vertices)
 		{
 			AddVertexToBuffer(Vertex, Buffers, Settings, EVoxelMaterialConfig::RGB);
@@ -193,6 +251,17 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesherUtilities::CreateChunkFromVertices(
 	{
 		Chunk->SetIsSingle(false);
 
+		// Count the triangles of each material, so that each buffer is only reserved for its own data
+		TVoxelStaticArray<int32, 256> NumIndicesPerMaterial{ ForceInit };
+		for (int32 I = 0; I < Indices.Num(); I += 3)
+		{
+			const uint8 MaterialIndexToUse = FMath::Min3(
+				Vertices[Indices[I + 0]].Material.GetSingleIndex(),
+				Vertices[Indices[I + 1]].Material.GetSingleIndex(),
+				Vertices[Indices[I + 2]].Material.GetSingleIndex());
+			NumIndicesPerMaterial[MaterialIndexToUse] += 3;
+		}
+
 		TVoxelStaticArray<TMap<int32, int32>, 256> IndicesMaps{ ForceInit };
 		for (int32 I = 0; I < Indices.Num(); I += 3)
 		{
@@ -216,12 +285,16 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesherUtilities::CreateChunkFromVertices(
 
 			bool bAdded;
 			FVoxelChunkMeshBuffers& Buffer = Chunk->FindOrAddBuffer(MaterialIndices, bAdded);
+			TMap<int32, int32>& IndicesMap = IndicesMaps[MaterialIndexToUse];
 			if (bAdded)
 			{
-				ReserveBuffer(Buffer, Vertices.Num(), Settings, EVoxelMaterialConfig::SingleIndex);
+				const int32 NumIndices = NumIndicesPerMaterial[MaterialIndexToUse];
+				// Vertices can be shared between triangles: this is an upper bound
+				const int32 NumVertices = FMath::Min(NumIndices, Vertices.Num());
+				ReserveBuffer(Buffer, NumVertices, NumIndices, Settings, EVoxelMaterialConfig::SingleIndex);
+				IndicesMap.Reserve(NumVertices);
 			}
-			
-			TMap<int32, int32>& IndicesMap = IndicesMaps[MaterialIndexToUse];
+
 
 			const auto AddVertex = [&](int32 Index, const FVoxelMesherVertex& Vertex)
 			{
@@ -327,12 +400,13 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelMesherUtilities::CreateChunkFromVertices(
 				bool bAdded;
 				FVoxelChunkMeshBuffers& Buffer = Chunk->FindOrAddBuffer(VoxelMaterialIndices, bAdded);
 				check(bAdded);
-				ReserveBuffer(Buffer, Vertices.Num(), Settings, EVoxelMaterialConfig::MultiIndex);
+				ReserveBuffer(Buffer, Vertices.Num(), 0, Settings, EVoxelMaterialConfig::MultiIndex);
 
 				return Buffer;
 			};
 			FVoxelChunkMeshBuffers& Buffer = MakeBuffer();
 
+			// Single buffer: no need to copy the indices
 			Buffer.Indices = MoveTemp(Indices);
 
 			for (const FVoxelMesherVertex& Vertex : Vertices)
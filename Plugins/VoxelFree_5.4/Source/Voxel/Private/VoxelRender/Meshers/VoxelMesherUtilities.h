@@ -6,10 +6,14 @@
 #include "VoxelEnums.h"
 #include "VoxelMaterial.h"
 #include "VoxelDirection.h"
+#include "VoxelIntBox.h"
 #include "VoxelRender/VoxelProcMeshTangent.h"
 
 struct FVoxelRendererSettings;
 struct FVoxelChunkMesh;
+class FVoxelData;
+template<typename T>
+class TVoxelQueryZone;
 
 struct FVoxelMesherVertex
 {
@@ -20,6 +24,47 @@ struct FVoxelMesherVertex
 	FVoxelMaterial Material;
 };
 
+// Materials of a box of a chunk, queried all at once instead of one accelerator lookup per vertex
+class FVoxelMesherMaterialGrid
+{
+public:
+	// LocalBounds is relative to the chunk position and must be aligned on the LOD step
+	void Query(const FVoxelData& Data, const FIntVector& ChunkPosition, int32 LOD, const FVoxelIntBox& LocalBounds);
+	// Same as Query, but also queries ValueQueryZone in the same pass (see FVoxelData::GetValuesAndMaterials)
+	// LocalBounds translated by ChunkPosition must be inside ValueQueryZone
+	void QueryWithValues(const FVoxelData& Data, const FIntVector& ChunkPosition, int32 LOD, const FVoxelIntBox& LocalBounds, TVoxelQueryZone<FVoxelValue>& ValueQueryZone);
+
+	// If true, the meshers query the materials of the whole chunk with the values
+	// Else, they only query the materials around the surface once the geometry is done
+	static bool ShouldQueryWithValues();
+
+	FORCEINLINE int32 Num() const
+	{
+		return Materials.Num();
+	}
+	FORCEINLINE bool Contains(const FIntVector& LocalPosition) const
+	{
+		return
+			Materials.Num() > 0 &&
+			Bounds.Contains(LocalPosition) &&
+			((LocalPosition.X | LocalPosition.Y | LocalPosition.Z) & (Step - 1)) == 0;
+	}
+	FORCEINLINE FVoxelMaterial Get(const FIntVector& LocalPosition) const
+	{
+		checkVoxelSlow(Contains(LocalPosition));
+		const FIntVector Position = (LocalPosition - Bounds.Min) / Step;
+		return Materials[Position.X + Position.Y * Size.X + Position.Z * Size.X * Size.Y];
+	}
+
+private:
+	FVoxelIntBox Bounds;
+	FIntVector Size = FIntVector::ZeroValue;
+	int32 Step = 1;
+	TArray<FVoxelMaterial> Materials;
+
+	void Allocate(int32 LOD, const FVoxelIntBox& LocalBounds);
+};
+
 namespace FVoxelMesherUtilities
 {
 	TVoxelSharedPtr<FVoxelChunkMesh> CreateChunkFromVertices(
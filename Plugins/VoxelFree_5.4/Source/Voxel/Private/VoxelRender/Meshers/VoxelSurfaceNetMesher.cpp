@@ -40,7 +40,7 @@ struct FVoxelSurfaceNetFullVertex : FVoxelMesherVertex
 };
 static_assert(sizeof(FVoxelSurfaceNetFullVertex) == sizeof(FVoxelMesherVertex), "");
 
-struct FVoxelSurfaceNetGeometryVertex : FVector
+struct FVoxelSurfaceNetGeometryVertex : FVector3f
 {
 	static constexpr bool bComputeParentPosition = false;
 	static constexpr bool bComputeNormal = false;
@@ -49,7 +49,7 @@ struct FVoxelSurfaceNetGeometryVertex : FVector
 	
 	FORCEINLINE void SetPosition(const FVector& InPosition)
 	{
-		static_cast<FVector&>(*this) = InPosition;
+		static_cast<FVector3f&>(*this) = FVector3f(InPosition);
 	}
 	FORCEINLINE void SetParentPosition(const FVector& InParentPosition)
 	{
@@ -68,17 +68,7 @@ struct FVoxelSurfaceNetGeometryVertex : FVector
 		checkVoxelSlow(false);
 	}
 };
-static_assert(sizeof(FVoxelSurfaceNetGeometryVertex) == sizeof(FVector), "");
-
-FVoxelIntBox FVoxelSurfaceNetMesher::GetBoundsToCheckIsEmptyOn() const
-{
-	return FVoxelIntBox(ChunkPosition, ChunkPosition + SN_EXTENDED_CHUNK_SIZE * Step);
-}
-
-FVoxelIntBox FVoxelSurfaceNetMesher::GetBoundsToLock() const
-{
-	return GetBoundsToCheckIsEmptyOn();
-}
+static_assert(sizeof(FVoxelSurfaceNetGeometryVertex) == sizeof(FVector3f), "");
 
 inline float SampleIsoValue(const float Values[8], const FVector& Offset)
 {
@@ -105,16 +95,170 @@ inline FVector GetNormal(const float Values[8], const FVector& Offset)
 	return FVector(MaxX - MinX, MaxY - MinY, MaxZ - MinZ).GetSafeNormal();
 }
 
-template<typename TVertex>
-void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<TVertex>& Vertices)
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelSurfaceNetCells::ComputeEdgeFactors(FVoxelMesherTimes& Times, int32 LX, int32 LY, int32 LZ)
 {
-	VOXEL_ASYNC_FUNCTION_COUNTER();
+	constexpr uint32 Offsets[3] = { 1, SN_EXTENDED_CHUNK_SIZE, SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE };
+	const FIntVector icorners[3] = { {1,0,0},{0,1,0},{0,0,1} };
+
+	const int32 LOD = Mesher.LOD;
+	const int32 Step = Mesher.Step;
+
+	const uint32 VoxelIndex = LX + LY * SN_EXTENDED_CHUNK_SIZE + LZ * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+	const FVoxelValue MinCornerValue = CachedValues[VoxelIndex];
+	FIntVector MinCornerPosition = FIntVector(LX, LY, LZ) * Step;
+	FIntVector MaxCornerPositions = FIntVector(LX + 1, LY + 1, LZ + 1);
+
+	for (uint32 Direction = 0; Direction < 3; Direction++)
+	{
+		float Factor = -1; // empty value, valid factor should be between 0 and 1
+		if (MaxCornerPositions[Direction] < SN_EXTENDED_CHUNK_SIZE) // don't go outside of the cached area
+		{
+			const FVoxelValue MaxCornerInDirectionValue = CachedValues[VoxelIndex + Offsets[Direction]];
+			if (MinCornerValue.IsEmpty() != MaxCornerInDirectionValue.IsEmpty())
+			{
+				FVoxelValue MinValue = MinCornerValue;
+				FVoxelValue MaxValue = MaxCornerInDirectionValue;
+
+				if (LOD != 0)
+				{
+					// for LOD chunks, search along the edge for the actual intersecting segment
+					FIntVector MinPosition = MinCornerPosition;
+					FIntVector MaxPosition = MinCornerPosition + icorners[Direction] * Step;
+					float c1 = 0;
+					float c2 = 1;
+					for (int iStep = Step; iStep > 1; iStep >>= 1)
+					{
+						const float cmid = (c1 + c2) * 0.5f;
+						const FIntVector MidPosition = (MinPosition + MaxPosition) / 2;
+						const FVoxelValue MidValue = MESHER_TIME_RETURN_VALUES(1, Accelerator->Get<FVoxelValue>(MidPosition + Mesher.ChunkPosition, LOD));
+						if (MinValue.IsEmpty() != MidValue.IsEmpty())//intersection is between c1 and cmid
+						{
+							c2 = cmid;
+							MaxValue = MidValue;
+							MaxPosition = MidPosition;
+						}
+						else //intersection is between cmid and c2
+						{
+							c1 = cmid;
+							MinValue = MidValue;
+							MinPosition = MidPosition;
+						}
+					}
+					// TODO is this needed
+					Factor = c1 + (c2 - c1) * MinValue.ToFloat() / (MinValue.ToFloat() - MaxValue.ToFloat());
+				}
+				else
+				{
+					Factor = MinValue.ToFloat() / (MinValue.ToFloat() - MaxValue.ToFloat());
+				}
+			}
+		}
+		EdgeFactors[3 * VoxelIndex + Direction] = Factor;
+	}
+}
+
+void FVoxelSurfaceNetCells::ComputeMaterialPosition(int32 LX, int32 LY, int32 LZ)
+{
+	const uint32 VoxelIndex = LX + LY * SN_EXTENDED_CHUNK_SIZE + LZ * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+
+	// We need to find the min value that's a surface value
+	if (LX < SN_EXTENDED_CHUNK_SIZE - 1 &&
+		LY < SN_EXTENDED_CHUNK_SIZE - 1 &&
+		LZ < SN_EXTENDED_CHUNK_SIZE - 1)
+	{
+		FVoxelValue VoxelValues[8];
+		VoxelValues[0] = CachedValues[VoxelIndex];
+		VoxelValues[1] = CachedValues[VoxelIndex + 1];
+		VoxelValues[2] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE];
+		VoxelValues[3] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE + 1];
+		VoxelValues[4] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
+		VoxelValues[5] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1];
+		VoxelValues[6] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
+		VoxelValues[7] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1];
+
+		FVoxelValue MinValue = FVoxelValue::Empty();
+		int32 MinValueIndex = 0;
+
+		for (int32 Index = 0; Index < 8; Index++)
+		{
+			if (VoxelValues[Index] > MinValue)
+			{
+				continue;
+			}
+			bool bIsSurfaceValue = false;
+			for (int32 Neighbor = 0; Neighbor < 3; Neighbor++)
+			{
+				const int32 NeighborIndex = Index ^ (1 << Neighbor);
+				if (VoxelValues[Index].IsEmpty() != VoxelValues[NeighborIndex].IsEmpty())
+				{
+					bIsSurfaceValue = true;
+					break;
+				}
+			}
+			if (!bIsSurfaceValue)
+			{
+				continue;
+			}
+			MinValue = VoxelValues[Index];
+			MinValueIndex = Index;
+		}
 
-	TVoxelQueryZone<FVoxelValue> QueryZone(GetBoundsToCheckIsEmptyOn(), FIntVector(SN_EXTENDED_CHUNK_SIZE), LOD, CachedValues);
-	MESHER_TIME_VALUES(SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE, Data.Get<FVoxelValue>(QueryZone, LOD));
+		MaterialPositions[VoxelIndex] =
+		{
+			LX + bool(MinValueIndex & 0x1),
+			LY + bool(MinValueIndex & 0x2),
+			LZ + bool(MinValueIndex & 0x4)
+		};
 
-	Accelerator = MakeUnique<FVoxelConstDataAccelerator>(Data, GetBoundsToLock());
+		bool bHasSurface = false;
+		for (int32 Index = 1; Index < 8; Index++)
+		{
+			bHasSurface |= VoxelValues[Index].IsEmpty() != VoxelValues[0].IsEmpty();
+		}
+		if (bHasSurface)
+		{
+			MaterialsMin = FVoxelUtilities::ComponentMin(MaterialsMin, MaterialPositions[VoxelIndex]);
+			MaterialsMax = FVoxelUtilities::ComponentMax(MaterialsMax, MaterialPositions[VoxelIndex]);
+		}
+	}
+	else
+	{
+		MaterialPositions[VoxelIndex] = { LX, LY, LZ };
+	}
+}
 
+void FVoxelSurfaceNetCells::QueryMaterials(FVoxelMesherTimes& Times)
+{
+	if (MaterialGrid.Num() > 0)
+	{
+		// Already queried with the values
+		return;
+	}
+	if (MaterialsMin.X > MaterialsMax.X)
+	{
+		// No surface
+		return;
+	}
+
+	const int32 LOD = Mesher.LOD;
+	const int32 Step = Mesher.Step;
+
+	const FVoxelIntBox MaterialsBounds(MaterialsMin * Step, (MaterialsMax + FIntVector(1)) * Step);
+	MESHER_TIME_MATERIALS(MaterialsBounds.Count() >> (3 * LOD), MaterialGrid.Query(Mesher.Data, Mesher.ChunkPosition, LOD, MaterialsBounds));
+}
+
+template<typename TVertex>
+bool FVoxelSurfaceNetCells::CreateVertex(
+	FVoxelMesherTimes& Times,
+	int32 LX, int32 LY, int32 LZ,
+	TVertex& OutVertex,
+	uint8& OutSurfaceNetsCase,
+	FVector* OutParentPosition) const
+{
 	constexpr uint32 EdgeIndexOffsets[12] =
 	{
 		0,
@@ -163,7 +307,7 @@ void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TA
 	constexpr uint32 EdgeFirstCornerIndex[12] = { 0, 2, 4, 6, 0, 1, 4, 5, 0, 1, 2, 3 };
 	constexpr uint32 EdgeSecondCornerIndex[12] = { 1, 3, 5, 7, 2, 3, 6, 7, 4, 5, 6, 7 };
 	// TODO: Replace buffer by simple math
-	const FVector Corners[8] =
+	static const FVector Corners[8] =
 	{
 		{0,0,0},
 		{1,0,0},
@@ -174,7 +318,7 @@ void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TA
 		{0,1,1},
 		{1,1,1}
 	};
-	const FVector ParentCorners[8] =
+	static const FVector ParentCorners[8] =
 	{
 		{0,0,0},
 		{2,0,0},
@@ -185,8 +329,182 @@ void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TA
 		{0,2,2},
 		{2,2,2}
 	};
-	constexpr uint32 Offsets[3] = { 1, SN_EXTENDED_CHUNK_SIZE, SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE };
-	const FIntVector icorners[3] = { {1,0,0},{0,1,0},{0,0,1} };
+
+	const int32 Step = Mesher.Step;
+
+	const uint32 VoxelIndex = LX + LY * SN_EXTENDED_CHUNK_SIZE + LZ * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+
+	uint32 VoxelIndices[8];
+	VoxelIndices[0] = VoxelIndex;
+	VoxelIndices[1] = VoxelIndex + 1;
+	VoxelIndices[2] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE;
+	VoxelIndices[3] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE + 1;
+	VoxelIndices[4] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+	VoxelIndices[5] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1;
+	VoxelIndices[6] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+	VoxelIndices[7] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1;
+
+	FVoxelValue VoxelValues[8];
+	VoxelValues[0] = CachedValues[VoxelIndices[0]];
+	VoxelValues[1] = CachedValues[VoxelIndices[1]];
+	VoxelValues[2] = CachedValues[VoxelIndices[2]];
+	VoxelValues[3] = CachedValues[VoxelIndices[3]];
+	VoxelValues[4] = CachedValues[VoxelIndices[4]];
+	VoxelValues[5] = CachedValues[VoxelIndices[5]];
+	VoxelValues[6] = CachedValues[VoxelIndices[6]];
+	VoxelValues[7] = CachedValues[VoxelIndices[7]];
+
+	const uint32 MarchingCubesCase =
+		(VoxelValues[0].IsEmpty() << 0) |
+		(VoxelValues[1].IsEmpty() << 1) |
+		(VoxelValues[2].IsEmpty() << 2) |
+		(VoxelValues[3].IsEmpty() << 3) |
+		(VoxelValues[4].IsEmpty() << 4) |
+		(VoxelValues[5].IsEmpty() << 5) |
+		(VoxelValues[6].IsEmpty() << 6) |
+		(VoxelValues[7].IsEmpty() << 7);
+
+	OutSurfaceNetsCase =
+		(VoxelValues[3].IsEmpty() << 0) |
+		(VoxelValues[5].IsEmpty() << 1) |
+		(VoxelValues[6].IsEmpty() << 2) |
+		(VoxelValues[7].IsEmpty() << 3);
+
+	if ((MarchingCubesCase == 0) || (MarchingCubesCase == 255)) //cell is empty
+	{
+		return false;
+	}
+
+	float VoxelFloats[8];
+	VoxelFloats[0] = VoxelValues[0].ToFloat();
+	VoxelFloats[1] = VoxelValues[1].ToFloat();
+	VoxelFloats[2] = VoxelValues[2].ToFloat();
+	VoxelFloats[3] = VoxelValues[3].ToFloat();
+	VoxelFloats[4] = VoxelValues[4].ToFloat();
+	VoxelFloats[5] = VoxelValues[5].ToFloat();
+	VoxelFloats[6] = VoxelValues[6].ToFloat();
+	VoxelFloats[7] = VoxelValues[7].ToFloat();
+
+	const uint32 VoxelEdgeIndex = VoxelIndex * 3;
+	FVector CrossingTotal = FVector(0, 0, 0);
+	uint32 CrossingCount = 0;
+
+	constexpr int32 RemoveFirstBit = 0xFFFE; // TODO: what if more than 64k vertices
+	const FIntVector ParentPosition((LX & RemoveFirstBit), (LY & RemoveFirstBit), (LZ & RemoveFirstBit));
+	const uint32 ParentVoxelIndex = ParentPosition.X + ParentPosition.Y * SN_EXTENDED_CHUNK_SIZE + ParentPosition.Z * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+	const uint32 ParentVoxelEdgeIndex = ParentVoxelIndex * 3;
+	FVector ParentCrossingTotal = FVector(0, 0, 0);
+	uint32 ParentCrossingCount = 0;
+
+	for (uint32 Edge = 0; Edge < 12; Edge++)
+	{
+		// if this edge has a crossing, find the point and add it to the avg total, increment count
+		const float EdgeFactor = EdgeFactors[VoxelEdgeIndex + EdgeIndexOffsets[Edge]];
+		if (EdgeFactor >= 0)
+		{
+			const FVector MinPosition = Corners[EdgeFirstCornerIndex[Edge]];
+			const FVector MaxPosition = Corners[EdgeSecondCornerIndex[Edge]];
+			const FVector MidPosition = FMath::Lerp(MinPosition, MaxPosition, EdgeFactor); // blend between corners
+			CrossingTotal += MidPosition;
+			CrossingCount++;
+		}
+
+		// find crossings of parent cell
+		const float ParentEdgeFactorMin = EdgeFactors[ParentVoxelEdgeIndex + ParentEdgeIndexOffsetsMin[Edge]];
+		const float ParentEdgeFactorMax = EdgeFactors[ParentVoxelEdgeIndex + ParentEdgeIndexOffsetsMax[Edge]];
+		if ((ParentEdgeFactorMin >= 0) || (ParentEdgeFactorMax >= 0))
+		{
+			const float ParentEdgeFactor =
+				((ParentEdgeFactorMin >= 0) ? 0.5f * ParentEdgeFactorMin : 0.5f) +
+				((ParentEdgeFactorMax >= 0) ? 0.5f * ParentEdgeFactorMax : 0);
+			const FVector MinPosition = ParentCorners[EdgeFirstCornerIndex[Edge]];
+			const FVector MaxPosition = ParentCorners[EdgeSecondCornerIndex[Edge]];
+			const FVector MidPosition = FMath::Lerp(MinPosition, MaxPosition, ParentEdgeFactor); // blend between corners
+			ParentCrossingTotal += MidPosition;
+			ParentCrossingCount++;
+		}
+	}
+
+	ensureVoxelSlowNoSideEffects(CrossingCount > 0);
+	const FVector Offset = CrossingTotal / CrossingCount;
+
+	const FVector ParentOffset = ParentCrossingCount == 0 ? FVector::ZeroVector : ParentCrossingTotal / ParentCrossingCount;
+
+
+	const FIntVector CellPosition(LX * Step, LY * Step, LZ * Step);
+	const FVector CornerPosition{ CellPosition };
+	const FVector FinalPosition = CornerPosition + Offset * Step;
+
+	const FIntVector ParentCellPosition = ParentPosition * Step;
+	const FVector ParentCornerPosition{ ParentCellPosition };
+	const FVector ParentFinalPosition = ParentCornerPosition + ParentOffset * Step;
+
+	if (OutParentPosition)
+	{
+		*OutParentPosition = ParentFinalPosition;
+	}
+
+	OutVertex.SetPosition(FinalPosition);
+	if (TVertex::bComputeParentPosition)
+	{
+		OutVertex.SetParentPosition((ParentFinalPosition - FinalPosition) / Step); // Divide by Step to avoid overflowing the tangent
+	}
+	if (TVertex::bComputeNormal)
+	{
+		OutVertex.SetNormal(MESHER_TIME_RETURN(Normals, GetNormal(VoxelFloats, Offset)));
+	}
+	if (TVertex::bComputeMaterial)
+	{
+		OutVertex.SetMaterial(MaterialGrid.Get(MaterialPositions[VoxelIndex] * Step));
+	}
+	if (TVertex::bComputeTextureCoordinate)
+	{
+		OutVertex.SetTextureCoordinate(MESHER_TIME_RETURN(UVs, FVoxelMesherUtilities::GetUVs(Mesher, FinalPosition)));
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelIntBox FVoxelSurfaceNetMesher::GetBoundsToCheckIsEmptyOn() const
+{
+	return FVoxelSurfaceNetCells::GetBounds(*this);
+}
+
+FVoxelIntBox FVoxelSurfaceNetMesher::GetBoundsToLock() const
+{
+	return GetBoundsToCheckIsEmptyOn();
+}
+
+template<typename TVertex>
+void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<TVertex>& Vertices)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	TVoxelQueryZone<FVoxelValue> QueryZone(GetBoundsToCheckIsEmptyOn(), FIntVector(SN_EXTENDED_CHUNK_SIZE), LOD, Cells.CachedValues);
+	if (TVertex::bComputeMaterial && FVoxelMesherMaterialGrid::ShouldQueryWithValues())
+	{
+		// Generate the materials in the same pass as the values. All the material positions are inside the values bounds
+#if ENABLE_MESHER_STATS
+		// The time is counted with the values
+		Times._MaterialsAccesses += SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
+#endif
+		MESHER_TIME_VALUES(
+			SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE,
+			Cells.MaterialGrid.QueryWithValues(Data, ChunkPosition, LOD, GetBoundsToCheckIsEmptyOn().Translate(-ChunkPosition), QueryZone));
+	}
+	else
+	{
+		MESHER_TIME_VALUES(SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE, Data.Get<FVoxelValue>(QueryZone, LOD));
+	}
+
+	if (LOD != 0)
+	{
+		Cells.Accelerator = MakeUnique<FVoxelConstDataAccelerator>(Data, GetBoundsToLock());
+	}
 
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("Find Intersections");
@@ -198,120 +516,23 @@ void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TA
 			{
 				for (int32 LX = 0; LX < SN_EXTENDED_CHUNK_SIZE; LX++)
 				{
-					const uint32 VoxelIndex = LX + LY * SN_EXTENDED_CHUNK_SIZE + LZ * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
-					const FVoxelValue MinCornerValue = CachedValues[VoxelIndex];
-					FIntVector MinCornerPosition = FIntVector(LX, LY, LZ) * Step;
-					FIntVector MaxCornerPositions = FIntVector(LX + 1, LY + 1, LZ + 1);
+					Cells.ComputeEdgeFactors(Times, LX, LY, LZ);
 
-					for (uint32 Direction = 0; Direction < 3; Direction++)
-					{
-						float Factor = -1; // empty value, valid factor should be between 0 and 1
-						if (MaxCornerPositions[Direction] < SN_EXTENDED_CHUNK_SIZE) // don't go outside of the cached area
-						{
-							const FVoxelValue MaxCornerInDirectionValue = CachedValues[VoxelIndex + Offsets[Direction]];
-							if (MinCornerValue.IsEmpty() != MaxCornerInDirectionValue.IsEmpty())
-							{
-								FVoxelValue MinValue = MinCornerValue;
-								FVoxelValue MaxValue = MaxCornerInDirectionValue;
-
-								if (LOD != 0)
-								{
-									// for LOD chunks, search along the edge for the actual intersecting segment
-									FIntVector MinPosition = MinCornerPosition;
-									FIntVector MaxPosition = MinCornerPosition + icorners[Direction] * Step;
-									float c1 = 0;
-									float c2 = 1;
-									for (int iStep = Step; iStep > 1; iStep >>= 1)
-									{
-										const float cmid = (c1 + c2) * 0.5f;
-										const FIntVector MidPosition = (MinPosition + MaxPosition) / 2;
-										const FVoxelValue MidValue = MESHER_TIME_RETURN_VALUES(1, Accelerator->Get<FVoxelValue>(MidPosition + ChunkPosition, LOD));
-										if (MinValue.IsEmpty() != MidValue.IsEmpty())//intersection is between c1 and cmid
-										{
-											c2 = cmid;
-											MaxValue = MidValue;
-											MaxPosition = MidPosition;
-										}
-										else //intersection is between cmid and c2
-										{
-											c1 = cmid;
-											MinValue = MidValue;
-											MinPosition = MidPosition;
-										}
-									}
-									// TODO is this needed
-									Factor = c1 + (c2 - c1) * MinValue.ToFloat() / (MinValue.ToFloat() - MaxValue.ToFloat());
-								}
-								else
-								{
-									Factor = MinValue.ToFloat() / (MinValue.ToFloat() - MaxValue.ToFloat());
-								}
-							}
-						}
-						EdgeFactors[3 * VoxelIndex + Direction] = Factor;
-					}
-					
 					if (TVertex::bComputeMaterial)
 					{
-						// We need to find the min value that's a surface value
-						if (LX < SN_EXTENDED_CHUNK_SIZE - 1 && 
-							LY < SN_EXTENDED_CHUNK_SIZE - 1 &&
-							LZ < SN_EXTENDED_CHUNK_SIZE - 1)
-						{
-							FVoxelValue VoxelValues[8];
-							VoxelValues[0] = CachedValues[VoxelIndex];
-							VoxelValues[1] = CachedValues[VoxelIndex + 1];
-							VoxelValues[2] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE];
-							VoxelValues[3] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE + 1];
-							VoxelValues[4] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
-							VoxelValues[5] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1];
-							VoxelValues[6] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
-							VoxelValues[7] = CachedValues[VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1];
-							
-							FVoxelValue MinValue = FVoxelValue::Empty();
-							int32 MinValueIndex = 0;
-							
-							for (int32 Index = 0; Index < 8; Index++)
-							{
-								if (VoxelValues[Index] > MinValue)
-								{
-									continue;
-								}
-								bool bIsSurfaceValue = false;
-								for (int32 Neighbor = 0; Neighbor < 3; Neighbor++)
-								{
-									const int32 NeighborIndex = Index ^ (1 << Neighbor);
-									if (VoxelValues[Index].IsEmpty() != VoxelValues[NeighborIndex].IsEmpty())
-									{
-										bIsSurfaceValue = true;
-										break;
-									}
-								}
-								if (!bIsSurfaceValue)
-								{
-									continue;
-								}
-								MinValue = VoxelValues[Index];
-								MinValueIndex = Index;
-							}
-							
-							MaterialPositions[VoxelIndex] = 
-							{
-								LX + bool(MinValueIndex & 0x1),
-								LY + bool(MinValueIndex & 0x2),
-								LZ + bool(MinValueIndex & 0x4)
-							};
-						}
-						else
-						{
-							MaterialPositions[VoxelIndex] = { LX, LY, LZ };
-						}
+						Cells.ComputeMaterialPosition(LX, LY, LZ);
 					}
 				}
 			}
 		}
 	}
 
+	if (TVertex::bComputeMaterial)
+	{
+		// Query all the materials used by the vertices at once
+		Cells.QueryMaterials(Times);
+	}
+
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("Generate Vertices");
 
@@ -322,139 +543,17 @@ void FVoxelSurfaceNetMesher::CreateGeometryTemplate(FVoxelMesherTimes& Times, TA
 			{
 				for (uint32 LX = 0; LX < SN_CHUNK_SIZE; LX++)
 				{
-					const uint32 VoxelIndex = LX + LY * SN_EXTENDED_CHUNK_SIZE + LZ * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
 					const uint32 VertexIndex = LX + LY * SN_CHUNK_SIZE + LZ * SN_CHUNK_SIZE * SN_CHUNK_SIZE;
 
-					uint32 VoxelIndices[8];
-					VoxelIndices[0] = VoxelIndex;
-					VoxelIndices[1] = VoxelIndex + 1;
-					VoxelIndices[2] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE;
-					VoxelIndices[3] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE + 1;
-					VoxelIndices[4] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
-					VoxelIndices[5] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1;
-					VoxelIndices[6] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
-					VoxelIndices[7] = VoxelIndex + SN_EXTENDED_CHUNK_SIZE + SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE + 1;
-
-					FVoxelValue VoxelValues[8];
-					VoxelValues[0] = CachedValues[VoxelIndices[0]];
-					VoxelValues[1] = CachedValues[VoxelIndices[1]];
-					VoxelValues[2] = CachedValues[VoxelIndices[2]];
-					VoxelValues[3] = CachedValues[VoxelIndices[3]];
-					VoxelValues[4] = CachedValues[VoxelIndices[4]];
-					VoxelValues[5] = CachedValues[VoxelIndices[5]];
-					VoxelValues[6] = CachedValues[VoxelIndices[6]];
-					VoxelValues[7] = CachedValues[VoxelIndices[7]];
-
-					float VoxelFloats[8];
-					VoxelFloats[0] = VoxelValues[0].ToFloat();
-					VoxelFloats[1] = VoxelValues[1].ToFloat();
-					VoxelFloats[2] = VoxelValues[2].ToFloat();
-					VoxelFloats[3] = VoxelValues[3].ToFloat();
-					VoxelFloats[4] = VoxelValues[4].ToFloat();
-					VoxelFloats[5] = VoxelValues[5].ToFloat();
-					VoxelFloats[6] = VoxelValues[6].ToFloat();
-					VoxelFloats[7] = VoxelValues[7].ToFloat();
-
-					const uint32 MarchingCubesCase =
-						(VoxelValues[0].IsEmpty() << 0) |
-						(VoxelValues[1].IsEmpty() << 1) |
-						(VoxelValues[2].IsEmpty() << 2) |
-						(VoxelValues[3].IsEmpty() << 3) |
-						(VoxelValues[4].IsEmpty() << 4) |
-						(VoxelValues[5].IsEmpty() << 5) |
-						(VoxelValues[6].IsEmpty() << 6) |
-						(VoxelValues[7].IsEmpty() << 7);
-
-					const uint8 SurfaceNetsCase =
-						(VoxelValues[3].IsEmpty() << 0) |
-						(VoxelValues[5].IsEmpty() << 1) |
-						(VoxelValues[6].IsEmpty() << 2) |
-						(VoxelValues[7].IsEmpty() << 3);
-
-					VertexSNCases[VertexIndex] = SurfaceNetsCase;
-
-					if ((MarchingCubesCase == 0) || (MarchingCubesCase == 255)) //cell is empty
-					{
-						VertexIndices[VertexIndex] = -1;
-						continue;
-					}
-
-					VertexIndices[VertexIndex] = Vertices.Num();
-
-
-					const uint32 VoxelEdgeIndex = VoxelIndex * 3;
-					FVector CrossingTotal = FVector(0, 0, 0);
-					uint32 CrossingCount = 0;
-
-					constexpr int32 RemoveFirstBit = 0xFFFE; // TODO: what if more than 64k vertices
-					const FIntVector ParentPosition((LX & RemoveFirstBit), (LY & RemoveFirstBit), (LZ & RemoveFirstBit));
-					const uint32 ParentVoxelIndex = ParentPosition.X + ParentPosition.Y * SN_EXTENDED_CHUNK_SIZE + ParentPosition.Z * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE;
-					const uint32 ParentVoxelEdgeIndex = ParentVoxelIndex * 3;
-					FVector ParentCrossingTotal = FVector(0, 0, 0);
-					uint32 ParentCrossingCount = 0;
-
-					for (uint32 Edge = 0; Edge < 12; Edge++)
-					{
-						// if this edge has a crossing, find the point and add it to the avg total, increment count
-						const float EdgeFactor = EdgeFactors[VoxelEdgeIndex + EdgeIndexOffsets[Edge]];
-						if (EdgeFactor >= 0)
-						{
-							const FVector MinPosition = Corners[EdgeFirstCornerIndex[Edge]];
-							const FVector MaxPosition = Corners[EdgeSecondCornerIndex[Edge]];
-							const FVector MidPosition = FMath::Lerp(MinPosition, MaxPosition, EdgeFactor); // blend between corners
-							CrossingTotal += MidPosition;
-							CrossingCount++;
-						}
-
-						// find crossings of parent cell
-						const float ParentEdgeFactorMin = EdgeFactors[ParentVoxelEdgeIndex + ParentEdgeIndexOffsetsMin[Edge]];
-						const float ParentEdgeFactorMax = EdgeFactors[ParentVoxelEdgeIndex + ParentEdgeIndexOffsetsMax[Edge]];
-						if ((ParentEdgeFactorMin >= 0) || (ParentEdgeFactorMax >= 0))
-						{
-							const float ParentEdgeFactor =
-								((ParentEdgeFactorMin >= 0) ? 0.5f * ParentEdgeFactorMin : 0.5f) +
-								((ParentEdgeFactorMax >= 0) ? 0.5f * ParentEdgeFactorMax : 0);
-							const FVector MinPosition = ParentCorners[EdgeFirstCornerIndex[Edge]];
-							const FVector MaxPosition = ParentCorners[EdgeSecondCornerIndex[Edge]];
-							const FVector MidPosition = FMath::Lerp(MinPosition, MaxPosition, ParentEdgeFactor); // blend between corners
-							ParentCrossingTotal += MidPosition;
-							ParentCrossingCount++;
-						}
-					}
-
-					ensureVoxelSlowNoSideEffects(CrossingCount > 0);
-					const FVector Offset = CrossingTotal / CrossingCount;
-
-					const FVector ParentOffset = ParentCrossingCount == 0 ? FVector::ZeroVector : ParentCrossingTotal / ParentCrossingCount;
-
-
-					const FIntVector CellPosition(LX * Step, LY * Step, LZ * Step);
-					const FVector CornerPosition{ CellPosition };
-					const FVector FinalPosition = CornerPosition + Offset * Step;
-
-					const FIntVector ParentCellPosition = ParentPosition * Step;
-					const FVector ParentCornerPosition{ ParentCellPosition };
-					const FVector ParentFinalPosition = ParentCornerPosition + ParentOffset * Step;
-					
 					TVertex Vertex;
-					Vertex.SetPosition(FinalPosition);
-					if (TVertex::bComputeParentPosition)
+					if (Cells.CreateVertex(Times, LX, LY, LZ, Vertex, VertexSNCases[VertexIndex]))
 					{
-						Vertex.SetParentPosition((ParentFinalPosition - FinalPosition) / Step); // Divide by Step to avoid overflowing the tangent
+						VertexIndices[VertexIndex] = Vertices.Add(Vertex);
 					}
-					if (TVertex::bComputeNormal)
+					else
 					{
-						Vertex.SetNormal(MESHER_TIME_RETURN(Normals, GetNormal(VoxelFloats, Offset)));
-					}
-					if (TVertex::bComputeMaterial)
-					{
-						Vertex.SetMaterial(MESHER_TIME_RETURN_MATERIALS(1, Accelerator->GetMaterial(MaterialPositions[VoxelIndex] * Step + ChunkPosition, LOD)));
-					}
-					if (TVertex::bComputeTextureCoordinate)
-					{
-						Vertex.SetTextureCoordinate(MESHER_TIME_RETURN(UVs, FVoxelMesherUtilities::GetUVs(*this, FinalPosition)));
+						VertexIndices[VertexIndex] = -1;
 					}
-					Vertices.Add(Vertex);
 				}
 			}
 		}
@@ -557,7 +656,194 @@ TVoxelSharedPtr<FVoxelChunkMesh> FVoxelSurfaceNetMesher::CreateFullChunkImpl(FVo
 		MoveTemp(reinterpret_cast<TArray<FVoxelMesherVertex>&>(Vertices))));
 }
 
-void FVoxelSurfaceNetMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices)
+void FVoxelSurfaceNetMesher::CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices)
 {
 	CreateGeometryTemplate(Times, Indices, reinterpret_cast<TArray<FVoxelSurfaceNetGeometryVertex>&>(Vertices));
-}
\ No newline at end of file
+}
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelIntBox FVoxelSurfaceNetTransitionsMesher::GetBoundsToCheckIsEmptyOn() const
+{
+	return FVoxelSurfaceNetCells::GetBounds(*this);
+}
+
+FVoxelIntBox FVoxelSurfaceNetTransitionsMesher::GetBoundsToLock() const
+{
+	return GetBoundsToCheckIsEmptyOn();
+}
+
+TVoxelSharedPtr<FVoxelChunkMesh> FVoxelSurfaceNetTransitionsMesher::CreateFullChunkImpl(FVoxelMesherTimes& Times)
+{
+	// The border cells are on the plane Axis = Border: either the first or the last layer of cells
+	// Their parents are in the layers [Border, Border + 2], so we need the values in [Border, Border + 3]
+	const auto GetBorder = [](int32 Direction)
+	{
+		return (Direction & 0x1) ? RENDER_CHUNK_SIZE : 0;
+	};
+	const auto GetLayersBounds = [](int32 Direction, int32 Border, int32 NumLayers)
+	{
+		const int32 Axis = Direction / 2;
+		FIntVector Min(0);
+		FIntVector Max(SN_EXTENDED_CHUNK_SIZE);
+		Min[Axis] = Border;
+		Max[Axis] = FMath::Min(Border + NumLayers, SN_EXTENDED_CHUNK_SIZE);
+		return FVoxelIntBox(Min, Max);
+	};
+
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Query Values");
+
+		TVoxelQueryZone<FVoxelValue> QueryZone(GetBoundsToCheckIsEmptyOn(), FIntVector(SN_EXTENDED_CHUNK_SIZE), LOD, Cells.CachedValues);
+		for (int32 Direction = 0; Direction < 6; Direction++)
+		{
+			if (!(TransitionsMask & (1 << Direction))) continue;
+
+			const FVoxelIntBox LocalBounds = GetLayersBounds(Direction, GetBorder(Direction), 4);
+			auto LayersQueryZone = QueryZone.ShrinkTo(FVoxelIntBox(ChunkPosition + LocalBounds.Min * Step, ChunkPosition + LocalBounds.Max * Step));
+			MESHER_TIME_VALUES(LocalBounds.Count(), Data.Get<FVoxelValue>(LayersQueryZone, LOD));
+		}
+	}
+
+	if (LOD != 0)
+	{
+		Cells.Accelerator = MakeUnique<FVoxelConstDataAccelerator>(Data, GetBoundsToLock());
+	}
+
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Find Intersections");
+
+		for (int32 Direction = 0; Direction < 6; Direction++)
+		{
+			if (!(TransitionsMask & (1 << Direction))) continue;
+
+			const int32 Border = GetBorder(Direction);
+			const FVoxelIntBox EdgesBounds = GetLayersBounds(Direction, Border, 3);
+			EdgesBounds.Iterate([&](int32 LX, int32 LY, int32 LZ)
+			{
+				Cells.ComputeEdgeFactors(Times, LX, LY, LZ);
+			});
+
+			FIntVector CellsMax(SN_CHUNK_SIZE);
+			CellsMax[Direction / 2] = Border + 1;
+			const FVoxelIntBox CellsBounds = GetLayersBounds(Direction, Border, 1).Overlap(FVoxelIntBox(FIntVector(0), CellsMax));
+			CellsBounds.Iterate([&](int32 LX, int32 LY, int32 LZ)
+			{
+				Cells.ComputeMaterialPosition(LX, LY, LZ);
+			});
+		}
+	}
+
+	Cells.QueryMaterials(Times);
+
+	TArray<FVoxelSurfaceNetFullVertex> Vertices;
+	TArray<uint32> Indices;
+
+	for (int32 Direction = 0; Direction < 6; Direction++)
+	{
+		if (!(TransitionsMask & (1 << Direction))) continue;
+
+		VOXEL_ASYNC_SCOPE_COUNTER("Create Transitions");
+
+		const int32 Axis = Direction / 2;
+		const int32 AxisU = (Axis + 1) % 3;
+		const int32 AxisV = (Axis + 2) % 3;
+		const int32 Border = GetBorder(Direction);
+
+		FMemory::Memset(BorderVertexIndices, 0xFF, sizeof(BorderVertexIndices));
+
+		// Returns the index of the top vertex of the border cell, the parent vertex being the next one
+		const auto GetVertex = [&](int32 U, int32 V)
+		{
+			uint32& VertexIndex = BorderVertexIndices[U + V * SN_CHUNK_SIZE];
+			if (VertexIndex == uint32(-1))
+			{
+				FIntVector Position;
+				Position[Axis] = Border;
+				Position[AxisU] = U;
+				Position[AxisV] = V;
+
+				FVoxelSurfaceNetFullVertex Vertex;
+				uint8 SurfaceNetsCase;
+				FVector ParentPosition;
+				const bool bHasVertex = Cells.CreateVertex(Times, Position.X, Position.Y, Position.Z, Vertex, SurfaceNetsCase, &ParentPosition);
+				ensureVoxelSlowNoSideEffects(bHasVertex);
+
+				FVoxelSurfaceNetFullVertex ParentVertex = Vertex;
+				ParentVertex.SetPosition(ParentPosition);
+				ParentVertex.SetParentPosition(FVector::ZeroVector); // Already at the parent position
+				ParentVertex.SetTextureCoordinate(MESHER_TIME_RETURN(UVs, FVoxelMesherUtilities::GetUVs(*this, ParentPosition)));
+
+				VertexIndex = Vertices.Add(Vertex);
+				Vertices.Add(ParentVertex);
+			}
+			return VertexIndex;
+		};
+
+		// The main chunk has no quads around the edges lying on the border plane: these are the edges of its boundary
+		// For each such edge with a surface crossing, stitch the two border cells around it to their parents
+		for (int32 EdgeAxis : { AxisU, AxisV })
+		{
+			const int32 OtherAxis = EdgeAxis == AxisU ? AxisV : AxisU;
+			for (int32 EdgeCoordinate = 1; EdgeCoordinate <= RENDER_CHUNK_SIZE; EdgeCoordinate++)
+			{
+				for (int32 OtherCoordinate = 1; OtherCoordinate <= RENDER_CHUNK_SIZE; OtherCoordinate++)
+				{
+					FIntVector Position;
+					Position[Axis] = Border;
+					Position[EdgeAxis] = EdgeCoordinate;
+					Position[OtherAxis] = OtherCoordinate;
+
+					FIntVector PreviousPosition = Position;
+					PreviousPosition[EdgeAxis]--;
+
+					const auto GetValue = [&](const FIntVector& P)
+					{
+						return Cells.CachedValues[P.X + P.Y * SN_EXTENDED_CHUNK_SIZE + P.Z * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
+					};
+					if (GetValue(Position).IsEmpty() == GetValue(PreviousPosition).IsEmpty())
+					{
+						continue;
+					}
+
+					FIntVector CellA(Border);
+					CellA[EdgeAxis] = EdgeCoordinate - 1;
+					CellA[OtherAxis] = OtherCoordinate - 1;
+					FIntVector CellB = CellA;
+					CellB[OtherAxis]++;
+
+					const uint32 A = GetVertex(CellA[AxisU], CellA[AxisV]);
+					const uint32 B = GetVertex(CellB[AxisU], CellB[AxisV]);
+					const uint32 ParentA = A + 1;
+					const uint32 ParentB = B + 1;
+
+					// Orient the strip like the surface it continues
+					const FVector& PositionA = Vertices[A].Position;
+					const FVector Normal = FVector::CrossProduct(Vertices[ParentB].Position - PositionA, Vertices[B].Position - PositionA);
+					const FVector OtherNormal = FVector::CrossProduct(Vertices[ParentA].Position - PositionA, Vertices[ParentB].Position - PositionA);
+					const FVector SurfaceNormal = Vertices[A].Normal + Vertices[B].Normal;
+					const bool bFlip = FVector::DotProduct(Normal + OtherNormal, SurfaceNormal) < 0;
+
+					Indices.Add(A);
+					Indices.Add(bFlip ? ParentB : B);
+					Indices.Add(bFlip ? B : ParentB);
+
+					Indices.Add(A);
+					Indices.Add(bFlip ? ParentA : ParentB);
+					Indices.Add(bFlip ? ParentB : ParentA);
+				}
+			}
+		}
+	}
+
+	UnlockData();
+
+	FVoxelMesherUtilities::SanitizeMesh(Indices, Vertices);
+
+	return MESHER_TIME_RETURN(CreateChunk, FVoxelMesherUtilities::CreateChunkFromVertices(
+		Settings,
+		LOD,
+		MoveTemp(Indices),
+		MoveTemp(reinterpret_cast<TArray<FVoxelMesherVertex>&>(Vertices))));
+}
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "VoxelData/VoxelDataAccelerator.h"
 #include "VoxelRender/Meshers/VoxelMesher.h"
+#include "VoxelRender/Meshers/VoxelMesherUtilities.h"
 
 /**
  * This code is based on an original implementation kindly provided by Dexyfex
@@ -14,6 +15,58 @@
 #define SN_CHUNK_SIZE (RENDER_CHUNK_SIZE + 1) /* +1 since SN vertices are within cells */
 #define SN_EXTENDED_CHUNK_SIZE (RENDER_CHUNK_SIZE + 3) /* +3 to get parent's outer edge */
 
+// Values and edge intersections of a surface nets chunk
+// Shared by the main and the transitions meshers so that both create the exact same vertices
+class FVoxelSurfaceNetCells
+{
+public:
+	explicit FVoxelSurfaceNetCells(const FVoxelMesherBase& Mesher)
+		: Mesher(Mesher)
+	{
+	}
+
+	// Bounds of all the values used by a chunk
+	static FVoxelIntBox GetBounds(const FVoxelMesherBase& Mesher)
+	{
+		return FVoxelIntBox(Mesher.ChunkPosition, Mesher.ChunkPosition + SN_EXTENDED_CHUNK_SIZE * Mesher.Step);
+	}
+
+	// Find the intersections along the 3 edges starting at this voxel. Values must be queried up to +1 in every direction
+	void ComputeEdgeFactors(FVoxelMesherTimes& Times, int32 LX, int32 LY, int32 LZ);
+	// Find the voxel this cell takes its material from
+	void ComputeMaterialPosition(int32 LX, int32 LY, int32 LZ);
+	// Query the materials of all the cells passed to ComputeMaterialPosition at once
+	void QueryMaterials(FVoxelMesherTimes& Times);
+
+	// Returns false if the cell has no surface
+	// Edge factors must be computed up to +2 in every direction to find the parent position
+	template<typename TVertex>
+	bool CreateVertex(
+		FVoxelMesherTimes& Times, 
+		int32 LX, int32 LY, int32 LZ, 
+		TVertex& OutVertex, 
+		uint8& OutSurfaceNetsCase, 
+		FVector* OutParentPosition = nullptr) const;
+
+public:
+	const FVoxelMesherBase& Mesher;
+	// Only needed to search the intersections along the edges when LOD != 0
+	TUniquePtr<FVoxelConstDataAccelerator> Accelerator;
+
+	FVoxelValue CachedValues[SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
+	float EdgeFactors[SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * 3]; // edge blending factors for each cell, X,Y,Z
+
+	// The material position is detected in a first step
+	TVoxelStaticArray<FIntVector, SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE> MaterialPositions;
+	// Then all the materials are queried at once
+	FVoxelMesherMaterialGrid MaterialGrid;
+
+private:
+	// Bounds of the material positions of the cells with a surface
+	FIntVector MaterialsMin = FIntVector(MAX_int32);
+	FIntVector MaterialsMax = FIntVector(MIN_int32);
+};
+
 class FVoxelSurfaceNetMesher : public FVoxelMesher
 {
 public:
@@ -23,19 +76,38 @@ protected:
 	virtual FVoxelIntBox GetBoundsToCheckIsEmptyOn() const override final;
 	virtual FVoxelIntBox GetBoundsToLock() const override final;
 	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunkImpl(FVoxelMesherTimes& Times) override final;
-	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector>& Vertices) override final;
+	virtual void CreateGeometryImpl(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<FVector3f>& Vertices) override final;
+	virtual FVoxelChunkDistanceFieldValues GetDistanceFieldValues() const override final
+	{
+		return { Cells.CachedValues, SN_EXTENDED_CHUNK_SIZE, 0 };
+	}
 	
 private:
-	TUniquePtr<FVoxelConstDataAccelerator> Accelerator;
+	FVoxelSurfaceNetCells Cells{ *this };
 
-	FVoxelValue CachedValues[SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE];
-	float EdgeFactors[SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * 3]; // edge blending factors for each cell, X,Y,Z
 	uint32 VertexIndices[SN_CHUNK_SIZE * SN_CHUNK_SIZE * SN_CHUNK_SIZE]; // final vertex indices, per voxel. 65535 if no vertex
 	uint8 VertexSNCases[SN_CHUNK_SIZE * SN_CHUNK_SIZE * SN_CHUNK_SIZE]; // surface net voxel cases for each cell
-
-	// The material position is detected in a first step
-	TVoxelStaticArray<FIntVector, SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE * SN_EXTENDED_CHUNK_SIZE> MaterialPositions;
 	
 	template<typename TVertex>
 	void CreateGeometryTemplate(FVoxelMesherTimes& Times, TArray<uint32>& Indices, TArray<TVertex>& Vertices);
-};
\ No newline at end of file
+};
+
+// Surface nets transitions are set on the high resolution chunks (see bInvertTransitions)
+// The border cells of a high resolution chunk have the cells of their low resolution neighbor as parents:
+// the transitions are strips stitching the border vertices to their parent positions
+class FVoxelSurfaceNetTransitionsMesher : public FVoxelTransitionsMesher
+{
+public:
+	using FVoxelTransitionsMesher::FVoxelTransitionsMesher;
+
+protected:
+	virtual FVoxelIntBox GetBoundsToCheckIsEmptyOn() const override final;
+	virtual FVoxelIntBox GetBoundsToLock() const override final;
+	virtual TVoxelSharedPtr<FVoxelChunkMesh> CreateFullChunkImpl(FVoxelMesherTimes& Times) override final;
+
+private:
+	FVoxelSurfaceNetCells Cells{ *this };
+
+	// Index of the top vertex of each border cell. The parent vertex is stored right after it
+	uint32 BorderVertexIndices[SN_CHUNK_SIZE * SN_CHUNK_SIZE];
+};
@@ -6,6 +6,7 @@
 #include "VoxelRender/VoxelProcMeshBuffers.h"
 #include "VoxelRender/IVoxelProceduralMeshComponent_PhysicsCallbackHandler.h"
 #include "VoxelUtilities/VoxelThreadingUtilities.h"
+#include "IVoxelPool.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 
 double GTotalVoxelCollisionCookingTime = 0;
@@ -16,6 +17,12 @@ static TAutoConsoleVariable<int32> CVarLogCollisionCookingTimes(
 	TEXT("If true, will log the time it took to cook the voxel meshes collisions"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarCookBatchSize(
+	TEXT("voxel.collision.CookBatchSize"),
+	8,
+	TEXT("Max number of chunks whose collisions are cooked in a single task"),
+	ECVF_Default);
+
 static FAutoConsoleCommand CmdLogTotalCollisionCookingTime(
     TEXT("voxel.collision.LogTotalCookingTime"),
     TEXT("Log the accumulated total spent computing collision. Also see voxel.collision.ClearTotalCookingTime"),
@@ -49,6 +56,7 @@ IVoxelAsyncPhysicsCooker::IVoxelAsyncPhysicsCooker(UVoxelProceduralMeshComponent
 		: Component->CollisionTraceFlag)
 	, PriorityHandler(Component->PriorityHandler)
 	, bCleanCollisionMesh(Component->bCleanCollisionMesh)
+	, CollisionSimplificationTolerance(Component->CollisionSimplificationTolerance)
 	, NumConvexHullsPerAxis(Component->NumConvexHullsPerAxis)
 	, Buffers([&]()
 		{
@@ -107,4 +115,72 @@ void IVoxelAsyncPhysicsCooker::PostDoWork()
 uint32 IVoxelAsyncPhysicsCooker::GetPriority() const
 {
 	return PriorityHandler.GetPriority();
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelAsyncPhysicsCookerBatch::FVoxelAsyncPhysicsCookerBatch(TArray<IVoxelAsyncPhysicsCooker*>&& Cookers)
+	: IVoxelQueuedWork(STATIC_FNAME("AsyncPhysicsCookerBatch"), Cookers.Num() > 0 ? Cookers[0]->PriorityDuration : 0)
+	, Cookers(MoveTemp(Cookers))
+{
+	ensure(this->Cookers.Num() > 0);
+}
+
+void FVoxelAsyncPhysicsCookerBatch::QueueCookers(IVoxelPool& Pool, TArray<IVoxelAsyncPhysicsCooker*>&& Cookers)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (Cookers.Num() == 0)
+	{
+		return;
+	}
+
+	// Cook the closest chunks first
+	Cookers.Sort([](const IVoxelAsyncPhysicsCooker& A, const IVoxelAsyncPhysicsCooker& B) { return A.PriorityHandler.GetPriority() > B.PriorityHandler.GetPriority(); });
+
+	const int32 BatchSize = FMath::Max(1, CVarCookBatchSize.GetValueOnGameThread());
+
+	TArray<IVoxelQueuedWork*> Batches;
+	for (int32 Index = 0; Index < Cookers.Num(); Index += BatchSize)
+	{
+		TArray<IVoxelAsyncPhysicsCooker*> BatchCookers(&Cookers[Index], FMath::Min(BatchSize, Cookers.Num() - Index));
+		Batches.Add(new FVoxelAsyncPhysicsCookerBatch(MoveTemp(BatchCookers)));
+	}
+	Pool.QueueTasks(EVoxelTaskType::CollisionCooking, Batches);
+}
+
+void FVoxelAsyncPhysicsCookerBatch::DoThreadedWork()
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	for (IVoxelAsyncPhysicsCooker* Cooker : Cookers)
+	{
+		// Might delete the cooker if it was canceled
+		Cooker->DoThreadedWork();
+	}
+	delete this;
+}
+
+void FVoxelAsyncPhysicsCookerBatch::Abandon()
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	for (IVoxelAsyncPhysicsCooker* Cooker : Cookers)
+	{
+		Cooker->Abandon();
+	}
+	delete this;
+}
+
+uint32 FVoxelAsyncPhysicsCookerBatch::GetPriority() const
+{
+	// Cookers are alive until the batch runs
+	uint32 Priority = 0;
+	for (const IVoxelAsyncPhysicsCooker* Cooker : Cookers)
+	{
+		Priority = FMath::Max(Priority, Cooker->PriorityHandler.GetPriority());
+	}
+	return Priority;
+}
@@ -9,6 +9,7 @@
 #include "PhysicsEngine/BodySetup.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
+class IVoxelPool;
 struct FVoxelProcMeshBuffers;
 struct FVoxelProceduralMeshComponentMemoryUsage;
 class UBodySetup;
@@ -26,6 +27,7 @@ public:
 	const ECollisionTraceFlag CollisionTraceFlag;
 	const FVoxelPriorityHandler PriorityHandler;
 	const bool bCleanCollisionMesh;
+	const float CollisionSimplificationTolerance;
 	const int32 NumConvexHullsPerAxis;
 	const TArray<TVoxelSharedPtr<const FVoxelProcMeshBuffers>> Buffers;
 	const FTransform LocalToRoot;
@@ -47,4 +49,24 @@ protected:
 	virtual void PostDoWork() override;
 	virtual uint32 GetPriority() const override;
 	//~ End FVoxelAsyncWork Interface
+};
+
+// Cooks several components in a single pool task
+// The cookers are not queued themselves: the batch runs or abandons each of them exactly once, which handles their cancellation
+class FVoxelAsyncPhysicsCookerBatch : public IVoxelQueuedWork
+{
+public:
+	explicit FVoxelAsyncPhysicsCookerBatch(TArray<IVoxelAsyncPhysicsCooker*>&& Cookers);
+
+	// Queue the cookers in batches of voxel.collision.CookBatchSize
+	static void QueueCookers(IVoxelPool& Pool, TArray<IVoxelAsyncPhysicsCooker*>&& Cookers);
+
+	//~ Begin IVoxelQueuedWork Interface
+	virtual void DoThreadedWork() override;
+	virtual void Abandon() override;
+	virtual uint32 GetPriority() const override;
+	//~ End IVoxelQueuedWork Interface
+
+private:
+	const TArray<IVoxelAsyncPhysicsCooker*> Cookers;
 };
\ No newline at end of file
@@ -2,25 +2,566 @@
 
 #include "VoxelRender/PhysicsCooker/VoxelAsyncPhysicsCooker_Chaos.h"
 #include "VoxelRender/VoxelProcMeshBuffers.h"
+#include "VoxelRender/IVoxelProceduralMeshComponent_PhysicsCallbackHandler.h"
 #include "VoxelUtilities/VoxelMathUtilities.h"
 
+#include "Hash/CityHash.h"
 #include "PhysicsEngine/BodySetup.h"
 
 #include "Chaos/ImplicitObject.h"
 #include "Chaos/CollisionConvexMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
 
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelPhysicsCookCacheMemory);
+
+static TAutoConsoleVariable<int32> CVarCookCacheSize(
+	TEXT("voxel.collision.CookCacheSize"),
+	64,
+	TEXT("Size in MB of the cache of cooked collision meshes of each voxel world. Meshes are reused when the exact same geometry is cooked again, eg on undo/redo. 0 to disable"),
+	ECVF_Default);
+
+FVoxelPhysicsCookCache::~FVoxelPhysicsCookCache()
+{
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelPhysicsCookCacheMemory, TotalMemory);
+}
+
+bool FVoxelPhysicsCookCache::Find(uint64 Key, FTriMeshPtr& OutTriMesh)
+{
+	FScopeLock Lock(&Section);
+	const int32* Index = KeyToEntry.Find(Key);
+	if (!Index)
+	{
+		return false;
+	}
+	Unlink(*Index);
+	LinkAsMostRecent(*Index);
+	OutTriMesh = Entries[*Index].TriMesh;
+	return true;
+}
+
+void FVoxelPhysicsCookCache::Add(uint64 Key, const FTriMeshPtr& TriMesh, uint32 Memory)
+{
+	const int64 MaxMemory = int64(CVarCookCacheSize.GetValueOnAnyThread()) << 20;
+	
+	FScopeLock Lock(&Section);
+	if (Memory <= MaxMemory && !KeyToEntry.Contains(Key))
+	{
+		const int32 Index = Entries.Add({ Key, TriMesh, Memory });
+		KeyToEntry.Add(Key, Index);
+		LinkAsMostRecent(Index);
+		TotalMemory += Memory;
+		INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelPhysicsCookCacheMemory, Memory);
+	}
+
+	// Also shrinks the cache if the CVar was lowered
+	while (TotalMemory > MaxMemory && ensure(LeastRecent != -1))
+	{
+		Remove(LeastRecent);
+	}
+}
+
+void FVoxelPhysicsCookCache::Empty()
+{
+	FScopeLock Lock(&Section);
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelPhysicsCookCacheMemory, TotalMemory);
+	TotalMemory = 0;
+	Entries.Empty();
+	KeyToEntry.Empty();
+	MostRecent = -1;
+	LeastRecent = -1;
+}
+
+void FVoxelPhysicsCookCache::Unlink(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+
+	if (Entry.Previous != -1)
+	{
+		Entries[Entry.Previous].Next = Entry.Next;
+	}
+	else
+	{
+		checkVoxelSlow(MostRecent == Index);
+		MostRecent = Entry.Next;
+	}
+
+	if (Entry.Next != -1)
+	{
+		Entries[Entry.Next].Previous = Entry.Previous;
+	}
+	else
+	{
+		checkVoxelSlow(LeastRecent == Index);
+		LeastRecent = Entry.Previous;
+	}
+
+	Entry.Previous = -1;
+	Entry.Next = -1;
+}
+
+void FVoxelPhysicsCookCache::LinkAsMostRecent(int32 Index)
+{
+	FEntry& Entry = Entries[Index];
+	checkVoxelSlow(Entry.Previous == -1 && Entry.Next == -1);
+
+	Entry.Next = MostRecent;
+	if (MostRecent != -1)
+	{
+		Entries[MostRecent].Previous = Index;
+	}
+	MostRecent = Index;
+
+	if (LeastRecent == -1)
+	{
+		LeastRecent = Index;
+	}
+}
+
+void FVoxelPhysicsCookCache::Remove(int32 Index)
+{
+	Unlink(Index);
+
+	const FEntry& Entry = Entries[Index];
+	ensure(KeyToEntry.Remove(Entry.Key) == 1);
+	TotalMemory -= Entry.Memory;
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelPhysicsCookCacheMemory, Entry.Memory);
+
+	Entries.RemoveAt(Index);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+namespace FVoxelAsyncPhysicsCooker_ChaosImpl
+{
+	// Symmetric 4x4 matrix giving the sum of the squared distances of a point to a set of planes
+	struct FQuadric
+	{
+		double XX = 0, XY = 0, XZ = 0, XW = 0;
+		double YY = 0, YZ = 0, YW = 0;
+		double ZZ = 0, ZW = 0;
+		double WW = 0;
+
+		FQuadric() = default;
+		// Plane of equation Dot(Normal, P) + W = 0, Normal being normalized
+		FQuadric(const FVector3d& Normal, double W)
+			: XX(Normal.X * Normal.X), XY(Normal.X * Normal.Y), XZ(Normal.X * Normal.Z), XW(Normal.X * W)
+			, YY(Normal.Y * Normal.Y), YZ(Normal.Y * Normal.Z), YW(Normal.Y * W)
+			, ZZ(Normal.Z * Normal.Z), ZW(Normal.Z * W)
+			, WW(W * W)
+		{
+		}
+
+		FQuadric& operator+=(const FQuadric& Other)
+		{
+			XX += Other.XX; XY += Other.XY; XZ += Other.XZ; XW += Other.XW;
+			YY += Other.YY; YZ += Other.YZ; YW += Other.YW;
+			ZZ += Other.ZZ; ZW += Other.ZW;
+			WW += Other.WW;
+			return *this;
+		}
+		FQuadric operator+(const FQuadric& Other) const
+		{
+			FQuadric Result = *this;
+			Result += Other;
+			return Result;
+		}
+
+		double Evaluate(const FVector3f& Position) const
+		{
+			const double X = Position.X;
+			const double Y = Position.Y;
+			const double Z = Position.Z;
+			return
+				XX * X * X + 2 * XY * X * Y + 2 * XZ * X * Z + 2 * XW * X +
+				YY * Y * Y + 2 * YZ * Y * Z + 2 * YW * Y +
+				ZZ * Z * Z + 2 * ZW * Z +
+				WW;
+		}
+	};
+
+	// Quadric error edge collapse (Garland & Heckbert): collapses the edges, cheapest first,
+	// as long as the new vertex is within MaxError of all the planes of the original triangles it replaces
+	// Flat areas collapse to a few triangles, curved ones are kept up to MaxError
+	// Vertices within BorderSize of the chunks borders, on holes or on non manifold edges are never moved so that neighbors still match
+	void Decimate(float MaxError, float ChunkSize, float BorderSize, TArray<FVector3f>& Positions, TArray<int32>& Indices)
+	{
+		VOXEL_ASYNC_FUNCTION_COUNTER();
+
+		TArray<FVector3f> Vertices;
+		TArray<FIntVector> Triangles;
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Weld vertices");
+
+			// The sections and some meshers duplicate vertices
+			TMap<FVector3f, int32> VertexMap;
+			VertexMap.Reserve(Positions.Num());
+
+			TArray<int32> VertexRemap;
+			VertexRemap.SetNumUninitialized(Positions.Num());
+			for (int32 Index = 0; Index < Positions.Num(); Index++)
+			{
+				const FVector3f& Position = Positions[Index];
+				if (const int32* ExistingIndex = VertexMap.Find(Position))
+				{
+					VertexRemap[Index] = *ExistingIndex;
+				}
+				else
+				{
+					VertexRemap[Index] = Vertices.Add(Position);
+					VertexMap.Add(Position, VertexRemap[Index]);
+				}
+			}
+
+			Triangles.Reserve(Indices.Num() / 3);
+			for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+			{
+				const FIntVector Triangle(
+					VertexRemap[Indices[Index + 0]],
+					VertexRemap[Indices[Index + 1]],
+					VertexRemap[Indices[Index + 2]]);
+				if (Triangle.X == Triangle.Y || Triangle.Y == Triangle.Z || Triangle.X == Triangle.Z)
+				{
+					continue;
+				}
+				// Collapsed triangles are invalid for Chaos
+				const FVector3f Normal = FVector3f::CrossProduct(Vertices[Triangle.Y] - Vertices[Triangle.X], Vertices[Triangle.Z] - Vertices[Triangle.X]);
+				if (Normal.SizeSquared() < SMALL_NUMBER)
+				{
+					continue;
+				}
+				Triangles.Add(Triangle);
+			}
+		}
+
+		const int32 NumVertices = Vertices.Num();
+
+		const auto GetEdgeKey = [](int32 A, int32 B)
+		{
+			return (uint64(FMath::Min(A, B)) << 32) | uint64(FMath::Max(A, B));
+		};
+
+		TArray<bool> LockedVertices;
+		TMap<uint64, int32> EdgesNumTriangles;
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Lock vertices");
+
+			LockedVertices.SetNumUninitialized(NumVertices);
+			for (int32 Index = 0; Index < NumVertices; Index++)
+			{
+				const FVector3f& Position = Vertices[Index];
+
+				bool bOnBorder = false;
+				for (int32 Axis = 0; Axis < 3; Axis++)
+				{
+					const float Value = Position[Axis];
+					bOnBorder |= FMath::Abs(Value - ChunkSize * FMath::RoundToFloat(Value / ChunkSize)) <= BorderSize;
+				}
+				LockedVertices[Index] = bOnBorder;
+			}
+
+			EdgesNumTriangles.Reserve(Triangles.Num() * 3 / 2);
+			for (const FIntVector& Triangle : Triangles)
+			{
+				for (int32 Edge = 0; Edge < 3; Edge++)
+				{
+					EdgesNumTriangles.FindOrAdd(GetEdgeKey(Triangle[Edge], Triangle[(Edge + 1) % 3]))++;
+				}
+			}
+			for (auto& It : EdgesNumTriangles)
+			{
+				if (It.Value != 2)
+				{
+					LockedVertices[int32(It.Key >> 32)] = true;
+					LockedVertices[int32(It.Key & 0xFFFFFFFF)] = true;
+				}
+			}
+		}
+
+		TArray<FQuadric> Quadrics;
+		TArray<TArray<int32, TInlineAllocator<8>>> VertexTriangles;
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Compute quadrics");
+
+			Quadrics.SetNum(NumVertices);
+			VertexTriangles.SetNum(NumVertices);
+			for (int32 TriangleIndex = 0; TriangleIndex < Triangles.Num(); TriangleIndex++)
+			{
+				const FIntVector& Triangle = Triangles[TriangleIndex];
+				const FVector3d A = FVector3d(Vertices[Triangle.X]);
+				const FVector3d B = FVector3d(Vertices[Triangle.Y]);
+				const FVector3d C = FVector3d(Vertices[Triangle.Z]);
+				const FVector3d Normal = FVector3d::CrossProduct(B - A, C - A).GetSafeNormal();
+				const FQuadric Quadric(Normal, -FVector3d::DotProduct(Normal, A));
+
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					Quadrics[Triangle[Corner]] += Quadric;
+					VertexTriangles[Triangle[Corner]].Add(TriangleIndex);
+				}
+			}
+		}
+
+		struct FCollapse
+		{
+			double Cost = 0;
+			int32 Keep = -1;
+			int32 Remove = -1;
+			// Used to skip the collapses computed before one of the vertices changed
+			uint32 KeepStamp = 0;
+			uint32 RemoveStamp = 0;
+			FVector3f Position;
+		};
+		const auto CollapsePredicate = [](const FCollapse& A, const FCollapse& B) { return A.Cost < B.Cost; };
+
+		const double MaxCost = FMath::Square(double(MaxError));
+
+		TArray<FCollapse> Collapses;
+		TArray<uint32> VertexStamps;
+		VertexStamps.SetNumZeroed(NumVertices);
+		TArray<bool> RemovedVertices;
+		RemovedVertices.SetNumZeroed(NumVertices);
+		TArray<bool> RemovedTriangles;
+		RemovedTriangles.SetNumZeroed(Triangles.Num());
+
+		const auto AddCollapse = [&](int32 Keep, int32 Remove)
+		{
+			if (LockedVertices[Remove])
+			{
+				Swap(Keep, Remove);
+			}
+			if (LockedVertices[Remove])
+			{
+				return;
+			}
+
+			const FQuadric Quadric = Quadrics[Keep] + Quadrics[Remove];
+
+			// Locked vertices can't move
+			FVector3f Candidates[3] = { Vertices[Keep], Vertices[Remove], (Vertices[Keep] + Vertices[Remove]) / 2 };
+			const int32 NumCandidates = LockedVertices[Keep] ? 1 : 3;
+
+			FCollapse Collapse;
+			Collapse.Cost = MAX_dbl;
+			for (int32 Index = 0; Index < NumCandidates; Index++)
+			{
+				const double Cost = Quadric.Evaluate(Candidates[Index]);
+				if (Cost < Collapse.Cost)
+				{
+					Collapse.Cost = Cost;
+					Collapse.Position = Candidates[Index];
+				}
+			}
+			if (Collapse.Cost > MaxCost)
+			{
+				return;
+			}
+
+			Collapse.Keep = Keep;
+			Collapse.Remove = Remove;
+			Collapse.KeepStamp = VertexStamps[Keep];
+			Collapse.RemoveStamp = VertexStamps[Remove];
+			Collapses.HeapPush(Collapse, CollapsePredicate);
+		};
+		const auto GetNeighbors = [&](int32 Vertex, TArray<int32, TInlineAllocator<32>>& OutNeighbors)
+		{
+			OutNeighbors.Reset();
+			for (const int32 TriangleIndex : VertexTriangles[Vertex])
+			{
+				if (RemovedTriangles[TriangleIndex])
+				{
+					continue;
+				}
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const int32 Neighbor = Triangles[TriangleIndex][Corner];
+					if (Neighbor != Vertex)
+					{
+						OutNeighbors.AddUnique(Neighbor);
+					}
+				}
+			}
+		};
+		// The triangles around the collapse must not flip nor become degenerate
+		const auto IsCollapseValid = [&](int32 Vertex, int32 Other, const FVector3f& Position)
+		{
+			for (const int32 TriangleIndex : VertexTriangles[Vertex])
+			{
+				if (RemovedTriangles[TriangleIndex])
+				{
+					continue;
+				}
+				const FIntVector& Triangle = Triangles[TriangleIndex];
+				if (Triangle.X == Other || Triangle.Y == Other || Triangle.Z == Other)
+				{
+					// Removed by the collapse
+					continue;
+				}
+
+				FVector3f Corners[3];
+				FVector3f NewCorners[3];
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					Corners[Corner] = Vertices[Triangle[Corner]];
+					NewCorners[Corner] = Triangle[Corner] == Vertex ? Position : Corners[Corner];
+				}
+				const FVector3f Normal = FVector3f::CrossProduct(Corners[1] - Corners[0], Corners[2] - Corners[0]);
+				const FVector3f NewNormal = FVector3f::CrossProduct(NewCorners[1] - NewCorners[0], NewCorners[2] - NewCorners[0]);
+				if (NewNormal.SizeSquared() < SMALL_NUMBER ||
+					FVector3f::DotProduct(Normal.GetSafeNormal(), NewNormal.GetSafeNormal()) < 0.2f)
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Compute collapses");
+
+			Collapses.Reserve(EdgesNumTriangles.Num());
+			for (auto& It : EdgesNumTriangles)
+			{
+				if (It.Value == 2)
+				{
+					AddCollapse(int32(It.Key >> 32), int32(It.Key & 0xFFFFFFFF));
+				}
+			}
+		}
+
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Collapse edges");
+
+			TArray<int32, TInlineAllocator<32>> KeepNeighbors;
+			TArray<int32, TInlineAllocator<32>> RemoveNeighbors;
+			while (Collapses.Num() > 0)
+			{
+				FCollapse Collapse;
+				Collapses.HeapPop(Collapse, CollapsePredicate);
+
+				const int32 Keep = Collapse.Keep;
+				const int32 Remove = Collapse.Remove;
+				if (RemovedVertices[Keep] ||
+					RemovedVertices[Remove] ||
+					VertexStamps[Keep] != Collapse.KeepStamp ||
+					VertexStamps[Remove] != Collapse.RemoveStamp)
+				{
+					continue;
+				}
+
+				// Link condition: the edge must still exist, and only the two triangles sharing it can be removed, else the mesh folds onto itself
+				GetNeighbors(Keep, KeepNeighbors);
+				if (!KeepNeighbors.Contains(Remove))
+				{
+					continue;
+				}
+				GetNeighbors(Remove, RemoveNeighbors);
+				int32 NumSharedNeighbors = 0;
+				for (const int32 Neighbor : RemoveNeighbors)
+				{
+					NumSharedNeighbors += KeepNeighbors.Contains(Neighbor);
+				}
+				if (NumSharedNeighbors != 2)
+				{
+					continue;
+				}
+
+				if (!IsCollapseValid(Keep, Remove, Collapse.Position) ||
+					!IsCollapseValid(Remove, Keep, Collapse.Position))
+				{
+					continue;
+				}
+
+				for (const int32 TriangleIndex : VertexTriangles[Remove])
+				{
+					if (RemovedTriangles[TriangleIndex])
+					{
+						continue;
+					}
+					FIntVector& Triangle = Triangles[TriangleIndex];
+					if (Triangle.X == Keep || Triangle.Y == Keep || Triangle.Z == Keep)
+					{
+						RemovedTriangles[TriangleIndex] = true;
+						continue;
+					}
+					for (int32 Corner = 0; Corner < 3; Corner++)
+					{
+						if (Triangle[Corner] == Remove)
+						{
+							Triangle[Corner] = Keep;
+						}
+					}
+					VertexTriangles[Keep].Add(TriangleIndex);
+				}
+				VertexTriangles[Keep].RemoveAllSwap([&](int32 TriangleIndex) { return RemovedTriangles[TriangleIndex]; });
+				VertexTriangles[Remove].Empty();
+				RemovedVertices[Remove] = true;
+
+				Vertices[Keep] = Collapse.Position;
+				Quadrics[Keep] += Quadrics[Remove];
+				VertexStamps[Keep]++;
+
+				GetNeighbors(Keep, KeepNeighbors);
+				for (const int32 Neighbor : KeepNeighbors)
+				{
+					AddCollapse(Keep, Neighbor);
+				}
+			}
+		}
+
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Remove unused vertices");
+
+			TArray<int32> VertexRemap;
+			VertexRemap.Init(-1, NumVertices);
+
+			Positions.Reset();
+			Indices.Reset();
+			for (int32 TriangleIndex = 0; TriangleIndex < Triangles.Num(); TriangleIndex++)
+			{
+				if (RemovedTriangles[TriangleIndex])
+				{
+					continue;
+				}
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const int32 Vertex = Triangles[TriangleIndex][Corner];
+					int32& NewIndex = VertexRemap[Vertex];
+					if (NewIndex == -1)
+					{
+						NewIndex = Positions.Add(Vertices[Vertex]);
+					}
+					Indices.Add(NewIndex);
+				}
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 FVoxelAsyncPhysicsCooker_Chaos::FVoxelAsyncPhysicsCooker_Chaos(UVoxelProceduralMeshComponent* Component)
 	: IVoxelAsyncPhysicsCooker(Component)
+	, CookCache([&]() -> TVoxelSharedPtr<FVoxelPhysicsCookCache>
+		{
+			const auto PinnedPhysicsCallbackHandler = PhysicsCallbackHandler.Pin();
+			return PinnedPhysicsCallbackHandler.IsValid() ? PinnedPhysicsCallbackHandler->GetCookCache() : TVoxelSharedPtr<FVoxelPhysicsCookCache>();
+		}())
 {
 }
 
 bool FVoxelAsyncPhysicsCooker_Chaos::Finalize(UBodySetup& BodySetup, FVoxelProceduralMeshComponentMemoryUsage& OutMemoryUsage)
 {
 #if TRACK_CHAOS_GEOMETRY
-	for (auto& TriMesh : TriMeshes)
+	if (!bTriMeshesFromCache)
 	{
-		TriMesh->Track(Chaos::MakeSerializable(TriMesh), "Voxel Mesh");
+		for (auto& TriMesh : TriMeshes)
+		{
+			TriMesh->Track(Chaos::MakeSerializable(TriMesh), "Voxel Mesh");
+		}
 	}
 #endif
 
@@ -37,6 +578,8 @@ bool FVoxelAsyncPhysicsCooker_Chaos::Finalize(UBodySetup& BodySetup, FVoxelProce
 #endif
 	BodySetup.bCreatedPhysicsMeshes = true;
 
+	OutMemoryUsage.TriangleMeshes = TriMeshesMemory;
+
 	return true;
 }
 
@@ -59,6 +602,7 @@ void FVoxelAsyncPhysicsCooker_Chaos::CookMesh()
 void FVoxelAsyncPhysicsCooker_Chaos::CreateTriMesh()
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
+	using namespace FVoxelAsyncPhysicsCooker_ChaosImpl;
 				
 	int32 NumIndices = 0;
 	int32 NumVertices = 0;
@@ -68,100 +612,153 @@ void FVoxelAsyncPhysicsCooker_Chaos::CreateTriMesh()
 		NumVertices += Buffer->GetNumVertices();
 	}
 
-	const auto Process = [&](auto& Triangles)
+	TArray<FVector3f> Positions;
+	TArray<int32> Indices;
 	{
-		Chaos::TParticles<Chaos::FRealSingle, 3> Particles;
+		VOXEL_ASYNC_SCOPE_COUNTER("Copy data from buffers");
+
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Allocate");
+			ensure(NumIndices % 3 == 0);
+			Positions.SetNumUninitialized(NumVertices);
+			Indices.SetNumUninitialized(NumIndices);
+		}
 
+		int32 IndexIndex = 0;
+		int32 VertexIndex = 0;
+		for (int32 SectionIndex = 0; SectionIndex < Buffers.Num(); SectionIndex++)
 		{
-			VOXEL_ASYNC_SCOPE_COUNTER("Copy data from buffers");
+			auto& Buffer = *Buffers[SectionIndex];
+
+			const int32 VertexOffset = VertexIndex;
 
 			{
-				VOXEL_ASYNC_SCOPE_COUNTER("Allocate");
-				ensure(NumIndices % 3 == 0);
-				Triangles.SetNumUninitialized(NumIndices / 3);
-				Particles.AddParticles(NumVertices);
+				VOXEL_ASYNC_SCOPE_COUNTER("Copy vertices");
+				
+				auto& PositionBuffer = Buffer.VertexBuffers.PositionVertexBuffer;
+				for (uint32 Index = 0; Index < PositionBuffer.GetNumVertices(); Index++)
+				{
+					FVoxelUtilities::Get(Positions, VertexIndex++) = PositionBuffer.VertexPosition(Index);
+				}
 			}
 
-			int32 IndexIndex = 0;
-			int32 VertexIndex = 0;
-			for (int32 SectionIndex = 0; SectionIndex < Buffers.Num(); SectionIndex++)
 			{
-				auto& Buffer = *Buffers[SectionIndex];
+				VOXEL_ASYNC_SCOPE_COUNTER("Copy triangles");
+				
+				auto& IndexBuffer = Buffer.IndexBuffer;
 
-				const int32 VertexOffset = VertexIndex;
+				ensure(IndexBuffer.GetNumIndices() % 3 == 0);
+				const int32 NumTriangles = IndexBuffer.GetNumIndices() / 3;
 
+				const auto Lambda = [&](const auto* RESTRICT Data)
 				{
-					VOXEL_ASYNC_SCOPE_COUNTER("Copy vertices");
-					
-					auto& PositionBuffer = Buffer.VertexBuffers.PositionVertexBuffer;
-					for (uint32 Index = 0; Index < PositionBuffer.GetNumVertices(); Index++)
+					for (int32 Index = 0; Index < 3 * NumTriangles; Index++)
 					{
-#if VOXEL_ENGINE_VERSION >= 504
-						Particles.SetX(VertexIndex++, PositionBuffer.VertexPosition(Index));
-#else
-						Particles.X(VertexIndex++) = PositionBuffer.VertexPosition(Index);
-#endif
+						FVoxelUtilities::Get(Indices, IndexIndex++) = int32(Data[Index]) + VertexOffset;
 					}
+				};
+				if (IndexBuffer.Is32Bit())
+				{
+					Lambda(IndexBuffer.GetData_32());
 				}
-
+				else
 				{
-					VOXEL_ASYNC_SCOPE_COUNTER("Copy triangles");
-					
-					auto& IndexBuffer = Buffer.IndexBuffer;
+					Lambda(IndexBuffer.GetData_16());
+				}
+			}
+		}
+		check(IndexIndex == Indices.Num());
+		check(VertexIndex == Positions.Num());
+	}
 
-					ensure(IndexBuffer.GetNumIndices() % 3 == 0);
-					const int32 NumTriangles = IndexBuffer.GetNumIndices() / 3;
+	// Same geometry & settings: reuse the previous cook, eg when undoing an edit
+	uint64 CacheKey;
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Hash");
+		CacheKey = CityHash64(reinterpret_cast<const char*>(Positions.GetData()), Positions.Num() * Positions.GetTypeSize());
+		CacheKey = CityHash64WithSeed(reinterpret_cast<const char*>(Indices.GetData()), Indices.Num() * Indices.GetTypeSize(), CacheKey);
+		const float Settings[] = { float(LOD), CollisionSimplificationTolerance, float(bCleanCollisionMesh) };
+		CacheKey = CityHash64WithSeed(reinterpret_cast<const char*>(Settings), sizeof(Settings), CacheKey);
+	}
+	if (CookCache.IsValid())
+	{
+		FTriMeshPtr CachedTriMesh;
+		if (CookCache->Find(CacheKey, CachedTriMesh))
+		{
+			// Shared with the component that cooked it, which already counts its memory
+			TriMeshesMemory = 0;
+			TriMeshes.Add(CachedTriMesh);
+			bTriMeshesFromCache = true;
+			return;
+		}
+	}
 
-					const auto Lambda = [&](const auto* RESTRICT Data)
-					{
-						for (int32 Index = 0; Index < NumTriangles; Index++)
-						{
-							checkVoxelSlow(3 * Index + 2 < IndexBuffer.GetNumIndices());
+	if (CollisionSimplificationTolerance > 0)
+	{
+		const float Step = 1 << LOD;
+		// Only the vertices exactly on the borders are shared with the neighbors
+		Decimate(CollisionSimplificationTolerance * Step, RENDER_CHUNK_SIZE * Step, Step / 100, Positions, Indices);
+
+		if (Indices.Num() == 0)
+		{
+			return;
+		}
+	}
 
-							const Chaos::TVector<int32, 3> Triangle{
-									int32(Data[3 * Index + 2]) + VertexOffset,
-									int32(Data[3 * Index + 1]) + VertexOffset,
-									int32(Data[3 * Index + 0]) + VertexOffset
-							};
+	const auto Process = [&](auto& Triangles)
+	{
+		Chaos::TParticles<Chaos::FRealSingle, 3> Particles;
 
-							FVoxelUtilities::Get(Triangles, IndexIndex++) = Triangle;
+		{
+			VOXEL_ASYNC_SCOPE_COUNTER("Copy data to Chaos");
 
-#if VOXEL_DEBUG
+			Triangles.SetNumUninitialized(Indices.Num() / 3);
+			Particles.AddParticles(Positions.Num());
+
+			for (int32 Index = 0; Index < Positions.Num(); Index++)
+			{
 #if VOXEL_ENGINE_VERSION >= 504
-							const auto A = Particles.GetX(Triangle.X);
-							const auto B = Particles.GetX(Triangle.Y);
-							const auto C = Particles.GetX(Triangle.Z);
+				Particles.SetX(Index, Positions[Index]);
 #else
+				Particles.X(Index) = Positions[Index];
+#endif
+			}
 
-							const auto A = Particles.X(Triangle.X);
-							const auto B = Particles.X(Triangle.Y);
-							const auto C = Particles.X(Triangle.Z);
+			for (int32 Index = 0; Index < Triangles.Num(); Index++)
+			{
+				const Chaos::TVector<int32, 3> Triangle{
+					Indices[3 * Index + 2],
+					Indices[3 * Index + 1],
+					Indices[3 * Index + 0]
+				};
+
+				Triangles[Index] = Triangle;
+
+#if VOXEL_DEBUG
+#if VOXEL_ENGINE_VERSION >= 504
+				const auto A = Particles.GetX(Triangle.X);
+				const auto B = Particles.GetX(Triangle.Y);
+				const auto C = Particles.GetX(Triangle.Z);
+#else
+				const auto A = Particles.X(Triangle.X);
+				const auto B = Particles.X(Triangle.Y);
+				const auto C = Particles.X(Triangle.Z);
 #endif
-							ensure(Chaos::FConvexBuilder::IsValidTriangle(A, B, C));
+				ensure(Chaos::FConvexBuilder::IsValidTriangle(A, B, C));
 #endif
-						}
-					};
-					if (IndexBuffer.Is32Bit())
-					{
-						Lambda(IndexBuffer.GetData_32());
-					}
-					else
-					{
-						Lambda(IndexBuffer.GetData_16());
-					}
-				}
 			}
-			check(IndexIndex == Triangles.Num());
-			check(VertexIndex == Particles.Size());
 		}
 
+		// Particles & triangles only, doesn't include the BVH
+		TriMeshesMemory = Particles.Size() * sizeof(Chaos::FVec3f) + Triangles.Num() * Triangles.GetTypeSize();
+
 		TArray<uint16> MaterialIndices;
 		
 		VOXEL_ASYNC_SCOPE_COUNTER("Build Tri Mesh");
 		TriMeshes.Emplace(new Chaos::FTriangleMeshImplicitObject(MoveTemp(Particles), MoveTemp(Triangles), MoveTemp(MaterialIndices)));
 	};
 	
-	if (NumVertices < TNumericLimits<uint16>::Max())
+	if (Positions.Num() < TNumericLimits<uint16>::Max())
 	{
 		TArray<Chaos::TVector<uint16, 3>> TrianglesSmallIdx;
 		Process(TrianglesSmallIdx);
@@ -171,4 +768,9 @@ void FVoxelAsyncPhysicsCooker_Chaos::CreateTriMesh()
 		TArray<Chaos::TVector<int32, 3>> TrianglesLargeIdx;
 		Process(TrianglesLargeIdx);
 	}
-}
\ No newline at end of file
+
+	if (CookCache.IsValid())
+	{
+		CookCache->Add(CacheKey, TriMeshes.Last(), TriMeshesMemory);
+	}
+}
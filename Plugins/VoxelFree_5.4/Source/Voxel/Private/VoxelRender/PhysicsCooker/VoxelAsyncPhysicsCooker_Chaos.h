@@ -12,9 +12,57 @@ namespace Chaos
 
 class IPhysXCooking;
 
+DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Physics Cooked Meshes Cache Memory"), STAT_VoxelPhysicsCookCacheMemory, STATGROUP_VoxelMemory, VOXEL_API);
+
+// Cooked trimeshes by geometry hash, least recently used are removed first. Size set by voxel.collision.CookCacheSize
+// Owned by the physics callback handler of the renderer: freed with the world
+// Thread safe
+class FVoxelPhysicsCookCache
+{
+public:
+#if VOXEL_ENGINE_VERSION >= 504
+	using FTriMeshPtr = Chaos::FTriangleMeshImplicitObjectPtr;
+#else
+	using FTriMeshPtr = TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>;
+#endif
+
+	FVoxelPhysicsCookCache() = default;
+	~FVoxelPhysicsCookCache();
+
+	UE_NONCOPYABLE(FVoxelPhysicsCookCache);
+
+	bool Find(uint64 Key, FTriMeshPtr& OutTriMesh);
+	void Add(uint64 Key, const FTriMeshPtr& TriMesh, uint32 Memory);
+	void Empty();
+
+private:
+	struct FEntry
+	{
+		uint64 Key = 0;
+		FTriMeshPtr TriMesh;
+		uint32 Memory = 0;
+
+		// Doubly linked list from the most recently used to the least recently used
+		int32 Previous = -1;
+		int32 Next = -1;
+	};
+	FCriticalSection Section;
+	TSparseArray<FEntry> Entries;
+	TMap<uint64, int32> KeyToEntry;
+	int32 MostRecent = -1;
+	int32 LeastRecent = -1;
+	int64 TotalMemory = 0;
+
+	void Unlink(int32 Index);
+	void LinkAsMostRecent(int32 Index);
+	void Remove(int32 Index);
+};
+
 class FVoxelAsyncPhysicsCooker_Chaos : public IVoxelAsyncPhysicsCooker
 {
 public:
+	using FTriMeshPtr = FVoxelPhysicsCookCache::FTriMeshPtr;
+
 	explicit FVoxelAsyncPhysicsCooker_Chaos(UVoxelProceduralMeshComponent* Component);
 
 private:
@@ -28,13 +76,16 @@ protected:
 	virtual bool Finalize(UBodySetup& BodySetup, FVoxelProceduralMeshComponentMemoryUsage& OutMemoryUsage) override;
 	virtual void CookMesh() override;
 	//~ End IVoxelAsyncPhysicsCooker Interface
-	
+
 private:
+	// Null if the handler was already destroyed
+	const TVoxelSharedPtr<FVoxelPhysicsCookCache> CookCache;
+
 	void CreateTriMesh();
 
-#if VOXEL_ENGINE_VERSION >= 504
-	TArray<Chaos::FTriangleMeshImplicitObjectPtr> TriMeshes;
-#else
-	TArray<TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>> TriMeshes;
-#endif
-};
\ No newline at end of file
+	TArray<FTriMeshPtr> TriMeshes;
+	// Approximate size of the trimeshes. 0 if they come from the cache: they are counted by the cooker that built them
+	uint32 TriMeshesMemory = 0;
+	// Cached trimeshes are already tracked
+	bool bTriMeshesFromCache = false;
+};
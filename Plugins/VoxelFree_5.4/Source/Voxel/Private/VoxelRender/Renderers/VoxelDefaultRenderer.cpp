@@ -14,6 +14,9 @@
 #include "VoxelDebug/VoxelDebugManager.h"
 #include "VoxelData/VoxelData.h"
 #include "VoxelGenerators/VoxelGeneratorInstance.h"
+#include "VoxelPriorityHandler.h"
+
+#include "Algo/StableSort.h"
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelRenderer);
 
@@ -23,6 +26,12 @@ static TAutoConsoleVariable<int32> CVarFreezeRenderer(
 	TEXT("Stops renderer tick"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarPrioritizeMeshUpdates(
+	TEXT("voxel.renderer.PrioritizeMeshUpdates"),
+	1,
+	TEXT("If true, finished chunk meshes are applied closest to the invokers first, and chunks replacing the same chunk are applied in the same frame. If false, they are applied in the order they finished"),
+	ECVF_Default);
+
 FVoxelDefaultRenderer::FVoxelDefaultRenderer(const FVoxelRendererSettings& Settings)
 	: IVoxelRenderer(Settings)
 	, MeshHandler(Settings.bMergeChunks ? Settings.bDoNotMergeCollisionsAndNavmesh
@@ -72,6 +81,7 @@ void FVoxelDefaultRenderer::Destroy()
 	}
 
 	ChunksMap.Reset();
+	PendingTasksCallbacks.Empty();
 	MeshHandler.Reset();
 }
 
@@ -690,7 +700,7 @@ void FVoxelDefaultRenderer::CreateGeometry_AnyThread(
 	int32 LOD,
 	const FIntVector& ChunkPosition,
 	TArray<uint32>& OutIndices,
-	TArray<FVector>& OutVertices) const
+	TArray<FVector3f>& OutVertices) const
 {
 	FVoxelMesherAsyncWork::CreateGeometry_AnyThread(*this, LOD, ChunkPosition, OutIndices, OutVertices);
 }
@@ -714,13 +724,14 @@ void FVoxelDefaultRenderer::Tick(float)
 	{
 		VOXEL_SCOPE_COUNTER("MeshHandler Tick");
 		MeshHandler->Tick(MaxTime);
+		MeshHandler->FlushRenderDataInits();
 	}
 	
 	ProcessChunksToRemoveOrShow();
 	ProcessMeshUpdates(MaxTime);
 	FlushQueuedTasks();
 
-	if (!OnWorldLoadedFired && UpdateIndex > 0 && TaskCount.GetValue() == 0 && TasksCallbacksQueue.IsEmpty())
+	if (!OnWorldLoadedFired && UpdateIndex > 0 && TaskCount.GetValue() == 0 && TasksCallbacksQueue.IsEmpty() && PendingTasksCallbacks.Num() == 0)
 	{
 		OnWorldLoaded.Broadcast();
 		OnWorldLoadedFired = true;
@@ -729,7 +740,7 @@ void FVoxelDefaultRenderer::Tick(float)
 	UpdateAllocatedSize();
 	
 	Settings.DebugManager->ReportMeshTaskCount(TaskCount.GetValue());
-	Settings.DebugManager->ReportMeshTasksCallbacksQueueNum(TasksCallbacksQueue.Num());
+	Settings.DebugManager->ReportMeshTasksCallbacksQueueNum(TasksCallbacksQueue.Num() + PendingTasksCallbacks.Num());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -758,14 +769,11 @@ void FVoxelDefaultRenderer::StartTask(FChunk& Chunk)
 
 	if (MainOrTransitions == EMainOrTransitions::Transitions)
 	{
-		if (Settings.RenderType == EVoxelRenderType::SurfaceNets)
+		if (Settings.RenderType == EVoxelRenderType::SurfaceNets && Chunk.MeshId.IsValid())
 		{
-			if (Chunk.MeshId.IsValid())
-			{
-				MeshHandler->SetTransitionsMaskForSurfaceNets(Chunk.MeshId, Chunk.Settings.TransitionsMask);
-			}
-			Chunk.BuiltData.TransitionsChunkCreationTime = FPlatformTime::Seconds(); // Make sure to always update the time
-			return;
+			// Materials can morph the border vertices to their parent positions
+			// The transitions chunk stitches them to the low res neighbor otherwise
+			MeshHandler->SetTransitionsMaskForSurfaceNets(Chunk.MeshId, Chunk.Settings.TransitionsMask);
 		}
 		if (Chunk.Settings.TransitionsMask == 0)
 		{
@@ -1164,111 +1172,201 @@ void FVoxelDefaultRenderer::ProcessChunksToRemoveOrShow()
 void FVoxelDefaultRenderer::ProcessMeshUpdates(double MaxTime)
 {
 	VOXEL_FUNCTION_COUNTER();
-	
-	FVoxelTaskCallback Callback;
-	while ( // First check the time, else dequeued elements aren't processed!
-		FPlatformTime::Seconds() < MaxTime &&
-		TasksCallbacksQueue.Dequeue(Callback))
+
+	if (CVarPrioritizeMeshUpdates.GetValueOnGameThread() == 0 && PendingTasksCallbacks.Num() == 0)
 	{
-		FChunk* Chunk = ChunksMap.Find(Callback.ChunkId);
-		if (!Chunk) continue;
-
-		auto& Tasks = Chunk->Tasks;
-		auto& Task = Callback.bIsTransitionTask ? Tasks.TransitionsTask : Tasks.MainTask;
-		if (!Task.IsValid() || Task->TaskId != Callback.TaskId) continue; // If task was canceled
-		if (!ensure(Task->IsDone())) continue; // Must be done if we're in the callback
-
-		// Move built data
-		auto& BuiltData = Chunk->BuiltData;
-		const auto PreviousBuiltData = BuiltData;
-		if (Callback.bIsTransitionTask)
+		FVoxelTaskCallback Callback;
+		while ( // First check the time, else dequeued elements aren't processed!
+			FPlatformTime::Seconds() < MaxTime &&
+			TasksCallbacksQueue.Dequeue(Callback))
 		{
-			ensure(Task->TransitionsMask == Chunk->Settings.TransitionsMask); // Should have been canceled
-			BuiltData.TransitionsMask = Task->TransitionsMask;
-			BuiltData.TransitionsChunk = Task->Chunk;
-			BuiltData.TransitionsChunkCreationTime = Task->CreationTime;
+			ProcessTaskCallback(Callback);
 		}
-		else
+		return;
+	}
+
+	// Dequeue everything so that the most important updates are applied first when we are over budget, eg after a teleport
+	{
+		VOXEL_SCOPE_COUNTER("Dequeue");
+		
+		const int32 NumPending = PendingTasksCallbacks.Num();
+		FVoxelTaskCallback Callback;
+		while (TasksCallbacksQueue.Dequeue(Callback))
 		{
-			BuiltData.MainChunk = Task->Chunk;
-			BuiltData.MainChunkCreationTime = Task->CreationTime;
+			PendingTasksCallbacks.Add({ Callback, 0, 0 });
 		}
+		if (PendingTasksCallbacks.Num() > NumPending)
+		{
+			SortTasksCallbacks();
+		}
+	}
 
-		// Finally, delete the task
-		Task.Reset();
+	int32 NumProcessed = 0;
+	for (; NumProcessed < PendingTasksCallbacks.Num(); NumProcessed++)
+	{
+		// Only check the time between groups, so that a region never shows the new chunks next to holes
+		// First check the time, else the budget might be used by the mesh handler and nothing would be checked
+		const auto& PendingCallback = PendingTasksCallbacks[NumProcessed];
+		if ((NumProcessed == 0 || PendingTasksCallbacks[NumProcessed - 1].GroupId != PendingCallback.GroupId) &&
+			FPlatformTime::Seconds() >= MaxTime)
+		{
+			break;
+		}
 
-		// Do nothing while the main chunk isn't valid - we don't want to have unneeded updates for transitions then main
-		if (BuiltData.MainChunk.IsValid())
+		ProcessTaskCallback(PendingCallback.Callback);
+	}
+	PendingTasksCallbacks.RemoveAt(0, NumProcessed, false);
+}
+
+void FVoxelDefaultRenderer::SortTasksCallbacks()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const auto& InvokersPositions = GetInvokersPositionsForPriorities();
+
+	// Group priority is the priority of its most important chunk
+	TMap<uint64, uint32> GroupsPriorities;
+	GroupsPriorities.Reserve(PendingTasksCallbacks.Num());
+	for (auto& PendingCallback : PendingTasksCallbacks)
+	{
+		const FChunk* Chunk = ChunksMap.Find(PendingCallback.Callback.ChunkId);
+		if (!Chunk)
 		{
-			auto& MeshId = Chunk->MeshId;
-			const auto Update = [&]()
-			{
-				if (!MeshId.IsValid())
-				{
-					MeshId = MeshHandler->AddChunk(Chunk->LOD, Chunk->Bounds.Min);
-				}
-				MeshHandler->UpdateChunk(MeshId, Chunk->Settings, *BuiltData.MainChunk, BuiltData.TransitionsChunk.Get(), BuiltData.TransitionsMask);
+			// Will be skipped
+			PendingCallback.GroupId = PendingCallback.Callback.ChunkId;
+			PendingCallback.Priority = MAX_uint32;
+			continue;
+		}
+		
+		// New chunks all have the chunk they are replacing in their PreviousChunks
+		PendingCallback.GroupId = Chunk->PreviousChunks.Num() > 0 ? Chunk->PreviousChunks[0] : Chunk->Id;
+		PendingCallback.Priority = FVoxelPriorityHandler(Chunk->Bounds, InvokersPositions).GetPriority();
 
-				if (Settings.bStaticWorld)
-				{
-					// Free up memory ASAP
-					BuiltData.MainChunk.Reset();
-					BuiltData.TransitionsChunk.Reset();
-				}
-			};
+		uint32& GroupPriority = GroupsPriorities.FindOrAdd(PendingCallback.GroupId, 0);
+		GroupPriority = FMath::Max(GroupPriority, PendingCallback.Priority);
+	}
+	for (auto& PendingCallback : PendingTasksCallbacks)
+	{
+		if (const uint32* GroupPriority = GroupsPriorities.Find(PendingCallback.GroupId))
+		{
+			PendingCallback.Priority = *GroupPriority;
+		}
+	}
 
-			const bool bTransitionsChunkIsBuilt =
-				BuiltData.TransitionsChunk.IsValid() ||
-				Chunk->Settings.TransitionsMask == 0 ||
-				Settings.RenderType == EVoxelRenderType::SurfaceNets;
+	// Stable to keep the callbacks of a chunk in order
+	Algo::StableSort(PendingTasksCallbacks, [](const FVoxelPendingTaskCallback& A, const FVoxelPendingTaskCallback& B)
+	{
+		if (A.Priority != B.Priority)
+		{
+			return A.Priority > B.Priority;
+		}
+		return A.GroupId < B.GroupId;
+	});
+}
 
-			if (BuiltData.MainChunk->IsEmpty() && (!BuiltData.TransitionsChunk.IsValid() || BuiltData.TransitionsChunk->IsEmpty()))
+void FVoxelDefaultRenderer::ProcessTaskCallback(const FVoxelTaskCallback& Callback)
+{
+	VOXEL_FUNCTION_COUNTER();
+	
+	FChunk* Chunk = ChunksMap.Find(Callback.ChunkId);
+	if (!Chunk) return;
+
+	auto& Tasks = Chunk->Tasks;
+	auto& Task = Callback.bIsTransitionTask ? Tasks.TransitionsTask : Tasks.MainTask;
+	if (!Task.IsValid() || Task->TaskId != Callback.TaskId) return; // If task was canceled
+	if (!ensure(Task->IsDone())) return; // Must be done if we're in the callback
+
+	// Move built data
+	auto& BuiltData = Chunk->BuiltData;
+	const auto PreviousBuiltData = BuiltData;
+	if (Callback.bIsTransitionTask)
+	{
+		ensure(Task->TransitionsMask == Chunk->Settings.TransitionsMask); // Should have been canceled
+		BuiltData.TransitionsMask = Task->TransitionsMask;
+		BuiltData.TransitionsChunk = Task->Chunk;
+		BuiltData.TransitionsChunkCreationTime = Task->CreationTime;
+	}
+	else
+	{
+		BuiltData.MainChunk = Task->Chunk;
+		BuiltData.MainChunkCreationTime = Task->CreationTime;
+	}
+
+	// Finally, delete the task
+	Task.Reset();
+
+	// Do nothing while the main chunk isn't valid - we don't want to have unneeded updates for transitions then main
+	if (BuiltData.MainChunk.IsValid())
+	{
+		auto& MeshId = Chunk->MeshId;
+		const auto Update = [&]()
+		{
+			if (!MeshId.IsValid())
 			{
-				// Both empty, remove mesh if existing
-				if (MeshId.IsValid())
-				{
-					MeshHandler->RemoveChunk(MeshId);
-					MeshId = {};
-				}
+				MeshId = MeshHandler->AddChunk(Chunk->LOD, Chunk->Bounds.Min);
 			}
-			else
-			{
-				Update();
-				
-				ensure(MeshId.IsValid());
+			MeshHandler->UpdateChunk(MeshId, Chunk->Settings, *BuiltData.MainChunk, BuiltData.TransitionsChunk.Get(), BuiltData.TransitionsMask);
 
-				// Dither in if first update
-				// If first load and LOD 0, don't dither as it doesn't look nice to have the world dithering under the player
-				if (Settings.bDitherChunks &&
-					!PreviousBuiltData.MainChunk.IsValid() && 
-					!(UpdateIndex == 1 && Chunk->LOD == 0))
-				{
-					// Can be a first update if:
-					// - we are a showed new chunks that's dithering in
-					// - we are a hidden chunk that's updated for the first time. If so don't dither in
-					ensure(Chunk->GetState() == EChunkState::Hidden || Chunk->GetState() == EChunkState::DitheringIn);
-					if (Chunk->GetState() == EChunkState::DitheringIn)
-					{
-						DitherInChunk(*Chunk, Chunk->PreviousChunks);
-					}
-				}
+			if (Settings.bStaticWorld)
+			{
+				// Free up memory ASAP
+				BuiltData.MainChunk.Reset();
+				BuiltData.TransitionsChunk.Reset();
 			}
+		};
+
+		// Surface nets do not wait for their transitions: the low res chunk needs to dither at the same time as the high res one
+		const bool bTransitionsChunkIsBuilt =
+			BuiltData.TransitionsChunk.IsValid() ||
+			Chunk->Settings.TransitionsMask == 0 ||
+			Settings.RenderType == EVoxelRenderType::SurfaceNets;
 
-			// Dither out/remove previous chunks only once transitions are built too
-			// Note: bTransitionsChunkIsBuilt is always true for surface nets
-			if (bTransitionsChunkIsBuilt)
+		if (BuiltData.MainChunk->IsEmpty() && (!BuiltData.TransitionsChunk.IsValid() || BuiltData.TransitionsChunk->IsEmpty()))
+		{
+			// Both empty, remove mesh if existing
+			if (MeshId.IsValid())
 			{
-				ClearPreviousChunks(*Chunk);
+				MeshHandler->RemoveChunk(MeshId);
+				MeshId = {};
 			}
 		}
 		else
 		{
-			ensure(!Chunk->MeshId.IsValid());
+			Update();
+			
+			ensure(MeshId.IsValid());
+
+			// Dither in if first update
+			// If first load and LOD 0, don't dither as it doesn't look nice to have the world dithering under the player
+			if (Settings.bDitherChunks &&
+				!PreviousBuiltData.MainChunk.IsValid() && 
+				!(UpdateIndex == 1 && Chunk->LOD == 0))
+			{
+				// Can be a first update if:
+				// - we are a showed new chunks that's dithering in
+				// - we are a hidden chunk that's updated for the first time. If so don't dither in
+				ensure(Chunk->GetState() == EChunkState::Hidden || Chunk->GetState() == EChunkState::DitheringIn);
+				if (Chunk->GetState() == EChunkState::DitheringIn)
+				{
+					DitherInChunk(*Chunk, Chunk->PreviousChunks);
+				}
+			}
 		}
 
-		// Start new tasks as needed
-		CheckPendingUpdates(*Chunk);
+		// Dither out/remove previous chunks only once transitions are built too
+		// Note: bTransitionsChunkIsBuilt is always true for surface nets
+		if (bTransitionsChunkIsBuilt)
+		{
+			ClearPreviousChunks(*Chunk);
+		}
 	}
+	else
+	{
+		ensure(!Chunk->MeshId.IsValid());
+	}
+
+	// Start new tasks as needed
+	CheckPendingUpdates(*Chunk);
 }
 
 void FVoxelDefaultRenderer::FlushQueuedTasks()
@@ -1330,6 +1428,7 @@ void FVoxelDefaultRenderer::UpdateAllocatedSize()
 	AllocatedSize += ChunksMap.GetAllocatedSize();
 	AllocatedSize += ChunksToRemove.GetAllocatedSize();
 	AllocatedSize += ChunksToShow.GetAllocatedSize();
+	AllocatedSize += PendingTasksCallbacks.GetAllocatedSize();
 	
 	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelRenderer, AllocatedSize);
 }
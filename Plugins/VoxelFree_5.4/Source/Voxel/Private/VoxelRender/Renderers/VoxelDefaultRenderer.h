@@ -40,7 +40,7 @@ public:
 		int32 LOD,
 		const FIntVector& ChunkPosition,
 		TArray<uint32>& OutIndices,
-		TArray<FVector>& OutVertices) const override;
+		TArray<FVector3f>& OutVertices) const override;
 	//~ End IVoxelRender Interface
 
 	//~ Begin FVoxelTickable Interface
@@ -183,6 +183,7 @@ private:
 	
 	void ProcessChunksToRemoveOrShow();
 	void ProcessMeshUpdates(double MaxTime);
+	void SortTasksCallbacks();
 	void FlushQueuedTasks();
 
 	void DestroyChunk(FChunk& Chunk);
@@ -216,5 +217,18 @@ private:
 	};
 	TVoxelQueueWithNum<FVoxelTaskCallback, EQueueMode::Mpsc> TasksCallbacksQueue;
 
+	struct FVoxelPendingTaskCallback
+	{
+		FVoxelTaskCallback Callback;
+		// Chunks replacing the same previous chunk share the same group, and are applied in the same frame
+		uint64 GroupId;
+		// Priority of the most important chunk of the group
+		uint32 Priority;
+	};
+	// Callbacks dequeued from TasksCallbacksQueue, sorted by priority
+	TArray<FVoxelPendingTaskCallback> PendingTasksCallbacks;
+
+	void ProcessTaskCallback(const FVoxelTaskCallback& Callback);
+
 	void CancelTask(TUniquePtr<FVoxelMesherAsyncWork, TVoxelAsyncWorkDelete<FVoxelMesherAsyncWork>>& Task);
 };
\ No newline at end of file
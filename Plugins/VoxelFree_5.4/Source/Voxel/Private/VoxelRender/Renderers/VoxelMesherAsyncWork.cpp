@@ -90,7 +90,7 @@ void FVoxelMesherAsyncWork::DoWork()
 		// If we're not rendering the world, we only need the geometry for collisions/navmesh
 
 		TArray<uint32> Indices;
-		TArray<FVector> Vertices;
+		TArray<FVector3f> Vertices;
 		Mesher->CreateGeometry(Indices, Vertices);
 		
 		Chunk = MakeVoxelShared<FVoxelChunkMesh>();
@@ -99,6 +99,7 @@ void FVoxelMesherAsyncWork::DoWork()
 
 		Buffers.Indices = MoveTemp(Indices);
 		Buffers.Positions = MoveTemp(Vertices);
+		Buffers.Shrink(); // Also updates the memory stats
 	}
 	
 	FVoxelUtilities::DeleteOnGameThread_AnyThread(PinnedRenderer);
@@ -159,8 +160,7 @@ TUniquePtr<FVoxelMesherBase> FVoxelMesherAsyncWork::GetMesher(
 	{
 		if (bIsTransitionTask)
 		{
-			check(false);
-			return nullptr;
+			return MakeUnique<FVoxelSurfaceNetTransitionsMesher>(LOD, ChunkPosition, Settings, TransitionsMask);
 		}
 		else
 		{
@@ -175,7 +175,7 @@ void FVoxelMesherAsyncWork::CreateGeometry_AnyThread(
 	int32 LOD, 
 	const FIntVector& ChunkPosition, 
 	TArray<uint32>& OutIndices, 
-	TArray<FVector>& OutVertices)
+	TArray<FVector3f>& OutVertices)
 {
 	const auto Mesher = GetMesher(Renderer.Settings, LOD, ChunkPosition, false, 0);
 	Mesher->CreateGeometry(OutIndices, OutVertices);
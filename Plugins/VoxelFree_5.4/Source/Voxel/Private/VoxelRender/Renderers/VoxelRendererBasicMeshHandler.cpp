@@ -296,6 +296,7 @@ void FVoxelRendererBasicMeshHandler::FlushActionQueue(double MaxTime)
 					Mesh.AddProcMeshSection(Section.Key, MoveTemp(Section.Value), EVoxelProcMeshSectionUpdate::DelayUpdate);
 				}
 				Mesh.FinishSectionsUpdates();
+				QueueRenderDataInit(Mesh);
 
 				MeshIndex++;
 			}
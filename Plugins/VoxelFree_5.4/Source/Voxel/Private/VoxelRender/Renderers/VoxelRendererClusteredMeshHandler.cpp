@@ -27,7 +27,8 @@ public:
 			Cluster->Position,
 			Handler,
 			Cluster->UpdateIndex.ToSharedRef(),
-			Cluster->ChunkMeshesToBuild);
+			Cluster->ChunkMeshesToBuild,
+			Cluster->MergeState);
 	}
 
 private:
@@ -37,6 +38,7 @@ private:
 	const TVoxelWeakPtr<FVoxelRendererClusteredMeshHandler> Handler;
 
 	const TMap<uint64, TVoxelSharedPtr<const FVoxelChunkMeshesToBuild>> MeshesToBuild;
+	const TVoxelSharedPtr<const FVoxelRendererClusteredMeshHandler::FClusterMergeState> MergeState;
 	const TVoxelSharedRef<FThreadSafeCounter> UpdateIndexPtr;
 	const int32 UpdateIndex;
 	
@@ -45,13 +47,15 @@ private:
 		const FIntVector& Position,
 		FVoxelRendererClusteredMeshHandler& Handler,
 		const TVoxelSharedRef<FThreadSafeCounter>& UpdateIndexPtr,
-		const TMap<uint64, TVoxelSharedPtr<const FVoxelChunkMeshesToBuild>>& MeshesToBuild)
+		const TMap<uint64, TVoxelSharedPtr<const FVoxelChunkMeshesToBuild>>& MeshesToBuild,
+		const TVoxelSharedPtr<const FVoxelRendererClusteredMeshHandler::FClusterMergeState>& MergeState)
 		: FVoxelAsyncWork(STATIC_FNAME("FVoxelClusteredMeshMergeWork"), 1e9, true)
 		, ClusterRef(ClusterRef)
 		, Position(Position)
 		, RendererSettings(static_cast<const FVoxelRendererSettingsBase&>(Handler.Renderer.Settings))
 		, Handler(StaticCastVoxelSharedRef<FVoxelRendererClusteredMeshHandler>(Handler.AsShared()))
 		, MeshesToBuild(MeshesToBuild)
+		, MergeState(MergeState)
 		, UpdateIndexPtr(UpdateIndexPtr)
 		, UpdateIndex(UpdateIndexPtr->GetValue())
 	{
@@ -69,25 +73,61 @@ private:
 			// Canceled
 			return;
 		}
-		FVoxelChunkMeshesToBuild RealMap;
+		// Mesh config -> section settings -> sections of all the chunks to merge into it
+		TMap<FVoxelMeshConfig, TMap<FVoxelProcMeshSectionSettings, TArray<FVoxelKeyedChunkMeshSection>>> SectionsMap;
 		for (auto& ChunkIt : MeshesToBuild)
 		{
-			// Key is ChunkId = useless here
+			// Key is the chunk unique id: used to find the chunk in the previous merge
 			for (auto& MeshIt : *ChunkIt.Value)
 			{
-				auto& MeshMap = RealMap.FindOrAdd(MeshIt.Key);
+				auto& MeshMap = SectionsMap.FindOrAdd(MeshIt.Key);
 				for (auto& SectionIt : MeshIt.Value)
 				{
-					MeshMap.FindOrAdd(SectionIt.Key).Append(SectionIt.Value);
+					auto& Sections = MeshMap.FindOrAdd(SectionIt.Key);
+					for (int32 Index = 0; Index < SectionIt.Value.Num(); Index++)
+					{
+						Sections.Add({ ChunkIt.Key, Index, SectionIt.Value[Index] });
+					}
 				}
 			}
 		}
-		auto BuiltMeshes = FVoxelRenderUtilities::BuildMeshes_AnyThread(RealMap, RendererSettings, Position, *UpdateIndexPtr, UpdateIndex);
-		if (!BuiltMeshes.IsValid())
+
+		auto BuiltMeshes = MakeUnique<FVoxelRendererClusteredMeshHandler::FClusterBuiltMeshes>();
+		for (auto& MeshIt : SectionsMap)
 		{
-			// Canceled
-			return;
+			const auto* PreviousSections = MergeState.IsValid() ? MergeState->Find(MeshIt.Key) : nullptr;
+			
+			auto& BuiltSections = BuiltMeshes->Emplace_GetRef(MeshIt.Key, TArray<FVoxelRendererClusteredMeshHandler::FClusterBuiltSection>()).Value;
+			for (auto& SectionIt : MeshIt.Value)
+			{
+				const FVoxelProcMeshSectionSettings& SectionSettings = SectionIt.Key;
+				ensure(SectionSettings.bSectionVisible || SectionSettings.bEnableCollisions || SectionSettings.bEnableNavmesh);
+
+				FVoxelRendererClusteredMeshHandler::FClusterBuiltSection BuiltSection;
+				BuiltSection.Settings = SectionSettings;
+				BuiltSection.NewBuffers = FVoxelRenderUtilities::MergeSectionsIfChanged_AnyThread(
+					RendererSettings,
+					SectionIt.Value,
+					Position,
+					PreviousSections ? PreviousSections->Find(SectionSettings) : nullptr,
+					BuiltSection.Merged,
+					*UpdateIndexPtr,
+					UpdateIndex);
+
+				if (UpdateIndexPtr->GetValue() > UpdateIndex)
+				{
+					// Canceled
+					return;
+				}
+				if (!BuiltSection.NewBuffers.IsValid() && !BuiltSection.Merged.Buffers.IsValid())
+				{
+					continue;
+				}
+				
+				BuiltSections.Add(MoveTemp(BuiltSection));
+			}
 		}
+		
 		auto HandlerPinned = Handler.Pin();
 		if (HandlerPinned.IsValid())
 		{
@@ -344,6 +384,7 @@ void FVoxelRendererClusteredMeshHandler::FlushActionQueue(double MaxTime)
 			int32 MeshIndex = 0;
 			CleanUp(Cluster.Meshes);
 			// Apply built meshes
+			const auto NewMergeState = MakeVoxelShared<FClusterMergeState>();
 			for (auto& BuiltMesh : *BuiltMeshes)
 			{
 				const FVoxelMeshConfig& MeshConfig = BuiltMesh.Key;
@@ -358,16 +399,26 @@ void FVoxelRendererClusteredMeshHandler::FlushActionQueue(double MaxTime)
 				auto& Mesh = *Cluster.Meshes[MeshIndex];
 				MeshConfig.ApplyTo(Mesh);
 
+				auto& MergedSections = NewMergeState->FindOrAdd(MeshConfig);
+				
 				Mesh.SetDistanceFieldData(nullptr);
 				Mesh.ClearSections(EVoxelProcMeshSectionUpdate::DelayUpdate);
 				for (auto& Section : BuiltMesh.Value)
 				{
-					Mesh.AddProcMeshSection(Section.Key, MoveTemp(Section.Value), EVoxelProcMeshSectionUpdate::DelayUpdate);
+					// Sections whose chunks didn't change keep the same buffers, and don't need to be uploaded again
+					if (Section.NewBuffers.IsValid())
+					{
+						Section.Merged.Buffers = MakeShareable(Section.NewBuffers.Release());
+					}
+					Mesh.AddProcMeshSection(Section.Settings, Section.Merged.Buffers.ToSharedRef(), EVoxelProcMeshSectionUpdate::DelayUpdate);
+					MergedSections.Add(Section.Settings, MoveTemp(Section.Merged));
 				}
 				Mesh.FinishSectionsUpdates();
+				QueueRenderDataInit(Mesh);
 
 				MeshIndex++;
 			}
+			Cluster.MergeState = NewMergeState;
 
 			// Clear unused meshes
 			for (; MeshIndex < Cluster.Meshes.Num(); MeshIndex++)
@@ -377,20 +428,9 @@ void FVoxelRendererClusteredMeshHandler::FlushActionQueue(double MaxTime)
 				Mesh.ClearSections(EVoxelProcMeshSectionUpdate::UpdateNow);
 			}
 
-			// Handle distance fields
-			const auto& DistanceFieldVolumeData = Action.UpdateChunk().AfterCall.DistanceFieldVolumeData;
-			if (DistanceFieldVolumeData.IsValid())
-			{
-#if 0
-				// Use the first mesh to hold the distance field data
-				// We should always have at least one mesh, else the chunk should have been removed instead of updated
-				if (ensure(Cluster.Meshes.Num() > 0))
-				{
-					Cluster.Meshes[0]->SetDistanceFieldData(DistanceFieldVolumeData);
-				}
-#endif
-				// TODO: No distance fields with merging = on
-			}
+			// No distance fields with merging on: a cluster mesh holds many chunks, but a primitive can only have one distance field
+			// The renderer settings don't build them in that case
+			ensure(!Action.UpdateChunk().AfterCall.DistanceFieldVolumeData.IsValid());
 			break;
 		}
 		case EAction::RemoveChunk:
@@ -429,7 +469,7 @@ void FVoxelRendererClusteredMeshHandler::FlushActionQueue(double MaxTime)
 	}
 }
 
-void FVoxelRendererClusteredMeshHandler::MeshMergeCallback(FClusterRef ClusterRef, int32 UpdateIndex, TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes)
+void FVoxelRendererClusteredMeshHandler::MeshMergeCallback(FClusterRef ClusterRef, int32 UpdateIndex, TUniquePtr<FClusterBuiltMeshes> BuiltMeshes)
 {
 	CallbackQueue.Enqueue({ ClusterRef, FClusterBuiltData{ UpdateIndex,  MoveTemp(BuiltMeshes) } });
 }
\ No newline at end of file
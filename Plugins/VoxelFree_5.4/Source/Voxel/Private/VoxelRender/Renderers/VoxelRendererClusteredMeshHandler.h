@@ -25,10 +25,22 @@ public:
 private:
 	DEFINE_TYPED_VOXEL_SPARSE_ARRAY_ID(FClusterId);
 	
+	// Merged sections currently used by a cluster
+	using FClusterMergeState = TMap<FVoxelMeshConfig, TMap<FVoxelProcMeshSectionSettings, FVoxelMergedSection>>;
+	
+	struct FClusterBuiltSection
+	{
+		FVoxelProcMeshSectionSettings Settings;
+		// Null if none of the chunks of this section changed: Merged.Buffers is then reused
+		TUniquePtr<FVoxelProcMeshBuffers> NewBuffers;
+		FVoxelMergedSection Merged;
+	};
+	using FClusterBuiltMeshes = TArray<TPair<FVoxelMeshConfig, TArray<FClusterBuiltSection>>>;
+	
 	struct FClusterBuiltData
 	{
 		int32 UpdateIndex = -1;
-		TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes;
+		TUniquePtr<FClusterBuiltMeshes> BuiltMeshes;
 	};
 	struct FCluster
 	{
@@ -50,6 +62,10 @@ private:
 		// Processed data waiting to be displayed
 		FClusterBuiltData BuiltData;
 
+		// Used by the merge tasks to reuse the buffers of the sections whose chunks didn't change
+		// Shared ptr: used by build task
+		TVoxelSharedPtr<const FClusterMergeState> MergeState;
+
 		// Chunk unique id -> its meshes
 		// Shared ptr: used by build task
 		TMap<uint64, TVoxelSharedPtr<const FVoxelChunkMeshesToBuild>> ChunkMeshesToBuild;
@@ -139,7 +155,7 @@ private:
 
 	void FlushBuiltDataQueue();
 	void FlushActionQueue(double MaxTime);
-	void MeshMergeCallback(FClusterRef ClusterRef, int32 UpdateIndex, TUniquePtr<FVoxelBuiltChunkMeshes> BuiltMeshes);
+	void MeshMergeCallback(FClusterRef ClusterRef, int32 UpdateIndex, TUniquePtr<FClusterBuiltMeshes> BuiltMeshes);
 
 	friend class FVoxelClusteredMeshMergeWork;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "VoxelRender/VoxelProceduralMeshComponent.h"
 #include "VoxelRender/IVoxelRenderer.h"
 #include "VoxelRender/VoxelRenderUtilities.h"
+#include "VoxelRender/VoxelProceduralMeshSceneProxy.h"
 
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Voxel Proc Mesh Pool"), STAT_VoxelProcMeshPool, STATGROUP_VoxelCounters);
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Voxel Proc Mesh Frozen Pool"), STAT_VoxelProcMeshFrozenPool, STATGROUP_VoxelCounters);
@@ -33,6 +34,8 @@ IVoxelRendererMeshHandler::~IVoxelRendererMeshHandler()
 	check(bIsInit);
 	ensure(bIsDestroying);
 	
+	FVoxelProcMeshBuffersRenderData::ReleaseBatch_GameThread(RenderDataBatch);
+	
 	// Avoid crashes
 	if (GExitPurge) return;
 	
@@ -207,6 +210,20 @@ void IVoxelRendererMeshHandler::Tick(double MaxTime)
 	TickHandler();
 }
 
+void IVoxelRendererMeshHandler::FlushRenderDataInits()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	// The proxies created at the end of the last frame hold their own references
+	FVoxelProcMeshBuffersRenderData::ReleaseBatch_GameThread(RenderDataBatch);
+
+	if (RenderDataToInit.Num() > 0)
+	{
+		RenderDataBatch = FVoxelProcMeshBuffersRenderData::InitBatch_GameThread(MoveTemp(RenderDataToInit), RenderDataFeatureLevel);
+		RenderDataToInit.Reset();
+	}
+}
+
 void IVoxelRendererMeshHandler::RecomputeMeshPositions()
 {
 	VOXEL_FUNCTION_COUNTER();
@@ -241,6 +258,24 @@ void IVoxelRendererMeshHandler::StartDestroying()
 	bIsDestroying = true;
 }
 
+void IVoxelRendererMeshHandler::QueueRenderDataInit(const UVoxelProceduralMeshComponent& Mesh)
+{
+	if (!Renderer.Settings.bRenderWorld || !Mesh.IsVisible())
+	{
+		return;
+	}
+
+	const FSceneInterface* Scene = Mesh.GetScene();
+	if (!Scene)
+	{
+		return;
+	}
+
+	ensure(RenderDataToInit.Num() == 0 || RenderDataFeatureLevel == Scene->GetFeatureLevel());
+	RenderDataFeatureLevel = Scene->GetFeatureLevel();
+	Mesh.GetVisibleSectionsBuffers(RenderDataToInit);
+}
+
 UVoxelProceduralMeshComponent* IVoxelRendererMeshHandler::GetNewMesh(FChunkId ChunkId, const FIntVector& Position, uint8 LOD)
 {
 	VOXEL_FUNCTION_COUNTER();
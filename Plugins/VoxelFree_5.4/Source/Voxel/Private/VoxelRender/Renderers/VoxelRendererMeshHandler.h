@@ -7,6 +7,7 @@
 #include "VoxelContainers/VoxelSparseArray.h"
 #include "VoxelRender/VoxelChunkToUpdate.h"
 #include "VoxelRender/IVoxelProceduralMeshComponent_PhysicsCallbackHandler.h"
+#include "RHIDefinitions.h"
 
 enum class EDitheringType : uint8;
 struct FVoxelChunkSettings;
@@ -15,6 +16,8 @@ struct FVoxelIntBox;
 class IVoxelRenderer;
 class FDistanceFieldVolumeData;
 class UVoxelProceduralMeshComponent;
+class FVoxelProcMeshBuffersRenderData;
+struct FVoxelProcMeshBuffers;
 template <class T>
 class TAutoConsoleVariable;
 
@@ -57,6 +60,8 @@ public:
 	virtual void ClearChunkMaterials() = 0;
 
 	virtual void Tick(double MaxTime);
+	// Create the render data of all the meshes updated since the last call in a single render command
+	virtual void FlushRenderDataInits();
 
 public:
 	virtual void RecomputeMeshPositions();
@@ -70,6 +75,8 @@ public:
 	
 protected:
 	UVoxelProceduralMeshComponent* GetNewMesh(FChunkId ChunkId, const FIntVector& Position, uint8 LOD);
+	// Call after FinishSectionsUpdates
+	void QueueRenderDataInit(const UVoxelProceduralMeshComponent& Mesh);
 	void RemoveMesh(UVoxelProceduralMeshComponent& Mesh);
 	TArray<TWeakObjectPtr<UVoxelProceduralMeshComponent>>& CleanUp(TArray<TWeakObjectPtr<UVoxelProceduralMeshComponent>>& Meshes) const;
 
@@ -144,6 +151,12 @@ private:
 	// Used to skip clearing mesh sections when the renderer is destroying
 	bool bIsDestroying = false;
 
+	// Buffers of the meshes updated since the last FlushRenderDataInits
+	TArray<TVoxelSharedRef<const FVoxelProcMeshBuffers>> RenderDataToInit;
+	ERHIFeatureLevel::Type RenderDataFeatureLevel = ERHIFeatureLevel::Num;
+	// Keeps the render data alive until the proxies of the meshes are created
+	TVoxelSharedPtr<TArray<TVoxelSharedPtr<FVoxelProcMeshBuffersRenderData>>> RenderDataBatch;
+
 #if CHECK_CHUNK_IDS
 	TSet<FChunkId> ValidIndices;
 #endif
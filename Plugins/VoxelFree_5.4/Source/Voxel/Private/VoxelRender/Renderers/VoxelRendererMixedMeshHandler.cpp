@@ -132,6 +132,14 @@ void FVoxelRendererMixedMeshHandler::Tick(double MaxTime)
 	ClusteredMeshHandler->Tick(MaxTime);
 }
 
+void FVoxelRendererMixedMeshHandler::FlushRenderDataInits()
+{
+	IVoxelRendererMeshHandler::FlushRenderDataInits();
+
+	BasicMeshHandler->FlushRenderDataInits();
+	ClusteredMeshHandler->FlushRenderDataInits();
+}
+
 void FVoxelRendererMixedMeshHandler::RecomputeMeshPositions()
 {
 	VOXEL_FUNCTION_COUNTER();
@@ -19,6 +19,7 @@ public:
 	virtual void ApplyAction(const FAction& Action) override;
 	virtual void ClearChunkMaterials() override;
 	virtual void Tick(double MaxTime) override;
+	virtual void FlushRenderDataInits() override;
 
 	virtual void RecomputeMeshPositions() override;
 	virtual void ApplyToAllMeshes(TFunctionRef<void(UVoxelProceduralMeshComponent&)> Lambda) override;
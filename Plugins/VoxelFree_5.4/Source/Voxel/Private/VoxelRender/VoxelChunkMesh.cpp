@@ -7,6 +7,8 @@
 
 #include "Materials/MaterialInstanceDynamic.h"
 #include "DistanceFieldAtlas.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
 
 #if ENABLE_TESSELLATION
 #include "ThirdParty/nvtesslib/inc/nvtess.h"
@@ -17,6 +19,19 @@
 #endif
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelChunkMeshMemory);
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelChunkMeshPoolMemory);
+
+static TAutoConsoleVariable<int32> CVarPoolMeshBuffers(
+	TEXT("voxel.renderer.PoolMeshBuffers"),
+	1,
+	TEXT("If true, the allocations of the chunk mesh buffers will be recycled between rebuilds instead of being freed"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMeshBufferPoolSize(
+	TEXT("voxel.renderer.MeshBufferPoolSize"),
+	64,
+	TEXT("Max memory kept by the chunk mesh buffers pool, in MB"),
+	ECVF_Default);
 
 #if ENABLE_TESSELLATION
 /**
@@ -28,7 +43,7 @@ public:
 
 	/** Construct from static mesh render buffers. */
 	FVoxelStaticMeshNvRenderBuffer(
-		const TArray<FVector>& InPositionVertexBuffer,
+		const TArray<FVector3f>& InPositionVertexBuffer,
 		const TArray<uint32>& Indices)
 		: PositionVertexBuffer(InPositionVertexBuffer)
 	{
@@ -40,7 +55,7 @@ public:
 	{
 		nv::Vertex Vertex;
 
-		const FVector& Position = PositionVertexBuffer[Index];
+		const FVector3f& Position = PositionVertexBuffer[Index];
 		Vertex.pos.x = Position.X;
 		Vertex.pos.y = Position.Y;
 		Vertex.pos.z = Position.Z;
@@ -53,7 +68,7 @@ public:
 
 private:
 	/** The position vertex buffer for the static mesh. */
-	const TArray<FVector>& PositionVertexBuffer;
+	const TArray<FVector3f>& PositionVertexBuffer;
 
 	/** Copying is forbidden. */
 	FVoxelStaticMeshNvRenderBuffer(const FVoxelStaticMeshNvRenderBuffer&) = delete;
@@ -91,26 +106,192 @@ void FVoxelChunkMeshBuffers::BuildAdjacency(TArray<uint32>& OutAdjacencyIndices)
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace FVoxelChunkMeshBufferPoolImpl
+{
+	// Shared by all the element types, so that the size limit is global
+	static FThreadSafeCounter64 PoolSize;
+
+	template<typename T>
+	class TArrayPool
+	{
+	public:
+		static TArrayPool& Get()
+		{
+			static TArrayPool Pool;
+			return Pool;
+		}
+
+		bool Allocate(TArray<T>& Array, int32 Num)
+		{
+			const int32 Class = FMath::CeilLogTwo(Num);
+
+			FScopeLock Lock(&Section);
+			// Also look one class up: better to waste some memory than to hit the allocator
+			for (int32 Index = Class; Index < FMath::Min(Class + 2, NumClasses); Index++)
+			{
+				auto& Bucket = Buckets[Index];
+				if (Bucket.Num() > 0)
+				{
+					Array = Bucket.Pop(false);
+					checkVoxelSlow(Array.Max() >= Num);
+
+					const int64 Size = Array.GetAllocatedSize();
+					PoolSize.Subtract(Size);
+					DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkMeshPoolMemory, Size);
+					return true;
+				}
+			}
+			return false;
+		}
+		void Release(TArray<T>& Array)
+		{
+			const int64 Size = Array.GetAllocatedSize();
+			const int64 MaxSize = int64(CVarMeshBufferPoolSize.GetValueOnAnyThread()) << 20;
+			if (PoolSize.Add(Size) + Size > MaxSize)
+			{
+				// Pool is full
+				PoolSize.Subtract(Size);
+				Array.Empty();
+				return;
+			}
+			INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkMeshPoolMemory, Size);
+
+			Array.Reset();
+			const int32 Class = FMath::FloorLog2(Array.Max());
+			
+			FScopeLock Lock(&Section);
+			Buckets[Class].Add(MoveTemp(Array));
+		}
+
+	private:
+		static constexpr int32 NumClasses = 32;
+		
+		FCriticalSection Section;
+		// Arrays in bucket N have a capacity in [2^N, 2^(N+1)[
+		TArray<TArray<T>> Buckets[NumClasses];
+	};
+}
+
+bool FVoxelChunkMeshBufferPool::IsEnabled()
+{
+	return CVarPoolMeshBuffers.GetValueOnAnyThread() != 0;
+}
+
+template<typename T>
+void FVoxelChunkMeshBufferPool::Allocate(TArray<T>& Array, int32 Num)
+{
+	ensureVoxelSlow(Array.Num() == 0);
+	
+	if (Num <= 0 || Array.Max() >= Num)
+	{
+		return;
+	}
+	
+	if (!IsEnabled())
+	{
+		Array.Reserve(Num);
+		return;
+	}
+
+	Release(Array);
+	if (!FVoxelChunkMeshBufferPoolImpl::TArrayPool<T>::Get().Allocate(Array, Num))
+	{
+		Array.Reserve(Num);
+	}
+}
+
+template<typename T>
+void FVoxelChunkMeshBufferPool::Release(TArray<T>& Array)
+{
+	if (Array.Max() == 0)
+	{
+		return;
+	}
+	
+	if (!IsEnabled())
+	{
+		Array.Empty();
+		return;
+	}
+
+	FVoxelChunkMeshBufferPoolImpl::TArrayPool<T>::Get().Release(Array);
+}
+
+template<typename T>
+void FVoxelChunkMeshBufferPool::Trim(TArray<T>& Array)
+{
+	// Up to 1/8 of slack isn't worth a reallocation
+	if (Array.Max() - Array.Num() <= Array.Num() / 8)
+	{
+		return;
+	}
+
+	if (!IsEnabled())
+	{
+		Array.Shrink();
+		return;
+	}
+
+	TArray<T> TrimmedArray;
+	TrimmedArray.Reserve(Array.Num());
+	TrimmedArray.Append(Array);
+	Release(Array);
+	Array = MoveTemp(TrimmedArray);
+}
+
+#define INSTANTIATE(T) \
+	template VOXEL_API void FVoxelChunkMeshBufferPool::Allocate<T>(TArray<T>&, int32); \
+	template VOXEL_API void FVoxelChunkMeshBufferPool::Release<T>(TArray<T>&); \
+	template VOXEL_API void FVoxelChunkMeshBufferPool::Trim<T>(TArray<T>&);
+
+INSTANTIATE(uint32);
+INSTANTIATE(FVector3f);
+INSTANTIATE(FVoxelPackedNormal);
+INSTANTIATE(FVoxelProcMeshTangent);
+INSTANTIATE(FColor);
+INSTANTIATE(FVector2f);
+
+#undef INSTANTIATE
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelChunkMeshBuffers::~FVoxelChunkMeshBuffers()
+{
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkMeshMemory, LastAllocatedSize);
+
+	FVoxelChunkMeshBufferPool::Release(Indices);
+	FVoxelChunkMeshBufferPool::Release(Positions);
+	FVoxelChunkMeshBufferPool::Release(Normals);
+	FVoxelChunkMeshBufferPool::Release(Tangents);
+	FVoxelChunkMeshBufferPool::Release(Colors);
+	for (auto& T : TextureCoordinates) FVoxelChunkMeshBufferPool::Release(T);
+}
+
 void FVoxelChunkMeshBuffers::OptimizeIndices()
 {
 #if ENABLE_OPTIMIZE_INDICES
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
-	TArray<uint32> OptimizedIndices;
-	OptimizedIndices.AddUninitialized(Indices.Num());
+	// Reuse the output of the previous calls on this thread
+	static thread_local TArray<uint32> OptimizedIndices;
+	OptimizedIndices.SetNumUninitialized(Indices.Num(), false);
 	const uint16 CacheSize = 32;
 	Forsyth::OptimizeFaces(Indices.GetData(), Indices.Num(), GetNumVertices(), OptimizedIndices.GetData(), CacheSize);
-	Indices = MoveTemp(OptimizedIndices);
+	FMemory::Memcpy(Indices.GetData(), OptimizedIndices.GetData(), Indices.Num() * sizeof(uint32));
 #endif
 }
 
 void FVoxelChunkMeshBuffers::Shrink()
 {
-	Positions.Shrink();
-	Normals.Shrink();
-	Tangents.Shrink();
-	Colors.Shrink();
-	for (auto& T : TextureCoordinates) T.Shrink();
+	// The buffers are kept until the chunk is rebuilt: don't keep the slack of the pooled allocations around
+	FVoxelChunkMeshBufferPool::Trim(Indices);
+	FVoxelChunkMeshBufferPool::Trim(Positions);
+	FVoxelChunkMeshBufferPool::Trim(Normals);
+	FVoxelChunkMeshBufferPool::Trim(Tangents);
+	FVoxelChunkMeshBufferPool::Trim(Colors);
+	for (auto& T : TextureCoordinates) FVoxelChunkMeshBufferPool::Trim(T);
 
 	UpdateStats();
 }
@@ -120,7 +301,7 @@ void FVoxelChunkMeshBuffers::ComputeBounds()
 	Bounds = FBox(ForceInit);
 	for (auto& Vertex : Positions)
 	{
-		Bounds += Vertex;
+		Bounds += FVector(Vertex);
 	}
 }
 
@@ -140,6 +321,174 @@ void FVoxelChunkMeshBuffers::UpdateStats()
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FIntVector& Position, const FVoxelData& Data, const FVoxelRendererSettingsBase& Settings)
+void FVoxelChunkMesh::BuildDistanceField(int32 LOD, const FVoxelChunkDistanceFieldValues& Values, const FVoxelRendererSettingsBase& Settings)
 {
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	if (!Values.Values || !ensure(Values.Size > 3))
+	{
+		// Mesher doesn't cache its values
+		return;
+	}
+
+	const int32 Step = 1 << LOD;
+
+	// Values are clamped densities: find the surface between them, and flood it to get actual distances
+	// The distances are in steps, on a grid starting at the second value
+	const FIntVector Size(Values.Size - 2);
+	TArray<float> Distances;
+	TArray<FVector3f> SurfacePositions;
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Distances");
+		
+		const TArrayView<const FVoxelValue> Densities(Values.Values, Values.Size * Values.Size * Values.Size);
+		FVoxelDistanceFieldUtilities::GetSurfacePositionsFromDensities(Size, Densities, Distances, SurfacePositions);
+		if (!SurfacePositions.ContainsByPredicate(&FVoxelDistanceFieldUtilities::IsSurfacePositionValid))
+		{
+			return;
+		}
+		FVoxelDistanceFieldUtilities::JumpFlood(Size, SurfacePositions);
+		FVoxelDistanceFieldUtilities::GetDistancesFromSurfacePositions(Size, SurfacePositions, Distances);
+	}
+
+	const FVector3f GridOrigin = FVector3f(Values.Offset + 1) * Step;
+	const auto SampleDistance = [&](const FVector3f& LocalPosition)
+	{
+		const FVector3f GridPosition = (LocalPosition - GridOrigin) / Step;
+		const FVector3f ClampedPosition = GridPosition.BoundToBox(FVector3f(0.f), FVector3f(Size - 1));
+		const FIntVector Min(
+			FMath::Min(FMath::FloorToInt(ClampedPosition.X), Size.X - 2),
+			FMath::Min(FMath::FloorToInt(ClampedPosition.Y), Size.Y - 2),
+			FMath::Min(FMath::FloorToInt(ClampedPosition.Z), Size.Z - 2));
+		const FVector3f Alpha = ClampedPosition - FVector3f(Min);
+
+		const auto Get = [&](int32 X, int32 Y, int32 Z) { return FVoxelUtilities::Get3D(Distances, Size, Min.X + X, Min.Y + Y, Min.Z + Z); };
+		const float Distance = FVoxelUtilities::TrilinearInterpolation(
+			Get(0, 0, 0), Get(1, 0, 0), Get(0, 1, 0), Get(1, 1, 0),
+			Get(0, 0, 1), Get(1, 0, 1), Get(0, 1, 1), Get(1, 1, 1),
+			Alpha.X, Alpha.Y, Alpha.Z);
+
+		// Outside of the values: the surface is at least that much further away
+		const float DistanceToGrid = FVector3f::Distance(GridPosition, ClampedPosition);
+		return (Distance + FMath::Sign(Distance) * DistanceToGrid) * Step;
+	};
+
+	// Same layout as the sparse distance fields built by the engine for static meshes, see DistanceFieldAtlas.h
+	const FBox3f LocalSpaceMeshBounds = FBox3f(FVector3f(0.f), FVector3f(RENDER_CHUNK_SIZE * Step)).ExpandBy(Settings.DistanceFieldBoundsExtension);
+	const float LocalToVolumeScale = 1.f / LocalSpaceMeshBounds.GetExtent().GetMax();
+	// RENDER_CHUNK_SIZE voxels per chunk side by default
+	const float NumVoxelsPerLocalSpaceUnit = 1.f / (Step * FMath::Max(1, Settings.DistanceFieldResolutionDivisor));
+	
+	const FVector3f DesiredDimensions = LocalSpaceMeshBounds.GetSize() * NumVoxelsPerLocalSpaceUnit / float(DistanceField::UniqueDataBrickSize);
+	const FIntVector Mip0IndirectionDimensions(
+		FMath::Clamp(FMath::RoundToInt(DesiredDimensions.X), 1, DistanceField::MaxIndirectionDimension),
+		FMath::Clamp(FMath::RoundToInt(DesiredDimensions.Y), 1, DistanceField::MaxIndirectionDimension),
+		FMath::Clamp(FMath::RoundToInt(DesiredDimensions.Z), 1, DistanceField::MaxIndirectionDimension));
+
+	constexpr int32 BrickSize = DistanceField::BrickSize;
+	constexpr int32 BrickSizeCubed = BrickSize * BrickSize * BrickSize;
+
+	const auto VolumeData = MakeVoxelShared<FDistanceFieldVolumeData>();
+	VolumeData->LocalSpaceMeshBounds = LocalSpaceMeshBounds;
+	VolumeData->bMostlyTwoSided = false;
+
+	TArray<uint8> StreamableMipData;
+	for (int32 MipIndex = 0; MipIndex < DistanceField::NumMips; MipIndex++)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Mip");
+		
+		const FIntVector IndirectionDimensions(
+			FMath::DivideAndRoundUp(Mip0IndirectionDimensions.X, 1 << MipIndex),
+			FMath::DivideAndRoundUp(Mip0IndirectionDimensions.Y, 1 << MipIndex),
+			FMath::DivideAndRoundUp(Mip0IndirectionDimensions.Z, 1 << MipIndex));
+		const FIntVector NumUniqueVoxels = IndirectionDimensions * DistanceField::UniqueDataBrickSize;
+
+		// Expand to guarantee one voxel border for gradient reconstruction using bilinear filtering
+		const FVector3f TexelObjectSpaceSize = LocalSpaceMeshBounds.GetSize() / FVector3f(NumUniqueVoxels - FIntVector(2 * DistanceField::MeshDistanceFieldObjectBorder));
+		const FBox3f DistanceFieldVolumeBounds = LocalSpaceMeshBounds.ExpandBy(TexelObjectSpaceSize);
+
+		const FVector3f IndirectionVoxelSize = DistanceFieldVolumeBounds.GetSize() / FVector3f(IndirectionDimensions);
+		const FVector3f DistanceFieldVoxelSize = IndirectionVoxelSize / float(DistanceField::UniqueDataBrickSize);
+		const float LocalSpaceTraceDistance = DistanceFieldVoxelSize.GetMax() * DistanceField::BandSizeInVoxels;
+		const FVector2f DistanceFieldToVolumeScaleBias(2.f * LocalSpaceTraceDistance * LocalToVolumeScale, -LocalSpaceTraceDistance * LocalToVolumeScale);
+
+		TArray<uint32> IndirectionTable;
+		IndirectionTable.Init(DistanceField::InvalidBrickIndex, IndirectionDimensions.X * IndirectionDimensions.Y * IndirectionDimensions.Z);
+		TArray<uint8> BrickData;
+		
+		for (int32 Z = 0; Z < IndirectionDimensions.Z; Z++)
+		{
+			for (int32 Y = 0; Y < IndirectionDimensions.Y; Y++)
+			{
+				for (int32 X = 0; X < IndirectionDimensions.X; X++)
+				{
+					const FVector3f BrickMinPosition = DistanceFieldVolumeBounds.Min + FVector3f(X, Y, Z) * IndirectionVoxelSize;
+					
+					uint8 Brick[BrickSizeCubed];
+					uint8 MinDistance = MAX_uint8;
+					uint8 MaxDistance = 0;
+					for (int32 VZ = 0; VZ < BrickSize; VZ++)
+					{
+						for (int32 VY = 0; VY < BrickSize; VY++)
+						{
+							for (int32 VX = 0; VX < BrickSize; VX++)
+							{
+								const FVector3f VoxelPosition = BrickMinPosition + FVector3f(VX, VY, VZ) * DistanceFieldVoxelSize;
+								const float VolumeSpaceDistance = SampleDistance(VoxelPosition) * LocalToVolumeScale;
+								const float RescaledDistance = (VolumeSpaceDistance - DistanceFieldToVolumeScaleBias.Y) / DistanceFieldToVolumeScaleBias.X;
+								const uint8 QuantizedDistance = FMath::Clamp<int32>(FMath::FloorToInt(RescaledDistance * 255.f + 0.5f), 0, 255);
+
+								Brick[VX + VY * BrickSize + VZ * BrickSize * BrickSize] = QuantizedDistance;
+								MinDistance = FMath::Min(MinDistance, QuantizedDistance);
+								MaxDistance = FMath::Max(MaxDistance, QuantizedDistance);
+							}
+						}
+					}
+
+					// Only keep the bricks intersecting the narrow band around the surface
+					if (MinDistance < MAX_uint8 && MaxDistance > 0)
+					{
+						IndirectionTable[X + Y * IndirectionDimensions.X + Z * IndirectionDimensions.X * IndirectionDimensions.Y] = BrickData.Num() / BrickSizeCubed;
+						BrickData.Append(Brick, BrickSizeCubed);
+					}
+				}
+			}
+		}
+
+		if (MipIndex == 0 && BrickData.Num() == 0)
+		{
+			// Surface is outside of the chunk bounds
+			return;
+		}
+
+		FSparseDistanceFieldMip& Mip = VolumeData->Mips[MipIndex];
+		Mip.IndirectionDimensions = IndirectionDimensions;
+		Mip.DistanceFieldToVolumeScaleBias = DistanceFieldToVolumeScaleBias;
+		Mip.NumDistanceFieldBricks = BrickData.Num() / BrickSizeCubed;
+
+		// Account for the border voxels we added
+		const FVector3f VirtualUVMin = FVector3f(DistanceField::MeshDistanceFieldObjectBorder) / FVector3f(NumUniqueVoxels);
+		const FVector3f VirtualUVSize = FVector3f(NumUniqueVoxels - FIntVector(2 * DistanceField::MeshDistanceFieldObjectBorder)) / FVector3f(NumUniqueVoxels);
+		const FVector3f VolumeSpaceExtent = LocalSpaceMeshBounds.GetExtent() * LocalToVolumeScale;
+
+		// [-VolumeSpaceExtent, VolumeSpaceExtent] -> [VirtualUVMin, VirtualUVMin + VirtualUVSize]
+		Mip.VolumeToVirtualUVScale = VirtualUVSize / (2 * VolumeSpaceExtent);
+		Mip.VolumeToVirtualUVAdd = VolumeSpaceExtent * Mip.VolumeToVirtualUVScale + VirtualUVMin;
+
+		// The lowest resolution mip is always loaded, the others are streamed
+		const bool bAlwaysLoaded = MipIndex == DistanceField::NumMips - 1;
+		TArray<uint8>& MipData = bAlwaysLoaded ? VolumeData->AlwaysLoadedMip : StreamableMipData;
+		Mip.BulkOffset = MipData.Num();
+		MipData.Append(reinterpret_cast<const uint8*>(IndirectionTable.GetData()), IndirectionTable.Num() * IndirectionTable.GetTypeSize());
+		MipData.Append(BrickData);
+		Mip.BulkSize = MipData.Num() - Mip.BulkOffset;
+	}
+
+	VolumeData->StreamableMips.Lock(LOCK_READ_WRITE);
+	uint8* StreamableMipsPtr = static_cast<uint8*>(VolumeData->StreamableMips.Realloc(StreamableMipData.Num()));
+	FMemory::Memcpy(StreamableMipsPtr, StreamableMipData.GetData(), StreamableMipData.Num());
+	VolumeData->StreamableMips.Unlock();
+	VolumeData->StreamableMips.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+
+	DistanceFieldVolumeData = VolumeData;
 }
@@ -3,6 +3,7 @@
 #include "VoxelRender/VoxelProceduralMeshComponent.h"
 #include "VoxelRender/VoxelProceduralMeshSceneProxy.h"
 #include "VoxelRender/PhysicsCooker/VoxelAsyncPhysicsCooker.h"
+#include "VoxelRender/PhysicsCooker/VoxelAsyncPhysicsCooker_Chaos.h"
 #include "VoxelRender/VoxelProcMeshBuffers.h"
 #include "VoxelRender/VoxelMaterialInterface.h"
 #include "VoxelRender/VoxelToolRendering.h"
@@ -21,6 +22,7 @@
 #include "Async/Async.h"
 #include "DrawDebugHelpers.h"
 #include "Materials/Material.h"
+#include "TimerManager.h"
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelPhysicsTriangleMeshesMemory);
 
@@ -30,15 +32,32 @@ static TAutoConsoleVariable<int32> CVarShowCollisionsUpdates(
 	TEXT("If true, will show the chunks that finished updating collisions"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<float> CVarStaticDrawSettleTime(
+	TEXT("voxel.renderer.StaticDrawSettleTime"),
+	1.f,
+	TEXT("Chunks updated twice within this time (in seconds) are drawn through the dynamic path until they stop being updated for that long. Static draws cache their mesh draw commands, which is wasted work on chunks updated every frame"),
+	ECVF_Default);
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+IVoxelProceduralMeshComponent_PhysicsCallbackHandler::~IVoxelProceduralMeshComponent_PhysicsCallbackHandler()
+{
+	// Never sent to the pool: mark them as done so that they can be deleted
+	for (IVoxelAsyncPhysicsCooker* Cooker : PendingCookers)
+	{
+		Cooker->Abandon();
+	}
+}
+
 void IVoxelProceduralMeshComponent_PhysicsCallbackHandler::TickHandler()
 {
 	VOXEL_FUNCTION_COUNTER();
 	check(IsInGameThread());
 
+	FlushCookers();
+
 	FCallback Callback;
 	while (Queue.Dequeue(Callback))
 	{
@@ -54,6 +73,50 @@ void IVoxelProceduralMeshComponent_PhysicsCallbackHandler::CookerCallback(uint64
 	Queue.Enqueue({ CookerId, Component });
 }
 
+void IVoxelProceduralMeshComponent_PhysicsCallbackHandler::FlushCookers()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (PendingCookers.Num() == 0)
+	{
+		return;
+	}
+
+	const auto Pool = CookersPool.Pin();
+	if (!ensure(Pool.IsValid()))
+	{
+		for (IVoxelAsyncPhysicsCooker* Cooker : PendingCookers)
+		{
+			Cooker->Abandon();
+		}
+		PendingCookers.Reset();
+		return;
+	}
+
+	FVoxelAsyncPhysicsCookerBatch::QueueCookers(*Pool, MoveTemp(PendingCookers));
+	PendingCookers.Reset();
+}
+
+TVoxelSharedRef<FVoxelPhysicsCookCache> IVoxelProceduralMeshComponent_PhysicsCallbackHandler::GetCookCache()
+{
+	check(IsInGameThread());
+
+	if (!CookCache.IsValid())
+	{
+		CookCache = MakeVoxelShared<FVoxelPhysicsCookCache>();
+	}
+	return CookCache.ToSharedRef();
+}
+
+void IVoxelProceduralMeshComponent_PhysicsCallbackHandler::QueueCooker(const TVoxelWeakPtr<IVoxelPool>& Pool, IVoxelAsyncPhysicsCooker* Cooker)
+{
+	check(IsInGameThread());
+	ensure(!CookersPool.IsValid() || CookersPool == Pool);
+
+	CookersPool = Pool;
+	PendingCookers.Add(Cooker);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -79,6 +142,7 @@ void UVoxelProceduralMeshComponent::Init(
 	CollisionTraceFlag = RendererSettings.CollisionTraceFlag;
 	NumConvexHullsPerAxis = RendererSettings.NumConvexHullsPerAxis;
 	bCleanCollisionMesh = RendererSettings.bCleanCollisionMeshes;
+	CollisionSimplificationTolerance = RendererSettings.CollisionSimplificationTolerance;
 	bClearProcMeshBuffersOnFinishUpdate = RendererSettings.bStaticWorld && !RendererSettings.bRenderWorld; // We still need the buffers if we are rendering!
 	DistanceFieldSelfShadowBias = RendererSettings.DistanceFieldSelfShadowBias;
 }
@@ -87,6 +151,14 @@ void UVoxelProceduralMeshComponent::ClearInit()
 {
 	ensure(ProcMeshSections.Num() == 0);
 	bInit = false;
+
+	// Don't inherit the draw path of the previous chunk
+	LastFinishSectionsUpdatesTime = 0;
+	bUseDynamicDrawPath = false;
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(DrawPathSettleTimerHandle);
+	}
 }
 
 UVoxelProceduralMeshComponent::UVoxelProceduralMeshComponent()
@@ -190,11 +262,28 @@ void UVoxelProceduralMeshComponent::SetProcMeshSection(int32 Index, FVoxelProcMe
 
 	Buffers->UpdateStats();
 
-	ProcMeshSections[Index].Settings = Settings;
-
 	// Due to InitResources etc, we must make sure we are the only component using this buffers, hence the TUniquePtr
 	// However the buffer is shared between the component and the proxy
-	ProcMeshSections[Index].Buffers = MakeShareable(Buffers.Release());
+	SetProcMeshSection(Index, Settings, TVoxelSharedRef<const FVoxelProcMeshBuffers>(MakeShareable(Buffers.Release())), Update);
+}
+
+int32 UVoxelProceduralMeshComponent::AddProcMeshSection(FVoxelProcMeshSectionSettings Settings, TUniquePtr<FVoxelProcMeshBuffers> Buffers, EVoxelProcMeshSectionUpdate Update)
+{
+	check(Buffers.IsValid());
+	Buffers->UpdateStats();
+	return AddProcMeshSection(Settings, TVoxelSharedRef<const FVoxelProcMeshBuffers>(MakeShareable(Buffers.Release())), Update);
+}
+
+void UVoxelProceduralMeshComponent::SetProcMeshSection(int32 Index, FVoxelProcMeshSectionSettings Settings, const TVoxelSharedRef<const FVoxelProcMeshBuffers>& Buffers, EVoxelProcMeshSectionUpdate Update)
+{
+	VOXEL_FUNCTION_COUNTER();
+	if (!ensure(ProcMeshSections.IsValidIndex(Index)))
+	{
+		return;
+	}
+
+	ProcMeshSections[Index].Settings = Settings;
+	ProcMeshSections[Index].Buffers = Buffers;
 
 	if (Update == EVoxelProcMeshSectionUpdate::UpdateNow)
 	{
@@ -202,10 +291,9 @@ void UVoxelProceduralMeshComponent::SetProcMeshSection(int32 Index, FVoxelProcMe
 	}
 }
 
-int32 UVoxelProceduralMeshComponent::AddProcMeshSection(FVoxelProcMeshSectionSettings Settings, TUniquePtr<FVoxelProcMeshBuffers> Buffers, EVoxelProcMeshSectionUpdate Update)
+int32 UVoxelProceduralMeshComponent::AddProcMeshSection(FVoxelProcMeshSectionSettings Settings, const TVoxelSharedRef<const FVoxelProcMeshBuffers>& Buffers, EVoxelProcMeshSectionUpdate Update)
 {
 	VOXEL_FUNCTION_COUNTER();
-	check(Buffers.IsValid());
 
 	ensure(Settings.bSectionVisible || Settings.bEnableCollisions || Settings.bEnableNavmesh);
 	
@@ -215,7 +303,7 @@ int32 UVoxelProceduralMeshComponent::AddProcMeshSection(FVoxelProcMeshSectionSet
 	}
 
 	const int32 Index = ProcMeshSections.Emplace();
-	SetProcMeshSection(Index, Settings, MoveTemp(Buffers), Update);
+	SetProcMeshSection(Index, Settings, Buffers, Update);
 
 	return Index;
 }
@@ -306,6 +394,9 @@ void UVoxelProceduralMeshComponent::FinishSectionsUpdates()
 		ProcMeshSectionsGuidToSettings = MoveTemp(NewGuidToSettings);
 	}
 
+	const double Time = FPlatformTime::Seconds();
+
+	UpdateDrawPath(Time);
 	UpdatePhysicalMaterials();
 	UpdateLocalBounds();
 	MarkRenderStateDirty();
@@ -324,7 +415,19 @@ void UVoxelProceduralMeshComponent::FinishSectionsUpdates()
 		ProcMeshSections.Reset();
 	}
 
-	LastFinishSectionsUpdatesTime = FPlatformTime::Seconds();
+	LastFinishSectionsUpdatesTime = Time;
+}
+
+void UVoxelProceduralMeshComponent::GetVisibleSectionsBuffers(TArray<TVoxelSharedRef<const FVoxelProcMeshBuffers>>& OutBuffers) const
+{
+	for (auto& Section : ProcMeshSections)
+	{
+		// Empty buffers are never rendered, see FVoxelProceduralMeshSceneProxy
+		if (Section.Settings.bSectionVisible && Section.Buffers->GetNumVertices() > 0)
+		{
+			OutBuffers.Add(Section.Buffers.ToSharedRef());
+		}
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -543,6 +646,55 @@ void UVoxelProceduralMeshComponent::OnComponentDestroyed(bool bDestroyingHierarc
 	
 	// Clear memory
 	ProcMeshSections.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(DrawPathSettleTimerHandle);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void UVoxelProceduralMeshComponent::UpdateDrawPath(double Time)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		bUseDynamicDrawPath = false;
+		return;
+	}
+
+	// Static draws cache their mesh draw commands when the proxy is added to the scene:
+	// only worth it if the proxy isn't going to be recreated right away
+	const float SettleTime = CVarStaticDrawSettleTime.GetValueOnGameThread();
+	if (SettleTime > 0 && Time - LastFinishSectionsUpdatesTime < SettleTime)
+	{
+		bUseDynamicDrawPath = true;
+		World->GetTimerManager().SetTimer(DrawPathSettleTimerHandle, this, &UVoxelProceduralMeshComponent::OnDrawPathSettled, SettleTime);
+	}
+	else
+	{
+		bUseDynamicDrawPath = false;
+		World->GetTimerManager().ClearTimer(DrawPathSettleTimerHandle);
+	}
+}
+
+void UVoxelProceduralMeshComponent::OnDrawPathSettled()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!bUseDynamicDrawPath)
+	{
+		return;
+	}
+
+	// Recreate the proxy so that it uses the static draw path
+	bUseDynamicDrawPath = false;
+	MarkRenderStateDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -629,7 +781,16 @@ void UVoxelProceduralMeshComponent::UpdateCollision()
 			AsyncCooker = IVoxelAsyncPhysicsCooker::CreateCooker(this);
 			if (ensure(AsyncCooker))
 			{
-				PoolPtr->QueueTask(EVoxelTaskType::CollisionCooking, AsyncCooker);
+				// Batched with the other chunks updated this frame
+				const auto PinnedPhysicsCallbackHandler = PhysicsCallbackHandler.Pin();
+				if (PinnedPhysicsCallbackHandler.IsValid())
+				{
+					PinnedPhysicsCallbackHandler->QueueCooker(Pool, AsyncCooker);
+				}
+				else
+				{
+					PoolPtr->QueueTask(EVoxelTaskType::CollisionCooking, AsyncCooker);
+				}
 			}
 		}
 	}
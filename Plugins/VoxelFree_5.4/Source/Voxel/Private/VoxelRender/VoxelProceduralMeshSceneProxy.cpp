@@ -37,9 +37,16 @@ static TAutoConsoleVariable<int32> CVarShowMeshSections(
 	TEXT("If true, will assign a unique color to each mesh section"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarStaticDrawPath(
+	TEXT("voxel.renderer.StaticDrawPath"),
+	1,
+	TEXT("If true, chunks that are not being updated will be drawn through cached mesh draw commands instead of GetDynamicMeshElements"),
+	ECVF_Default);
+
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelMeshDistanceFieldMemory);
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("Num Voxel Draw Calls"), STAT_NumVoxelDrawCalls, STATGROUP_VoxelCounters);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Num Voxel Static Mesh Batches"), STAT_NumVoxelStaticMeshBatches, STATGROUP_VoxelCounters);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Num Voxel Draw Calls For Tools"), STAT_NumVoxelDrawCallsForTools, STATGROUP_VoxelCounters);
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("Num Voxel Triangles Drawn "), STAT_NumVoxelTrianglesDrawn, STATGROUP_VoxelCounters);
@@ -116,6 +123,46 @@ TVoxelSharedRef<FVoxelProcMeshBuffersRenderData> FVoxelProcMeshBuffersRenderData
 		return Buffers->RenderData.Pin().ToSharedRef();
 	}
 }
+TVoxelSharedRef<FVoxelProcMeshBuffersRenderData::FBatch> FVoxelProcMeshBuffersRenderData::InitBatch_GameThread(
+	TArray<TVoxelSharedRef<const FVoxelProcMeshBuffers>>&& Buffers,
+	ERHIFeatureLevel::Type FeatureLevel)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	const auto Batch = MakeVoxelShared<FBatch>();
+	ENQUEUE_RENDER_COMMAND(VoxelInitRenderDataBatch)(
+		[Batch, Buffers = MoveTemp(Buffers), FeatureLevel](FRHICommandListImmediate& RHICmdList)
+		{
+			VOXEL_RENDER_SCOPE_COUNTER("VoxelInitRenderDataBatch");
+			
+			Batch->Reserve(Buffers.Num());
+			for (auto& It : Buffers)
+			{
+				Batch->Add(GetRenderData(It, FeatureLevel));
+			}
+		});
+	return Batch;
+}
+
+void FVoxelProcMeshBuffersRenderData::ReleaseBatch_GameThread(TVoxelSharedPtr<FBatch>& Batch)
+{
+	check(IsInGameThread());
+
+	if (!Batch.IsValid())
+	{
+		return;
+	}
+
+	// Render data must be destroyed on the render thread
+	ENQUEUE_RENDER_COMMAND(VoxelReleaseRenderDataBatch)(
+		[Batch = MoveTemp(Batch)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			Batch.Reset();
+		});
+	Batch.Reset();
+}
+
 FVoxelProcMeshBuffersRenderData::~FVoxelProcMeshBuffersRenderData()
 {
 	VOXEL_RENDER_FUNCTION_COUNTER();
@@ -159,6 +206,7 @@ FVoxelProceduralMeshSceneProxy::FVoxelProceduralMeshSceneProxy(UVoxelProceduralM
 	, WeakToolRenderingManager(Component->ToolRenderingManager)
 	, CollisionResponse(Component->GetCollisionResponseToChannels())
 	, CollisionTraceFlag(Component->CollisionTraceFlag)
+	, bStaticDrawPath(CVarStaticDrawPath.GetValueOnAnyThread() != 0 && !Component->bUseDynamicDrawPath)
 {
 	VOXEL_FUNCTION_COUNTER();
 
@@ -288,6 +336,43 @@ void FVoxelProceduralMeshSceneProxy::DestroyRenderThreadResources()
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+void FVoxelProceduralMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PDI)
+{
+	VOXEL_RENDER_FUNCTION_COUNTER();
+
+	if (!bStaticDrawPath)
+	{
+		return;
+	}
+
+	for (const auto& Section : Sections)
+	{
+		if (!Section.bSectionVisible || !Section.RenderData.IsValid())
+		{
+			continue;
+		}
+
+		auto* Material = Section.Material->GetMaterial();
+		if (!Material)
+		{
+			// Will happen in force delete
+			continue;
+		}
+
+		FMeshBatch Mesh;
+		InitMeshBatch(Mesh, Section, Material->GetRenderProxy(), true, false);
+		Mesh.LODIndex = 0;
+		Mesh.CastShadow = true;
+		Mesh.bUseForMaterial = true;
+		Mesh.bUseForDepthPass = true;
+		Mesh.bUseAsOccluder = ShouldUseAsOccluder();
+
+		PDI->DrawMesh(Mesh, FLT_MAX);
+		
+		INC_DWORD_STAT(STAT_NumVoxelStaticMeshBatches);
+	}
+}
+
 void FVoxelProceduralMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const
 {
 	VOXEL_RENDER_FUNCTION_COUNTER();
@@ -374,12 +459,14 @@ void FVoxelProceduralMeshSceneProxy::GetDynamicMeshElements(const TArray<const F
 #endif
 	{
 		const bool bForceDisableTessellation = !(EngineShowFlags.Materials || EngineShowFlags.Wireframe); // else crash in eg lighting
+		// Else the sections are already drawn through DrawStaticElements, we're only here for the tools
+		const bool bDrawSections = ShouldDrawSectionsDynamically(EngineShowFlags);
 
 		for (const auto& Section : Sections)
 		{
 			VOXEL_SLOW_SCOPE_COUNTER("Render Section");
 			
-			if (!Section.bSectionVisible)
+			if (!bDrawSections || !Section.bSectionVisible)
 			{
 				continue;
 			}
@@ -540,7 +627,16 @@ FPrimitiveViewRelevance FVoxelProceduralMeshSceneProxy::GetViewRelevance(const F
 	FPrimitiveViewRelevance Result;
 	Result.bDrawRelevance = IsShown(View);
 	Result.bShadowRelevance = IsShadowCast(View);
-	Result.bDynamicRelevance = true;
+	if (ShouldDrawSectionsDynamically(View->Family->EngineShowFlags))
+	{
+		Result.bDynamicRelevance = true;
+	}
+	else
+	{
+		Result.bStaticRelevance = true;
+		// Tools overlays and bounds are always dynamic
+		Result.bDynamicRelevance = HasToolsToRender() || (NOT_SHIPPING_NOR_TEST && View->Family->EngineShowFlags.Bounds);
+	}
 	Result.bRenderInMainPass = ShouldRenderInMainPass();
 	Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
 	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
@@ -566,6 +662,26 @@ SIZE_T FVoxelProceduralMeshSceneProxy::GetTypeHash() const
 	return reinterpret_cast<size_t>(&UniquePointer);
 }
 
+void FVoxelProceduralMeshSceneProxy::GetDistanceFieldAtlasData(const FDistanceFieldVolumeData*& OutDistanceFieldData, float& SelfShadowBias) const
+{
+	OutDistanceFieldData = DistanceFieldData.Get();
+	SelfShadowBias = DistanceFieldSelfShadowBias;
+}
+
+void FVoxelProceduralMeshSceneProxy::GetDistanceFieldInstanceData(TArray<FRenderTransform>& InstanceLocalToPrimitiveTransforms) const
+{
+	if (DistanceFieldData.IsValid())
+	{
+		// Distance field is built in the chunk local space
+		InstanceLocalToPrimitiveTransforms.Add(FRenderTransform::Identity);
+	}
+}
+
+bool FVoxelProceduralMeshSceneProxy::HasDistanceFieldRepresentation() const
+{
+	return CastsDynamicShadow() && AffectsDistanceFieldLighting() && DistanceFieldData.IsValid();
+}
+
 uint32 FVoxelProceduralMeshSceneProxy::GetAllocatedSize() const
 {
 	return Sections.GetAllocatedSize() + FPrimitiveSceneProxy::GetAllocatedSize();
@@ -583,12 +699,22 @@ FMeshBatch& FVoxelProceduralMeshSceneProxy::DrawSection(
 	bool bWireframe) const
 {
 	VOXEL_RENDER_FUNCTION_COUNTER();
-	
+
+	FMeshBatch& Mesh = Collector.AllocateMesh();
+	InitMeshBatch(Mesh, Section, MaterialRenderProxy, bEnableTessellation, bWireframe);
+	return Mesh;
+}
+
+void FVoxelProceduralMeshSceneProxy::InitMeshBatch(
+	FMeshBatch& Mesh,
+	const FVoxelProcMeshProxySection& Section,
+	const FMaterialRenderProxy* MaterialRenderProxy,
+	bool bEnableTessellation,
+	bool bWireframe) const
+{
 	check(MaterialRenderProxy);
 	check(Section.RenderData.IsValid());
 
-	FMeshBatch& Mesh = Collector.AllocateMesh();
-	
 	Mesh.VertexFactory = &Section.RenderData->VertexFactory;
 	Mesh.MaterialRenderProxy = MaterialRenderProxy;
 	Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
@@ -623,8 +749,49 @@ FMeshBatch& FVoxelProceduralMeshSceneProxy::DrawSection(
 		}
 	}
 #endif
+}
 
-	return Mesh;
+bool FVoxelProceduralMeshSceneProxy::ShouldDrawSectionsDynamically(const FEngineShowFlags& EngineShowFlags) const
+{
+	if (!bStaticDrawPath)
+	{
+		return true;
+	}
+	
+#if NOT_SHIPPING_NOR_TEST
+	// Debug views replace the section materials
+	if (IsCollisionView(EngineShowFlags) ||
+		FVoxelDebugManager::ShowCollisionAndNavmeshDebug() ||
+		CVarShowMeshSections.GetValueOnRenderThread() != 0)
+	{
+		return true;
+	}
+	// Make sure the proc mesh delays are still logged
+	if (!bLoggedTime && CVarLogProcMeshDelays.GetValueOnRenderThread() != 0 && FinishSectionsUpdatesTime > 0)
+	{
+		return true;
+	}
+#endif
+
+	return false;
+}
+
+bool FVoxelProceduralMeshSceneProxy::HasToolsToRender() const
+{
+	const auto ToolRenderingManager = WeakToolRenderingManager.Pin();
+	if (!ToolRenderingManager.IsValid())
+	{
+		return false;
+	}
+
+	bool bHasTools = false;
+	const FBox WorldBounds = GetBounds().GetBox();
+	ToolRenderingManager->IterateTools(
+		[&](const FVoxelToolRendering& Tool)
+		{
+			bHasTools |= Tool.bEnabled && Tool.WorldBounds.Intersect(WorldBounds);
+		});
+	return bHasTools;
 }
 
 bool FVoxelProceduralMeshSceneProxy::ShouldDrawComplexCollisions(const FEngineShowFlags& EngineShowFlags) const
@@ -31,6 +31,14 @@ public:
 	static TVoxelSharedRef<FVoxelProcMeshBuffersRenderData> GetRenderData(
 		const TVoxelSharedRef<const FVoxelProcMeshBuffers>& Buffers,
 		ERHIFeatureLevel::Type FeatureLevel);
+
+	// Create the render data of all these buffers in a single render command instead of one per proxy
+	// The batch keeps the render data alive until ReleaseBatch_GameThread, so that the proxies created in between can pick it up
+	using FBatch = TArray<TVoxelSharedPtr<FVoxelProcMeshBuffersRenderData>>;
+	static TVoxelSharedRef<FBatch> InitBatch_GameThread(
+		TArray<TVoxelSharedRef<const FVoxelProcMeshBuffers>>&& Buffers,
+		ERHIFeatureLevel::Type FeatureLevel);
+	static void ReleaseBatch_GameThread(TVoxelSharedPtr<FBatch>& Batch);
 	~FVoxelProcMeshBuffersRenderData();
 
 private:
@@ -62,6 +70,7 @@ public:
 	virtual void CreateRenderThreadResources(UE_504_ONLY(FRHICommandListBase& RHICmdList)) override;
 	virtual void DestroyRenderThreadResources() override;
 	
+	virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override;
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override;
 
 #if RHI_RAYTRACING
@@ -73,6 +82,9 @@ public:
 	virtual bool CanBeOccluded() const override;
 	virtual uint32 GetMemoryFootprint() const override;
 	virtual SIZE_T GetTypeHash() const override;
+	virtual void GetDistanceFieldAtlasData(const FDistanceFieldVolumeData*& OutDistanceFieldData, float& SelfShadowBias) const override;
+	virtual void GetDistanceFieldInstanceData(TArray<FRenderTransform>& InstanceLocalToPrimitiveTransforms) const override;
+	virtual bool HasDistanceFieldRepresentation() const override;
 	uint32 GetAllocatedSize() const;
 	//~ End FPrimitiveSceneProxy Interface
 
@@ -86,6 +98,9 @@ private:
 	const FCollisionResponseContainer CollisionResponse;
 	const ECollisionTraceFlag CollisionTraceFlag;
 
+	// If true, the visible sections are drawn through DrawStaticElements unless a debug view needs them
+	const bool bStaticDrawPath;
+
 	TArray<FVoxelProcMeshProxySection> Sections;
 	TVoxelSharedPtr<const FDistanceFieldVolumeData> DistanceFieldData;
 
@@ -99,6 +114,16 @@ private:
 		const FMaterialRenderProxy* MaterialRenderProxy,
 		bool bEnableTessellation,
 		bool bWireframe) const;
+	void InitMeshBatch(
+		FMeshBatch& Mesh,
+		const FVoxelProcMeshProxySection& Section, 
+		const FMaterialRenderProxy* MaterialRenderProxy,
+		bool bEnableTessellation,
+		bool bWireframe) const;
+
+	// Whether the sections must be drawn through GetDynamicMeshElements for this view
+	bool ShouldDrawSectionsDynamically(const FEngineShowFlags& EngineShowFlags) const;
+	bool HasToolsToRender() const;
 	
 	bool ShouldDrawComplexCollisions(const FEngineShowFlags& EngineShowFlags) const;
 };
\ No newline at end of file
@@ -26,6 +26,12 @@ static TAutoConsoleVariable<int32> CVarShowTransitions(
 	TEXT("If true, will only show the transition meshes"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarReuseUnchangedClusterSections(
+	TEXT("voxel.renderer.ReuseUnchangedClusterSections"),
+	1,
+	TEXT("If true, merged sections whose chunks didn't change will keep their buffers instead of being merged & uploaded again"),
+	ECVF_Default);
+
 float FVoxelRenderUtilities::GetWorldCurrentTime(UWorld* World)
 {
 	if (!ensure(World)) return 0;
@@ -270,10 +276,11 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 	const auto CopyPositions = [&](const FVoxelChunkMeshBuffers& Chunk, const FVector& Offset)
 	{
 		VOXEL_ASYNC_SCOPE_COUNTER("CopyPositions");
+		const FVector3f LocalOffset(Offset);
 		const int32 ChunkNumVertices = Chunk.GetNumVertices();
 		for (int32 Index = 0; Index < ChunkNumVertices; Index++)
 		{
-			PositionBuffer.VertexPosition(VerticesOffset + Index) = FVector3f(Get(Chunk.Positions, Index) + Offset);
+			PositionBuffer.VertexPosition(VerticesOffset + Index) = Get(Chunk.Positions, Index) + LocalOffset;
 		}
 	};
 	const auto CopyColors = [&](const FVoxelChunkMeshBuffers& Chunk)
@@ -307,14 +314,14 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 		{
 			{
 				auto& Tangent = Get(Chunk.Tangents, Index);
-				auto& Normal = Get(Chunk.Normals, Index);
-				StaticMeshBuffer.SetVertexTangents(VerticesOffset + Index, FVector3f(Tangent.TangentX), FVector3f(Tangent.GetY(Normal)), FVector3f(Normal));
+				const FVector3f Normal = Get(Chunk.Normals, Index).Unpack();
+				StaticMeshBuffer.SetVertexTangents(VerticesOffset + Index, Tangent.TangentX, Tangent.GetY(Normal), Normal);
 			}
 			check(Chunk.TextureCoordinates.Num() == NumTextureCoordinates);
 			for (int32 Tex = 0; Tex < NumTextureCoordinates; Tex++)
 			{
 				auto& TextureCoordinate = Get(Chunk.TextureCoordinates[Tex], Index);
-				StaticMeshBuffer.SetVertexUV(VerticesOffset + Index, Tex, FVector2f(TextureCoordinate));
+				StaticMeshBuffer.SetVertexUV(VerticesOffset + Index, Tex, TextureCoordinate);
 			}
 		}
 	};
@@ -360,8 +367,8 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 				for (int32 Index = 0; Index < MainChunk.GetNumVertices(); Index++)
 				{
 					PositionBuffer.VertexPosition(VerticesOffset + Index) = FVector3f(FVoxelMesherUtilities::GetTranslatedTransvoxel(
-						Get(MainChunk.Positions, Index),
-						Get(MainChunk.Normals, Index),
+						FVector(Get(MainChunk.Positions, Index)),
+						FVector(Get(MainChunk.Normals, Index).Unpack()),
 						Chunk.TransitionsMask,
 						Chunk.LOD) + PositionOffset);
 				}
@@ -446,6 +453,63 @@ TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSections_AnyThread
 	return ProcMeshBuffersPtr;
 }
 
+TUniquePtr<FVoxelProcMeshBuffers> FVoxelRenderUtilities::MergeSectionsIfChanged_AnyThread(
+	const FVoxelRendererSettingsBase& RendererSettings,
+	const TArray<FVoxelKeyedChunkMeshSection>& Sections,
+	const FIntVector& CenterPosition,
+	const FVoxelMergedSection* Previous,
+	FVoxelMergedSection& OutMerged,
+	const FThreadSafeCounter& CancelCounter,
+	int32 CancelThreshold)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	OutMerged = {};
+	OutMerged.Sections = Sections;
+
+	const auto IsUnchanged = [&]()
+	{
+		if (!Previous ||
+			!Previous->Buffers.IsValid() ||
+			Previous->Sections.Num() != Sections.Num() ||
+			CVarReuseUnchangedClusterSections.GetValueOnAnyThread() == 0)
+		{
+			return false;
+		}
+
+		// Order isn't guaranteed to be the same
+		TMap<TPair<uint64, int32>, const FVoxelChunkMeshSection*> PreviousSections;
+		PreviousSections.Reserve(Previous->Sections.Num());
+		for (auto& Section : Previous->Sections)
+		{
+			PreviousSections.Add({ Section.ChunkId, Section.SectionIndex }, &Section.Section);
+		}
+		for (auto& Section : Sections)
+		{
+			const FVoxelChunkMeshSection* const* PreviousSection = PreviousSections.Find({ Section.ChunkId, Section.SectionIndex });
+			if (!PreviousSection || !(**PreviousSection).IsSameAs(Section.Section))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	if (IsUnchanged())
+	{
+		OutMerged.Buffers = Previous->Buffers;
+		return {};
+	}
+
+	TArray<FVoxelChunkMeshSection> SectionsToMerge;
+	SectionsToMerge.Reserve(Sections.Num());
+	for (auto& Section : Sections)
+	{
+		SectionsToMerge.Add(Section.Section);
+	}
+	return MergeSections_AnyThread(RendererSettings, SectionsToMerge, CenterPosition, CancelCounter, CancelThreshold);
+}
+
 TUniquePtr<FVoxelBuiltChunkMeshes> FVoxelRenderUtilities::BuildMeshes_AnyThread(
 	const FVoxelChunkMeshesToBuild& ChunkMeshesToBuild,
 	const FVoxelRendererSettingsBase& RendererSettings,
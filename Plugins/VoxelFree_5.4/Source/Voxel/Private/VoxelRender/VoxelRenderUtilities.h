@@ -44,6 +44,36 @@ struct FVoxelChunkMeshSection
 		, TransitionsMask(TransitionsMask)
 	{
 	}
+
+	// Whether both sections would be copied to the exact same merged data
+	inline bool IsSameAs(const FVoxelChunkMeshSection& Other) const
+	{
+		return
+			LOD == Other.LOD &&
+			ChunkPosition == Other.ChunkPosition &&
+			bEnableTessellation == Other.bEnableTessellation &&
+			bTranslateVertices == Other.bTranslateVertices &&
+			TransitionsMask == Other.TransitionsMask &&
+			MainChunk == Other.MainChunk &&
+			TransitionChunk == Other.TransitionChunk;
+	}
+};
+
+// A chunk mesh section, along with what identifies it across merges
+struct FVoxelKeyedChunkMeshSection
+{
+	uint64 ChunkId = 0;
+	int32 SectionIndex = 0; // Index among the sections of the chunk merged into the same buffers
+	FVoxelChunkMeshSection Section;
+};
+
+// Chunk sections merged into buffers, so that the buffers can be reused if none of the chunks changed
+struct FVoxelMergedSection
+{
+	TArray<FVoxelKeyedChunkMeshSection> Sections;
+	
+	// Set once the buffers are shared with a mesh
+	TVoxelSharedPtr<const FVoxelProcMeshBuffers> Buffers;
 };
 
 // Map from mesh config -> section config -> array of meshes to merge into that section
@@ -93,6 +123,16 @@ namespace FVoxelRenderUtilities
 		const FIntVector& CenterPosition,
 		const FThreadSafeCounter& CancelCounter = FThreadSafeCounter(),
 		int32 CancelThreshold = 0);
+	// If Sections are the same as the ones of Previous, returns null and sets OutMerged.Buffers to the previous buffers
+	// Else merges them. Returns null as well if canceled
+	TUniquePtr<FVoxelProcMeshBuffers> MergeSectionsIfChanged_AnyThread(
+		const FVoxelRendererSettingsBase& RendererSettings,
+		const TArray<FVoxelKeyedChunkMeshSection>& Sections,
+		const FIntVector& CenterPosition,
+		const FVoxelMergedSection* Previous,
+		FVoxelMergedSection& OutMerged,
+		const FThreadSafeCounter& CancelCounter,
+		int32 CancelThreshold);
 	TUniquePtr<FVoxelBuiltChunkMeshes> BuildMeshes_AnyThread(
 		const FVoxelChunkMeshesToBuild& ChunkMeshesToBuild,
 		const FVoxelRendererSettingsBase& RendererSettings,
@@ -51,9 +51,29 @@
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Queue the edit in the world edit batch if possible. It will be applied at the end of the frame
+#define GENERATED_TOOL_BATCH(Type, bRecordModified, ...) \
+	if (FVoxelToolHelpers::CanBatchEdit(VoxelWorld, bRecordModified)) \
+	{ \
+		FVoxelToolHelpers::AddBatchedEdit(VoxelWorld, Bounds, bUpdateRender, [=](FVoxelData& WorldData) \
+		{ \
+			auto Data = TVoxelDataImpl<FModifiedVoxel##Type>(WorldData, bMultiThreaded, false); \
+			__VA_ARGS__; \
+		}); \
+		return; \
+	} \
+	/* Apply the queued edits first to keep edits in order */ \
+	FVoxelToolHelpers::FlushEditBatch(VoxelWorld);
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 #define GENERATED_TOOL_CALL(Type, ...) \
 	GENERATED_TOOL_PREFIX(Type) \
 	EditedBounds = Bounds; \
+	Modified##Type##s.Reset(); \
+	GENERATED_TOOL_BATCH(Type, bRecordModified##Type##s, __VA_ARGS__) \
 	auto& WorldData = VoxelWorld->GetData(); \
 	{ \
 		FVoxelWriteScopeLock Lock(WorldData, Bounds, FUNCTION_FNAME); \
@@ -93,6 +113,7 @@
 #define GENERATED_TOOL_CALL_CPP(Type, ...) \
 	GENERATED_TOOL_PREFIX(Type) \
 	if (OutEditedBounds) *OutEditedBounds = Bounds; \
+	GENERATED_TOOL_BATCH(Type, OutModified##Type##s != nullptr, __VA_ARGS__) \
 	auto& WorldData = VoxelWorld->GetData(); \
 	{ \
 		FVoxelWriteScopeLock Lock(WorldData, Bounds, FUNCTION_FNAME); \
@@ -27,9 +27,10 @@ void UVoxelSurfaceEditTools::EditVoxelValues(
 	}
 	
 	const FVoxelIntBox Bounds = FVoxelSurfaceEditToolsImpl::GetBounds(ProcessedVoxels);
-	const FVoxelHardnessHandler HardnessHandler(*VoxelWorld);
+	// Shared with the batched edit instead of being copied into it. ProcessedVoxels only holds a shared ref to the voxels, so copying it is cheap
+	const TVoxelSharedRef<const FVoxelHardnessHandler> HardnessHandler = MakeVoxelShared<FVoxelHardnessHandler>(*VoxelWorld);
 	
-	GENERATED_TOOL_CALL(Value, FVoxelSurfaceEditToolsImpl::EditVoxelValues(Data, HardnessHandler, Bounds, ProcessedVoxels, DistanceDivisor));
+	GENERATED_TOOL_CALL(Value, FVoxelSurfaceEditToolsImpl::EditVoxelValues(Data, *HardnessHandler, Bounds, ProcessedVoxels, DistanceDivisor));
 }
 
 void UVoxelSurfaceEditTools::EditVoxelValuesAsync(
@@ -75,9 +76,10 @@ void UVoxelSurfaceEditTools::EditVoxelValues(
 	}
 	
 	const FVoxelIntBox Bounds = FVoxelSurfaceEditToolsImpl::GetBounds(ProcessedVoxels);
-	const FVoxelHardnessHandler HardnessHandler(*VoxelWorld);
+	// Shared with the batched edit instead of being copied into it. ProcessedVoxels only holds a shared ref to the voxels, so copying it is cheap
+	const TVoxelSharedRef<const FVoxelHardnessHandler> HardnessHandler = MakeVoxelShared<FVoxelHardnessHandler>(*VoxelWorld);
 	
-	GENERATED_TOOL_CALL_CPP(Value, FVoxelSurfaceEditToolsImpl::EditVoxelValues(Data, HardnessHandler, Bounds, ProcessedVoxels, DistanceDivisor));
+	GENERATED_TOOL_CALL_CPP(Value, FVoxelSurfaceEditToolsImpl::EditVoxelValues(Data, *HardnessHandler, Bounds, ProcessedVoxels, DistanceDivisor));
 }
 
 void UVoxelSurfaceEditTools::EditVoxelValuesAsync(
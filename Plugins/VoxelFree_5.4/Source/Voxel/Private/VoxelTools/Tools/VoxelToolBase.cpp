@@ -398,6 +398,8 @@ void UVoxelToolBase::CallTool(AVoxelWorld* InVoxelWorld, const FVoxelToolTickDat
 			}
 			else
 			{
+				// Tools write to the data directly: apply the queued edits first to keep edits in order
+				VoxelWorld->FlushEditBatch();
 				ModifiedBounds = K2_DoEdit();
 			}
 
@@ -55,6 +55,7 @@ void UVoxelAssetTools::ImportAssetAsReference(
 	const auto AssetInstance = ImportAssetHelper(__FUNCTION__, World, Asset, Transform, Bounds, bConvertToVoxelSpace);
 	if (!AssetInstance) return;
 
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& Data = World->GetData();
 
 	{
@@ -166,6 +167,7 @@ void UVoxelAssetTools::ImportModifierAsset(
 	CHECK_BOUNDS_ARE_VALID_VOID();
 	CHECK_BOUNDS_ARE_32BITS_VOID();
 
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& Data = World->GetData();
 	{
 		FVoxelWriteScopeLock Lock(Data, bLockEntireWorld ? FVoxelIntBox::Infinite : Bounds, FUNCTION_FNAME);
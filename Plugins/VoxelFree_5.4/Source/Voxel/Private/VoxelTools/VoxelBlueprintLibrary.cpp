@@ -3,6 +3,7 @@
 #include "VoxelTools/VoxelBlueprintLibrary.h"
 #include "VoxelTools/VoxelToolHelpers.h"
 #include "VoxelTools/VoxelDataTools.h"
+#include "VoxelTools/VoxelEditBatch.h"
 #include "VoxelIntBox.h"
 #include "VoxelWorld.h"
 #include "VoxelData/VoxelData.h"
@@ -471,6 +472,9 @@ bool UVoxelBlueprintLibrary::Undo(AVoxelWorld* World, TArray<FVoxelIntBox>& OutU
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED();
 
+	// Apply the batched edits and save their frame first
+	FVoxelToolHelpers::FlushEditBatch(World);
+
 	auto& Data = World->GetData();
 
 	if (!Data.bEnableUndoRedo)
@@ -505,6 +509,9 @@ bool UVoxelBlueprintLibrary::Redo(AVoxelWorld* World, TArray<FVoxelIntBox>& OutU
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED();
 	
+	// Apply the batched edits and save their frame first
+	FVoxelToolHelpers::FlushEditBatch(World);
+	
 	auto& Data = World->GetData();
 
 	if (!Data.bEnableUndoRedo)
@@ -546,6 +553,14 @@ void UVoxelBlueprintLibrary::SaveFrame(AVoxelWorld* World)
 		FVoxelMessages::Error(FUNCTION_ERROR("bEnableUndoRedo is false!"));
 		return;
 	}
+
+	auto& EditBatch = World->GetEditBatch();
+	if (!EditBatch.IsEmpty())
+	{
+		// The batch will save a single frame when flushed
+		EditBatch.RequestSaveFrame();
+		return;
+	}
 	
 	Data.SaveFrame(FVoxelIntBox::Infinite);
 }
@@ -649,6 +664,7 @@ void UVoxelBlueprintLibrary::ClearValueData(AVoxelWorld* World, bool bUpdateRend
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
 	
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& Data = World->GetData();
 
 	{
@@ -667,6 +683,7 @@ void UVoxelBlueprintLibrary::ClearMaterialData(AVoxelWorld* World, bool bUpdateR
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
 	
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& Data = World->GetData();
 
 	{
@@ -706,6 +723,7 @@ void UVoxelBlueprintLibrary::ClearDirtyData(AVoxelWorld* World, bool bUpdateRend
 {
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& Data = World->GetData();
 
 	TArray<FVoxelIntBox> OutBoundsToUpdate;
@@ -725,6 +743,7 @@ void UVoxelBlueprintLibrary::ScaleData(AVoxelWorld* World, const FVector& Scale)
 {
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& SourceData = World->GetData();
 	const auto DestData = SourceData.Clone();
 
@@ -8,6 +8,15 @@
 #include "VoxelAssets/VoxelHeightmapAsset.h"
 #include "VoxelAssets/VoxelHeightmapAssetSamplerWrapper.h"
 #include "VoxelFeedbackContext.h"
+#include "VoxelCancelCounter.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarMultiThreadedDataTools(
+	TEXT("voxel.tools.MultiThreadedDataTools"),
+	1,
+	TEXT("If true, bulk data tools (RoundVoxels, RoundToGenerator, ClearUnusedMaterials...) will process leaves in parallel"),
+	ECVF_Default);
 
 #define VOXEL_DATA_TOOL_PREFIX const FVoxelIntBox Bounds(Position);
 
@@ -146,6 +155,7 @@ void UVoxelDataTools::GetSave(AVoxelWorld* World, FVoxelUncompressedWorldSave& O
 void UVoxelDataTools::GetSave(AVoxelWorld* World, FVoxelUncompressedWorldSaveImpl& OutSave, TArray<FVoxelObjectArchiveEntry>& OutObjects)
 {
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
+	FVoxelToolHelpers::FlushEditBatch(World);
 	World->GetData().GetSave(OutSave, OutObjects);
 }
 
@@ -157,6 +167,7 @@ void UVoxelDataTools::GetCompressedSave(AVoxelWorld* World, FVoxelCompressedWorl
 void UVoxelDataTools::GetCompressedSave(AVoxelWorld* World, FVoxelCompressedWorldSaveImpl& OutSave, TArray<FVoxelObjectArchiveEntry>& OutObjects)
 {
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
+	FVoxelToolHelpers::FlushEditBatch(World);
 	FVoxelUncompressedWorldSaveImpl Save;
 	World->GetData().GetSave(Save, OutObjects);
 	UVoxelSaveUtilities::CompressVoxelSave(Save, OutSave);
@@ -222,6 +233,9 @@ bool UVoxelDataTools::LoadFromSave(const AVoxelWorld* World, const FVoxelUncompr
 	CHECK_VOXELWORLD_IS_CREATED();
 	CHECK_SAVE();
 
+	// Queued edits were made before the load
+	FVoxelToolHelpers::FlushEditBatch(World);
+
 	TArray<FVoxelIntBox> BoundsToUpdate;
 	auto& Data = World->GetData();
 	
@@ -255,58 +269,129 @@ bool UVoxelDataTools::LoadFromCompressedSave(const AVoxelWorld* World, const FVo
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void UVoxelDataTools::RoundVoxelsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds)
+static bool IsCanceled(const FVoxelCancelCounter* CancelCounter)
+{
+	return CancelCounter && CancelCounter->IsCanceled();
+}
+
+/**
+ * Calls Lambda on all the leaves in parallel. The whole bounds must already be locked by the caller
+ * If bSplitNeighbors is true, leaves are processed in 8 passes so that two adjacent leaves are never processed at the same time:
+ * Lambda can then write its leaf while reading the neighboring ones
+ * Progress is reported to SlowTask, which must have one frame per leaf
+ * Returns false if canceled
+ */
+template<typename TLambda>
+static bool ParallelForEachLeaf(
+	const TArray<FVoxelDataOctreeLeaf*>& Leaves,
+	bool bSplitNeighbors,
+	const FVoxelCancelCounter* CancelCounter,
+	FVoxelScopedSlowTask& SlowTask,
+	TLambda Lambda)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	TArray<FVoxelDataOctreeLeaf*> Passes[8];
+	for (FVoxelDataOctreeLeaf* Leaf : Leaves)
+	{
+		int32 PassIndex = 0;
+		if (bSplitNeighbors)
+		{
+			const FIntVector ChunkPosition = Leaf->GetMin() / DATA_CHUNK_SIZE;
+			PassIndex = (ChunkPosition.X & 1) + 2 * (ChunkPosition.Y & 1) + 4 * (ChunkPosition.Z & 1);
+		}
+		Passes[PassIndex].Add(Leaf);
+	}
+
+	const bool bForceSingleThread = CVarMultiThreadedDataTools.GetValueOnAnyThread() == 0;
+
+	std::atomic<int32> NumProcessed{ 0 };
+	int32 NumReported = 0;
+
+	for (const TArray<FVoxelDataOctreeLeaf*>& Pass : Passes)
+	{
+		if (IsCanceled(CancelCounter))
+		{
+			return false;
+		}
+
+		ParallelFor(Pass.Num(), [&](int32 Index)
+		{
+			if (IsCanceled(CancelCounter))
+			{
+				return;
+			}
+
+			Lambda(*Pass[Index]);
+			NumProcessed++;
+
+			// Slow tasks can only be updated from the game thread
+			if (IsInGameThread())
+			{
+				const int32 NewNumReported = NumProcessed.load();
+				SlowTask.EnterProgressFrame(NewNumReported - NumReported);
+				NumReported = NewNumReported;
+			}
+		}, bForceSingleThread);
+	}
+
+	return !IsCanceled(CancelCounter);
+}
+
+// Async data tools are canceled when the world is destroyed
+#define DATA_TOOL_CANCEL_PREFIX const FVoxelCancelCounter CancelCounter(World->GetAsyncToolsCancelCounter());
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool UVoxelDataTools::RoundVoxelsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, const FVoxelCancelCounter* CancelCounter)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
-	int32 NumDirtyLeaves = 0;
-	uint64 NumVoxels = 0;
+	TArray<FVoxelDataOctreeLeaf*> Leaves;
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Record stats");
+		VOXEL_ASYNC_SCOPE_COUNTER("Find leaves");
 		FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
 		{
 			if (Leaf.GetData<FVoxelValue>().IsDirty() && Leaf.GetData<FVoxelValue>().HasAllocation())
 			{
-				NumDirtyLeaves++;
-				NumVoxels += VOXELS_PER_DATA_CHUNK;
+				Leaves.Add(&Leaf);
 			}
 		});
 	}
 	
-	FVoxelScopedSlowTask SlowTask(NumDirtyLeaves, VOXEL_LOCTEXT("Rounding voxels"));
-	FScopeToolsTimeLogger ToolsLogger(__FUNCTION__, NumVoxels);
-		
-	FVoxelMutableDataAccelerator OctreeAccelerator(Data, Bounds.Extend(2));
-	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+	FVoxelScopedSlowTask SlowTask(Leaves.Num(), VOXEL_LOCTEXT("Rounding voxels"));
+	FScopeToolsTimeLogger ToolsLogger(__FUNCTION__, uint64(Leaves.Num()) * VOXELS_PER_DATA_CHUNK);
+
+	// Reads the neighbors values
+	return ParallelForEachLeaf(Leaves, true, CancelCounter, SlowTask, [&](FVoxelDataOctreeLeaf& Leaf)
 	{
-		if (Leaf.GetData<FVoxelValue>().IsDirty() && Leaf.GetData<FVoxelValue>().HasAllocation())
+		const FVoxelIntBox LeafBounds = Leaf.GetBounds();
+		FVoxelMutableDataAccelerator OctreeAccelerator(Data, LeafBounds.Extend(2));
+
+		LeafBounds.Iterate([&](int32 X, int32 Y, int32 Z)
 		{
-			SlowTask.EnterProgressFrame();
+			const FVoxelCellIndex Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(LeafBounds.Min, X, Y, Z);
+			const FVoxelValue& Value = Leaf.GetData<FVoxelValue>().Get(Index);
+					
+			if (Value.IsTotallyEmpty() || Value.IsTotallyFull()) return;
 			
-			const FVoxelIntBox LeafBounds = Leaf.GetBounds();
-			LeafBounds.Iterate([&](int32 X, int32 Y, int32 Z)
+			const bool bEmpty = Value.IsEmpty();
+			for (int32 OtherX = X - 2; OtherX <= X + 2; OtherX++)
 			{
-				const FVoxelCellIndex Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(LeafBounds.Min, X, Y, Z);
-				const FVoxelValue& Value = Leaf.GetData<FVoxelValue>().Get(Index);
-						
-				if (Value.IsTotallyEmpty() || Value.IsTotallyFull()) return;
-				
-				const bool bEmpty = Value.IsEmpty();
-				for (int32 OtherX = X - 2; OtherX <= X + 2; OtherX++)
+				for (int32 OtherY = Y - 2; OtherY <= Y + 2; OtherY++)
 				{
-					for (int32 OtherY = Y - 2; OtherY <= Y + 2; OtherY++)
+					for (int32 OtherZ = Z - 2; OtherZ <= Z + 2; OtherZ++)
 					{
-						for (int32 OtherZ = Z - 2; OtherZ <= Z + 2; OtherZ++)
-						{
-							if (OtherX == X && OtherY == Y && OtherZ == Z) continue;
-							const auto OtherValue = OctreeAccelerator.GetValue(OtherX, OtherY, OtherZ, 0);
-							if (OtherValue.IsEmpty() != bEmpty) return;
-						}
+						if (OtherX == X && OtherY == Y && OtherZ == Z) continue;
+						const auto OtherValue = OctreeAccelerator.GetValue(OtherX, OtherY, OtherZ, 0);
+						if (OtherValue.IsEmpty() != bEmpty) return;
 					}
 				}
-				OctreeAccelerator.SetValue(X, Y, Z, bEmpty ? FVoxelValue::Empty() : FVoxelValue::Full());
-			});
-		}
+			}
+			OctreeAccelerator.SetValue(X, Y, Z, bEmpty ? FVoxelValue::Empty() : FVoxelValue::Full());
+		});
 	});
 }
 
@@ -324,75 +409,69 @@ void UVoxelDataTools::RoundVoxelsAsync(
 	bool bHideLatentWarnings)
 {
 	const FVoxelIntBox Bounds = InBounds.Extend(2);
-	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, NO_PREFIX, RoundVoxelsImpl(Data, InBounds));
+	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, DATA_TOOL_CANCEL_PREFIX, RoundVoxelsImpl(Data, InBounds, &CancelCounter));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void UVoxelDataTools::ClearUnusedMaterialsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds)
+bool UVoxelDataTools::ClearUnusedMaterialsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, const FVoxelCancelCounter* CancelCounter)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
-	int32 NumDirtyLeaves = 0;
-	uint64 NumVoxels = 0;
+	TArray<FVoxelDataOctreeLeaf*> Leaves;
 	{
-		VOXEL_ASYNC_SCOPE_COUNTER("Record stats");
+		VOXEL_ASYNC_SCOPE_COUNTER("Find leaves");
 		FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
 		{
 			if (Leaf.GetData<FVoxelMaterial>().IsDirty() && Leaf.GetData<FVoxelMaterial>().HasAllocation())
 			{
-				NumDirtyLeaves++;
-				NumVoxels += VOXELS_PER_DATA_CHUNK;
+				Leaves.Add(&Leaf);
 			}
 		});
 	}
 	
-	FVoxelScopedSlowTask SlowTask(NumDirtyLeaves, VOXEL_LOCTEXT("Clearing unused materials"));
-	FScopeToolsTimeLogger ToolsLogger(__FUNCTION__, NumVoxels);
-		
-	FVoxelMutableDataAccelerator OctreeAccelerator(Data, Bounds.Extend(2));
-	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+	FVoxelScopedSlowTask SlowTask(Leaves.Num(), VOXEL_LOCTEXT("Clearing unused materials"));
+	FScopeToolsTimeLogger ToolsLogger(__FUNCTION__, uint64(Leaves.Num()) * VOXELS_PER_DATA_CHUNK);
+
+	// Only reads the neighbors values, which aren't edited here: no need to split neighbors
+	return ParallelForEachLeaf(Leaves, false, CancelCounter, SlowTask, [&](FVoxelDataOctreeLeaf& Leaf)
 	{
-		if (Leaf.GetData<FVoxelMaterial>().IsDirty() && Leaf.GetData<FVoxelMaterial>().HasAllocation())
+		const FVoxelIntBox LeafBounds = Leaf.GetBounds();
+		FVoxelMutableDataAccelerator OctreeAccelerator(Data, LeafBounds.Extend(1));
+
+		bool bEdited = false;
+		LeafBounds.Iterate([&](int32 X, int32 Y, int32 Z)
 		{
-			SlowTask.EnterProgressFrame();
+			const FVoxelCellIndex Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(LeafBounds.Min, X, Y, Z);
+			const FVoxelMaterial Material = Leaf.GetData<FVoxelMaterial>().Get(Index);
 
-			bool bEdited = false;
+			if (Material == FVoxelMaterial::Default()) return;
 			
-			const FVoxelIntBox LeafBounds = Leaf.GetBounds();
-			LeafBounds.Iterate([&](int32 X, int32 Y, int32 Z)
+			const FVoxelValue Value = OctreeAccelerator.GetValue(X, Y, Z, 0);
+			if (!Value.IsEmpty()) // Only not empty voxels materials can affect the surface
 			{
-				const FVoxelCellIndex Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(LeafBounds.Min, X, Y, Z);
-				const FVoxelMaterial Material = Leaf.GetData<FVoxelMaterial>().Get(Index);
-
-				if (Material == FVoxelMaterial::Default()) return;
-				
-				const FVoxelValue Value = OctreeAccelerator.GetValue(X, Y, Z, 0);
-				if (!Value.IsEmpty()) // Only not empty voxels materials can affect the surface
+				for (int32 OtherX = X - 1; OtherX <= X + 1; OtherX++)
 				{
-					for (int32 OtherX = X - 1; OtherX <= X + 1; OtherX++)
+					for (int32 OtherY = Y - 1; OtherY <= Y + 1; OtherY++)
 					{
-						for (int32 OtherY = Y - 1; OtherY <= Y + 1; OtherY++)
+						for (int32 OtherZ = Z - 1; OtherZ <= Z + 1; OtherZ++)
 						{
-							for (int32 OtherZ = Z - 1; OtherZ <= Z + 1; OtherZ++)
-							{
-								if (OtherX == X && OtherY == Y && OtherZ == Z) continue;
-								const auto OtherValue = OctreeAccelerator.GetValue(OtherX, OtherY, OtherZ, 0);
-								if (OtherValue.IsEmpty()) return;
-							}
+							if (OtherX == X && OtherY == Y && OtherZ == Z) continue;
+							const auto OtherValue = OctreeAccelerator.GetValue(OtherX, OtherY, OtherZ, 0);
+							if (OtherValue.IsEmpty()) return;
 						}
 					}
 				}
-				OctreeAccelerator.SetMaterial(X, Y, Z, FVoxelMaterial::Default());
-				bEdited = true;
-			});
-
-			if (bEdited)
-			{
-				Leaf.GetData<FVoxelMaterial>().Compress(Data);
 			}
+			OctreeAccelerator.SetMaterial(X, Y, Z, FVoxelMaterial::Default());
+			bEdited = true;
+		});
+
+		if (bEdited)
+		{
+			Leaf.GetData<FVoxelMaterial>().Compress(Data);
 		}
 	});
 }
@@ -411,7 +490,7 @@ void UVoxelDataTools::ClearUnusedMaterialsAsync(
 	bool bHideLatentWarnings)
 {
 	const FVoxelIntBox Bounds = InBounds.Extend(1);
-	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, NO_PREFIX, ClearUnusedMaterialsImpl(Data, InBounds));
+	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, DATA_TOOL_CANCEL_PREFIX, ClearUnusedMaterialsImpl(Data, InBounds, &CancelCounter));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -584,7 +663,7 @@ void UVoxelDataTools::CheckForSingleMaterialsAsync(
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<T>& Wrapper, const bool bCheckAllLeaves)
+bool UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<T>& Wrapper, const bool bCheckAllLeaves, const FVoxelCancelCounter* CancelCounter)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
@@ -612,18 +691,16 @@ void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightma
 			});
 		}
 		
-		int32 NumLeaves = 0;
+		TArray<FVoxelDataOctreeLeaf*> Leaves;
 		FVoxelOctreeUtilities::IterateAllLeaves(Data.GetOctree(), [&](FVoxelDataOctreeLeaf& Leaf)
 		{
-			if (Leaf.GetData<FVoxelValue>().IsDirty() || bCheckAllLeaves)
-			{
-				NumLeaves++;
-			}
+			Leaves.Add(&Leaf);
 		});
 
-		FVoxelScopedSlowTask LocalSlowTask(NumLeaves, VOXEL_LOCTEXT("Caching data"));
+		FVoxelScopedSlowTask LocalSlowTask(Leaves.Num(), VOXEL_LOCTEXT("Caching data"));
 
-		FVoxelOctreeUtilities::IterateAllLeaves(Data.GetOctree(), [&](FVoxelDataOctreeLeaf& Leaf)
+		// Each leaf only touches its own data
+		const bool bFinished = ParallelForEachLeaf(Leaves, false, CancelCounter, LocalSlowTask, [&](FVoxelDataOctreeLeaf& Leaf)
 		{
 			ensureThreadSafe(Leaf.IsLockedForWrite());
 
@@ -647,26 +724,40 @@ void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightma
 				{
 					// Flush cache
 					DataHolder.ClearData(Data);
-					return;
 				}
 			}
+		});
+		if (!bFinished)
+		{
+			return false;
+		}
 
-			LocalSlowTask.EnterProgressFrame();
+		for (FVoxelDataOctreeLeaf* Leaf : Leaves)
+		{
+			if (!bCheckAllLeaves && !Leaf->GetData<FVoxelValue>().IsDirty())
+			{
+				continue;
+			}
 
-			const FIntVector Min = Leaf.GetMin();
+			const FIntVector Min = Leaf->GetMin();
 			
 			auto& Column = LeavesColumns.FindOrAdd(FIntPoint(Min.X, Min.Y));
 			check(!Column.Contains(Min.Z));
-			Column.Add(Min.Z, &Leaf);
-		});
+			Column.Add(Min.Z, Leaf);
+		}
 	}
 	
 	SlowTask.EnterProgressFrame();
 	FVoxelScopedSlowTask LocalSlowTask(LeavesColumns.Num(), VOXEL_LOCTEXT("Finding heights"));
 
+	// Leaves can be created and all the columns write to the same heightmap: done on a single thread
 	FVoxelMutableDataAccelerator Accelerator(Data, FVoxelIntBox::Infinite);
 	for (auto& ColumnsIt : LeavesColumns)
 	{
+		if (IsCanceled(CancelCounter))
+		{
+			return false;
+		}
 		LocalSlowTask.EnterProgressFrame();
 		
 		const FIntPoint LeafMinXY = ColumnsIt.Key;
@@ -796,6 +887,8 @@ void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightma
 		}
 
 		// Write the heights
+		TArray<FIntPoint, TInlineAllocator<DATA_CHUNK_SIZE * DATA_CHUNK_SIZE>> HeightsPositions;
+		TArray<float, TInlineAllocator<DATA_CHUNK_SIZE * DATA_CHUNK_SIZE>> HeightsToWrite;
 		for (int32 X = 0; X < DATA_CHUNK_SIZE; X++)
 		{
 			for (int32 Y = 0; Y < DATA_CHUNK_SIZE; Y++)
@@ -803,14 +896,18 @@ void UVoxelDataTools::CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightma
 				const FIntPoint HeightmapPosition = GetHeightmapPosition(X, Y);
 				if (!IsInBounds(HeightmapPosition)) continue;
 
-				Wrapper.SetHeight(HeightmapPosition.X, HeightmapPosition.Y, NewHeights[X + DATA_CHUNK_SIZE * Y]);
+				HeightsPositions.Add(HeightmapPosition);
+				HeightsToWrite.Add(NewHeights[X + DATA_CHUNK_SIZE * Y]);
 			}
 		}
+		Wrapper.SetHeights(HeightsPositions, HeightsToWrite);
 	}
+
+	return true;
 }
 
-template VOXEL_API void UVoxelDataTools::CompressIntoHeightmapImpl<uint16>(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<uint16>& Wrapper, bool bCheckAllLeaves);
-template VOXEL_API void UVoxelDataTools::CompressIntoHeightmapImpl<float>(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<float>& Wrapper, bool bCheckAllLeaves);
+template VOXEL_API bool UVoxelDataTools::CompressIntoHeightmapImpl<uint16>(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<uint16>& Wrapper, bool bCheckAllLeaves, const FVoxelCancelCounter* CancelCounter);
+template VOXEL_API bool UVoxelDataTools::CompressIntoHeightmapImpl<float>(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<float>& Wrapper, bool bCheckAllLeaves, const FVoxelCancelCounter* CancelCounter);
 
 void UVoxelDataTools::CompressIntoHeightmap(
 	AVoxelWorld* World, 
@@ -820,6 +917,7 @@ void UVoxelDataTools::CompressIntoHeightmap(
 	VOXEL_FUNCTION_COUNTER();
 	CHECK_VOXELWORLD_IS_CREATED_VOID();
 
+	FVoxelToolHelpers::FlushEditBatch(World);
 	auto& Data = World->GetData();
 	FVoxelWriteScopeLock Lock(Data, FVoxelIntBox::Infinite, "");
 
@@ -888,35 +986,33 @@ void UVoxelDataTools::CompressIntoHeightmap(
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void UVoxelDataTools::RoundToGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, bool bPreserveNormals)
+bool UVoxelDataTools::RoundToGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, bool bPreserveNormals, const FVoxelCancelCounter* CancelCounter)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
-	int32 NumDirtyLeaves = 0;
-	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+	TArray<FVoxelDataOctreeLeaf*> Leaves;
 	{
-		if (Leaf.GetData<FVoxelValue>().IsDirty())
+		VOXEL_ASYNC_SCOPE_COUNTER("Find leaves");
+		FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
 		{
-			NumDirtyLeaves++;
-		}
-	});
+			if (Leaf.GetData<FVoxelValue>().IsDirty())
+			{
+				Leaves.Add(&Leaf);
+			}
+		});
+	}
 	
-	FVoxelScopedSlowTask SlowTask(NumDirtyLeaves, VOXEL_LOCTEXT("Round To Generator"));
-		
-	FVoxelMutableDataAccelerator OctreeAccelerator(Data, Bounds.Extend(2));
-	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
-	{
-		if (!Leaf.GetData<FVoxelValue>().IsDirty())
-		{
-			return;
-		}
-
-		SlowTask.EnterProgressFrame();
+	FVoxelScopedSlowTask SlowTask(Leaves.Num(), VOXEL_LOCTEXT("Round To Generator"));
 
+	// Reads the neighbors values
+	return ParallelForEachLeaf(Leaves, true, CancelCounter, SlowTask, [&](FVoxelDataOctreeLeaf& Leaf)
+	{
 		// Do not try to round if single value
 		if (!Leaf.GetData<FVoxelValue>().IsSingleValue())
 		{
 			const FVoxelIntBox LeafBounds = Leaf.GetBounds();
+			FVoxelMutableDataAccelerator OctreeAccelerator(Data, LeafBounds.Extend(1));
+
 			LeafBounds.Iterate([&](int32 X, int32 Y, int32 Z)
 			{
 				const FVoxelCellIndex Index = FVoxelDataOctreeUtilities::IndexFromGlobalCoordinates(LeafBounds.Min, X, Y, Z);
@@ -979,27 +1075,31 @@ void UVoxelDataTools::RoundToGeneratorAsync(
 	bool bPreserveNormals,
 	bool bHideLatentWarnings)
 {
-	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, NO_PREFIX, RoundToGeneratorImpl(Data, Bounds, bPreserveNormals));
+	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, DATA_TOOL_CANCEL_PREFIX, RoundToGeneratorImpl(Data, Bounds, bPreserveNormals, &CancelCounter));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void UVoxelDataTools::CheckIfSameAsGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds)
+bool UVoxelDataTools::CheckIfSameAsGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, const FVoxelCancelCounter* CancelCounter)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 	
-	int32 NumLeaves = 0;
-	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+	TArray<FVoxelDataOctreeLeaf*> Leaves;
 	{
-		NumLeaves++;
-	});
+		VOXEL_ASYNC_SCOPE_COUNTER("Find leaves");
+		FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+		{
+			Leaves.Add(&Leaf);
+		});
+	}
+
+	FVoxelScopedSlowTask SlowTask(Leaves.Num(), VOXEL_LOCTEXT("Check If Same As Generator"));
 
-	FVoxelScopedSlowTask SlowTask(NumLeaves, VOXEL_LOCTEXT("Check If Same As Generator"));
-	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](FVoxelDataOctreeLeaf& Leaf)
+	// Only touches the leaf itself
+	return ParallelForEachLeaf(Leaves, false, CancelCounter, SlowTask, [&](FVoxelDataOctreeLeaf& Leaf)
 	{
-		SlowTask.EnterProgressFrame();
 		ensureThreadSafe(Leaf.IsLockedForWrite());
 		if (Leaf.GetData<FVoxelValue>().IsDirty())
 		{
@@ -1024,7 +1124,7 @@ void UVoxelDataTools::CheckIfSameAsGeneratorAsync(
 	FVoxelIntBox Bounds,
 	bool bHideLatentWarnings)
 {
-	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, NO_PREFIX, CheckIfSameAsGeneratorImpl(Data, Bounds));
+	VOXEL_TOOL_LATENT_HELPER(Write, DoNotUpdateRender, DATA_TOOL_CANCEL_PREFIX, CheckIfSameAsGeneratorImpl(Data, Bounds, &CancelCounter));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
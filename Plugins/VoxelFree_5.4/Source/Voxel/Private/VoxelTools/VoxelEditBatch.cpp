@@ -0,0 +1,120 @@
+// Copyright Voxel Plugin SAS. All Rights Reserved.
+
+#include "VoxelTools/VoxelEditBatch.h"
+#include "VoxelRender/IVoxelLODManager.h"
+#include "VoxelData/VoxelData.h"
+
+DEFINE_STAT(STAT_VoxelBatchedEdits);
+DEFINE_STAT(STAT_VoxelBatchedEditsLockScopes);
+
+FVoxelEditBatch::~FVoxelEditBatch()
+{
+	ensureMsgf(Edits.Num() == 0, TEXT("Edit batch destroyed without being flushed, %d edits lost"), Edits.Num());
+}
+
+void FVoxelEditBatch::AddEdit(const FVoxelIntBox& Bounds, bool bUpdateRender, FEdit&& Edit)
+{
+	check(IsInGameThread());
+	check(Edit);
+
+	Edits.Add({ Bounds, bUpdateRender, MoveTemp(Edit) });
+	INC_DWORD_STAT(STAT_VoxelBatchedEdits);
+}
+
+void FVoxelEditBatch::Flush(FVoxelData& Data, IVoxelLODManager& LODManager)
+{
+	check(IsInGameThread());
+
+	if (Edits.Num() == 0)
+	{
+		return;
+	}
+
+	VOXEL_FUNCTION_COUNTER();
+
+	// Edits could in theory add new edits: only flush the current ones
+	const TArray<FQueuedEdit> EditsToApply = MoveTemp(Edits);
+	Edits.Reset();
+
+	const bool bSaveFrame = bSaveFrameRequested;
+	bSaveFrameRequested = false;
+
+	struct FGroup
+	{
+		FVoxelIntBox Bounds;
+		FVoxelIntBoxWithValidity BoundsToUpdate;
+		TArray<int32, TInlineAllocator<8>> EditIndices;
+	};
+	TArray<FGroup> Groups;
+	{
+		VOXEL_SCOPE_COUNTER("Group edits");
+
+		// Merge edits with intersecting bounds in the same group, so that they are applied in order under the same lock
+		// Edits in different groups don't overlap, so the order between groups doesn't matter
+		for (int32 EditIndex = 0; EditIndex < EditsToApply.Num(); EditIndex++)
+		{
+			const FQueuedEdit& Edit = EditsToApply[EditIndex];
+
+			FGroup NewGroup;
+			NewGroup.Bounds = Edit.Bounds;
+			if (Edit.bUpdateRender)
+			{
+				NewGroup.BoundsToUpdate += Edit.Bounds;
+			}
+			NewGroup.EditIndices.Add(EditIndex);
+
+			// Growing the group can make it intersect groups that were already checked
+			bool bMerged = true;
+			while (bMerged)
+			{
+				bMerged = false;
+				for (int32 GroupIndex = Groups.Num() - 1; GroupIndex >= 0; GroupIndex--)
+				{
+					FGroup& Group = Groups[GroupIndex];
+					if (!Group.Bounds.Intersect(NewGroup.Bounds))
+					{
+						continue;
+					}
+
+					NewGroup.Bounds = NewGroup.Bounds + Group.Bounds;
+					NewGroup.BoundsToUpdate += Group.BoundsToUpdate;
+					NewGroup.EditIndices.Append(Group.EditIndices);
+					Groups.RemoveAtSwap(GroupIndex);
+					bMerged = true;
+				}
+			}
+
+			NewGroup.EditIndices.Sort();
+			Groups.Add(MoveTemp(NewGroup));
+		}
+	}
+
+	TArray<FVoxelIntBox> BoundsToUpdate;
+	for (const FGroup& Group : Groups)
+	{
+		{
+			FVoxelWriteScopeLock Lock(Data, Group.Bounds, FUNCTION_FNAME);
+			for (const int32 EditIndex : Group.EditIndices)
+			{
+				EditsToApply[EditIndex].Edit(Data);
+			}
+		}
+		INC_DWORD_STAT(STAT_VoxelBatchedEditsLockScopes);
+
+		if (Group.BoundsToUpdate.IsValid())
+		{
+			BoundsToUpdate.Add(Group.BoundsToUpdate.GetBox());
+		}
+	}
+
+	if (bSaveFrame && ensure(Data.bEnableUndoRedo))
+	{
+		// Same as UVoxelBlueprintLibrary::SaveFrame
+		Data.SaveFrame(FVoxelIntBox::Infinite);
+	}
+
+	if (BoundsToUpdate.Num() > 0)
+	{
+		LODManager.UpdateBounds(BoundsToUpdate);
+	}
+}
@@ -1,6 +1,7 @@
 // Copyright Voxel Plugin SAS. All Rights Reserved.
 
 #include "VoxelTools/VoxelToolHelpers.h"
+#include "VoxelTools/VoxelEditBatch.h"
 #include "VoxelRender/IVoxelLODManager.h"
 #include "IVoxelPool.h"
 
@@ -81,6 +82,7 @@ void FVoxelToolHelpers::StartAsyncEditTask(AVoxelWorld* World, IVoxelQueuedWork*
 {
 	if (World)
 	{
+		FlushEditBatch(World);
 		World->GetPool().QueueTask(EVoxelTaskType::AsyncEditFunctions, Work);
 	}
 	else
@@ -90,6 +92,27 @@ void FVoxelToolHelpers::StartAsyncEditTask(AVoxelWorld* World, IVoxelQueuedWork*
 	}
 }
 
+bool FVoxelToolHelpers::CanBatchEdit(AVoxelWorld* World, bool bRecordModifiedVoxels)
+{
+	check(World);
+	return World->bBatchToolEdits && !bRecordModifiedVoxels && IsInGameThread();
+}
+
+void FVoxelToolHelpers::AddBatchedEdit(AVoxelWorld* World, const FVoxelIntBox& Bounds, bool bUpdateRender, TFunction<void(FVoxelData&)>&& Edit)
+{
+	check(World);
+	World->GetEditBatch().AddEdit(Bounds, bUpdateRender, MoveTemp(Edit));
+}
+
+void FVoxelToolHelpers::FlushEditBatch(const AVoxelWorld* World)
+{
+	check(World);
+	if (IsInGameThread())
+	{
+		World->FlushEditBatch();
+	}
+}
+
 float FVoxelToolHelpers::GetRealDistance(AVoxelWorld* World, float Distance, bool bConvertToVoxelSpace)
 {
 	if (bConvertToVoxelSpace)
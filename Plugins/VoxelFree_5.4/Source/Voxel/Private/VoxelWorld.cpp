@@ -21,6 +21,7 @@
 #include "VoxelTools/VoxelBlueprintLibrary.h"
 #include "VoxelTools/VoxelDataTools.h"
 #include "VoxelTools/VoxelToolHelpers.h"
+#include "VoxelTools/VoxelEditBatch.h"
 #include "VoxelPlaceableItems/VoxelPlaceableItemManager.h"
 #include "VoxelPlaceableItems/Actors/VoxelPlaceableItemActorHelper.h"
 #include "VoxelPlaceableItems/Actors/VoxelAssetActor.h"
@@ -501,6 +502,8 @@ void AVoxelWorld::Tick(float DeltaTime)
 	if (IsCreated())
 	{
 		WorldRoot->TickWorldRoot();
+		FlushEditBatch();
+		Data->CompressIdleLeaves();
 		GameThreadTasks->Flush();
 #if WITH_EDITOR
 		if (PlayType == EVoxelPlayType::Preview && Data->IsDirty())
@@ -964,6 +967,8 @@ void AVoxelWorld::CreateWorldInternal(const FVoxelWorldCreateInfo& Info)
 	DebugManager = CreateDebugManager();
 	EventManager = CreateEventManager();
 	ToolRenderingManager = CreateToolRenderingManager();
+	EditBatch = MakeVoxelShared<FVoxelEditBatch>();
+	OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &AVoxelWorld::OnWorldPostActorTick);
 	Renderer = CreateRenderer();
 	Renderer->OnWorldLoaded.AddUObject(this, &AVoxelWorld::OnWorldLoadedCallback);
 	LODManager = CreateLODManager();
@@ -1034,6 +1039,15 @@ void AVoxelWorld::DestroyWorldInternal()
 
 	check(IsCreated());
 
+	// Don't lose the edits of this frame
+	FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+	OnWorldPostActorTickHandle.Reset();
+	FlushEditBatch();
+	EditBatch.Reset();
+
+	// The async data tools in flight are working on data that is about to be dropped
+	AsyncToolsCancelCounter->Increment();
+
 #if WITH_EDITOR
 	if (PlayType == EVoxelPlayType::Preview)
 	{
@@ -1284,6 +1298,23 @@ void AVoxelWorld::ApplyCollisionSettingsToRoot() const
 	WorldRoot->RecreatePhysicsState();
 }
 
+void AVoxelWorld::FlushEditBatch() const
+{
+	if (EditBatch.IsValid() && !EditBatch->IsEmpty())
+	{
+		EditBatch->Flush(*Data, *LODManager);
+	}
+}
+
+void AVoxelWorld::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds) const
+{
+	// Actors ticking after the voxel world can queue edits: apply them this frame too
+	if (InWorld == GetWorld() && IsCreated())
+	{
+		FlushEditBatch();
+	}
+}
+
 void AVoxelWorld::RecreateRender()
 {
 	VOXEL_FUNCTION_COUNTER();
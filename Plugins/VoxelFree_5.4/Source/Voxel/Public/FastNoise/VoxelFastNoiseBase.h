@@ -155,6 +155,9 @@ protected:
 		T fx, T fy, T fz,
 		T& xs, T& ys, T& zs,
 		T& dx, T& dy, T& dz) const;
+
+	// Interpolate BatchSize values at once
+	void Interpolate_Batch(const v_flt* RESTRICT f, v_flt* RESTRICT s) const;
 	
 protected:
 	template<typename T>
@@ -200,6 +203,39 @@ private:
 	template<typename T>
 	v_flt FractalRigidMulti_3D_Deriv(T GetNoise, v_flt x, v_flt y, v_flt z, int32 octaves, v_flt& outDx, v_flt& outDy, v_flt& outDz) const;
 
+protected:
+	// Split the samples in batches of BatchSize and call GetNoiseBatch(offset, x, y, outValues) on them
+	template<typename T>
+	void Batch_2D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, v_flt frequency, v_flt* outValues) const;
+	template<typename T>
+	void Batch_3D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, v_flt* outValues) const;
+
+	template<typename T>
+	void FractalBatch_2D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, v_flt frequency, int32 octaves, v_flt* outValues) const;
+	template<typename T>
+	void FractalBatch_3D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, int32 octaves, v_flt* outValues) const;
+
+private:
+	template<typename T>
+	static void ForEachBatch_2D(int32 num, const v_flt* x, const v_flt* y, v_flt frequency, v_flt* outValues, T Lambda);
+	template<typename T>
+	static void ForEachBatch_3D(int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, v_flt* outValues, T Lambda);
+
+	// Same as the scalar fractals, on BatchSize samples. Modifies x y z
+	template<typename T>
+	void FractalFBM_2D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, int32 octaves, v_flt* RESTRICT outValues) const;
+	template<typename T>
+	void FractalBillow_2D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, int32 octaves, v_flt* RESTRICT outValues) const;
+	template<typename T>
+	void FractalRigidMulti_2D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, int32 octaves, v_flt* RESTRICT outValues) const;
+	
+	template<typename T>
+	void FractalFBM_3D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, v_flt* RESTRICT z, int32 octaves, v_flt* RESTRICT outValues) const;
+	template<typename T>
+	void FractalBillow_3D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, v_flt* RESTRICT z, int32 octaves, v_flt* RESTRICT outValues) const;
+	template<typename T>
+	void FractalRigidMulti_3D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, v_flt* RESTRICT z, int32 octaves, v_flt* RESTRICT outValues) const;
+
 private:
 	void CalculateFractalBounding(int32 Octaves);
 
@@ -287,4 +323,51 @@ private:
 	FN_FORCEINLINE v_flt Get ## FunctionName ## Fractal_3D_Deriv(v_flt x, v_flt y, v_flt z, v_flt frequency, int32 octaves, v_flt& outDx, v_flt& outDy, v_flt& outDz) const \
 	{ \
 		return This().Fractal_3D_Deriv(FLambda_ ## Single ## FunctionName ## _3D_Deriv { *this }, x, y, z, frequency, octaves, outDx, outDy, outDz); \
-	}
\ No newline at end of file
+	}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// Evaluate num samples at once: x, y, z and outValues are arrays of num elements
+#define GENERATED_VOXEL_NOISE_FUNCTION_BATCH_2D(ClassName, FunctionName) \
+	DEFINE_VOXEL_NOISE_LAMBDA(TVoxelFastNoise_ ## ClassName ## Noise<T>, Single ## FunctionName ## _2D_Batch) \
+	FN_FORCEINLINE void Get ## FunctionName ## _2D_Batch(int32 num, const v_flt* x, const v_flt* y, v_flt frequency, v_flt* outValues) const \
+	{ \
+		This().Batch_2D(FLambda_ ## Single ## FunctionName ## _2D_Batch { *this }, num, x, y, frequency, outValues); \
+	} \
+	FN_FORCEINLINE void Get ## FunctionName ## Fractal_2D_Batch(int32 num, const v_flt* x, const v_flt* y, v_flt frequency, int32 octaves, v_flt* outValues) const \
+	{ \
+		This().FractalBatch_2D(FLambda_ ## Single ## FunctionName ## _2D_Batch { *this }, num, x, y, frequency, octaves, outValues); \
+	}
+
+#define GENERATED_VOXEL_NOISE_FUNCTION_BATCH_3D(ClassName, FunctionName) \
+	DEFINE_VOXEL_NOISE_LAMBDA(TVoxelFastNoise_ ## ClassName ## Noise<T>, Single ## FunctionName ## _3D_Batch) \
+	FN_FORCEINLINE void Get ## FunctionName ## _3D_Batch(int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, v_flt* outValues) const \
+	{ \
+		This().Batch_3D(FLambda_ ## Single ## FunctionName ## _3D_Batch { *this }, num, x, y, z, frequency, outValues); \
+	} \
+	FN_FORCEINLINE void Get ## FunctionName ## Fractal_3D_Batch(int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, int32 octaves, v_flt* outValues) const \
+	{ \
+		This().FractalBatch_3D(FLambda_ ## Single ## FunctionName ## _3D_Batch { *this }, num, x, y, z, frequency, octaves, outValues); \
+	}
+
+// For noises without a batch implementation: call the scalar function on each sample
+// Still benefits from the fractal loops being interleaved
+#define GENERATED_VOXEL_NOISE_SCALAR_BATCH_2D(FunctionName) \
+	FN_FORCEINLINE void Single ## FunctionName ## _2D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, v_flt* RESTRICT outValues) const \
+	{ \
+		for (int32 i = 0; i < FVoxelFastNoiseMath::BatchSize; i++) \
+		{ \
+			outValues[i] = Single ## FunctionName ## _2D(offset, x[i], y[i]); \
+		} \
+	}
+
+#define GENERATED_VOXEL_NOISE_SCALAR_BATCH_3D(FunctionName) \
+	FN_FORCEINLINE void Single ## FunctionName ## _3D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, const v_flt* RESTRICT z, v_flt* RESTRICT outValues) const \
+	{ \
+		for (int32 i = 0; i < FVoxelFastNoiseMath::BatchSize; i++) \
+		{ \
+			outValues[i] = Single ## FunctionName ## _3D(offset, x[i], y[i], z[i]); \
+		} \
+	}
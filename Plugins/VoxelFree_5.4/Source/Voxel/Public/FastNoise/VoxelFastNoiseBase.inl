@@ -175,6 +175,33 @@ FN_FORCEINLINE_MATH void FVoxelFastNoiseBase::Interpolate_3D_Deriv(T fx, T fy, T
 	}
 }
 
+FN_FORCEINLINE_MATH void FVoxelFastNoiseBase::Interpolate_Batch(const v_flt* RESTRICT f, v_flt* RESTRICT s) const
+{
+	// Switch outside of the loops so that they can be vectorized
+	switch (Interpolation)
+	{
+	default: ensureVoxelSlow(false);
+	case EVoxelNoiseInterpolation::Linear:
+		for (int32 i = 0; i < FNoiseMath::BatchSize; i++)
+		{
+			s[i] = f[i];
+		}
+		break;
+	case EVoxelNoiseInterpolation::Hermite:
+		for (int32 i = 0; i < FNoiseMath::BatchSize; i++)
+		{
+			s[i] = FNoiseMath::InterpHermiteFunc(f[i]);
+		}
+		break;
+	case EVoxelNoiseInterpolation::Quintic:
+		for (int32 i = 0; i < FNoiseMath::BatchSize; i++)
+		{
+			s[i] = FNoiseMath::InterpQuinticFunc(f[i]);
+		}
+		break;
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -541,4 +568,337 @@ FN_FORCEINLINE v_flt FVoxelFastNoiseBase::FractalRigidMulti_3D_Deriv(T GetNoise,
 	outDy *= FractalBounding;
 	outDz *= FractalBounding;
 	return sum;
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::ForEachBatch_2D(int32 num, const v_flt* x, const v_flt* y, v_flt frequency, v_flt* outValues, T Lambda)
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	for (int32 start = 0; start < num; start += N)
+	{
+		const int32 count = FMath::Min(N, num - start);
+
+		v_flt batchX[N];
+		v_flt batchY[N];
+		v_flt batchValues[N];
+		for (int32 i = 0; i < N; i++)
+		{
+			// Pad the last batch by repeating its last sample
+			const int32 index = start + FMath::Min(i, count - 1);
+			batchX[i] = x[index] * frequency;
+			batchY[i] = y[index] * frequency;
+		}
+
+		Lambda(batchX, batchY, batchValues);
+
+		FMemory::Memcpy(outValues + start, batchValues, count * sizeof(v_flt));
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::ForEachBatch_3D(int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, v_flt* outValues, T Lambda)
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	for (int32 start = 0; start < num; start += N)
+	{
+		const int32 count = FMath::Min(N, num - start);
+
+		v_flt batchX[N];
+		v_flt batchY[N];
+		v_flt batchZ[N];
+		v_flt batchValues[N];
+		for (int32 i = 0; i < N; i++)
+		{
+			// Pad the last batch by repeating its last sample
+			const int32 index = start + FMath::Min(i, count - 1);
+			batchX[i] = x[index] * frequency;
+			batchY[i] = y[index] * frequency;
+			batchZ[i] = z[index] * frequency;
+		}
+
+		Lambda(batchX, batchY, batchZ, batchValues);
+
+		FMemory::Memcpy(outValues + start, batchValues, count * sizeof(v_flt));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::Batch_2D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, v_flt frequency, v_flt* outValues) const
+{
+	ForEachBatch_2D(num, x, y, frequency, outValues, [&](v_flt* batchX, v_flt* batchY, v_flt* batchValues)
+	{
+		GetNoiseBatch(0, batchX, batchY, batchValues);
+	});
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::Batch_3D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, v_flt* outValues) const
+{
+	ForEachBatch_3D(num, x, y, z, frequency, outValues, [&](v_flt* batchX, v_flt* batchY, v_flt* batchZ, v_flt* batchValues)
+	{
+		GetNoiseBatch(0, batchX, batchY, batchZ, batchValues);
+	});
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalBatch_2D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, v_flt frequency, int32 octaves, v_flt* outValues) const
+{
+	ForEachBatch_2D(num, x, y, frequency, outValues, [&](v_flt* batchX, v_flt* batchY, v_flt* batchValues)
+	{
+#define Macro(Type) Fractal##Type##_2D_Batch(GetNoiseBatch, batchX, batchY, octaves, batchValues)
+		VOXEL_FRACTAL_TYPE_SWITCH(Macro)
+#undef Macro
+	});
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalBatch_3D(T GetNoiseBatch, int32 num, const v_flt* x, const v_flt* y, const v_flt* z, v_flt frequency, int32 octaves, v_flt* outValues) const
+{
+	ForEachBatch_3D(num, x, y, z, frequency, outValues, [&](v_flt* batchX, v_flt* batchY, v_flt* batchZ, v_flt* batchValues)
+	{
+#define Macro(Type) Fractal##Type##_3D_Batch(GetNoiseBatch, batchX, batchY, batchZ, octaves, batchValues)
+		VOXEL_FRACTAL_TYPE_SWITCH(Macro)
+#undef Macro
+	});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalFBM_2D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, int32 octaves, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	v_flt sum[N];
+	GetNoiseBatch(Perm[0], x, y, sum);
+	
+	v_flt amp = 1;
+	int32 i = 0;
+
+	while (++i < octaves)
+	{
+		for (int32 j = 0; j < N; j++)
+		{
+			x[j] *= Lacunarity;
+			y[j] *= Lacunarity;
+		}
+
+		amp *= Gain;
+
+		v_flt noise[N];
+		GetNoiseBatch(Perm[i], x, y, noise);
+		
+		for (int32 j = 0; j < N; j++)
+		{
+			sum[j] += noise[j] * amp;
+		}
+	}
+
+	for (int32 j = 0; j < N; j++)
+	{
+		outValues[j] = sum[j] * FractalBounding;
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalBillow_2D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, int32 octaves, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	v_flt sum[N];
+	GetNoiseBatch(Perm[0], x, y, sum);
+	for (int32 j = 0; j < N; j++)
+	{
+		sum[j] = FNoiseMath::FastAbs(sum[j]) * 2 - 1;
+	}
+	
+	v_flt amp = 1;
+	int32 i = 0;
+
+	while (++i < octaves)
+	{
+		for (int32 j = 0; j < N; j++)
+		{
+			x[j] *= Lacunarity;
+			y[j] *= Lacunarity;
+		}
+		
+		amp *= Gain;
+
+		v_flt noise[N];
+		GetNoiseBatch(Perm[i], x, y, noise);
+		
+		for (int32 j = 0; j < N; j++)
+		{
+			sum[j] += (FNoiseMath::FastAbs(noise[j]) * 2 - 1) * amp;
+		}
+	}
+
+	for (int32 j = 0; j < N; j++)
+	{
+		outValues[j] = sum[j] * FractalBounding;
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalRigidMulti_2D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, int32 octaves, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	GetNoiseBatch(Perm[0], x, y, outValues);
+	for (int32 j = 0; j < N; j++)
+	{
+		outValues[j] = 1 - FNoiseMath::FastAbs(outValues[j]);
+	}
+	
+	v_flt amp = 1;
+	int32 i = 0;
+
+	while (++i < octaves)
+	{
+		for (int32 j = 0; j < N; j++)
+		{
+			x[j] *= Lacunarity;
+			y[j] *= Lacunarity;
+		}
+
+		amp *= Gain;
+
+		v_flt noise[N];
+		GetNoiseBatch(Perm[i], x, y, noise);
+		
+		for (int32 j = 0; j < N; j++)
+		{
+			outValues[j] -= (1 - FNoiseMath::FastAbs(noise[j])) * amp;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalFBM_3D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, v_flt* RESTRICT z, int32 octaves, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	v_flt sum[N];
+	GetNoiseBatch(Perm[0], x, y, z, sum);
+	
+	v_flt amp = 1;
+	int32 i = 0;
+
+	while (++i < octaves)
+	{
+		for (int32 j = 0; j < N; j++)
+		{
+			x[j] *= Lacunarity;
+			y[j] *= Lacunarity;
+			z[j] *= Lacunarity;
+		}
+
+		amp *= Gain;
+
+		v_flt noise[N];
+		GetNoiseBatch(Perm[i], x, y, z, noise);
+		
+		for (int32 j = 0; j < N; j++)
+		{
+			sum[j] += noise[j] * amp;
+		}
+	}
+
+	for (int32 j = 0; j < N; j++)
+	{
+		outValues[j] = sum[j] * FractalBounding;
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalBillow_3D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, v_flt* RESTRICT z, int32 octaves, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	v_flt sum[N];
+	GetNoiseBatch(Perm[0], x, y, z, sum);
+	for (int32 j = 0; j < N; j++)
+	{
+		sum[j] = FNoiseMath::FastAbs(sum[j]) * 2 - 1;
+	}
+	
+	v_flt amp = 1;
+	int32 i = 0;
+
+	while (++i < octaves)
+	{
+		for (int32 j = 0; j < N; j++)
+		{
+			x[j] *= Lacunarity;
+			y[j] *= Lacunarity;
+			z[j] *= Lacunarity;
+		}
+		
+		amp *= Gain;
+
+		v_flt noise[N];
+		GetNoiseBatch(Perm[i], x, y, z, noise);
+		
+		for (int32 j = 0; j < N; j++)
+		{
+			sum[j] += (FNoiseMath::FastAbs(noise[j]) * 2 - 1) * amp;
+		}
+	}
+
+	for (int32 j = 0; j < N; j++)
+	{
+		outValues[j] = sum[j] * FractalBounding;
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE void FVoxelFastNoiseBase::FractalRigidMulti_3D_Batch(T GetNoiseBatch, v_flt* RESTRICT x, v_flt* RESTRICT y, v_flt* RESTRICT z, int32 octaves, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+	
+	GetNoiseBatch(Perm[0], x, y, z, outValues);
+	for (int32 j = 0; j < N; j++)
+	{
+		outValues[j] = 1 - FNoiseMath::FastAbs(outValues[j]);
+	}
+	
+	v_flt amp = 1;
+	int32 i = 0;
+
+	while (++i < octaves)
+	{
+		for (int32 j = 0; j < N; j++)
+		{
+			x[j] *= Lacunarity;
+			y[j] *= Lacunarity;
+			z[j] *= Lacunarity;
+		}
+
+		amp *= Gain;
+
+		v_flt noise[N];
+		GetNoiseBatch(Perm[i], x, y, z, noise);
+		
+		for (int32 j = 0; j < N; j++)
+		{
+			outValues[j] -= (1 - FNoiseMath::FastAbs(noise[j])) * amp;
+		}
+	}
+}
@@ -14,6 +14,12 @@
 class FVoxelFastNoiseMath
 {
 public:
+	// Number of samples processed together by the _Batch functions
+	// Each step is a plain loop over the samples so that it is vectorized for the target instruction set (SSE, AVX, NEON)
+	// Note: the instruction set is picked at compile time by the target settings (eg MinCpuArchX64 for AVX2), there is no runtime dispatch
+	// Only the LUT lookups stay scalar: results are exactly the same as calling the scalar functions
+	static constexpr int32 BatchSize = 8;
+
 	static int32 FastFloor(v_flt f);
 	static int32 FastRound(v_flt f);
 	static int32 FastAbs(int32 i);
@@ -75,4 +75,88 @@ public:
 
 		UE_DEBUG_BREAK();
 	}
+
+	// Check that the batch functions return the exact same values as the scalar ones
+	static void TestBatch()
+	{
+		FVoxelFastNoise FastNoise;
+		FastNoise.SetSeed(1337);
+		FastNoise.SetFractalOctavesAndGain(5, 0.5f);
+
+		const int32 Num = 1000003; // Not a multiple of the batch size
+		const v_flt Frequency = 0.02f;
+		const int32 Octaves = 5;
+
+		FRandomStream Stream(0);
+		TArray<v_flt> X, Y, Z;
+		X.SetNumUninitialized(Num);
+		Y.SetNumUninitialized(Num);
+		Z.SetNumUninitialized(Num);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			X[Index] = Stream.FRandRange(-10000.f, 10000.f);
+			Y[Index] = Stream.FRandRange(-10000.f, 10000.f);
+			Z[Index] = Stream.FRandRange(-10000.f, 10000.f);
+		}
+
+		TArray<v_flt> Values;
+		Values.SetNumUninitialized(Num);
+
+		const auto Check = [&](const TCHAR* Name, auto Batch, auto Scalar)
+		{
+			double BatchTime;
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				Batch();
+				BatchTime = FPlatformTime::Seconds() - StartTime;
+			}
+
+			double ScalarTime;
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Index = 0; Index < Num; Index++)
+				{
+					ensure(Values[Index] == Scalar(Index));
+				}
+				ScalarTime = FPlatformTime::Seconds() - StartTime;
+			}
+
+			LOG_VOXEL(Log, TEXT("%s: batch took %fns, scalar took %fns"), Name, BatchTime / Num * 1e9, ScalarTime / Num * 1e9);
+		};
+
+#define CHECK_NOISE(Name) \
+		Check(TEXT(#Name "_2D"), \
+			[&]() { FastNoise.Get ## Name ## _2D_Batch(Num, X.GetData(), Y.GetData(), Frequency, Values.GetData()); }, \
+			[&](int32 Index) { return FastNoise.Get ## Name ## _2D(X[Index], Y[Index], Frequency); }); \
+		Check(TEXT(#Name "_3D"), \
+			[&]() { FastNoise.Get ## Name ## _3D_Batch(Num, X.GetData(), Y.GetData(), Z.GetData(), Frequency, Values.GetData()); }, \
+			[&](int32 Index) { return FastNoise.Get ## Name ## _3D(X[Index], Y[Index], Z[Index], Frequency); }); \
+		Check(TEXT(#Name "Fractal_2D"), \
+			[&]() { FastNoise.Get ## Name ## Fractal_2D_Batch(Num, X.GetData(), Y.GetData(), Frequency, Octaves, Values.GetData()); }, \
+			[&](int32 Index) { return FastNoise.Get ## Name ## Fractal_2D(X[Index], Y[Index], Frequency, Octaves); }); \
+		Check(TEXT(#Name "Fractal_3D"), \
+			[&]() { FastNoise.Get ## Name ## Fractal_3D_Batch(Num, X.GetData(), Y.GetData(), Z.GetData(), Frequency, Octaves, Values.GetData()); }, \
+			[&](int32 Index) { return FastNoise.Get ## Name ## Fractal_3D(X[Index], Y[Index], Z[Index], Frequency, Octaves); });
+
+		for (const EVoxelNoiseFractalType FractalType : { EVoxelNoiseFractalType::FBM, EVoxelNoiseFractalType::Billow, EVoxelNoiseFractalType::RigidMulti })
+		{
+			FastNoise.SetFractalType(FractalType);
+			
+			for (const EVoxelNoiseInterpolation Interpolation : { EVoxelNoiseInterpolation::Linear, EVoxelNoiseInterpolation::Hermite, EVoxelNoiseInterpolation::Quintic })
+			{
+				FastNoise.SetInterpolation(Interpolation);
+				
+				CHECK_NOISE(Value);
+				CHECK_NOISE(Perlin);
+			}
+
+			CHECK_NOISE(Simplex);
+			CHECK_NOISE(Cubic);
+			CHECK_NOISE(Crater);
+		}
+
+#undef CHECK_NOISE
+
+		UE_DEBUG_BREAK();
+	}
 };
\ No newline at end of file
@@ -28,6 +28,8 @@ public:
 	GENERATED_VOXEL_NOISE_FUNCTION_3D(Crater)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_2D(Cellular, Crater)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D(Cellular, Crater)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_2D(Cellular, Crater)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_3D(Cellular, Crater)
 	
 	FN_FORCEINLINE v_flt GetGavoronoi_2D(v_flt x, v_flt y, v_flt frequency, v_flt dirX, v_flt dirY, v_flt dirVariation) const
 	{
@@ -59,6 +61,9 @@ protected:
 	
 	v_flt SingleCrater_2D(uint8 offset, v_flt x, v_flt y) const;
 	v_flt SingleCrater_3D(uint8 offset, v_flt x, v_flt y, v_flt z) const;
+
+	GENERATED_VOXEL_NOISE_SCALAR_BATCH_2D(Crater)
+	GENERATED_VOXEL_NOISE_SCALAR_BATCH_3D(Crater)
 	
 	v_flt SingleGavoronoi_2D(uint8 offset, v_flt x, v_flt y, v_flt dirX, v_flt dirY, v_flt dirVariation) const;
 	v_flt SingleGavoronoi_Erosion_2D(uint8 offset, v_flt x, v_flt y, v_flt dirX, v_flt dirY, v_flt& outDx, v_flt& outDy) const;
@@ -14,6 +14,8 @@ public:
 	GENERATED_VOXEL_NOISE_FUNCTION_3D(Cubic)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_2D(Cubic, Cubic)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D(Cubic, Cubic)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_2D(Cubic, Cubic)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_3D(Cubic, Cubic)
 
 protected:
 	static constexpr v_flt CUBIC_2D_BOUNDING = 1 / (v_flt(1.5) * v_flt(1.5));
@@ -21,4 +23,7 @@ protected:
 
 	v_flt SingleCubic_2D(uint8 offset, v_flt x, v_flt y) const;
 	v_flt SingleCubic_3D(uint8 offset, v_flt x, v_flt y, v_flt z) const;
+
+	GENERATED_VOXEL_NOISE_SCALAR_BATCH_2D(Cubic)
+	GENERATED_VOXEL_NOISE_SCALAR_BATCH_3D(Cubic)
 };
\ No newline at end of file
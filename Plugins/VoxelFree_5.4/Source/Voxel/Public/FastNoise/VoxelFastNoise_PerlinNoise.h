@@ -18,6 +18,8 @@ public:
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_2D_DERIV(Perlin, Perlin)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D(Perlin, Perlin)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D_DERIV(Perlin, Perlin)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_2D(Perlin, Perlin)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_3D(Perlin, Perlin)
 
 protected:
 	v_flt SinglePerlin_2D(uint8 offset, v_flt x, v_flt y) const;
@@ -25,4 +27,7 @@ protected:
 	
 	v_flt SinglePerlin_3D(uint8 offset, v_flt x, v_flt y, v_flt z) const;
 	v_flt SinglePerlin_3D_Deriv(uint8 offset, v_flt x, v_flt y, v_flt z, v_flt& outDx, v_flt& outDy, v_flt& outDz) const;
+	
+	void SinglePerlin_2D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, v_flt* RESTRICT outValues) const;
+	void SinglePerlin_3D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, const v_flt* RESTRICT z, v_flt* RESTRICT outValues) const;
 };
\ No newline at end of file
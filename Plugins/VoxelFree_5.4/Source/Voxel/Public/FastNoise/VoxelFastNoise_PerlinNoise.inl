@@ -241,4 +241,108 @@ FN_FORCEINLINE_SINGLE v_flt TVoxelFastNoise_PerlinNoise<T>::SinglePerlin_3D_Deri
 		ys * zs * (va - vc - ve + vg) + 
 		zs * xs * (va - vb - ve + vf) + 
 		xs * ys * zs * (-va + vb + vc - vd + ve - vf - vg + vh);
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+FN_FORCEINLINE_SINGLE void TVoxelFastNoise_PerlinNoise<T>::SinglePerlin_2D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+
+	int32 x0[N];
+	int32 y0[N];
+	v_flt fx[N];
+	v_flt fy[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x0[i] = FNoiseMath::FastFloor(x[i]);
+		y0[i] = FNoiseMath::FastFloor(y[i]);
+		fx[i] = x[i] - x0[i];
+		fy[i] = y[i] - y0[i];
+	}
+	
+	int32 x1[N];
+	int32 y1[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x1[i] = x0[i] + 1;
+		y1[i] = y0[i] + 1;
+	}
+
+	v_flt xs[N];
+	v_flt ys[N];
+	This().Interpolate_Batch(fx, xs);
+	This().Interpolate_Batch(fy, ys);
+
+	// Only the LUT lookups are scalar
+	for (int32 i = 0; i < N; i++)
+	{
+		const v_flt xd1 = fx[i] - 1;
+		const v_flt yd1 = fy[i] - 1;
+
+		const v_flt xf0 = FNoiseMath::Lerp(This().GradCoord2D(offset, x0[i], y0[i], fx[i], fy[i]), This().GradCoord2D(offset, x1[i], y0[i], xd1, fy[i]), xs[i]);
+		const v_flt xf1 = FNoiseMath::Lerp(This().GradCoord2D(offset, x0[i], y1[i], fx[i], yd1), This().GradCoord2D(offset, x1[i], y1[i], xd1, yd1), xs[i]);
+
+		outValues[i] = FNoiseMath::Lerp(xf0, xf1, ys[i]);
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE_SINGLE void TVoxelFastNoise_PerlinNoise<T>::SinglePerlin_3D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, const v_flt* RESTRICT z, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+
+	int32 x0[N];
+	int32 y0[N];
+	int32 z0[N];
+	v_flt fx[N];
+	v_flt fy[N];
+	v_flt fz[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x0[i] = FNoiseMath::FastFloor(x[i]);
+		y0[i] = FNoiseMath::FastFloor(y[i]);
+		z0[i] = FNoiseMath::FastFloor(z[i]);
+		fx[i] = x[i] - x0[i];
+		fy[i] = y[i] - y0[i];
+		fz[i] = z[i] - z0[i];
+	}
+	
+	int32 x1[N];
+	int32 y1[N];
+	int32 z1[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x1[i] = x0[i] + 1;
+		y1[i] = y0[i] + 1;
+		z1[i] = z0[i] + 1;
+	}
+
+	v_flt xs[N];
+	v_flt ys[N];
+	v_flt zs[N];
+	This().Interpolate_Batch(fx, xs);
+	This().Interpolate_Batch(fy, ys);
+	This().Interpolate_Batch(fz, zs);
+
+	// Only the LUT lookups are scalar
+	for (int32 i = 0; i < N; i++)
+	{
+		const v_flt xd1 = fx[i] - 1;
+		const v_flt yd1 = fy[i] - 1;
+		const v_flt zd1 = fz[i] - 1;
+
+		const v_flt xf00 = FNoiseMath::Lerp(This().GradCoord3D(offset, x0[i], y0[i], z0[i], fx[i], fy[i], fz[i]), This().GradCoord3D(offset, x1[i], y0[i], z0[i], xd1, fy[i], fz[i]), xs[i]);
+		const v_flt xf10 = FNoiseMath::Lerp(This().GradCoord3D(offset, x0[i], y1[i], z0[i], fx[i], yd1, fz[i]), This().GradCoord3D(offset, x1[i], y1[i], z0[i], xd1, yd1, fz[i]), xs[i]);
+		const v_flt xf01 = FNoiseMath::Lerp(This().GradCoord3D(offset, x0[i], y0[i], z1[i], fx[i], fy[i], zd1), This().GradCoord3D(offset, x1[i], y0[i], z1[i], xd1, fy[i], zd1), xs[i]);
+		const v_flt xf11 = FNoiseMath::Lerp(This().GradCoord3D(offset, x0[i], y1[i], z1[i], fx[i], yd1, zd1), This().GradCoord3D(offset, x1[i], y1[i], z1[i], xd1, yd1, zd1), xs[i]);
+
+		const v_flt yf0 = FNoiseMath::Lerp(xf00, xf10, ys[i]);
+		const v_flt yf1 = FNoiseMath::Lerp(xf01, xf11, ys[i]);
+
+		outValues[i] = FNoiseMath::Lerp(yf0, yf1, zs[i]);
+	}
+}
@@ -14,6 +14,8 @@ public:
 	GENERATED_VOXEL_NOISE_FUNCTION_3D(Simplex)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_2D(Simplex, Simplex)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D(Simplex, Simplex)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_2D(Simplex, Simplex)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_3D(Simplex, Simplex)
 
 protected:
 	static constexpr v_flt SQRT3 = v_flt(1.7320508075688772935274463415059);
@@ -25,4 +27,7 @@ protected:
 	
 	v_flt SingleSimplex_2D(uint8 offset, v_flt x, v_flt y) const;
 	v_flt SingleSimplex_3D(uint8 offset, v_flt x, v_flt y, v_flt z) const;
+
+	GENERATED_VOXEL_NOISE_SCALAR_BATCH_2D(Simplex)
+	GENERATED_VOXEL_NOISE_SCALAR_BATCH_3D(Simplex)
 };
\ No newline at end of file
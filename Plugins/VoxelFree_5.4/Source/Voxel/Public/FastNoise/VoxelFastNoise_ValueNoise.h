@@ -18,6 +18,8 @@ public:
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_2D_DERIV(Value, Value)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D(Value, Value)
 	GENERATED_VOXEL_NOISE_FUNCTION_FRACTAL_3D_DERIV(Value, Value)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_2D(Value, Value)
+	GENERATED_VOXEL_NOISE_FUNCTION_BATCH_3D(Value, Value)
 
 protected:
 	v_flt SingleValue_2D(uint8 offset, v_flt x, v_flt y) const;
@@ -26,6 +28,9 @@ protected:
 	v_flt SingleValue_3D(uint8 offset, v_flt x, v_flt y, v_flt z) const;
 	v_flt SingleValue_3D_Deriv(uint8 offset, v_flt x, v_flt y, v_flt z, v_flt& outDx, v_flt& outDy, v_flt& outDz) const;
 	
+	void SingleValue_2D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, v_flt* RESTRICT outValues) const;
+	void SingleValue_3D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, const v_flt* RESTRICT z, v_flt* RESTRICT outValues) const;
+	
 	VectorRegister SingleValue_2D(VectorRegister4Int offset, VectorRegister x, VectorRegister y) const;
 	
 public:
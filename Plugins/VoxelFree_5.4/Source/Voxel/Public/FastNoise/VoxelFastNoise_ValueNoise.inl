@@ -165,6 +165,103 @@ FN_FORCEINLINE_SINGLE v_flt TVoxelFastNoise_ValueNoise<T>::SingleValue_3D_Deriv(
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+template<typename T>
+FN_FORCEINLINE_SINGLE void TVoxelFastNoise_ValueNoise<T>::SingleValue_2D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+
+	int32 x0[N];
+	int32 y0[N];
+	v_flt fx[N];
+	v_flt fy[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x0[i] = FNoiseMath::FastFloor(x[i]);
+		y0[i] = FNoiseMath::FastFloor(y[i]);
+		fx[i] = x[i] - x0[i];
+		fy[i] = y[i] - y0[i];
+	}
+	
+	int32 x1[N];
+	int32 y1[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x1[i] = x0[i] + 1;
+		y1[i] = y0[i] + 1;
+	}
+
+	v_flt xs[N];
+	v_flt ys[N];
+	This().Interpolate_Batch(fx, xs);
+	This().Interpolate_Batch(fy, ys);
+
+	// Only the LUT lookups are scalar
+	for (int32 i = 0; i < N; i++)
+	{
+		const v_flt xf0 = FNoiseMath::Lerp(This().ValCoord2DFast(offset, x0[i], y0[i]), This().ValCoord2DFast(offset, x1[i], y0[i]), xs[i]);
+		const v_flt xf1 = FNoiseMath::Lerp(This().ValCoord2DFast(offset, x0[i], y1[i]), This().ValCoord2DFast(offset, x1[i], y1[i]), xs[i]);
+
+		outValues[i] = FNoiseMath::Lerp(xf0, xf1, ys[i]);
+	}
+}
+
+template<typename T>
+FN_FORCEINLINE_SINGLE void TVoxelFastNoise_ValueNoise<T>::SingleValue_3D_Batch(uint8 offset, const v_flt* RESTRICT x, const v_flt* RESTRICT y, const v_flt* RESTRICT z, v_flt* RESTRICT outValues) const
+{
+	constexpr int32 N = FNoiseMath::BatchSize;
+
+	int32 x0[N];
+	int32 y0[N];
+	int32 z0[N];
+	v_flt fx[N];
+	v_flt fy[N];
+	v_flt fz[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x0[i] = FNoiseMath::FastFloor(x[i]);
+		y0[i] = FNoiseMath::FastFloor(y[i]);
+		z0[i] = FNoiseMath::FastFloor(z[i]);
+		fx[i] = x[i] - x0[i];
+		fy[i] = y[i] - y0[i];
+		fz[i] = z[i] - z0[i];
+	}
+	
+	int32 x1[N];
+	int32 y1[N];
+	int32 z1[N];
+	for (int32 i = 0; i < N; i++)
+	{
+		x1[i] = x0[i] + 1;
+		y1[i] = y0[i] + 1;
+		z1[i] = z0[i] + 1;
+	}
+
+	v_flt xs[N];
+	v_flt ys[N];
+	v_flt zs[N];
+	This().Interpolate_Batch(fx, xs);
+	This().Interpolate_Batch(fy, ys);
+	This().Interpolate_Batch(fz, zs);
+
+	// Only the LUT lookups are scalar
+	for (int32 i = 0; i < N; i++)
+	{
+		const v_flt xf00 = FNoiseMath::Lerp(This().ValCoord3DFast(offset, x0[i], y0[i], z0[i]), This().ValCoord3DFast(offset, x1[i], y0[i], z0[i]), xs[i]);
+		const v_flt xf10 = FNoiseMath::Lerp(This().ValCoord3DFast(offset, x0[i], y1[i], z0[i]), This().ValCoord3DFast(offset, x1[i], y1[i], z0[i]), xs[i]);
+		const v_flt xf01 = FNoiseMath::Lerp(This().ValCoord3DFast(offset, x0[i], y0[i], z1[i]), This().ValCoord3DFast(offset, x1[i], y0[i], z1[i]), xs[i]);
+		const v_flt xf11 = FNoiseMath::Lerp(This().ValCoord3DFast(offset, x0[i], y1[i], z1[i]), This().ValCoord3DFast(offset, x1[i], y1[i], z1[i]), xs[i]);
+
+		const v_flt yf0 = FNoiseMath::Lerp(xf00, xf10, ys[i]);
+		const v_flt yf1 = FNoiseMath::Lerp(xf01, xf11, ys[i]);
+
+		outValues[i] = FNoiseMath::Lerp(yf0, yf1, zs[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename T>
 VectorRegister TVoxelFastNoise_ValueNoise<T>::SingleValue_2D(VectorRegister4Int offset, VectorRegister x, VectorRegister y) const
 {
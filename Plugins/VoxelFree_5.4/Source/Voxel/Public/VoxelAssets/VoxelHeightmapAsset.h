@@ -60,6 +60,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightmap Generator Settings", meta = (ClampMin = 1))
 	float Precision = 4;
 
+	// If true, distant LODs will sample prefiltered mips of the heightmap instead of the full resolution heights
+	// Reduces aliasing and the number of tiles decompressed when rendering far away chunks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Heightmap Generator Settings")
+	bool bUseHeightMips = true;
+
 	UFUNCTION(BlueprintCallable, Category = "Voxel|Heightmap Asset")
 	int32 GetWidth() const
 	{
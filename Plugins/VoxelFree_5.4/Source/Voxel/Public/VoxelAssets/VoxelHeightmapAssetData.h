@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "VoxelMaterial.h"
 #include "VoxelRange.h"
+#include <atomic>
 
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Heightmap Assets Memory"), STAT_VoxelHeightmapAssetMemory, STATGROUP_VoxelMemory, VOXEL_API);
 
@@ -29,26 +30,49 @@ namespace FVoxelHeightmapAssetDataVersion
 		SHARED_StoreMaterialChannelsIndividuallyAndRemoveFoliage,
 		UseTArray64,
 		SerializeHeightRangeMips,
-		
+		CompressedTilesAndHeightMips,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
 	};
 };
 
+namespace FVoxelHeightmapAssetTiles
+{
+	// Max memory used by the decompressed tiles of a heightmap, in bytes
+	VOXEL_API int64 GetMaxResidentMemory();
+	// Compressed memory above which a heightmap logs a warning, in bytes. 0 to disable
+	VOXEL_API int64 GetCompressedMemoryWarningThreshold();
+}
+
+/**
+ * Heights & materials are stored in TileSize x TileSize tiles, compressed in memory
+ * Tiles are decompressed on demand, and kept in a LRU bounded by voxel.heightmaps.TileCacheSize
+ * Levels after the first one are box filtered height mips, used to sample distant LODs
+ *
+ * All the compressed tiles stay in memory: only the decompressed working set is bounded
+ * TODO Page the compressed tiles from disk, which needs the asset to store them as bulk data.
+ * Until then, voxel.heightmaps.CompressedMemoryWarningThreshold reports the assets that are too big to stay resident
+ */
 template<typename T>
 struct TVoxelHeightmapAssetData
-{	
+{
 public:
+	static constexpr int64 TileSize = 128;
+
 	TVoxelHeightmapAssetData()
 	{
 		ClearData();
 	}
 	~TVoxelHeightmapAssetData()
 	{
+		ReleaseTiles();
 		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, AllocatedSize);
 	}
 
+	UE_NONCOPYABLE(TVoxelHeightmapAssetData);
+
 public:
 	int64 GetWidth() const
 	{
@@ -77,21 +101,21 @@ public:
 		SetSize(2, 2, false, {});
 		SetAllHeightsTo(0);
 	}
-	
+
 public:
 	bool HasMaterials() const
 	{
-		return Materials.Num() > 0;
+		return MaterialSize > 0;
 	}
 	bool IsEmpty() const
 	{
-		return Heights.Num() <= 4 && Materials.Num() == 0;
+		return Width * Height <= 4 && !HasMaterials();
 	}
 	int64 GetAllocatedSize() const
 	{
 		return AllocatedSize;
 	}
-	
+
 public:
 	int64 GetNumHeightRangeMips() const
 	{
@@ -123,13 +147,10 @@ public:
 	{
 		return (0 <= X && X < Width) && (0 <= Y && Y < Height);
 	}
-	FORCEINLINE int64 GetIndex(int64 X, int64 Y) const
-	{
-		checkVoxelSlow(IsValidIndex(X, Y));
-		return X + Width * Y;
-	}
 
 	void SetHeight(int64 X, int64 Y, T NewHeight);
+	// Same as calling SetHeight on every position, but only locks the tiles once
+	void SetHeights(TConstArrayView<FIntPoint> Positions, TConstArrayView<T> NewHeights);
 
 	void SetMaterial_RGB(int64 X, int64 Y, FColor Color);
 	void SetMaterial_SingleIndex(int64 X, int64 Y, uint8 SingleIndex);
@@ -137,17 +158,9 @@ public:
 
 	FORCEINLINE T GetHeightUnsafe(int64 X, int64 Y) const
 	{
-		return GetHeightUnsafe(GetIndex(X, Y));
-	}
-	FORCEINLINE FVoxelMaterial GetMaterialUnsafe(int64 X, int64 Y) const
-	{
-		return GetMaterialUnsafe(GetIndex(X, Y));
+		return GetLevelHeightUnsafe(0, X, Y);
 	}
-	FORCEINLINE T GetHeightUnsafe(int64 Index) const
-	{
-		return Heights[Index];
-	}
-	FVoxelMaterial GetMaterialUnsafe(int64 Index) const;
+	FVoxelMaterial GetMaterialUnsafe(int64 X, int64 Y) const;
 
 public:
 	void TileCoordinates(int64& X, int64& Y) const;
@@ -155,7 +168,7 @@ public:
 
 	T GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode) const;
 	FVoxelMaterial GetMaterial(int64 X, int64 Y, EVoxelSamplerMode Mode) const;
-	
+
 	T GetHeight(int32 X, int32 Y, EVoxelSamplerMode Mode) const
 	{
 		return GetHeight(int64(X), int64(Y), Mode);
@@ -169,26 +182,34 @@ public:
 	FVoxelMaterial GetMaterial(float X, float Y, EVoxelSamplerMode Mode) const;
 
 public:
-	const auto& GetRawHeights() const
+	int32 GetNumHeightMips() const
 	{
-		return Heights;
+		return Levels.Num();
 	}
+	// Mip 0 is the full resolution heightmap. Mip N averages 2^N x 2^N pixels
+	// Falls back to mip 0 if the mips are outdated
+	float GetHeight(float X, float Y, EVoxelSamplerMode Mode, int32 Mip) const;
+
+	// Called after loading and before saving. Needs to be called after SetHeight for the mips to be used
+	void UpdateHeightMips();
 
 public:
 	void Serialize(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave);
-	
+
 private:
-	TNoGrowArray64<T> Heights;
-	TNoGrowArray64<uint8> Materials;
+	void SerializeLegacy(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave);
 
+private:
 	// In theory these fit in int32, but it's safer to use 64 bit math everywhere
 	int64 Width = -1;
 	int64 Height = -1;
-	
+
 	T MinHeight = 0;
 	T MaxHeight = 0;
 
 	EVoxelMaterialConfig MaterialConfig{};
+	// Number of bytes per pixel, 0 if no materials
+	int32 MaterialSize = 0;
 
 	struct FHeightRangeMip
 	{
@@ -217,9 +238,100 @@ private:
 		}
 	};
 	TArray<FHeightRangeMip, TInlineAllocator<16>> HeightRangeMips;
-	
+
 private:
-	int64 AllocatedSize = 0;
+	struct FTileData
+	{
+		TArray<T> Heights;
+		// Only on level 0, MaterialSize per pixel
+		TArray<uint8> Materials;
+		// Set when the tile is evicted or reset: thread caches still referencing this data must load the tile again
+		std::atomic<bool> bReleased{ false };
 
-	void UpdateStats();
-};
\ No newline at end of file
+		int64 GetAllocatedSize() const
+		{
+			return Heights.GetAllocatedSize() + Materials.GetAllocatedSize();
+		}
+	};
+	struct FTile
+	{
+		// Heights then materials, compressed. Empty if the tile was never set
+		TArray<uint8> CompressedData;
+		// Set if the tile is resident
+		TVoxelSharedPtr<FTileData> Data;
+		// If true, Data was modified after CompressedData was computed
+		bool bDirty = false;
+
+		// Doubly linked list of the resident tiles, from the most recently used to the least recently used
+		int32 Previous = -1;
+		int32 Next = -1;
+	};
+	struct FLevel
+	{
+		int64 Width = 0;
+		int64 Height = 0;
+		int64 NumTilesX = 0;
+		int64 NumTilesY = 0;
+		// Index of the first tile of this level in Tiles
+		int32 FirstTile = 0;
+	};
+
+	// Level 0 is the full resolution data, the next ones are the height mips
+	TArray<FLevel, TInlineAllocator<16>> Levels;
+
+	// Tiles are paged in & out by const accessors
+	mutable FCriticalSection Section;
+	mutable TArray<FTile> Tiles;
+	mutable int32 MostRecentTile = -1;
+	mutable int32 LeastRecentTile = -1;
+	mutable int64 ResidentMemory = 0;
+	mutable int64 CompressedMemory = 0;
+	mutable std::atomic<bool> bWarnedAboutCompressedMemory{ false };
+
+	// Height of the pixels of tiles that were never set
+	T DefaultHeight = 0;
+	// Set by SetHeight until UpdateHeightMips is called
+	std::atomic<bool> bHeightMipsOutdated{ true };
+
+	FORCEINLINE int32 GetTileIndex(int32 Level, int64 X, int64 Y) const
+	{
+		const FLevel& LevelInfo = Levels[Level];
+		checkVoxelSlow(0 <= X && X < LevelInfo.Width && 0 <= Y && Y < LevelInfo.Height);
+		return LevelInfo.FirstTile + (X / TileSize) + LevelInfo.NumTilesX * (Y / TileSize);
+	}
+	FORCEINLINE static int64 GetIndexInTile(int64 X, int64 Y)
+	{
+		return (X % TileSize) + TileSize * (Y % TileSize);
+	}
+
+	T GetLevelHeightUnsafe(int32 Level, int64 X, int64 Y) const;
+	T GetLevelHeight(int32 Level, int64 X, int64 Y, EVoxelSamplerMode Mode) const;
+
+	// Thread safe, uses a small per-thread cache before locking. Evicting a tile only invalidates the cache entries of that tile
+	// The reference is valid until the next call to GetTileData on this thread
+	const FTileData& GetTileData(int32 TileIndex) const;
+	// Section must be locked
+	FTileData& LoadTileForWrite(int32 TileIndex);
+	const TVoxelSharedPtr<FTileData>& LoadTile_AssumeLocked(int32 TileIndex) const;
+
+	void ResetTiles();
+	// Mark the resident tiles data as released and free them
+	void ReleaseTiles();
+	void ReleaseTile_AssumeLocked(FTile& Tile) const;
+	void UpdateHeightRanges(int64 X, int64 Y, T NewHeight);
+	void CompressTile_AssumeLocked(int32 TileIndex) const;
+	void Unlink_AssumeLocked(int32 TileIndex) const;
+	void LinkAsMostRecent_AssumeLocked(int32 TileIndex) const;
+	void EvictTiles_AssumeLocked(int32 TileToKeep) const;
+
+	int32 GetNumMaterialsPerTile(int32 TileIndex) const
+	{
+		// Height mips don't have materials
+		return TileIndex < Levels[0].NumTilesX * Levels[0].NumTilesY ? MaterialSize * TileSize * TileSize : 0;
+	}
+
+private:
+	mutable int64 AllocatedSize = 0;
+
+	void UpdateStats() const;
+};
@@ -7,6 +7,8 @@
 #include "VoxelFeedbackContext.h"
 #include "VoxelAssets/VoxelHeightmapAssetData.h"
 #include "VoxelUtilities/VoxelSerializationUtilities.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
 
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetSize(int64 NewWidth, int64 NewHeight, bool bCreateMaterials, EVoxelMaterialConfig InMaterialConfig)
@@ -15,27 +17,16 @@ void TVoxelHeightmapAssetData<T>::SetSize(int64 NewWidth, int64 NewHeight, bool
 
 	check(NewWidth > 0 && NewHeight > 0);
 
-	const int64 NumHeights = NewWidth * NewHeight;
-	Heights.Empty(NumHeights);
-	Heights.SetNumUninitialized(NumHeights);
-
+	MaterialSize = 0;
 	if (bCreateMaterials)
 	{
-		int64 NumMaterials = NewWidth * NewHeight;
 		switch (InMaterialConfig)
 		{
-		case EVoxelMaterialConfig::RGB: NumMaterials *= 4; break;
-		case EVoxelMaterialConfig::SingleIndex: NumMaterials *= 1; break;
-		case EVoxelMaterialConfig::MultiIndex: NumMaterials *= 7; break;
+		case EVoxelMaterialConfig::RGB: MaterialSize = 4; break;
+		case EVoxelMaterialConfig::SingleIndex: MaterialSize = 1; break;
+		case EVoxelMaterialConfig::MultiIndex: MaterialSize = 7; break;
 		default: ensure(false);
 		}
-
-		Materials.Empty(NumMaterials);
-		Materials.SetNumUninitialized(NumMaterials);
-	}
-	else
-	{
-		Materials.Empty();
 	}
 
 	Width = NewWidth;
@@ -46,8 +37,43 @@ void TVoxelHeightmapAssetData<T>::SetSize(int64 NewWidth, int64 NewHeight, bool
 
 	MaterialConfig = InMaterialConfig;
 
-	UpdateStats();
+	Levels.Reset();
+	{
+		int32 NumTiles = 0;
+		int64 LevelWidth = Width;
+		int64 LevelHeight = Height;
+		while (true)
+		{
+			FLevel Level;
+			Level.Width = LevelWidth;
+			Level.Height = LevelHeight;
+			Level.NumTilesX = FVoxelUtilities::DivideCeil(LevelWidth, TileSize);
+			Level.NumTilesY = FVoxelUtilities::DivideCeil(LevelHeight, TileSize);
+			Level.FirstTile = NumTiles;
+			Levels.Add(Level);
+
+			NumTiles += Level.NumTilesX * Level.NumTilesY;
+
+			if (LevelWidth == 1 && LevelHeight == 1)
+			{
+				break;
+			}
+			LevelWidth = FVoxelUtilities::DivideCeil(LevelWidth, 2);
+			LevelHeight = FVoxelUtilities::DivideCeil(LevelHeight, 2);
+		}
+
+		ReleaseTiles();
+
+		FScopeLock Lock(&Section);
+		Tiles.Empty(NumTiles);
+		Tiles.SetNum(NumTiles);
+	}
+
+	ResetTiles();
 	InitializeHeightRangeMips();
+	UpdateStats();
+
+	bHeightMipsOutdated = true;
 }
 
 template<typename T>
@@ -55,10 +81,32 @@ void TVoxelHeightmapAssetData<T>::SetAllHeightsTo(T NewHeight)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 
-	for (auto& HeightIt : Heights)
+	DefaultHeight = NewHeight;
+
+	if (!HasMaterials())
 	{
-		HeightIt = NewHeight;
+		// All the tiles can use the default height
+		ResetTiles();
 	}
+	else
+	{
+		FScopeLock Lock(&Section);
+		for (int32 TileIndex = 0; TileIndex < Tiles.Num(); TileIndex++)
+		{
+			const FTile& Tile = Tiles[TileIndex];
+			if (Tile.CompressedData.Num() == 0 && !Tile.Data.IsValid())
+			{
+				continue;
+			}
+
+			FTileData& Data = LoadTileForWrite(TileIndex);
+			for (T& HeightIt : Data.Heights)
+			{
+				HeightIt = NewHeight;
+			}
+		}
+	}
+
 	for (auto& HeightRangeMip : HeightRangeMips)
 	{
 		for (auto& HeightRange : HeightRangeMip.Data)
@@ -66,6 +114,9 @@ void TVoxelHeightmapAssetData<T>::SetAllHeightsTo(T NewHeight)
 			HeightRange = NewHeight;
 		}
 	}
+
+	// All the mips are NewHeight too
+	bHeightMipsOutdated = false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -257,8 +308,41 @@ void TVoxelHeightmapAssetData<T>::InitializeHeightRangeMips()
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetHeight(int64 X, int64 Y, T NewHeight)
 {
-	Heights[GetIndex(X, Y)] = NewHeight;
+	{
+		FScopeLock Lock(&Section);
+		LoadTileForWrite(GetTileIndex(0, X, Y)).Heights[GetIndexInTile(X, Y)] = NewHeight;
+	}
+	bHeightMipsOutdated = true;
 
+	UpdateHeightRanges(X, Y, NewHeight);
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::SetHeights(TConstArrayView<FIntPoint> Positions, TConstArrayView<T> NewHeights)
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+	check(Positions.Num() == NewHeights.Num());
+
+	{
+		// Neighbor pixels are usually in the same tile, which then stays the most recent one and is found right away
+		FScopeLock Lock(&Section);
+		for (int32 Index = 0; Index < Positions.Num(); Index++)
+		{
+			const FIntPoint& Position = Positions[Index];
+			LoadTileForWrite(GetTileIndex(0, Position.X, Position.Y)).Heights[GetIndexInTile(Position.X, Position.Y)] = NewHeights[Index];
+		}
+	}
+	bHeightMipsOutdated = true;
+
+	for (int32 Index = 0; Index < Positions.Num(); Index++)
+	{
+		UpdateHeightRanges(Positions[Index].X, Positions[Index].Y, NewHeights[Index]);
+	}
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::UpdateHeightRanges(int64 X, int64 Y, T NewHeight)
+{
 	MaxHeight = FMath::Max(MaxHeight, NewHeight);
 	MinHeight = FMath::Min(MinHeight, NewHeight);
 
@@ -282,7 +366,10 @@ template<typename T>
 void TVoxelHeightmapAssetData<T>::SetMaterial_RGB(int64 X, int64 Y, FColor Color)
 {
 	checkVoxelSlow(MaterialConfig == EVoxelMaterialConfig::RGB);
-	const int64 Index = GetIndex(X, Y);
+	const int64 Index = GetIndexInTile(X, Y);
+
+	FScopeLock Lock(&Section);
+	TArray<uint8>& Materials = LoadTileForWrite(GetTileIndex(0, X, Y)).Materials;
 
 	Materials[4 * Index + 0] = Color.R;
 	Materials[4 * Index + 1] = Color.G;
@@ -294,14 +381,20 @@ template<typename T>
 void TVoxelHeightmapAssetData<T>::SetMaterial_SingleIndex(int64 X, int64 Y, uint8 SingleIndex)
 {
 	checkVoxelSlow(MaterialConfig == EVoxelMaterialConfig::SingleIndex);
-	Materials[GetIndex(X, Y)] = SingleIndex;
+	const int64 Index = GetIndexInTile(X, Y);
+
+	FScopeLock Lock(&Section);
+	LoadTileForWrite(GetTileIndex(0, X, Y)).Materials[Index] = SingleIndex;
 }
 
 template<typename T>
 void TVoxelHeightmapAssetData<T>::SetMaterial_MultiIndex(int64 X, int64 Y, const FVoxelMaterial& Material)
 {
 	checkVoxelSlow(MaterialConfig == EVoxelMaterialConfig::MultiIndex);
-	const int64 Index = GetIndex(X, Y);
+	const int64 Index = GetIndexInTile(X, Y);
+
+	FScopeLock Lock(&Section);
+	TArray<uint8>& Materials = LoadTileForWrite(GetTileIndex(0, X, Y)).Materials;
 
 	Materials[7 * Index + 0] = Material.GetMultiIndex_Blend0();
 	Materials[7 * Index + 1] = Material.GetMultiIndex_Blend1();
@@ -317,8 +410,17 @@ void TVoxelHeightmapAssetData<T>::SetMaterial_MultiIndex(int64 X, int64 Y, const
 ///////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-FORCEINLINE FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterialUnsafe(int64 Index) const
+FORCEINLINE T TVoxelHeightmapAssetData<T>::GetLevelHeightUnsafe(int32 Level, int64 X, int64 Y) const
+{
+	return GetTileData(GetTileIndex(Level, X, Y)).Heights[GetIndexInTile(X, Y)];
+}
+
+template<typename T>
+FORCEINLINE FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterialUnsafe(int64 X, int64 Y) const
 {
+	const TArray<uint8>& Materials = GetTileData(GetTileIndex(0, X, Y)).Materials;
+	const int64 Index = GetIndexInTile(X, Y);
+
 	FVoxelMaterial Material(ForceInit);
 	switch (MaterialConfig)
 	{
@@ -370,19 +472,27 @@ FORCEINLINE void TVoxelHeightmapAssetData<T>::TileCoordinates(int64& X, int64& Y
 template<typename T>
 T TVoxelHeightmapAssetData<T>::GetHeight(int64 X, int64 Y, EVoxelSamplerMode Mode) const
 {
-	if (!IsValidIndex(X, Y))
+	return GetLevelHeight(0, X, Y, Mode);
+}
+
+template<typename T>
+T TVoxelHeightmapAssetData<T>::GetLevelHeight(int32 Level, int64 X, int64 Y, EVoxelSamplerMode Mode) const
+{
+	const FLevel& LevelInfo = Levels[Level];
+	if (!(0 <= X && X < LevelInfo.Width && 0 <= Y && Y < LevelInfo.Height))
 	{
 		if (Mode == EVoxelSamplerMode::Tile)
 		{
-			TileCoordinates(X, Y);
+			X = FVoxelUtilities::PositiveMod(X, LevelInfo.Width);
+			Y = FVoxelUtilities::PositiveMod(Y, LevelInfo.Height);
 		}
 		else
 		{
-			ClampCoordinates(X, Y);
+			X = FMath::Clamp<int64>(X, 0, LevelInfo.Width - 1);
+			Y = FMath::Clamp<int64>(Y, 0, LevelInfo.Height - 1);
 		}
-		checkVoxelSlow(IsValidIndex(X, Y));
 	}
-	return GetHeightUnsafe(X, Y);
+	return GetLevelHeightUnsafe(Level, X, Y);
 }
 
 template<typename T>
@@ -406,6 +516,26 @@ FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterial(int64 X, int64 Y, EVoxel
 template<typename T>
 float TVoxelHeightmapAssetData<T>::GetHeight(float X, float Y, EVoxelSamplerMode Mode) const
 {
+	return GetHeight(X, Y, Mode, 0);
+}
+
+template<typename T>
+float TVoxelHeightmapAssetData<T>::GetHeight(float X, float Y, EVoxelSamplerMode Mode, int32 Mip) const
+{
+	if (Mip > 0 && !bHeightMipsOutdated)
+	{
+		Mip = FMath::Min(Mip, Levels.Num() - 1);
+
+		// Mip pixel N is the average of the pixels [N * 2^Mip, (N + 1) * 2^Mip[, so its center is at (N + 0.5) * 2^Mip - 0.5
+		const float MipScale = 1.f / float(int64(1) << Mip);
+		X = (X + 0.5f) * MipScale - 0.5f;
+		Y = (Y + 0.5f) * MipScale - 0.5f;
+	}
+	else
+	{
+		Mip = 0;
+	}
+
 	const int64 MinX = FMath::FloorToInt(X);
 	const int64 MinY = FMath::FloorToInt(Y);
 
@@ -416,10 +546,10 @@ float TVoxelHeightmapAssetData<T>::GetHeight(float X, float Y, EVoxelSamplerMode
 	const float AlphaY = Y - MinY;
 
 	return FVoxelUtilities::BilinearInterpolation<float>(
-		GetHeight(MinX, MinY, Mode),
-		GetHeight(MaxX, MinY, Mode),
-		GetHeight(MinX, MaxY, Mode),
-		GetHeight(MaxX, MaxY, Mode),
+		GetLevelHeight(Mip, MinX, MinY, Mode),
+		GetLevelHeight(Mip, MaxX, MinY, Mode),
+		GetLevelHeight(Mip, MinX, MaxY, Mode),
+		GetLevelHeight(Mip, MaxX, MaxY, Mode),
 		AlphaX,
 		AlphaY);
 }
@@ -441,13 +571,443 @@ FVoxelMaterial TVoxelHeightmapAssetData<T>::GetMaterial(float X, float Y, EVoxel
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+template<typename T>
+const typename TVoxelHeightmapAssetData<T>::FTileData& TVoxelHeightmapAssetData<T>::GetTileData(int32 TileIndex) const
+{
+	struct FCacheEntry
+	{
+		const TVoxelHeightmapAssetData* Owner = nullptr;
+		int32 TileIndex = -1;
+		TVoxelSharedPtr<const FTileData> Data;
+	};
+	struct FThreadCache
+	{
+		static constexpr int32 NumEntries = 4;
+
+		FCacheEntry Entries[NumEntries];
+		int32 NextEntry = 0;
+	};
+	static thread_local FThreadCache ThreadCache;
+	FThreadCache& Cache = ThreadCache;
+
+	for (const FCacheEntry& Entry : Cache.Entries)
+	{
+		// Released data is still alive as we hold a reference to it, so reading a slightly outdated flag is fine
+		// Owners release all their tiles when destroyed, so a new heightmap at the same address can't match old entries
+		if (Entry.TileIndex == TileIndex && Entry.Owner == this && !Entry.Data->bReleased.load(std::memory_order_relaxed))
+		{
+			return *Entry.Data;
+		}
+	}
+
+	VOXEL_SCOPE_COUNTER("Heightmap tile cache miss");
+
+	FCacheEntry& Entry = Cache.Entries[Cache.NextEntry];
+	Cache.NextEntry = (Cache.NextEntry + 1) % FThreadCache::NumEntries;
+
+	FScopeLock Lock(&Section);
+	Entry.Owner = this;
+	Entry.TileIndex = TileIndex;
+	Entry.Data = LoadTile_AssumeLocked(TileIndex);
+	return *Entry.Data;
+}
+
+template<typename T>
+typename TVoxelHeightmapAssetData<T>::FTileData& TVoxelHeightmapAssetData<T>::LoadTileForWrite(int32 TileIndex)
+{
+	FTileData& Data = *LoadTile_AssumeLocked(TileIndex);
+	Tiles[TileIndex].bDirty = true;
+	return Data;
+}
+
+template<typename T>
+const TVoxelSharedPtr<typename TVoxelHeightmapAssetData<T>::FTileData>& TVoxelHeightmapAssetData<T>::LoadTile_AssumeLocked(int32 TileIndex) const
+{
+	FTile& Tile = Tiles[TileIndex];
+	if (Tile.Data.IsValid())
+	{
+		if (MostRecentTile != TileIndex)
+		{
+			Unlink_AssumeLocked(TileIndex);
+			LinkAsMostRecent_AssumeLocked(TileIndex);
+		}
+		return Tile.Data;
+	}
+
+	const int32 NumHeights = TileSize * TileSize;
+	const int32 NumMaterials = GetNumMaterialsPerTile(TileIndex);
+
+	const TVoxelSharedRef<FTileData> Data = MakeVoxelShared<FTileData>();
+	Data->Heights.SetNumUninitialized(NumHeights);
+	Data->Materials.SetNumUninitialized(NumMaterials);
+
+	bool bDecompressed = false;
+	if (Tile.CompressedData.Num() > 0)
+	{
+		VOXEL_ASYNC_SCOPE_COUNTER("Decompress heightmap tile");
+
+		TArray<uint8> UncompressedData;
+		UncompressedData.SetNumUninitialized(NumHeights * sizeof(T) + NumMaterials);
+
+		bDecompressed = FCompression::UncompressMemory(
+			NAME_Zlib,
+			UncompressedData.GetData(),
+			UncompressedData.Num(),
+			Tile.CompressedData.GetData(),
+			Tile.CompressedData.Num());
+
+		if (ensureMsgf(bDecompressed, TEXT("Corrupted heightmap tile")))
+		{
+			FMemory::Memcpy(Data->Heights.GetData(), UncompressedData.GetData(), NumHeights * sizeof(T));
+			FMemory::Memcpy(Data->Materials.GetData(), UncompressedData.GetData() + NumHeights * sizeof(T), NumMaterials);
+		}
+	}
+	if (!bDecompressed)
+	{
+		for (T& HeightIt : Data->Heights)
+		{
+			HeightIt = DefaultHeight;
+		}
+		FMemory::Memzero(Data->Materials.GetData(), NumMaterials);
+	}
+
+	Tile.Data = Data;
+	ResidentMemory += Data->GetAllocatedSize();
+	LinkAsMostRecent_AssumeLocked(TileIndex);
+
+	EvictTiles_AssumeLocked(TileIndex);
+	UpdateStats();
+
+	return Tile.Data;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::ResetTiles()
+{
+	FScopeLock Lock(&Section);
+
+	for (FTile& Tile : Tiles)
+	{
+		ReleaseTile_AssumeLocked(Tile);
+		Tile = {};
+	}
+	MostRecentTile = -1;
+	LeastRecentTile = -1;
+	ResidentMemory = 0;
+	CompressedMemory = 0;
+
+	UpdateStats();
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::ReleaseTiles()
+{
+	FScopeLock Lock(&Section);
+
+	for (FTile& Tile : Tiles)
+	{
+		ReleaseTile_AssumeLocked(Tile);
+	}
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::ReleaseTile_AssumeLocked(FTile& Tile) const
+{
+	if (Tile.Data.IsValid())
+	{
+		Tile.Data->bReleased.store(true, std::memory_order_relaxed);
+		Tile.Data.Reset();
+	}
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::CompressTile_AssumeLocked(int32 TileIndex) const
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	FTile& Tile = Tiles[TileIndex];
+	check(Tile.Data.IsValid());
+
+	const TArray<T>& Heights = Tile.Data->Heights;
+	const TArray<uint8>& Materials = Tile.Data->Materials;
+
+	TArray<uint8> UncompressedData;
+	UncompressedData.SetNumUninitialized(Heights.Num() * sizeof(T) + Materials.Num());
+	FMemory::Memcpy(UncompressedData.GetData(), Heights.GetData(), Heights.Num() * sizeof(T));
+	FMemory::Memcpy(UncompressedData.GetData() + Heights.Num() * sizeof(T), Materials.GetData(), Materials.Num());
+
+	CompressedMemory -= Tile.CompressedData.GetAllocatedSize();
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedData.Num());
+	Tile.CompressedData.SetNumUninitialized(CompressedSize);
+	verify(FCompression::CompressMemory(
+		NAME_Zlib,
+		Tile.CompressedData.GetData(),
+		CompressedSize,
+		UncompressedData.GetData(),
+		UncompressedData.Num()));
+	Tile.CompressedData.SetNum(CompressedSize, EAllowShrinking::Yes);
+
+	CompressedMemory += Tile.CompressedData.GetAllocatedSize();
+
+	Tile.bDirty = false;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::Unlink_AssumeLocked(int32 TileIndex) const
+{
+	FTile& Tile = Tiles[TileIndex];
+
+	if (Tile.Previous != -1)
+	{
+		Tiles[Tile.Previous].Next = Tile.Next;
+	}
+	else
+	{
+		checkVoxelSlow(MostRecentTile == TileIndex);
+		MostRecentTile = Tile.Next;
+	}
+
+	if (Tile.Next != -1)
+	{
+		Tiles[Tile.Next].Previous = Tile.Previous;
+	}
+	else
+	{
+		checkVoxelSlow(LeastRecentTile == TileIndex);
+		LeastRecentTile = Tile.Previous;
+	}
+
+	Tile.Previous = -1;
+	Tile.Next = -1;
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::LinkAsMostRecent_AssumeLocked(int32 TileIndex) const
+{
+	FTile& Tile = Tiles[TileIndex];
+	checkVoxelSlow(Tile.Previous == -1 && Tile.Next == -1);
+
+	Tile.Next = MostRecentTile;
+	if (MostRecentTile != -1)
+	{
+		Tiles[MostRecentTile].Previous = TileIndex;
+	}
+	MostRecentTile = TileIndex;
+
+	if (LeastRecentTile == -1)
+	{
+		LeastRecentTile = TileIndex;
+	}
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::EvictTiles_AssumeLocked(int32 TileToKeep) const
+{
+	const int64 MaxResidentMemory = FVoxelHeightmapAssetTiles::GetMaxResidentMemory();
+
+	while (ResidentMemory > MaxResidentMemory && LeastRecentTile != -1 && LeastRecentTile != TileToKeep)
+	{
+		const int32 TileIndex = LeastRecentTile;
+		FTile& Tile = Tiles[TileIndex];
+
+		if (Tile.bDirty)
+		{
+			CompressTile_AssumeLocked(TileIndex);
+		}
+
+		ResidentMemory -= Tile.Data->GetAllocatedSize();
+		// Only invalidates the thread caches entries referencing this tile
+		ReleaseTile_AssumeLocked(Tile);
+		Unlink_AssumeLocked(TileIndex);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::UpdateHeightMips()
+{
+	VOXEL_ASYNC_FUNCTION_COUNTER();
+
+	if (!bHeightMipsOutdated)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&Section);
+
+	for (int32 LevelIndex = 1; LevelIndex < Levels.Num(); LevelIndex++)
+	{
+		const FLevel& Parent = Levels[LevelIndex - 1];
+		const FLevel& Level = Levels[LevelIndex];
+
+		for (int64 TileY = 0; TileY < Level.NumTilesY; TileY++)
+		{
+			for (int64 TileX = 0; TileX < Level.NumTilesX; TileX++)
+			{
+				// Each tile is computed from up to 2x2 parent tiles
+				// Keep references to them, as loading the other tiles might evict them
+				TVoxelSharedPtr<const FTileData> ParentTiles[2][2];
+				for (int32 DY = 0; DY < 2; DY++)
+				{
+					for (int32 DX = 0; DX < 2; DX++)
+					{
+						const int64 ParentTileX = 2 * TileX + DX;
+						const int64 ParentTileY = 2 * TileY + DY;
+						if (ParentTileX < Parent.NumTilesX && ParentTileY < Parent.NumTilesY)
+						{
+							ParentTiles[DX][DY] = LoadTile_AssumeLocked(Parent.FirstTile + ParentTileX + Parent.NumTilesX * ParentTileY);
+						}
+					}
+				}
+
+				const auto GetParentHeight = [&](int64 ParentX, int64 ParentY)
+				{
+					// Clamp on odd sizes
+					ParentX = FMath::Min(ParentX, Parent.Width - 1);
+					ParentY = FMath::Min(ParentY, Parent.Height - 1);
+
+					const FTileData& ParentTile = *ParentTiles[ParentX / TileSize - 2 * TileX][ParentY / TileSize - 2 * TileY];
+					return ParentTile.Heights[GetIndexInTile(ParentX, ParentY)];
+				};
+
+				FTileData& Data = LoadTileForWrite(Level.FirstTile + TileX + Level.NumTilesX * TileY);
+
+				const int64 MaxX = FMath::Min(TileSize, Level.Width - TileX * TileSize);
+				const int64 MaxY = FMath::Min(TileSize, Level.Height - TileY * TileSize);
+				for (int64 LocalY = 0; LocalY < MaxY; LocalY++)
+				{
+					for (int64 LocalX = 0; LocalX < MaxX; LocalX++)
+					{
+						const int64 X = TileX * TileSize + LocalX;
+						const int64 Y = TileY * TileSize + LocalY;
+
+						const float Average =
+							(float(GetParentHeight(2 * X + 0, 2 * Y + 0)) +
+							 float(GetParentHeight(2 * X + 1, 2 * Y + 0)) +
+							 float(GetParentHeight(2 * X + 0, 2 * Y + 1)) +
+							 float(GetParentHeight(2 * X + 1, 2 * Y + 1))) / 4.f;
+
+						Data.Heights[LocalX + TileSize * LocalY] = std::is_same_v<T, float> ? T(Average) : T(FMath::RoundToInt(Average));
+					}
+				}
+			}
+		}
+	}
+
+	bHeightMipsOutdated = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 template<typename T>
 void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave)
 {
 	VOXEL_FUNCTION_COUNTER();
-	
-	FVoxelScopedSlowTask Serializing(3.f);
-	
+
+	if (Version < FVoxelHeightmapAssetDataVersion::CompressedTilesAndHeightMips)
+	{
+		check(Ar.IsLoading());
+		SerializeLegacy(Ar, MaterialConfigFlag, Version, bNeedToSave);
+		return;
+	}
+
+	FVoxelScopedSlowTask Serializing(2.f);
+
+	if (Ar.IsSaving())
+	{
+		Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Computing height mips"));
+		UpdateHeightMips();
+	}
+	else
+	{
+		Serializing.EnterProgressFrame(1.f);
+	}
+
+	int64 NewWidth = Width;
+	int64 NewHeight = Height;
+	EVoxelMaterialConfig NewMaterialConfig = MaterialConfig;
+	int32 NewMaterialSize = MaterialSize;
+	Ar << NewWidth;
+	Ar << NewHeight;
+	Ar << NewMaterialConfig;
+	Ar << NewMaterialSize;
+
+	if (Ar.IsLoading())
+	{
+		if (NewWidth <= 0 || NewHeight <= 0)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		SetSize(NewWidth, NewHeight, NewMaterialSize > 0, NewMaterialConfig);
+
+		if (MaterialSize != NewMaterialSize)
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+
+	Ar << MaxHeight;
+	Ar << MinHeight;
+	Ar << DefaultHeight;
+	Ar << HeightRangeMips;
+
+	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Serializing tiles"));
+	{
+		FScopeLock Lock(&Section);
+
+		int32 NumTiles = Tiles.Num();
+		Ar << NumTiles;
+		if (NumTiles != Tiles.Num())
+		{
+			Ar.SetError();
+			return;
+		}
+
+		for (int32 TileIndex = 0; TileIndex < Tiles.Num(); TileIndex++)
+		{
+			FTile& Tile = Tiles[TileIndex];
+			if (Ar.IsSaving() && Tile.bDirty)
+			{
+				CompressTile_AssumeLocked(TileIndex);
+			}
+
+			Tile.CompressedData.BulkSerialize(Ar);
+
+			if (Ar.IsLoading())
+			{
+				CompressedMemory += Tile.CompressedData.GetAllocatedSize();
+			}
+		}
+	}
+
+	if (Ar.IsLoading())
+	{
+		// Saved mips are always up to date
+		bHeightMipsOutdated = false;
+	}
+
+	UpdateStats();
+}
+
+template<typename T>
+void TVoxelHeightmapAssetData<T>::SerializeLegacy(FArchive& Ar, uint32 MaterialConfigFlag, FVoxelHeightmapAssetDataVersion::Type Version, bool& bNeedToSave)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	FVoxelScopedSlowTask Serializing(4.f);
+
+	TArray64<T> Heights;
+	TArray64<uint8> Materials;
+
 	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Serializing heights"));
 	if (Version < FVoxelHeightmapAssetDataVersion::UseTArray64)
 	{
@@ -500,64 +1060,112 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 		Materials.BulkSerialize(Ar);
 	}
 
+	int64 NewWidth;
+	int64 NewHeight;
 	if (Version < FVoxelHeightmapAssetDataVersion::UseTArray64)
 	{
 		int32 Width32;
 		int32 Height32;
 		Ar << Width32;
 		Ar << Height32;
-		Width = Width32;
-		Height = Height32;
+		NewWidth = Width32;
+		NewHeight = Height32;
 	}
 	else
 	{
-		Ar << Width;
-		Ar << Height;
+		Ar << NewWidth;
+		Ar << NewHeight;
 	}
 
-	Ar << MaxHeight;
-	Ar << MinHeight;
+	T NewMaxHeight;
+	T NewMinHeight;
+	Ar << NewMaxHeight;
+	Ar << NewMinHeight;
 
+	EVoxelMaterialConfig NewMaterialConfig{};
 	if (Version >= FVoxelHeightmapAssetDataVersion::NoVoxelMaterialInHeightmapAssets)
 	{
-		Ar << MaterialConfig;
+		Ar << NewMaterialConfig;
 	}
 
-	if (Width * Height != Heights.Num())
+	if (NewWidth <= 0 || NewHeight <= 0 || NewWidth * NewHeight != Heights.Num())
 	{
 		Ar.SetError();
+		return;
 	}
 
+	int64 NewMaterialSize = 0;
 	if (Materials.Num() > 0)
 	{
-		int64 MaterialSize = 0;
-		switch (MaterialConfig)
+		switch (NewMaterialConfig)
 		{
 		case EVoxelMaterialConfig::RGB:
-			MaterialSize = 4;
+			NewMaterialSize = 4;
 			break;
 		case EVoxelMaterialConfig::SingleIndex:
-			MaterialSize = 1;
+			NewMaterialSize = 1;
 			break;
 		case EVoxelMaterialConfig::DoubleIndex_DEPRECATED:
-			MaterialSize = 0;
-			MaterialConfig = EVoxelMaterialConfig::RGB;
+			NewMaterialSize = 0;
+			NewMaterialConfig = EVoxelMaterialConfig::RGB;
 			Materials.Empty();
 			FVoxelMessages::Error("Cannot load double index heightmap materials, removing them. You'll need to reimport your weightmaps");
 			break;
 		case EVoxelMaterialConfig::MultiIndex:
-			MaterialSize = 7;
+			NewMaterialSize = 7;
 			break;
 		default:
 			Ar.SetError();
+			return;
 		}
 
-		if (MaterialSize * Width * Height != Materials.Num())
+		if (NewMaterialSize * NewWidth * NewHeight != Materials.Num())
 		{
 			Ar.SetError();
+			return;
+		}
+	}
+
+	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Converting to tiles"));
+	{
+		VOXEL_SCOPE_COUNTER("Converting to tiles");
+
+		SetSize(NewWidth, NewHeight, NewMaterialSize > 0, NewMaterialConfig);
+
+		FScopeLock Lock(&Section);
+
+		const FLevel& Level = Levels[0];
+		for (int64 TileY = 0; TileY < Level.NumTilesY; TileY++)
+		{
+			for (int64 TileX = 0; TileX < Level.NumTilesX; TileX++)
+			{
+				FTileData& Data = LoadTileForWrite(TileX + Level.NumTilesX * TileY);
+
+				for (int64 LocalY = 0; LocalY < TileSize; LocalY++)
+				{
+					for (int64 LocalX = 0; LocalX < TileSize; LocalX++)
+					{
+						// Pad with the border pixels
+						const int64 X = FMath::Min(TileX * TileSize + LocalX, Width - 1);
+						const int64 Y = FMath::Min(TileY * TileSize + LocalY, Height - 1);
+
+						const int64 Index = X + Width * Y;
+						const int64 IndexInTile = LocalX + TileSize * LocalY;
+
+						Data.Heights[IndexInTile] = Heights[Index];
+						for (int32 Byte = 0; Byte < MaterialSize; Byte++)
+						{
+							Data.Materials[MaterialSize * IndexInTile + Byte] = Materials[MaterialSize * Index + Byte];
+						}
+					}
+				}
+			}
 		}
 	}
 
+	MaxHeight = NewMaxHeight;
+	MinHeight = NewMinHeight;
+
 	Serializing.EnterProgressFrame(1.f, VOXEL_LOCTEXT("Recomputing height range mips"));
 	if (Version < FVoxelHeightmapAssetDataVersion::SerializeHeightRangeMips)
 	{
@@ -565,12 +1173,11 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 
 		const double StartTime = FPlatformTime::Seconds();
 
-		InitializeHeightRangeMips();
 		for (int64 X = 0; X < Width; X++)
 		{
 			for (int64 Y = 0; Y < Height; Y++)
 			{
-				const T LocalHeight = GetHeightUnsafe(X, Y);
+				const T LocalHeight = Heights[X + Width * Y];
 				for (int64 Mip = 0; Mip < GetNumHeightRangeMips(); Mip++)
 				{
 					int64 LocalX;
@@ -586,8 +1193,6 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 
 		const double EndTime = FPlatformTime::Seconds();
 
-		bNeedToSave = true;
-
 		int64 Size = HeightRangeMips.GetAllocatedSize();
 		for (auto& Mip : HeightRangeMips)
 		{
@@ -600,17 +1205,39 @@ void TVoxelHeightmapAssetData<T>::Serialize(FArchive& Ar, uint32 MaterialConfigF
 		Ar << HeightRangeMips;
 	}
 
+	// Free the legacy arrays before computing the mips
+	Heights.Empty();
+	Materials.Empty();
+
+	bHeightMipsOutdated = true;
+	UpdateHeightMips();
+
+	// Resave in the tiled format
+	bNeedToSave = true;
+
 	UpdateStats();
 }
 
 template<typename T>
-void TVoxelHeightmapAssetData<T>::UpdateStats()
+void TVoxelHeightmapAssetData<T>::UpdateStats() const
 {
 	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, AllocatedSize);
-	AllocatedSize = Heights.GetAllocatedSize() + Materials.GetAllocatedSize() + HeightRangeMips.GetAllocatedSize();
+	AllocatedSize = ResidentMemory + CompressedMemory + Tiles.GetAllocatedSize() + HeightRangeMips.GetAllocatedSize();
 	for (auto& Mip : HeightRangeMips)
 	{
 		AllocatedSize += Mip.Data.GetAllocatedSize();
 	}
 	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelHeightmapAssetMemory, AllocatedSize);
-}
\ No newline at end of file
+
+	const int64 CompressedMemoryWarningThreshold = FVoxelHeightmapAssetTiles::GetCompressedMemoryWarningThreshold();
+	if (CompressedMemoryWarningThreshold > 0 &&
+		CompressedMemory > CompressedMemoryWarningThreshold &&
+		!bWarnedAboutCompressedMemory.exchange(true))
+	{
+		LOG_VOXEL(Warning, TEXT("Heightmap %lldx%lld uses %fMB of compressed tiles, which all stay in memory (voxel.heightmaps.CompressedMemoryWarningThreshold: %lldMB)"),
+			Width,
+			Height,
+			CompressedMemory / double(1 << 20),
+			CompressedMemoryWarningThreshold >> 20);
+	}
+}
@@ -12,14 +12,26 @@ struct TVoxelHeightmapAssetSamplerWrapper
 	const float Scale;
 	const float HeightScale;
 	const float HeightOffset;
+	const bool bUseHeightMips;
+	// Mip = LOD - LODToMipOffset, so that a mip pixel is never bigger than a voxel at that LOD
+	const int32 LODToMipOffset;
 	const TVoxelSharedRef<TVoxelHeightmapAssetData<T>> Data;
 
 	explicit VOXEL_API TVoxelHeightmapAssetSamplerWrapper(UVoxelHeightmapAsset* Asset);
 
+	int32 GetMip(int32 LOD) const
+	{
+		return bUseHeightMips ? FMath::Max(0, LOD - LODToMipOffset) : 0;
+	}
+
 	float GetHeight(v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode) const
 	{
 		return HeightOffset + HeightScale * Data->GetHeight(float(X / Scale), float(Y / Scale), SamplerMode);
 	}
+	float GetHeight(v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode, int32 LOD) const
+	{
+		return HeightOffset + HeightScale * Data->GetHeight(float(X / Scale), float(Y / Scale), SamplerMode, GetMip(LOD));
+	}
 	FVoxelMaterial GetMaterial(v_flt X, v_flt Y, EVoxelSamplerMode SamplerMode) const
 	{
 		return Data->GetMaterial(float(X / Scale), float(Y / Scale), SamplerMode);
@@ -32,20 +44,51 @@ struct TVoxelHeightmapAssetSamplerWrapper
 			{ FMath::FloorToInt(Y.Min / Scale), FMath::CeilToInt(Y.Max / Scale) }, 
 			SamplerMode));
 	}
+	TVoxelRange<float> GetHeightRange(TVoxelRange<v_flt> X, TVoxelRange<v_flt> Y, EVoxelSamplerMode SamplerMode, int32 LOD) const
+	{
+		const int32 Mip = GetMip(LOD);
+		if (Mip == 0)
+		{
+			return GetHeightRange(X, Y, SamplerMode);
+		}
+
+		// Mip heights are averages of the pixels in their footprint: extend the ranges by it to stay conservative
+		const v_flt Footprint = v_flt(int64(2) << Mip) * Scale;
+		return GetHeightRange(X + TVoxelRange<v_flt>(-Footprint, Footprint), Y + TVoxelRange<v_flt>(-Footprint, Footprint), SamplerMode);
+	}
 
 	void SetHeight(int32 X, int32 Y, float Height)
 	{
 		ensureVoxelSlowNoSideEffects(Scale == 1.f);
+		Data->SetHeight(X, Y, ToDataHeight(Height));
+	}
+	// Locks the heightmap tiles once for all the positions
+	void SetHeights(TConstArrayView<FIntPoint> Positions, TConstArrayView<float> Heights)
+	{
+		ensureVoxelSlowNoSideEffects(Scale == 1.f);
+		check(Positions.Num() == Heights.Num());
+
+		TArray<T> DataHeights;
+		DataHeights.Reserve(Heights.Num());
+		for (const float Height : Heights)
+		{
+			DataHeights.Add(ToDataHeight(Height));
+		}
+		Data->SetHeights(Positions, DataHeights);
+	}
+
+	T ToDataHeight(float Height) const
+	{
 		Height -= HeightOffset;
 		Height /= HeightScale;
 		Height = FMath::Clamp<float>(Height, TNumericLimits<T>::Lowest(), TNumericLimits<T>::Max());
 		if (std::is_same_v<T, float>)
 		{
-			Data->SetHeight(X, Y, Height);
+			return Height;
 		}
 		else
 		{
-			Data->SetHeight(X, Y, FMath::RoundToInt(Height));
+			return FMath::RoundToInt(Height);
 		}
 	}
 
@@ -10,6 +10,9 @@
 #include "VoxelInvokerComponent.generated.h"
 
 class AVoxelWorldInterface;
+class UVoxelInvokerComponentBase;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FVoxelOnInvokerChanged, UVoxelInvokerComponentBase*);
 
 // Voxel Invokers are used to configure the voxel world LOD, collisions and navmesh
 UCLASS(Abstract, Blueprintable, ClassGroup = Voxel)
@@ -28,7 +31,7 @@ public:
 
 	// Whether to use to compute the tasks priorities
 	// If true, the task priorities will be higher if they are closer to this
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Priority")
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetUseForPriorities, Category = "Voxel Invoker|Priority")
 	bool bUseForPriorities = true;
 
 protected:
@@ -73,12 +76,47 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Voxel|Invoker")
 	bool IsInvokerEnabled() const;
 
+	// Voxel worlds only look at invokers that notified them of a change
+	// Movements and the invoker properties set from blueprint or the details panel are notified automatically:
+	// call this after changing the invoker properties from C++ or when GetInvokerSettings changes for another reason
+	UFUNCTION(BlueprintCallable, Category = "Voxel|Invoker")
+	void NotifyInvokerChanged();
+
+	UFUNCTION(BlueprintSetter)
+	void SetUseForPriorities(bool bNewUseForPriorities);
+
+	// If true, the position or the settings of this invoker can change without it notifying it,
+	// and voxel worlds will check it on every LOD update
+	// Defaults to true if IsLocalInvoker, GetInvokerVoxelPosition or GetInvokerSettings are implemented in blueprint
+	virtual bool NeedsPolling() const;
+
 protected:
 	//~ Begin UActorComponent Interface
 	virtual void OnRegister() override;
 	virtual void OnUnregister() override;
 	//~ End UActorComponent Interface
 
+	//~ Begin USceneComponent Interface
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+	//~ End USceneComponent Interface
+
+#if WITH_EDITOR
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+#endif
+
+	// Settings changes are not polled: the setters of the properties read by GetInvokerSettings must use this
+	template<typename T>
+	void SetInvokerProperty(T& Property, T NewValue)
+	{
+		if (Property != NewValue)
+		{
+			Property = NewValue;
+			NotifyInvokerChanged();
+		}
+	}
+
 private:
 	bool bIsInvokerEnabled = false;
 
@@ -88,6 +126,8 @@ public:
 	
 	static const TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>>& GetInvokers(UWorld* World);
 	static FSimpleMulticastDelegate OnForceRefreshInvokers;
+	// Broadcast when an invoker is enabled, disabled, moved or when NotifyInvokerChanged is called
+	static FVoxelOnInvokerChanged OnInvokerChanged;
 
 private:
 	static TMap<TWeakObjectPtr<UWorld>, TArray<TWeakObjectPtr<UVoxelInvokerComponentBase>>> Components;
@@ -101,31 +141,31 @@ class VOXEL_API UVoxelSimpleInvokerComponent : public UVoxelInvokerComponentBase
 	GENERATED_BODY()
 		
 public:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|LOD")
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetUseForLOD, Category = "Voxel Invoker|LOD")
 	bool bUseForLOD = true;
 
 	// You should leave this to 0
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|LOD", meta = (DisplayName = "LOD to Set", EditCondition = bUseForLOD, ClampMin = 0, ClampMax = 26, UIMin = 0, UIMax = 26))
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetLODToSet, Category = "Voxel Invoker|LOD", meta = (DisplayName = "LOD to Set", EditCondition = bUseForLOD, ClampMin = 0, ClampMax = 26, UIMin = 0, UIMax = 26))
 	int32 LODToSet = 0;
 
 	// In cm. Will set LODToSet around the invoker on this distance
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|LOD", meta = (DisplayName = "LOD Range", EditCondition = bUseForLOD, ClampMin = 0))
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetLODRange, Category = "Voxel Invoker|LOD", meta = (DisplayName = "LOD Range", EditCondition = bUseForLOD, ClampMin = 0))
 	float LODRange = 1000;
 
 	// Will enable high res collisions around the invoker
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Collisions")
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetUseForCollisions, Category = "Voxel Invoker|Collisions")
 	bool bUseForCollisions = true;
 	
 	// In cm. Will enable high res collisions on chunks under this distance from this invoker
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Collisions", meta = (EditCondition = bUseForCollisions, ClampMin = 0))
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetCollisionsRange, Category = "Voxel Invoker|Collisions", meta = (EditCondition = bUseForCollisions, ClampMin = 0))
 	float CollisionsRange = 1000;
 
 	// Will enable high res navmesh around the invoker
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Navmesh")
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetUseForNavmesh, Category = "Voxel Invoker|Navmesh")
 	bool bUseForNavmesh = true;
 	
 	// In cm. Will enable high res navmesh on chunks under this distance from this invoker
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Navmesh", meta = (EditCondition = bUseForNavmesh, ClampMin = 0))
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetNavmeshRange, Category = "Voxel Invoker|Navmesh", meta = (EditCondition = bUseForNavmesh, ClampMin = 0))
 	float NavmeshRange = 1000;
 
 public:
@@ -134,10 +174,29 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "Voxel|Invoker")
 	FVector GetInvokerGlobalPosition() const;
 
+public:
+	UFUNCTION(BlueprintSetter)
+	void SetUseForLOD(bool bNewUseForLOD);
+	UFUNCTION(BlueprintSetter)
+	void SetLODToSet(int32 NewLODToSet);
+	UFUNCTION(BlueprintSetter)
+	void SetLODRange(float NewLODRange);
+	
+	UFUNCTION(BlueprintSetter)
+	void SetUseForCollisions(bool bNewUseForCollisions);
+	UFUNCTION(BlueprintSetter)
+	void SetCollisionsRange(float NewCollisionsRange);
+	
+	UFUNCTION(BlueprintSetter)
+	void SetUseForNavmesh(bool bNewUseForNavmesh);
+	UFUNCTION(BlueprintSetter)
+	void SetNavmeshRange(float NewNavmeshRange);
+
 public:
 	//~ Begin UVoxelInvokerComponentBase Interface
 	virtual FIntVector GetInvokerVoxelPosition_Implementation(AVoxelWorldInterface* VoxelWorld) const override;
 	virtual FVoxelInvokerSettings GetInvokerSettings_Implementation(AVoxelWorldInterface* VoxelWorld) const override;
+	virtual bool NeedsPolling() const override;
 	//~ End UVoxelInvokerComponentBase Interface
 
 protected:
@@ -155,13 +214,22 @@ class VOXEL_API UVoxelInvokerWithPredictionComponent : public UVoxelSimpleInvoke
 		
 public:
 	// Will use the speed of the owner to determine the position to use
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Prediction")
+	UPROPERTY(EditAnywhere, BlueprintSetter = SetEnablePrediction, Category = "Voxel Invoker|Prediction")
 	bool bEnablePrediction = false;
 
 	// Will multiply the velocity by this to get the new position
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Invoker|Prediction", meta = (EditCondition = bEnablePrediction, ClampMin = 0))
 	float PredictionTime = 1;
 
+public:
+	UFUNCTION(BlueprintSetter)
+	void SetEnablePrediction(bool bNewEnablePrediction);
+
+public:
+	//~ Begin UVoxelInvokerComponentBase Interface
+	virtual bool NeedsPolling() const override;
+	//~ End UVoxelInvokerComponentBase Interface
+
 protected:
 	//~ Begin UVoxelSimpleInvokerComponent Interface
 	virtual FVector GetInvokerGlobalPosition_Implementation() const override;
@@ -175,6 +243,11 @@ class VOXEL_API UVoxelInvokerAutoCameraComponent : public UVoxelSimpleInvokerCom
 {
 	GENERATED_BODY()
 
+public:
+	//~ Begin UVoxelInvokerComponentBase Interface
+	virtual bool NeedsPolling() const override { return true; } // The camera doesn't move the component
+	//~ End UVoxelInvokerComponentBase Interface
+
 protected:
 	//~ Begin UVoxelSimpleInvokerComponent Interface
 	virtual FVector GetInvokerGlobalPosition_Implementation() const override;
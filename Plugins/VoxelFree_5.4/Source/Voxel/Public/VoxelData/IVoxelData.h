@@ -4,8 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "VoxelIntBox.h"
+#include "Misc/ScopeLock.h"
 
 class FVoxelGeneratorInstance;
+class FVoxelDataOctreeLeaf;
 
 class IVoxelDataOctreeMemory
 {
@@ -52,4 +54,63 @@ public:
 		, Generator(Generator)
 	{
 	}
+
+public:
+	// Called when a leaf creates its undo redo history. Leaves are only destroyed when clearing the entire data
+	void AddLeafWithUndoRedo(FVoxelDataOctreeLeaf& Leaf) const
+	{
+		FScopeLock Lock(&LeavesWithUndoRedoSection);
+		LeavesWithUndoRedo.Add(&Leaf);
+	}
+	// Iterate the leaves with an undo redo history, without going through the entire octree
+	template<typename F>
+	void IterateLeavesWithUndoRedo(F Lambda) const
+	{
+		FScopeLock Lock(&LeavesWithUndoRedoSection);
+		for (FVoxelDataOctreeLeaf* Leaf : LeavesWithUndoRedo)
+		{
+			Lambda(*Leaf);
+		}
+	}
+
+public:
+	// Called when the values of a leaf are expanded to be edited, so that they are compressed back once the leaf isn't edited anymore
+	// Leaves are stored by position as they can be destroyed in the meantime
+	void AddLeafToCompress(const FIntVector& LeafMin) const
+	{
+		FScopeLock Lock(&LeavesToCompressSection);
+		LeavesToCompress.Add(LeafMin, CompressFrameCounter);
+	}
+
+protected:
+	void ResetLeavesWithUndoRedo()
+	{
+		FScopeLock Lock(&LeavesWithUndoRedoSection);
+		LeavesWithUndoRedo.Empty();
+	}
+
+	// Increments the frame counter and returns the leaves that weren't edited for NumIdleFrames frames. Returns all of them if NumIdleFrames <= 0
+	void PopIdleLeavesToCompress(int32 NumIdleFrames, TArray<FIntVector>& OutLeaves)
+	{
+		FScopeLock Lock(&LeavesToCompressSection);
+		CompressFrameCounter++;
+		for (auto It = LeavesToCompress.CreateIterator(); It; ++It)
+		{
+			if (NumIdleFrames <= 0 || CompressFrameCounter - It.Value() >= NumIdleFrames)
+			{
+				OutLeaves.Add(It.Key());
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+private:
+	mutable FCriticalSection LeavesWithUndoRedoSection;
+	mutable TArray<FVoxelDataOctreeLeaf*> LeavesWithUndoRedo;
+
+	mutable FCriticalSection LeavesToCompressSection;
+	// Incremented on every CompressIdleLeaves
+	int32 CompressFrameCounter = 0;
+	// Leaf min -> CompressFrameCounter of its last edit
+	mutable TMap<FIntVector, int32> LeavesToCompress;
 };
\ No newline at end of file
@@ -18,6 +18,7 @@ class FVoxelDataOctreeBase;
 class FVoxelDataOctreeLeaf;
 class FVoxelDataOctreeParent;
 class FVoxelGeneratorInstance;
+class FVoxelGeneratedDataCache;
 class FVoxelTransformableGeneratorInstance;
 
 struct FVoxelDataItem;
@@ -27,6 +28,8 @@ struct FVoxelDisableEditsBoxItem;
 struct FVoxelPlaceableItemLoadInfo;
 struct FVoxelUncompressedWorldSaveImpl;
 
+enum class EVoxelDataRangeState : uint8;
+
 template<typename T>
 struct TVoxelRange;
 template<typename T>
@@ -111,6 +114,14 @@ private:
 	// Is locked as read when a lock is done
 	// Lock as write to clear the octree, making sure no octrees are locked
 	mutable FVoxelSharedMutex MainLock;
+	// Generator data of the unedited areas recently queried at LOD 0
+	const TUniquePtr<FVoxelGeneratedDataCache> GeneratedDataCache;
+
+public:
+	FORCEINLINE FVoxelGeneratedDataCache& GetGeneratedDataCache() const
+	{
+		return *GeneratedDataCache;
+	}
 
 public:
 	FORCEINLINE int32 Size() const
@@ -181,6 +192,9 @@ public:
 	// Get the data in zone. Requires read lock
 	template<typename T>
 	void Get(TVoxelQueryZone<T>& QueryZone, int32 LOD) const;
+	// Get the values and the materials in zone, generating both in a single pass when they are not cached
+	// MaterialQueryZone must be inside ValueQueryZone and have the same step. Requires read lock
+	void GetValuesAndMaterials(TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD) const;
 	
 	template<typename T>
 	TArray<T> Get(const FVoxelIntBox& Bounds) const;
@@ -200,7 +214,11 @@ public:
 
 	// Requires read lock
 	TVoxelRange<FVoxelValue> GetValueRange(const FVoxelIntBox& Bounds, int32 LOD) const;
+	// Requires read lock
+	// Uses the range states cached in the data octree nodes: much faster than GetValueRange when called repeatedly on the same area
+	EVoxelDataRangeState GetRangeState(const FVoxelIntBox& Bounds, int32 LOD) const;
 
+	// Requires read lock. True if there's no surface in Bounds
 	bool IsEmpty(const FVoxelIntBox& Bounds, int32 LOD) const;
 
 	template<typename T>
@@ -293,6 +311,10 @@ public:
 	bool IsCurrentFrameEmpty();
 	// Get the history position. No lock required
 	inline int32 GetHistoryPosition() const { return UndoRedo.HistoryPosition; }
+	// Get the min history position, ie the oldest frame that wasn't evicted by the history memory budget. No lock required
+	inline int32 GetMinHistoryPosition() const { return UndoRedo.MinHistoryPosition; }
+	// Memory used by the undo and redo frames. No lock required
+	inline int64 GetHistoryMemory() const { return UndoRedo.HistoryMemory; }
 	// Get the max history position, ie HistoryPosition + redo frames. No lock required
 	inline int32 GetMaxHistoryPosition() const { return UndoRedo.MaxHistoryPosition; }
 
@@ -305,12 +327,22 @@ public:
 	// Each save frame call gets assigned a unique ID, can be used to track the state of the world
 	// Will always be != 0
 	FORCEINLINE uint64 GetCurrentFrameUniqueId() const { return UndoRedo.CurrentFrameUniqueId; }
+
+public:
+	// Compress the values of the leaves that weren't edited during the last voxel.data.CompressIdleLeavesAfterFrames calls
+	// Leaves being edited aren't compressed & expanded on every edit. Called by the voxel world every tick. No lock required
+	void CompressIdleLeaves();
 	
 private:
 	struct FUndoRedo
 	{
 		int32 HistoryPosition = 0;
 		int32 MaxHistoryPosition = 0;
+		// Frames before that were evicted to stay under voxel.data.UndoRedoMemoryBudgetMB
+		int32 MinHistoryPosition = 0;
+
+		// Sum of the leaves history allocated size
+		int64 HistoryMemory = 0;
 		
 		TArray<FVoxelIntBox> UndoFramesBounds;
 		TArray<FVoxelIntBox> RedoFramesBounds;
@@ -328,6 +360,24 @@ private:
 	FUndoRedo UndoRedo;
 	bool bIsDirty = false;
 
+	TVoxelRange<FVoxelValue> GetNodeValueRange(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& QueryBounds, int32 LOD) const;
+	// Uses and fills the per-node cached ranges. Bounds must be clamped to the world bounds
+	TVoxelRange<FVoxelValue> GetNodeValueRangeCached(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& Bounds, int32 LOD) const;
+	EVoxelDataRangeState GetNodeRangeState(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& Bounds, int32 LOD) const;
+
+	void TrimHistory();
+
+	// Query the generator for a node without data, going through the generated data cache when possible
+	// LockedBounds are the bounds of the whole query, known to be locked
+	template<typename T>
+	void GetFromGenerator(const FVoxelDataOctreeBase& Node, const FVoxelIntBox& LockedBounds, TVoxelQueryZone<T>& QueryZone, int32 LOD) const;
+	void GetFromGenerator(
+		const FVoxelDataOctreeBase& Node,
+		const FVoxelIntBox& LockedBounds,
+		TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+		TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+		int32 LOD) const;
+
 public:
 	/**
 	 * Placeable items
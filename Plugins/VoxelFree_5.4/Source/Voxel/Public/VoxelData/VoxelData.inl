@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "VoxelData/VoxelData.h"
 #include "VoxelData/VoxelDataOctree.h"
+#include "VoxelData/VoxelGeneratedDataCache.h"
 #include "VoxelUtilities/VoxelOctreeUtilities.h"
 #include "VoxelGenerators/VoxelGeneratorInstance.inl"
 
@@ -109,8 +110,7 @@ TArray<T> FVoxelData::ParallelGet(const FVoxelIntBox& Bounds, bool bForceSingleT
 
 FORCEINLINE bool FVoxelData::IsEmpty(const FVoxelIntBox& Bounds, int32 LOD) const
 {
-	const auto Range = GetValueRange(Bounds, LOD);
-	return Range.Min.IsEmpty() == Range.Max.IsEmpty();
+	return GetRangeState(Bounds, LOD) != EVoxelDataRangeState::Surface;
 }
 
 template<typename T>
@@ -351,6 +351,12 @@ TVoxelWeakPtr<const TVoxelDataItemWrapper<T>> FVoxelData::AddItem(TArgs&&... Arg
 		}
 	});
 	
+	if (!std::is_same_v<T, FVoxelDisableEditsBoxItem>)
+	{
+		// The generator data depends on the items
+		GetGeneratedDataCache().Invalidate(ItemWrapper->Item.Bounds);
+	}
+	
 	if (std::is_same_v<T, FVoxelAssetItem>) { INC_DWORD_STAT(STAT_NumVoxelAssetItems); }
 	if (std::is_same_v<T, FVoxelDisableEditsBoxItem>) { INC_DWORD_STAT(STAT_NumVoxelDisableEditsItems); }
 	if (std::is_same_v<T, FVoxelDataItem>) { INC_DWORD_STAT(STAT_NumVoxelDataItems); }
@@ -408,6 +414,11 @@ bool FVoxelData::RemoveItem(TVoxelWeakPtr<const TVoxelDataItemWrapper<T>>& InIte
 		}
 	});
 	
+	if (!std::is_same_v<T, FVoxelDisableEditsBoxItem>)
+	{
+		GetGeneratedDataCache().Invalidate(Item->Item.Bounds);
+	}
+	
 	if (std::is_same_v<T, FVoxelAssetItem>) { DEC_DWORD_STAT(STAT_NumVoxelAssetItems); }
 	if (std::is_same_v<T, FVoxelDisableEditsBoxItem>) { DEC_DWORD_STAT(STAT_NumVoxelDisableEditsItems); }
 	if (std::is_same_v<T, FVoxelDataItem>) { DEC_DWORD_STAT(STAT_NumVoxelDataItems); }
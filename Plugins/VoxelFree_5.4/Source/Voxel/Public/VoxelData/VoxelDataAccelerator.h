@@ -11,10 +11,18 @@ class FVoxelData;
 class FVoxelDataOctreeLeaf;
 class FVoxelDataOctreeBase;
 
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Accelerator Reads"), STAT_VoxelDataAcceleratorReads, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Accelerator Writes"), STAT_VoxelDataAcceleratorWrites, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Accelerator Cache Hits"), STAT_VoxelDataAcceleratorCacheHits, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Accelerator Cache Misses"), STAT_VoxelDataAcceleratorCacheMisses, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Accelerator Map Hits"), STAT_VoxelDataAcceleratorMapHits, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Data Accelerator Map Misses"), STAT_VoxelDataAcceleratorMapMisses, STATGROUP_VoxelCounters, VOXEL_API);
+
 namespace FVoxelDataAcceleratorParameters
 {
 	VOXEL_API int32 GetDefaultCacheSize();
 	VOXEL_API bool GetUseAcceleratorMap();
+	VOXEL_API int32 GetMaxDenseMapSize();
 	VOXEL_API bool GetShowStats();
 }
 	
@@ -138,14 +146,70 @@ private:
 	mutable uint32 NumOutOfWorld = 0;
 #endif
 
-	using FAcceleratorMap = TMap<FIntVector, FVoxelDataOctreeLeaf*>;
+	// Leaves in Bounds, indexed by Leaf.GetMin() / DATA_CHUNK_SIZE
+	// Dense array of leaf pointers covering Bounds if small enough, else a map
+	struct FAcceleratorMap
+	{
+		// In data chunks
+		FIntVector Min = FIntVector::ZeroValue;
+		FIntVector Size = FIntVector::ZeroValue;
+		
+		TArray<FVoxelDataOctreeLeaf*> DenseLeaves;
+		TMap<FIntVector, FVoxelDataOctreeLeaf*> SparseLeaves;
+
+		static constexpr int32 ChunkSizeLog2 = FVoxelUtilities::IntLog2(DATA_CHUNK_SIZE);
+
+		FORCEINLINE bool IsDense() const
+		{
+			return DenseLeaves.Num() > 0;
+		}
+		FORCEINLINE int32 GetDenseIndex(const FIntVector& ChunkPosition) const
+		{
+			const FIntVector Position = ChunkPosition - Min;
+			if (uint32(Position.X) >= uint32(Size.X) ||
+				uint32(Position.Y) >= uint32(Size.Y) ||
+				uint32(Position.Z) >= uint32(Size.Z))
+			{
+				return -1;
+			}
+			return Position.X + Size.X * (Position.Y + Size.Y * Position.Z);
+		}
+		
+		FORCEINLINE FVoxelDataOctreeLeaf* Find(int32 X, int32 Y, int32 Z) const
+		{
+			const FIntVector ChunkPosition(X >> ChunkSizeLog2, Y >> ChunkSizeLog2, Z >> ChunkSizeLog2);
+			if (IsDense())
+			{
+				const int32 Index = GetDenseIndex(ChunkPosition);
+				return Index != -1 ? DenseLeaves.GetData()[Index] : nullptr;
+			}
+			else
+			{
+				return SparseLeaves.FindRef(ChunkPosition);
+			}
+		}
+		void Add(const FIntVector& ChunkPosition, FVoxelDataOctreeLeaf* Leaf)
+		{
+			if (IsDense())
+			{
+				const int32 Index = GetDenseIndex(ChunkPosition);
+				if (ensureVoxelSlow(Index != -1))
+				{
+					DenseLeaves[Index] = Leaf;
+				}
+			}
+			else
+			{
+				SparseLeaves.Add(ChunkPosition, Leaf);
+			}
+		}
+	};
 #if VOXEL_ENGINE_VERSION >= 504
 	using FConstAcceleratorMap = typename std::conditional_t<bIsConst, const FAcceleratorMap, FAcceleratorMap>;
 #else
 	using FConstAcceleratorMap = typename TChooseClass<bIsConst, const FAcceleratorMap, FAcceleratorMap>::Result;
 #endif
 	
-	// Map from Leaf.GetMin() to &Leaf
 	const TVoxelSharedPtr<FConstAcceleratorMap> AcceleratorMap;
 
 	template<typename T>
@@ -41,6 +41,13 @@ template<typename TData>
 TVoxelDataAccelerator<TData>::~TVoxelDataAccelerator()
 {
 #if VOXEL_DATA_ACCELERATOR_STATS
+	INC_DWORD_STAT_BY(STAT_VoxelDataAcceleratorReads, NumGet);
+	INC_DWORD_STAT_BY(STAT_VoxelDataAcceleratorWrites, NumSet);
+	INC_DWORD_STAT_BY(STAT_VoxelDataAcceleratorCacheHits, (NumCacheTopAccess - NumCacheTopMiss) + (NumCacheAllAccess - NumCacheAllMiss));
+	INC_DWORD_STAT_BY(STAT_VoxelDataAcceleratorCacheMisses, NumCacheAllMiss);
+	INC_DWORD_STAT_BY(STAT_VoxelDataAcceleratorMapHits, NumMapAccess - NumMapMiss);
+	INC_DWORD_STAT_BY(STAT_VoxelDataAcceleratorMapMisses, NumMapMiss);
+	
 	if (FVoxelDataAcceleratorParameters::GetShowStats() && (NumGet > 0 || NumSet > 0))
 	{
 		LOG_VOXEL(
@@ -224,9 +231,8 @@ bool TVoxelDataAccelerator<TData>::SetImpl(int32 X, int32 Y, int32 Z, TLambda Ed
 
 			if (bUseAcceleratorMap)
 			{
-				const FIntVector HashPosition = FVoxelUtilities::DivideFloor(FIntVector(X, Y, Z), DATA_CHUNK_SIZE);
 				ensureVoxelSlowNoSideEffects(AcceleratorMap.IsUnique());
-				AcceleratorMap->Add(HashPosition, &Octree->AsLeaf());
+				AcceleratorMap->Add(Octree->GetMin() / DATA_CHUNK_SIZE, &Octree->AsLeaf());
 			}
 		}
 
@@ -309,8 +315,8 @@ FVoxelDataOctreeBase* TVoxelDataAccelerator<TData>::GetOctreeFromMap(int32 X, in
 	checkVoxelSlow(bUseAcceleratorMap);
 
 	ACCELERATOR_STAT(NumMapAccess++);
-	const FIntVector HashPosition = FVoxelUtilities::DivideFloor(FIntVector(X, Y, Z), DATA_CHUNK_SIZE);
-	auto* Result = AcceleratorMap->FindRef(HashPosition);
+	auto* Result = AcceleratorMap->Find(X, Y, Z);
+	checkVoxelSlow(!Result || Result->IsInOctree(X, Y, Z));
 	ACCELERATOR_STAT(if (!Result) NumMapMiss++);
 	return Result;
 }
@@ -331,17 +337,30 @@ void TVoxelDataAccelerator<TData>::StoreOctreeInCache(FVoxelDataOctreeBase& Octr
 }
 
 template<typename TData>
-TVoxelSharedRef<TMap<FIntVector, FVoxelDataOctreeLeaf*>> TVoxelDataAccelerator<TData>::GetAcceleratorMap(const FVoxelData& Data, const FVoxelIntBox& Bounds)
+TVoxelSharedRef<typename TVoxelDataAccelerator<TData>::FAcceleratorMap> TVoxelDataAccelerator<TData>::GetAcceleratorMap(const FVoxelData& Data, const FVoxelIntBox& Bounds)
 {
 	VOXEL_ASYNC_FUNCTION_COUNTER();
 
 	const auto AcceleratorMap = MakeVoxelShared<FAcceleratorMap>();
+
+	// Only build a dense array if the bounds are bounded and small enough
+	const FVoxelIntBox WorldBounds = Bounds.Overlap(Data.WorldBounds);
+	const FIntVector ChunksMin = FVoxelUtilities::DivideFloor(WorldBounds.Min, DATA_CHUNK_SIZE);
+	const FIntVector ChunksSize = FVoxelUtilities::DivideCeil(WorldBounds.Max, DATA_CHUNK_SIZE) - ChunksMin;
+	if (Bounds.Intersect(Data.WorldBounds) &&
+		int64(ChunksSize.X) * int64(ChunksSize.Y) * int64(ChunksSize.Z) <= FVoxelDataAcceleratorParameters::GetMaxDenseMapSize())
+	{
+		AcceleratorMap->Min = ChunksMin;
+		AcceleratorMap->Size = ChunksSize;
+		AcceleratorMap->DenseLeaves.SetNumZeroed(ChunksSize.X * ChunksSize.Y * ChunksSize.Z);
+	}
+	
 	FVoxelOctreeUtilities::IterateLeavesInBounds(Data.GetOctree(), Bounds, [&](auto& Leaf)
 	{
 		ensureThreadSafe(Leaf.IsLockedForRead());
 		AcceleratorMap->Add(Leaf.GetMin() / DATA_CHUNK_SIZE, &Leaf);
 	});
-	AcceleratorMap->Compact();
+	AcceleratorMap->SparseLeaves.Compact();
 	return AcceleratorMap;
 }
 
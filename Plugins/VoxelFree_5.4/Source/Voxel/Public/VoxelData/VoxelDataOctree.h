@@ -14,6 +14,7 @@
 #include "VoxelData/VoxelDataOctreeLeafUndoRedo.h"
 #include "VoxelData/VoxelDataOctreeLeafMultiplayer.h"
 #include "VoxelPlaceableItems/VoxelPlaceableItem.h"
+#include <atomic>
 
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Data Octrees Memory"), STAT_VoxelDataOctreesMemory, STATGROUP_VoxelMemory, VOXEL_API);
 DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Voxel Data Octrees Count"), STAT_VoxelDataOctreesCount, STATGROUP_VoxelCounters, VOXEL_API);
@@ -43,6 +44,18 @@ namespace FVoxelDataOctreeUtilities
 	}
 }
 
+// Result of the range analysis of some values
+enum class EVoxelDataRangeState : uint8
+{
+	Unknown = 0,
+	// All values are empty
+	Empty = 1,
+	// All values are full
+	Full = 2,
+	// Values might have a surface
+	Surface = 3
+};
+
 class VOXEL_API FVoxelDataOctreeBase : public TVoxelOctreeBase<DATA_CHUNK_SIZE>
 {
 public:
@@ -74,6 +87,8 @@ public:
 	T GetFromGeneratorAndAssets(const FVoxelGeneratorInstance& Generator, U X, U Y, U Z, int32 LOD) const;
 	template<typename T>
 	void GetFromGeneratorAndAssets(const FVoxelGeneratorInstance& Generator, TVoxelQueryZone<T>& QueryZone, int32 LOD) const;
+	// MaterialQueryZone must be inside ValueQueryZone. Both are generated in a single pass when possible
+	void GetFromGeneratorAndAssets(const FVoxelGeneratorInstance& Generator, TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD) const;
 
 public:
 #if DO_THREADSAFE_CHECKS
@@ -85,7 +100,66 @@ public:
 	FVoxelPlaceableItemHolder& GetItemHolder() { return *ItemHolder; }
 	const FVoxelPlaceableItemHolder& GetItemHolder() const { return *ItemHolder; }
 
+public:
+	// Range state of the node bounds, cached per LOD. Cleared when the node or any of its children is unlocked after a write
+	// Must only be accessed when the entire node is locked
+	static constexpr int32 MaxCachedRangeStateLOD = 32;
+	
+	FORCEINLINE EVoxelDataRangeState GetCachedRangeState(int32 LOD) const
+	{
+		checkVoxelSlow(LOD >= 0);
+		if (LOD >= MaxCachedRangeStateLOD)
+		{
+			return EVoxelDataRangeState::Unknown;
+		}
+		return EVoxelDataRangeState((CachedRangeStates.load(std::memory_order_relaxed) >> (2 * LOD)) & 0x3);
+	}
+	FORCEINLINE void SetCachedRangeState(int32 LOD, EVoxelDataRangeState State) const
+	{
+		checkVoxelSlow(LOD >= 0);
+		if (LOD < MaxCachedRangeStateLOD)
+		{
+			// Several readers can compute the same state at once, but they will always agree
+			CachedRangeStates.fetch_or(uint64(State) << (2 * LOD), std::memory_order_relaxed);
+		}
+	}
+	
+	// Value range of the node bounds, cached for a single LOD at a time. Same rules as the range states
+	FORCEINLINE bool GetCachedValueRange(int32 LOD, FVoxelValue& OutMin, FVoxelValue& OutMax) const
+	{
+		checkVoxelSlow(LOD >= 0);
+		const uint64 Packed = CachedValueRange.load(std::memory_order_relaxed);
+		if (Packed >> 32 != uint64(LOD) + 1)
+		{
+			return false;
+		}
+		using FStorage = decltype(FVoxelValue().GetStorage());
+		OutMin = FVoxelValue::InternalConstructor(FStorage(int16(uint16(Packed >> 16))));
+		OutMax = FVoxelValue::InternalConstructor(FStorage(int16(uint16(Packed))));
+		return true;
+	}
+	FORCEINLINE void SetCachedValueRange(int32 LOD, FVoxelValue Min, FVoxelValue Max) const
+	{
+		checkVoxelSlow(LOD >= 0);
+		const uint64 Packed =
+			((uint64(LOD) + 1) << 32) |
+			(uint64(uint16(int16(Min.GetStorage()))) << 16) |
+			uint64(uint16(int16(Max.GetStorage())));
+		CachedValueRange.store(Packed, std::memory_order_relaxed);
+	}
+	
+	FORCEINLINE void ClearCachedRanges() const
+	{
+		CachedRangeStates.store(0, std::memory_order_relaxed);
+		CachedValueRange.store(0, std::memory_order_relaxed);
+	}
+
 private:
+	// 2 bits per LOD
+	mutable std::atomic<uint64> CachedRangeStates{ 0 };
+	// LOD + 1 in the high bits, 0 if not set
+	mutable std::atomic<uint64> CachedValueRange{ 0 };
+
 	// Always valid on a node with no children
 	TUniquePtr<FVoxelPlaceableItemHolder> ItemHolder = MakeUnique<FVoxelPlaceableItemHolder>();
 	FVoxelSharedMutex Mutex;
@@ -147,6 +221,11 @@ public:
 			if (Data.bEnableUndoRedo && !UndoRedo.IsValid())
 			{
 				UndoRedo = MakeUnique<FVoxelDataOctreeLeafUndoRedo>(*this);
+				Data.AddLeafWithUndoRedo(*this);
+			}
+			if (std::is_same_v<T, FVoxelValue>)
+			{
+				Data.AddLeafToCompress(GetMin());
 			}
 		}
 	}
@@ -230,6 +309,7 @@ struct FVoxelDataOctreeSetter
 				if (OldValue != Ref)
 				{
 					DataHolder.SetIsDirty(true, Data);
+					DataHolder.ExtendRange(Ref);
 					if (EnableMultiplayer) Leaf.Multiplayer->MarkIndexDirty<T>(Index);
 					if (EnableUndoRedo) Leaf.UndoRedo->SavePreviousValue(Index, OldValue);
 				}
@@ -285,12 +365,14 @@ struct FVoxelDataOctreeSetter
 				if (OldValueA != RefA)
 				{
 					DataHolderA.SetIsDirty(true, Data);
+					DataHolderA.ExtendRange(RefA);
 					if (EnableMultiplayer) Leaf.Multiplayer->MarkIndexDirty<TA>(Index);
 					if (EnableUndoRedo) Leaf.UndoRedo->SavePreviousValue(Index, OldValueA);
 				}
 				if (OldValueB != RefB)
 				{
 					DataHolderB.SetIsDirty(true, Data);
+					DataHolderB.ExtendRange(RefB);
 					if (EnableMultiplayer) Leaf.Multiplayer->MarkIndexDirty<TB>(Index);
 					if (EnableUndoRedo) Leaf.UndoRedo->SavePreviousValue(Index, OldValueB);
 				}
@@ -14,6 +14,8 @@ DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Dirty Materials Memory"), STAT_VoxelDataOc
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Cached Values Memory"), STAT_VoxelDataOctreeCachedValuesMemory, STATGROUP_VoxelMemory, VOXEL_API);
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Cached Materials Memory"), STAT_VoxelDataOctreeCachedMaterialsMemory, STATGROUP_VoxelMemory, VOXEL_API);
 
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Voxel Palette Values Leaves Count"), STAT_VoxelDataOctreePaletteValuesCount, STATGROUP_VoxelCounters, VOXEL_API);
+
 template<typename T>
 struct TVoxelDataOctreeLeafMemoryUsage
 {
@@ -72,11 +74,21 @@ template<>
 class TVoxelDataOctreeLeafData<FVoxelValue>
 {
 	FVoxelValue* RESTRICT DataPtr = nullptr;
+	// If set, the data is stored as a palette followed by bit-packed palette indices
+	// Layout: 1 << PaletteBitsPerIndex palette entries padded to a word, then VOXELS_PER_DATA_CHUNK indices
+	uint32* RESTRICT PaletteDataPtr = nullptr;
 	FVoxelValue SingleValue;
+	// Conservative range of the values stored in DataPtr/PaletteDataPtr: edits only extend it
+	FVoxelValue RangeMin;
+	FVoxelValue RangeMax;
+	uint8 PaletteBitsPerIndex = 0;
 	bool bIsSingleValue = false;
+	bool bIsRangeValid = false;
 	bool bDirty = false;
 
 	static constexpr int32 MemorySize = VOXELS_PER_DATA_CHUNK * sizeof(FVoxelValue);
+	// Above 8 bits per index the palette isn't much smaller than the raw data
+	static constexpr int32 MaxPaletteBitsPerIndex = 8;
 
 	friend class FVoxelSaveBuilder;
 	friend class FVoxelSaveLoader;
@@ -85,7 +97,7 @@ public:
 	TVoxelDataOctreeLeafData() = default;
 	~TVoxelDataOctreeLeafData()
 	{
-		if (!ensureVoxelSlow(!DataPtr))
+		if (!ensureVoxelSlow(!DataPtr && !PaletteDataPtr))
 		{
 			ClearData(IVoxelDataOctreeMemory());
 		}
@@ -117,6 +129,12 @@ public:
 			TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Decrease(MemorySize, bOldDirty, Memory);
 			TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Increase(MemorySize, bNewDirty, Memory);
 		}
+		if (PaletteDataPtr)
+		{
+			const int32 PaletteMemorySize = GetPaletteMemorySize(PaletteBitsPerIndex);
+			TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Decrease(PaletteMemorySize, bOldDirty, Memory);
+			TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Increase(PaletteMemorySize, bNewDirty, Memory);
+		}
 	}
 
 public:
@@ -133,6 +151,7 @@ public:
 		CreateData(Memory);
 		check(DataPtr);
 		Init(static_cast<FVoxelValue* RESTRICT>(DataPtr));
+		ComputeRange();
 	}
 	void CreateData(const IVoxelDataOctreeMemory& Memory, const TVoxelDataOctreeLeafData<FVoxelValue>& Source)
 	{
@@ -140,10 +159,18 @@ public:
 		CheckState();
 
 		bIsSingleValue = Source.bIsSingleValue;
+		bIsRangeValid = Source.bIsRangeValid;
+		RangeMin = Source.RangeMin;
+		RangeMax = Source.RangeMax;
 		if (Source.bIsSingleValue)
 		{
 			SingleValue = Source.SingleValue;
 		}
+		else if (Source.PaletteDataPtr)
+		{
+			Palette_Allocate(Source.PaletteBitsPerIndex, Memory);
+			FMemory::Memcpy(PaletteDataPtr, Source.PaletteDataPtr, GetPaletteMemorySize(PaletteBitsPerIndex));
+		}
 		else
 		{
 			if (Source.DataPtr)
@@ -163,7 +190,12 @@ public:
 		{
 			Deallocate(Memory);
 		}
+		if (PaletteDataPtr)
+		{
+			Palette_Deallocate(Memory);
+		}
 		bIsSingleValue = false;
+		bIsRangeValid = false;
 		checkVoxelSlow(!HasData());
 		CheckState();
 	}
@@ -172,19 +204,27 @@ public:
 	// Used to determine if it's worth compressing or clearing the cache
 	FORCEINLINE bool HasAllocation() const
 	{
-		return DataPtr != nullptr;
+		return DataPtr || PaletteDataPtr;
 	}
 	FORCEINLINE bool HasData() const
 	{
-		return DataPtr || bIsSingleValue;
+		return DataPtr || PaletteDataPtr || bIsSingleValue;
 	}
 	
 public:
 	void Compress(const IVoxelDataOctreeMemory& Memory)
 	{
-		if (!bIsSingleValue)
+		if (!DataPtr)
+		{
+			// Single value or already palette compressed
+			return;
+		}
+		
+		TryCompressToSingleValue(Memory);
+
+		if (DataPtr)
 		{
-			TryCompressToSingleValue(Memory);
+			TryCompressToPalette(Memory);
 		}
 	}
 
@@ -197,11 +237,14 @@ public:
 		{
 			return SingleValue;
 		}
-		else
+		else if (DataPtr)
 		{
-			checkVoxelSlow(DataPtr);
 			return DataPtr[Index];
 		}
+		else
+		{
+			return GetFromPalette(Index);
+		}
 	}
 
 public:
@@ -213,6 +256,10 @@ public:
 		{
 			ExpandSingleValue(Memory);
 		}
+		else if (PaletteDataPtr)
+		{
+			ExpandPalette(Memory);
+		}
 		CheckState();
 	}
 	FORCEINLINE FVoxelValue& GetRef(int32 Index)
@@ -223,6 +270,53 @@ public:
 		return DataPtr[Index];
 	}
 
+public:
+	// If false, the range must be computed by scanning the values
+	FORCEINLINE bool IsRangeValid() const
+	{
+		return bIsSingleValue || bIsRangeValid;
+	}
+	FORCEINLINE FVoxelValue GetRangeMin() const
+	{
+		checkVoxelSlow(IsRangeValid());
+		return bIsSingleValue ? SingleValue : RangeMin;
+	}
+	FORCEINLINE FVoxelValue GetRangeMax() const
+	{
+		checkVoxelSlow(IsRangeValid());
+		return bIsSingleValue ? SingleValue : RangeMax;
+	}
+	// Must be called with every value written through GetRef
+	FORCEINLINE void ExtendRange(FVoxelValue Value)
+	{
+		checkVoxelSlow(DataPtr);
+		RangeMin = FMath::Min(RangeMin, Value);
+		RangeMax = FMath::Max(RangeMax, Value);
+	}
+	// Must be called after writing to GetRef without calling ExtendRange
+	void ComputeRange()
+	{
+		VOXEL_SLOW_FUNCTION_COUNTER();
+		
+		checkVoxelSlow(HasData());
+		if (bIsSingleValue)
+		{
+			return;
+		}
+
+		const int32 Num = DataPtr ? VOXELS_PER_DATA_CHUNK : (1 << PaletteBitsPerIndex);
+		const FVoxelValue* RESTRICT const Values = DataPtr ? DataPtr : GetPalette();
+
+		RangeMin = FVoxelValue::Empty();
+		RangeMax = FVoxelValue::Full();
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			RangeMin = FMath::Min(RangeMin, Values[Index]);
+			RangeMax = FMath::Max(RangeMax, Values[Index]);
+		}
+		bIsRangeValid = true;
+	}
+
 public:
 	FORCEINLINE void CopyTo(FVoxelValue* RESTRICT DestPtr) const
 	{
@@ -234,10 +328,17 @@ public:
 				DestPtr[Index] = SingleValue;
 			}
 		}
-		else
+		else if (DataPtr)
 		{
 			FMemory::Memcpy(DestPtr, DataPtr, MemorySize);
 		}
+		else
+		{
+			for (int32 Index = 0; Index < VOXELS_PER_DATA_CHUNK; Index++)
+			{
+				DestPtr[Index] = GetFromPalette(Index);
+			}
+		}
 	}
 
 public:
@@ -250,12 +351,17 @@ public:
 		checkVoxelSlow(IsSingleValue());
 		return SingleValue;
 	}
+	FORCEINLINE bool IsPalette() const
+	{
+		return PaletteDataPtr != nullptr;
+	}
 	
 	void SetSingleValue(FVoxelValue InSingleValue)
 	{
 		CheckState();
-		check(!DataPtr && !bIsSingleValue);
+		check(!DataPtr && !PaletteDataPtr && !bIsSingleValue);
 		bIsSingleValue = true;
+		bIsRangeValid = false;
 		SingleValue = InSingleValue;
 		CheckState();
 	}
@@ -270,6 +376,9 @@ public:
 		{
 			DataPtr[Index] = SingleValue;
 		}
+		RangeMin = SingleValue;
+		RangeMax = SingleValue;
+		bIsRangeValid = true;
 		CheckState();
 	}
 	void TryCompressToSingleValue(const IVoxelDataOctreeMemory& Memory)
@@ -291,6 +400,102 @@ public:
 		Deallocate(Memory);
 		SingleValue = NewSingleValue;
 		bIsSingleValue = true;
+		bIsRangeValid = false;
+		
+		CheckState();
+	}
+	void TryCompressToPalette(const IVoxelDataOctreeMemory& Memory)
+	{
+		VOXEL_SLOW_FUNCTION_COUNTER();
+		
+		CheckState();
+		check(!bIsSingleValue && !PaletteDataPtr);
+
+		if (!DataPtr)
+		{
+			return;
+		}
+
+		constexpr int32 MaxPaletteSize = 1 << MaxPaletteBitsPerIndex;
+		
+		TVoxelStaticArray<FVoxelValue, MaxPaletteSize> Palette;
+		TVoxelStaticArray<uint8, VOXELS_PER_DATA_CHUNK> PaletteIndices;
+		int32 PaletteSize = 0;
+		int32 LastPaletteIndex = 0;
+		
+		for (int32 Index = 0; Index < VOXELS_PER_DATA_CHUNK; Index++)
+		{
+			const FVoxelValue Value = DataPtr[Index];
+			// Values are very often the same as the previous one, check that first
+			if (PaletteSize == 0 || Palette[LastPaletteIndex] != Value)
+			{
+				LastPaletteIndex = -1;
+				for (int32 PaletteIndex = 0; PaletteIndex < PaletteSize; PaletteIndex++)
+				{
+					if (Palette[PaletteIndex] == Value)
+					{
+						LastPaletteIndex = PaletteIndex;
+						break;
+					}
+				}
+				if (LastPaletteIndex == -1)
+				{
+					if (PaletteSize == MaxPaletteSize)
+					{
+						// Too many different values
+						return;
+					}
+					LastPaletteIndex = PaletteSize++;
+					Palette[LastPaletteIndex] = Value;
+				}
+			}
+			PaletteIndices[Index] = LastPaletteIndex;
+		}
+
+		uint8 BitsPerIndex = 1;
+		while ((1 << BitsPerIndex) < PaletteSize)
+		{
+			BitsPerIndex *= 2;
+		}
+		checkVoxelSlow(BitsPerIndex <= MaxPaletteBitsPerIndex);
+
+		Palette_Allocate(BitsPerIndex, Memory);
+
+		FVoxelValue* RESTRICT const PalettePtr = GetPalette();
+		for (int32 PaletteIndex = 0; PaletteIndex < (1 << BitsPerIndex); PaletteIndex++)
+		{
+			// Fill unused entries too, to not have uninitialized memory in the copies
+			PalettePtr[PaletteIndex] = Palette[FMath::Min(PaletteIndex, PaletteSize - 1)];
+		}
+
+		uint32* RESTRICT const WordsPtr = GetPaletteWords();
+		FMemory::Memzero(WordsPtr, GetPaletteWordsMemorySize(BitsPerIndex));
+		for (int32 Index = 0; Index < VOXELS_PER_DATA_CHUNK; Index++)
+		{
+			const uint32 BitIndex = Index * BitsPerIndex;
+			WordsPtr[BitIndex / 32] |= uint32(PaletteIndices[Index]) << (BitIndex % 32);
+		}
+
+		Deallocate(Memory);
+
+		// The palette holds every value exactly once, tighten the range for free
+		ComputeRange();
+		
+		CheckState();
+	}
+	void ExpandPalette(const IVoxelDataOctreeMemory& Memory)
+	{
+		VOXEL_SLOW_FUNCTION_COUNTER();
+		
+		CheckState();
+		check(PaletteDataPtr);
+
+		Allocate(Memory);
+		for (int32 Index = 0; Index < VOXELS_PER_DATA_CHUNK; Index++)
+		{
+			DataPtr[Index] = GetFromPalette(Index);
+		}
+		Palette_Deallocate(Memory);
 		
 		CheckState();
 	}
@@ -298,7 +503,7 @@ public:
 private:
 	FORCEINLINE void CheckState() const
 	{
-		checkVoxelSlow(!(DataPtr && bIsSingleValue));
+		checkVoxelSlow(int32(DataPtr != nullptr) + int32(PaletteDataPtr != nullptr) + int32(bIsSingleValue) <= 1);
 		checkVoxelSlow(!bDirty || HasData());
 	}
 	FORCEINLINE static void CheckBounds(int32 Index)
@@ -326,6 +531,72 @@ private:
 		
 		TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Decrease(MemorySize, bDirty, Memory);
 	}
+
+private:
+	FORCEINLINE static constexpr int32 GetPaletteEntriesMemorySize(int32 BitsPerIndex)
+	{
+		// Pad to a word so that the indices are aligned
+		return (((1 << BitsPerIndex) * sizeof(FVoxelValue) + sizeof(uint32) - 1) / sizeof(uint32)) * sizeof(uint32);
+	}
+	FORCEINLINE static constexpr int32 GetPaletteWordsMemorySize(int32 BitsPerIndex)
+	{
+		return VOXELS_PER_DATA_CHUNK * BitsPerIndex / 8;
+	}
+	FORCEINLINE static constexpr int32 GetPaletteMemorySize(int32 BitsPerIndex)
+	{
+		return GetPaletteEntriesMemorySize(BitsPerIndex) + GetPaletteWordsMemorySize(BitsPerIndex);
+	}
+	static_assert(GetPaletteMemorySize(MaxPaletteBitsPerIndex) < MemorySize, "");
+	
+	FORCEINLINE FVoxelValue* GetPalette() const
+	{
+		checkVoxelSlow(PaletteDataPtr);
+		return reinterpret_cast<FVoxelValue*>(PaletteDataPtr);
+	}
+	FORCEINLINE uint32* GetPaletteWords() const
+	{
+		checkVoxelSlow(PaletteDataPtr);
+		return PaletteDataPtr + GetPaletteEntriesMemorySize(PaletteBitsPerIndex) / sizeof(uint32);
+	}
+	FORCEINLINE FVoxelValue GetFromPalette(int32 Index) const
+	{
+		CheckBounds(Index);
+		checkVoxelSlow(PaletteDataPtr);
+		
+		// BitsPerIndex is a power of 2, so an index never straddles two words
+		const uint32 BitIndex = Index * PaletteBitsPerIndex;
+		const uint32 Word = GetPaletteWords()[BitIndex / 32];
+		const uint32 PaletteIndex = (Word >> (BitIndex % 32)) & ((1u << PaletteBitsPerIndex) - 1);
+		return GetPalette()[PaletteIndex];
+	}
+	
+	void Palette_Allocate(uint8 BitsPerIndex, const IVoxelDataOctreeMemory& Memory)
+	{
+		VOXEL_SLOW_FUNCTION_COUNTER();
+
+		check(!PaletteDataPtr && !bIsSingleValue);
+		check(FMath::IsPowerOfTwo(BitsPerIndex) && BitsPerIndex <= MaxPaletteBitsPerIndex);
+		
+		const int32 PaletteMemorySize = GetPaletteMemorySize(BitsPerIndex);
+		PaletteBitsPerIndex = BitsPerIndex;
+		PaletteDataPtr = static_cast<uint32*>(FMemory::Malloc(PaletteMemorySize));
+		
+		TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Increase(PaletteMemorySize, bDirty, Memory);
+		INC_DWORD_STAT(STAT_VoxelDataOctreePaletteValuesCount);
+	}
+	void Palette_Deallocate(const IVoxelDataOctreeMemory& Memory)
+	{
+		VOXEL_SLOW_FUNCTION_COUNTER();
+
+		check(PaletteDataPtr);
+		FMemory::Free(PaletteDataPtr);
+		PaletteDataPtr = nullptr;
+		
+		TVoxelDataOctreeLeafMemoryUsage<FVoxelValue>::Decrease(GetPaletteMemorySize(PaletteBitsPerIndex), bDirty, Memory);
+		DEC_DWORD_STAT(STAT_VoxelDataOctreePaletteValuesCount);
+		
+		PaletteBitsPerIndex = 0;
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -619,6 +890,13 @@ public:
 		checkVoxelSlow(Main_DataPtr);
 		return Main_DataPtr[Index];
 	}
+	// Materials have no range
+	FORCEINLINE void ExtendRange(FVoxelMaterial Value)
+	{
+	}
+	FORCEINLINE void ComputeRange()
+	{
+	}
 	FORCEINLINE void SetSingleValue(FVoxelMaterial SingleValue)
 	{
 		CheckState();
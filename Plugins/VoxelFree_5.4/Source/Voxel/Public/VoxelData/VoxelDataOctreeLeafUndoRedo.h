@@ -27,7 +27,14 @@ public:
 	~FVoxelDataOctreeLeafUndoRedo();
 
 	void ClearFrames(const FVoxelDataOctreeLeaf& Leaf);
-	void SaveFrame(const FVoxelDataOctreeLeaf& Leaf, int32 HistoryPosition);
+	void SaveFrame(const IVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, int32 HistoryPosition);
+
+	// Clear the redo stack. Game thread only
+	void ClearRedoFrames();
+	// Remove the undo frames with a history position <= HistoryPosition. Game thread only
+	void ClearUndoFramesUpTo(int32 HistoryPosition);
+	// Add the memory used by each undo frame to OutFramesSizes[Frame HistoryPosition - MinHistoryPosition]. Game thread only
+	void AddUndoFramesAllocatedSize(int32 MinHistoryPosition, TArray<int64>& OutFramesSizes) const;
 
 	template<typename T>
 	void ClearFramesOfType();
@@ -35,6 +42,11 @@ public:
 	template<EVoxelUndoRedo Type>
 	void UndoRedo(const IVoxelData& Data, FVoxelDataOctreeLeaf& Leaf, int32 HistoryPosition);
 
+	// Revert Values to their state at HistoryPosition. Values must be the current leaf values
+	// Will set IsValueSet to true for all the voxels modified since HistoryPosition
+	template<typename T>
+	void RevertValues(int32 HistoryPosition, T* RESTRICT Values, bool* RESTRICT IsValueSet) const;
+
 public:
 	template<EVoxelUndoRedo Type>
 	inline bool CanUndoRedo(int32 HistoryPosition) const
@@ -45,18 +57,19 @@ public:
 	{
 		return CurrentFrame->IsEmpty();
 	}
-	
+
 	template<EVoxelUndoRedo Type>
-	inline auto& GetFramesStack()
+	inline const auto& GetFramesStack() const
 	{
 		return Type == EVoxelUndoRedo::Undo ? UndoFramesStack : RedoFramesStack;
 	}
-	template<EVoxelUndoRedo Type>
-	inline const auto& GetFramesStack() const
+
+	// Memory used by the undo and redo stacks. Game thread only
+	inline int64 GetHistoryAllocatedSize() const
 	{
-		return Type == EVoxelUndoRedo::Undo ? UndoFramesStack : RedoFramesStack;
+		return HistoryAllocatedSize;
 	}
-	
+
 public:
 	template<typename T>
 	FORCEINLINE void SavePreviousValue(FVoxelCellIndex Index, T Value)
@@ -78,6 +91,14 @@ private:
 
 		TModifiedValue(FVoxelCellIndex Index, T Value) : Index(Index), Value(Value) {}
 	};
+	// Saved frames only store the XOR of the values before and after the frame:
+	// the same deltas are used to undo and to redo the frame
+	// Format: runs of modified voxels (varint skip, varint count), each followed by count deltas with their zero bytes run-length encoded
+	struct FCompressedDeltas
+	{
+		TArray<uint8> Values;
+		TArray<uint8> Materials;
+	};
 	struct FFrame
 	{
 		template<typename TLeaf>
@@ -90,22 +111,29 @@ private:
 		{
 			DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelUndoRedoMemory, AllocatedSize);
 		}
-		
+
 		int32 HistoryPosition = -1;
-		
+
 		const bool bValuesDirty;
 		const bool bMaterialsDirty;
 
+		// Previous values, only used while recording the current frame
 		TArray<TModifiedValue<FVoxelValue>> Values;
 		TArray<TModifiedValue<FVoxelMaterial>> Materials;
-		
+
+		FCompressedDeltas Deltas;
+
 		mutable uint32 AllocatedSize = 0;
-		
+
 		void UpdateStats() const;
-		
+
 		inline bool IsEmpty() const
 		{
-			return Values.Num() == 0 && Materials.Num() == 0;
+			return
+				Values.Num() == 0 &&
+				Materials.Num() == 0 &&
+				Deltas.Values.Num() == 0 &&
+				Deltas.Materials.Num() == 0;
 		}
 	};
 	struct FAlreadyModified
@@ -117,10 +145,23 @@ private:
 	FAlreadyModified AlreadyModified;
 
 	TUniquePtr<FFrame> CurrentFrame;
-	
+
 	TArray<TUniquePtr<FFrame>> UndoFramesStack;
 	TArray<TUniquePtr<FFrame>> RedoFramesStack;
-	
+
+	int64 HistoryAllocatedSize = 0;
+
+	template<EVoxelUndoRedo Type>
+	inline auto& GetFramesStack()
+	{
+		return Type == EVoxelUndoRedo::Undo ? UndoFramesStack : RedoFramesStack;
+	}
+
 	template<EVoxelUndoRedo Type>
 	void AddFrameToStack(TUniquePtr<FFrame>& Frame);
-};
\ No newline at end of file
+	template<EVoxelUndoRedo Type>
+	TUniquePtr<FFrame> PopFrameFromStack();
+
+	template<typename T>
+	static void CompressFrameDeltas(const IVoxelData& Data, const FVoxelDataOctreeLeaf& Leaf, FFrame& Frame);
+};
@@ -0,0 +1,93 @@
+// Copyright Voxel Plugin SAS. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+#include "VoxelIntBox.h"
+#include "VoxelValue.h"
+#include "VoxelMaterial.h"
+#include "Containers/SparseArray.h"
+#include <atomic>
+
+DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Generated Data Cache Memory"), STAT_VoxelGeneratedDataCacheMemory, STATGROUP_VoxelMemory, VOXEL_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Voxel Generated Data Cache Blocks"), STAT_VoxelGeneratedDataCacheBlocks, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Voxel Generated Data Cache Hits"), STAT_VoxelGeneratedDataCacheHits, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Voxel Generated Data Cache Misses"), STAT_VoxelGeneratedDataCacheMisses, STATGROUP_VoxelCounters, VOXEL_API);
+
+/**
+ * LRU cache of the generator values & materials of DATA_CHUNK_SIZE blocks without edited or cached leaf data
+ * Entries only depend on the generator and the items: they must be invalidated when items are added or removed
+ * The memory is capped by voxel.data.GeneratedDataCacheSize
+ * Thread safe
+ */
+class VOXEL_API FVoxelGeneratedDataCache
+{
+public:
+	template<typename T>
+	using TBlockData = TVoxelSharedPtr<const TArray<T>>;
+
+	FVoxelGeneratedDataCache() = default;
+	~FVoxelGeneratedDataCache();
+
+	UE_NONCOPYABLE(FVoxelGeneratedDataCache);
+
+	static bool IsEnabled();
+
+	FORCEINLINE static FVoxelIntBox GetBlockBounds(const FIntVector& Block)
+	{
+		return FVoxelIntBox(Block, Block + DATA_CHUNK_SIZE);
+	}
+
+public:
+	// Returns null on miss. Block is the min of the block, and must be a multiple of DATA_CHUNK_SIZE
+	template<typename T>
+	TBlockData<T> Find(const FIntVector& Block);
+	// Data is VOXELS_PER_DATA_CHUNK elements indexed like the leaves data
+	template<typename T>
+	void Add(const FIntVector& Block, const TBlockData<T>& Data);
+
+	// Remove all the blocks intersecting Bounds
+	void Invalidate(const FVoxelIntBox& Bounds);
+	void Empty();
+
+public:
+	struct FStats
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		int64 Memory = 0;
+		int32 NumBlocks = 0;
+	};
+	FStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FIntVector Block;
+		TBlockData<FVoxelValue> Values;
+		TBlockData<FVoxelMaterial> Materials;
+
+		// Doubly linked list from the most recently used to the least recently used
+		int32 Previous = -1;
+		int32 Next = -1;
+
+		int64 GetMemory() const;
+	};
+
+	mutable FCriticalSection Section;
+	TSparseArray<FEntry> Entries;
+	TMap<FIntVector, int32> BlockToEntry;
+	int32 MostRecent = -1;
+	int32 LeastRecent = -1;
+	int64 TotalMemory = 0;
+
+	std::atomic<uint64> NumHits{ 0 };
+	std::atomic<uint64> NumMisses{ 0 };
+
+	void Unlink(int32 Index);
+	void LinkAsMostRecent(int32 Index);
+	void Remove(int32 Index);
+	void EvictToFit(int64 MaxMemory);
+};
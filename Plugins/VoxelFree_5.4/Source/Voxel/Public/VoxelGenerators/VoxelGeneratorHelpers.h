@@ -84,6 +84,26 @@ public:
 			}
 		}
 	}
+	virtual void GetValuesAndMaterials(TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD, const FVoxelItemStack& Items) const override
+	{
+		check(ValueQueryZone.Step == MaterialQueryZone.Step);
+		check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+
+		for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, X))
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Y))
+			{
+				for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Z))
+				{
+					ValueQueryZone.Set(X, Y, Z, FVoxelValue(This().GetValueImpl(X, Y, Z, LOD, Items)));
+					if (MaterialQueryZone.Bounds.Contains(X, Y, Z))
+					{
+						MaterialQueryZone.Set(X, Y, Z, This().GetMaterialImpl(X, Y, Z, LOD, Items));
+					}
+				}
+			}
+		}
+	}
 	
 private:
 	inline const TWorldInstance& This() const
@@ -184,6 +204,26 @@ public:
 			}
 		}
 	}
+	virtual void GetValuesAndMaterials(TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD, const FVoxelItemStack& Items) const override
+	{
+		check(ValueQueryZone.Step == MaterialQueryZone.Step);
+		check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+
+		for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, X))
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Y))
+			{
+				for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Z))
+				{
+					ValueQueryZone.Set(X, Y, Z, FVoxelValue(This().GetValueNoTransformImpl(X, Y, Z, LOD, Items)));
+					if (MaterialQueryZone.Bounds.Contains(X, Y, Z))
+					{
+						MaterialQueryZone.Set(X, Y, Z, This().GetMaterialNoTransformImpl(X, Y, Z, LOD, Items));
+					}
+				}
+			}
+		}
+	}
 	
 	virtual void GetValues_Transform(const FTransform& LocalToWorld, TVoxelQueryZone<FVoxelValue>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const override
 	{
@@ -211,6 +251,26 @@ public:
 			}
 		}
 	}
+	virtual void GetValuesAndMaterials_Transform(const FTransform& LocalToWorld, TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD, const FVoxelItemStack& Items) const override
+	{
+		check(ValueQueryZone.Step == MaterialQueryZone.Step);
+		check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+
+		for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, X))
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Y))
+			{
+				for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Z))
+				{
+					ValueQueryZone.Set(X, Y, Z, FVoxelValue(This().GetValueWithTransformImpl(LocalToWorld, X, Y, Z, LOD, Items)));
+					if (MaterialQueryZone.Bounds.Contains(X, Y, Z))
+					{
+						MaterialQueryZone.Set(X, Y, Z, This().GetMaterialWithTransformImpl(LocalToWorld, X, Y, Z, LOD, Items));
+					}
+				}
+			}
+		}
+	}
 
 	v_flt GetValueNoTransformImpl(v_flt X, v_flt Y, v_flt Z, int32 LOD, const FVoxelItemStack& Items) const
 	{
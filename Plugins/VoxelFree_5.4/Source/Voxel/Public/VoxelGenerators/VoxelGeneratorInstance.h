@@ -95,6 +95,14 @@ public:
 	virtual void GetValues   (TVoxelQueryZone<FVoxelValue   >& QueryZone, int32 LOD, const FVoxelItemStack& Items) const = 0;
 	// This function is only called when a chunk material is edited for the first time. Fine to leave as default
 	virtual void GetMaterials(TVoxelQueryZone<FVoxelMaterial>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const = 0;
+	// Query the values and the materials in a single pass, sharing the work common to both
+	// MaterialQueryZone must be inside ValueQueryZone and have the same step
+	// Default implementation calls GetValues then GetMaterials
+	virtual void GetValuesAndMaterials(
+		TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+		TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+		int32 LOD,
+		const FVoxelItemStack& Items) const;
 
 	// World up vector at position (must be normalized). Used for spawners
 	virtual FVector GetUpVector(v_flt X, v_flt Y, v_flt Z) const = 0;
@@ -187,6 +195,12 @@ public:
 	//~ Begin FVoxelTransformableGeneratorInstance Interface
 	virtual void GetValues_Transform   (const FTransform& LocalToWorld, TVoxelQueryZone<FVoxelValue   >& QueryZone, int32 LOD, const FVoxelItemStack& Items) const = 0;
 	virtual void GetMaterials_Transform(const FTransform& LocalToWorld, TVoxelQueryZone<FVoxelMaterial>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const = 0;
+	virtual void GetValuesAndMaterials_Transform(
+		const FTransform& LocalToWorld,
+		TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+		TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+		int32 LOD,
+		const FVoxelItemStack& Items) const;
 	//~ End FVoxelTransformableGeneratorInstance Interface
 	
 public:
@@ -6,6 +6,9 @@
 #include "VoxelMinimal.h"
 #include "Containers/Queue.h"
 
+class IVoxelPool;
+class IVoxelAsyncPhysicsCooker;
+class FVoxelPhysicsCookCache;
 class UVoxelProceduralMeshComponent;
 
 // We don't want to have every component ticking
@@ -13,6 +16,8 @@ class UVoxelProceduralMeshComponent;
 class IVoxelProceduralMeshComponent_PhysicsCallbackHandler : public TVoxelSharedFromThis<IVoxelProceduralMeshComponent_PhysicsCallbackHandler>
 {
 public:
+	virtual ~IVoxelProceduralMeshComponent_PhysicsCallbackHandler();
+	
 	void TickHandler();
 
 private:
@@ -25,4 +30,23 @@ private:
 
 public:
 	void CookerCallback(uint64 CookerId, TWeakObjectPtr<UVoxelProceduralMeshComponent> Component);
+
+private:
+	// Cookers queued this frame, sent to the pool in batches on the next tick
+	TVoxelWeakPtr<IVoxelPool> CookersPool;
+	TArray<IVoxelAsyncPhysicsCooker*> PendingCookers;
+
+	void FlushCookers();
+
+public:
+	// Takes ownership of the cooker until it's run: the component can still cancel it
+	void QueueCooker(const TVoxelWeakPtr<IVoxelPool>& Pool, IVoxelAsyncPhysicsCooker* Cooker);
+
+private:
+	TVoxelSharedPtr<FVoxelPhysicsCookCache> CookCache;
+
+public:
+	// Cooked collision meshes of the components using this handler, kept so that eg undo/redo doesn't cook again
+	// Game thread only. Cookers keep a reference to it
+	TVoxelSharedRef<FVoxelPhysicsCookCache> GetCookCache();
 };
\ No newline at end of file
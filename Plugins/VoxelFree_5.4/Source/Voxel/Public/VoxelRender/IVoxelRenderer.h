@@ -66,6 +66,7 @@ struct FVoxelRendererSettingsBase
 	const ECollisionTraceFlag CollisionTraceFlag;
 	const int32 NumConvexHullsPerAxis;
 	const bool bCleanCollisionMeshes;
+	const float CollisionSimplificationTolerance;
 
 	const EVoxelRenderType RenderType;
 	const uint32 RenderSharpness;
@@ -80,6 +81,7 @@ struct FVoxelRendererSettingsBase
 	const float DistanceFieldSelfShadowBias;
 	
 	const bool bOneMaterialPerCubeSide;
+	const bool bGreedyCubicMeshing;
 	const bool bHalfPrecisionCoordinates;
 	const bool bInterpolateColors;
 	const bool bInterpolateUVs;
@@ -171,7 +173,7 @@ public:
 	virtual void ApplyNewMaterials() = 0;
 	virtual void ApplyToAllMeshes(TFunctionRef<void(UVoxelProceduralMeshComponent&)> Lambda) = 0;
 	
-	virtual void CreateGeometry_AnyThread(int32 LOD, const FIntVector& ChunkPosition, TArray<uint32>& OutIndices, TArray<FVector>& OutVertices) const = 0;
+	virtual void CreateGeometry_AnyThread(int32 LOD, const FIntVector& ChunkPosition, TArray<uint32>& OutIndices, TArray<FVector3f>& OutVertices) const = 0;
 	//~ End IVoxelRenderer Interface
 
 	// Called by LOD manager
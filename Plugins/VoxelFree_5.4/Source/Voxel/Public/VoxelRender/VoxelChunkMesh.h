@@ -6,32 +6,59 @@
 #include "VoxelMinimal.h"
 #include "VoxelRender/VoxelProcMeshTangent.h"
 #include "VoxelRender/VoxelMaterialIndices.h"
+#include "VoxelValue.h"
 
-class FVoxelData;
 class FDistanceFieldVolumeData;
 struct FVoxelRendererSettingsBase;
 
 DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Chunk Mesh Memory"), STAT_VoxelChunkMeshMemory, STATGROUP_VoxelMemory, VOXEL_API);
+DECLARE_VOXEL_MEMORY_STAT(TEXT("Voxel Chunk Mesh Pool Memory"), STAT_VoxelChunkMeshPoolMemory, STATGROUP_VoxelMemory, VOXEL_API);
+
+// Values sampled by a mesher, used to build the chunk distance field without querying the data again
+struct FVoxelChunkDistanceFieldValues
+{
+	// Size * Size * Size values, X first
+	const FVoxelValue* Values = nullptr;
+	int32 Size = 0;
+	// Position of the first value relative to the chunk, in steps
+	int32 Offset = 0;
+};
+
+// Recycles the allocations of the chunk mesh buffers between rebuilds
+// Allocations are sorted by capacity class (powers of 2), so that an array taken from the pool never has to grow
+// Allocations taken from the pool can have a lot of slack: buffers kept around must be trimmed once filled
+struct VOXEL_API FVoxelChunkMeshBufferPool
+{
+	static bool IsEnabled();
+
+	// Array must be empty. Num is the number of elements it will hold
+	template<typename T>
+	static void Allocate(TArray<T>& Array, int32 Num);
+	// Gives the allocation of Array back to the pool. Array is empty afterwards
+	template<typename T>
+	static void Release(TArray<T>& Array);
+	// Reallocates Array to its exact size if it has too much slack, giving its previous allocation back to the pool
+	template<typename T>
+	static void Trim(TArray<T>& Array);
+};
 
 struct VOXEL_API FVoxelChunkMeshBuffers
 {
 	TArray<uint32> Indices;
-	TArray<FVector> Positions;
+	// Positions are relative to the chunk: float precision is enough
+	TArray<FVector3f> Positions;
 
 	// Will not be set if bRenderWorld is false
-	TArray<FVector> Normals;
+	TArray<FVoxelPackedNormal> Normals;
 	TArray<FVoxelProcMeshTangent> Tangents;
 	TArray<FColor> Colors;
-	TArray<TArray<FVector2D>> TextureCoordinates;
+	TArray<TArray<FVector2f>> TextureCoordinates;
 
 	FBox Bounds;
 	FGuid Guid; // Use to avoid rebuilding collisions when the mesh didn't change
 
 	FVoxelChunkMeshBuffers() = default;
-	~FVoxelChunkMeshBuffers()
-	{
-		DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkMeshMemory, LastAllocatedSize);
-	}
+	~FVoxelChunkMeshBuffers();
 
 	inline int32 GetNumVertices() const
 	{
@@ -40,6 +67,7 @@ struct VOXEL_API FVoxelChunkMeshBuffers
 
 	void BuildAdjacency(TArray<uint32>& OutAdjacencyIndices) const;
 	void OptimizeIndices();
+	// Trims the slack of all the arrays, see FVoxelChunkMeshBufferPool::Trim
 	void Shrink();
 	void ComputeBounds();
 
@@ -102,7 +130,8 @@ public:
 	}
 	
 public:
-	void BuildDistanceField(int32 LOD, const FIntVector& Position, const FVoxelData& Data, const FVoxelRendererSettingsBase& Settings);
+	// Builds a sparse distance field from the values, in the same format as the static meshes ones
+	void BuildDistanceField(int32 LOD, const FVoxelChunkDistanceFieldValues& Values, const FVoxelRendererSettingsBase& Settings);
 	
 	template<typename T>
 	inline void IterateBuffers(T Lambda)
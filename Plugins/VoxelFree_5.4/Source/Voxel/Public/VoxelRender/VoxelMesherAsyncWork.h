@@ -41,7 +41,7 @@ public:
 		int32 LOD,
 		const FIntVector& ChunkPosition,
 		TArray<uint32>& OutIndices,
-		TArray<FVector>& OutVertices);
+		TArray<FVector3f>& OutVertices);
 
 private:
 	// Important: do not allow public delete
@@ -6,7 +6,8 @@
 
 struct FVoxelProcMeshTangent
 {
-	FVector TangentX = FVector::RightVector;
+	// Float precision: tangents are chunk-local and stored per vertex in the chunk meshes
+	FVector3f TangentX = FVector3f::RightVector;
 	bool bFlipTangentY = false;
 
 	FVoxelProcMeshTangent() = default;
@@ -15,14 +16,68 @@ struct FVoxelProcMeshTangent
 		, bFlipTangentY(false)
 	{
 	}
-	FVoxelProcMeshTangent(FVector InTangentX, bool bInFlipTangentY)
+	FVoxelProcMeshTangent(const FVector3f& InTangentX, bool bInFlipTangentY)
+		: TangentX(InTangentX)
+		, bFlipTangentY(bInFlipTangentY)
+	{
+	}
+	FVoxelProcMeshTangent(const FVector& InTangentX, bool bInFlipTangentY)
 		: TangentX(InTangentX)
 		, bFlipTangentY(bInFlipTangentY)
 	{
 	}
 
-	FVector GetY(const FVector& Normal) const
+	FVector3f GetY(const FVector3f& Normal) const
 	{
 		return (Normal ^ TangentX) * (bFlipTangentY ? -1 : 1);
 	}
-};
\ No newline at end of file
+};
+
+// Unit normal packed in 4 bytes using an octahedral mapping
+struct FVoxelPackedNormal
+{
+	int16 X = 0;
+	int16 Y = 0;
+
+	FVoxelPackedNormal() = default;
+	explicit FVoxelPackedNormal(const FVector3f& Normal)
+	{
+		const float L1Norm = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+		if (L1Norm == 0)
+		{
+			return;
+		}
+
+		float OctX = Normal.X / L1Norm;
+		float OctY = Normal.Y / L1Norm;
+		if (Normal.Z < 0)
+		{
+			// Fold the lower hemisphere over the diagonals
+			const float FoldedX = (1 - FMath::Abs(OctY)) * (OctX >= 0 ? 1 : -1);
+			const float FoldedY = (1 - FMath::Abs(OctX)) * (OctY >= 0 ? 1 : -1);
+			OctX = FoldedX;
+			OctY = FoldedY;
+		}
+		X = int16(FMath::RoundToInt(FMath::Clamp(OctX, -1.f, 1.f) * MAX_int16));
+		Y = int16(FMath::RoundToInt(FMath::Clamp(OctY, -1.f, 1.f) * MAX_int16));
+	}
+	explicit FVoxelPackedNormal(const FVector& Normal)
+		: FVoxelPackedNormal(FVector3f(Normal))
+	{
+	}
+
+	FVector3f Unpack() const
+	{
+		FVector3f Normal(float(X) / MAX_int16, float(Y) / MAX_int16, 0.f);
+		Normal.Z = 1 - FMath::Abs(Normal.X) - FMath::Abs(Normal.Y);
+		if (Normal.Z < 0)
+		{
+			const float UnfoldedX = (1 - FMath::Abs(Normal.Y)) * (Normal.X >= 0 ? 1 : -1);
+			const float UnfoldedY = (1 - FMath::Abs(Normal.X)) * (Normal.Y >= 0 ? 1 : -1);
+			Normal.X = UnfoldedX;
+			Normal.Y = UnfoldedY;
+		}
+		return Normal.GetSafeNormal();
+	}
+};
+static_assert(sizeof(FVoxelPackedNormal) == 4, "");
\ No newline at end of file
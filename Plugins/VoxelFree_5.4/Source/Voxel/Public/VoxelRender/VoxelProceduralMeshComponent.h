@@ -78,6 +78,8 @@ private:
 	int32 NumConvexHullsPerAxis = 2;
 	// Cooks slower, but won't crash in case of weird complex geometry
 	bool bCleanCollisionMesh = false;
+	// Max distance between the collision & render meshes, in voxels at LOD 0
+	float CollisionSimplificationTolerance = 0.f;
 	// Will clear the proc mesh buffers once navmesh + collisions have been built
 	bool bClearProcMeshBuffersOnFinishUpdate = false;
 	// Distance field bias
@@ -108,6 +110,10 @@ public:
 	void SetDistanceFieldData(const TVoxelSharedPtr<const FDistanceFieldVolumeData>& InDistanceFieldData);
 	void SetProcMeshSection(int32 Index, FVoxelProcMeshSectionSettings Settings, TUniquePtr<FVoxelProcMeshBuffers> Buffers, EVoxelProcMeshSectionUpdate Update);
 	int32 AddProcMeshSection(FVoxelProcMeshSectionSettings Settings, TUniquePtr<FVoxelProcMeshBuffers> Buffers, EVoxelProcMeshSectionUpdate Update);
+	// Buffers must not be used by any other component, and their stats must be up to date
+	// Used to keep the same buffers across updates
+	void SetProcMeshSection(int32 Index, FVoxelProcMeshSectionSettings Settings, const TVoxelSharedRef<const FVoxelProcMeshBuffers>& Buffers, EVoxelProcMeshSectionUpdate Update);
+	int32 AddProcMeshSection(FVoxelProcMeshSectionSettings Settings, const TVoxelSharedRef<const FVoxelProcMeshBuffers>& Buffers, EVoxelProcMeshSectionUpdate Update);
 	void ReplaceProcMeshSection(FVoxelProcMeshSectionSettings Settings, TUniquePtr<FVoxelProcMeshBuffers> Buffers, EVoxelProcMeshSectionUpdate Update);
 	void ClearSections(EVoxelProcMeshSectionUpdate Update);
 	void FinishSectionsUpdates();
@@ -128,6 +134,8 @@ public:
 			Lambda(Section.Settings, static_cast<const FVoxelProcMeshBuffers&>(*Section.Buffers));
 		}
 	}
+	// Used to create the render data of the visible sections ahead of the scene proxy
+	void GetVisibleSectionsBuffers(TArray<TVoxelSharedRef<const FVoxelProcMeshBuffers>>& OutBuffers) const;
 	
 public:
 	//~ Begin UPrimitiveComponent Interface.
@@ -150,6 +158,8 @@ private:
 	void UpdateNavigation();
 	void UpdateCollision();
 	void FinishCollisionUpdate();
+	void UpdateDrawPath(double Time);
+	void OnDrawPathSettled();
 
 private:
 	void PhysicsCookerCallback(uint64 CookerId);
@@ -186,5 +196,9 @@ private:
 
 	double LastFinishSectionsUpdatesTime = 0;
 
+	// Chunks updated several times in a row are drawn through the dynamic path until they settle
+	bool bUseDynamicDrawPath = false;
+	FTimerHandle DrawPathSettleTimerHandle;
+
 	friend class FVoxelProceduralMeshSceneProxy;
 };
\ No newline at end of file
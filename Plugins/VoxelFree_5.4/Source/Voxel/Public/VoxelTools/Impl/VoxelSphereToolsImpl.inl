@@ -687,17 +687,7 @@ void FVoxelSphereToolsImpl::RevertSphere(TData& InData, const FVoxelVector& Posi
 			TVoxelStaticArray<Type, VOXELS_PER_DATA_CHUNK> Values;
 			Leaf.GetData<Type>().CopyTo(Values.GetData());
 
-			const auto& Stack = Leaf.UndoRedo->GetFramesStack<EVoxelUndoRedo::Undo>();
-			for (int32 Index = Stack.Num() - 1; Index >= 0; --Index)
-			{
-				if (Stack[Index]->HistoryPosition < HistoryPosition) break;
-
-				for (auto& Value : FVoxelUtilities::TValuesMaterialsSelector<Type>::Get(*Stack[Index]))
-				{
-					IsValueSet[Value.Index] = true;
-					Values[Value.Index] = Value.Value;
-				}
-			}
+			Leaf.UndoRedo->RevertValues<Type>(HistoryPosition, Values.GetData(), IsValueSet.GetData());
 
 			const FIntVector Min = Leaf.GetMin();
 
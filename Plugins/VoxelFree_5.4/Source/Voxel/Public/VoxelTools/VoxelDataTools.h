@@ -11,6 +11,7 @@
 #include "VoxelDataTools.generated.h"
 
 class FVoxelData;
+class FVoxelCancelCounter;
 class AVoxelWorld;
 class UVoxelGenerator;
 class UVoxelHeightmapAsset;
@@ -294,7 +295,8 @@ public:
 public:
 	// Bounds.Extend(2) must be locked!
 	// Bounds can be FVoxelIntBox::Infinite
-	static void RoundVoxelsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds);
+	// Leaves are processed in parallel. Returns false if canceled through CancelCounter
+	static bool RoundVoxelsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, const FVoxelCancelCounter* CancelCounter = nullptr);
 	
 	// Round voxels that don't have an impact on the surface. Same visual result but will lead to better compression
 	UFUNCTION(BlueprintCallable, Category = "Voxel|Tools|Data")
@@ -312,7 +314,8 @@ public:
 public:
 	// Bounds.Extend(1) must be locked!
 	// Bounds can be FVoxelIntBox::Infinite
-	static void ClearUnusedMaterialsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds);
+	// Leaves are processed in parallel. Returns false if canceled through CancelCounter
+	static bool ClearUnusedMaterialsImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, const FVoxelCancelCounter* CancelCounter = nullptr);
 	
 	// Remove materials that do not affect the surface. Same visual result but will lead to better compression.
 	// Digging will look different.
@@ -405,8 +408,9 @@ public:
 
 public:
 	// Requires full write lock
+	// Leaves data is cached in parallel. Returns false if canceled through CancelCounter
 	template<typename T>
-	static void CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<T>& Wrapper, bool bCheckAllLeaves);
+	static bool CompressIntoHeightmapImpl(FVoxelData& Data, TVoxelHeightmapAssetSamplerWrapper<T>& Wrapper, bool bCheckAllLeaves, const FVoxelCancelCounter* CancelCounter = nullptr);
 
 	/**
 	 * If the voxel generator is a heightmap or if an heightmap asset is provided,
@@ -433,7 +437,8 @@ public:
 
 public:
 	// Requires write lock.
-	static void RoundToGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, bool bPreserveNormals);
+	// Leaves are processed in parallel. Returns false if canceled through CancelCounter
+	static bool RoundToGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, bool bPreserveNormals, const FVoxelCancelCounter* CancelCounter = nullptr);
 	
 	// Will revert the values who don't have a voxel neighbor with a different sign from the generator value
 	// Will ignore items when computing generator values
@@ -453,7 +458,8 @@ public:
 	
 public:
 	// Requires write lock.
-	static void CheckIfSameAsGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds);
+	// Leaves are processed in parallel. Returns false if canceled through CancelCounter
+	static bool CheckIfSameAsGeneratorImpl(FVoxelData& Data, const FVoxelIntBox& Bounds, const FVoxelCancelCounter* CancelCounter = nullptr);
 	
 	// Will undirty the chunks identical to the generator
 	UFUNCTION(BlueprintCallable, Category = "Voxel|Data", meta = (DefaultToSelf = "World"))
@@ -0,0 +1,63 @@
+// Copyright Voxel Plugin SAS. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelMinimal.h"
+#include "VoxelIntBox.h"
+
+class FVoxelData;
+class IVoxelLODManager;
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Voxel Batched Edits"), STAT_VoxelBatchedEdits, STATGROUP_VoxelCounters, VOXEL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Voxel Batched Edits Lock Scopes"), STAT_VoxelBatchedEditsLockScopes, STATGROUP_VoxelCounters, VOXEL_API);
+
+/**
+ * Queues the edits of the generated tools (sphere, surface edits, box...) made during a frame, and applies them at the end of the frame:
+ * - edits with intersecting bounds are applied in order under a single write lock
+ * - the render is updated once for all the edited bounds
+ * - if SaveFrame was called while edits were queued, a single undo frame is saved after applying them
+ *
+ * The batch is flushed in the voxel world tick and again once all the actors ticked, so that edits queued by actors ticking later are applied the same frame
+ * It is also flushed before any write tool, async tool, item add/remove, undo, redo, save or load, so that edits stay in order
+ * Sync read only tools (eg FindSurfaceVoxels) do not flush it: they see the data as of the last flush,
+ * so that a find & edit loop doesn't flush on every call. Code accessing FVoxelData directly must call AVoxelWorld::FlushEditBatch first
+ * Enabled by AVoxelWorld::bBatchToolEdits. Game thread only
+ */
+class VOXEL_API FVoxelEditBatch
+{
+public:
+	using FEdit = TFunction<void(FVoxelData& Data)>;
+
+	FVoxelEditBatch() = default;
+	~FVoxelEditBatch();
+
+	UE_NONCOPYABLE(FVoxelEditBatch);
+
+	bool IsEmpty() const
+	{
+		return Edits.Num() == 0;
+	}
+
+	// Bounds must contain everything Edit reads or writes
+	void AddEdit(const FVoxelIntBox& Bounds, bool bUpdateRender, FEdit&& Edit);
+	// Called when SaveFrame is called while edits are queued: a frame including all the unsaved edits is saved on flush
+	// Otherwise, the batched edits are left in the current frame
+	void RequestSaveFrame()
+	{
+		bSaveFrameRequested = true;
+	}
+
+	// Applies all the queued edits. Must be called before anything else reads or edits the data, to keep edits in order
+	void Flush(FVoxelData& Data, IVoxelLODManager& LODManager);
+
+private:
+	struct FQueuedEdit
+	{
+		FVoxelIntBox Bounds;
+		bool bUpdateRender = false;
+		FEdit Edit;
+	};
+	TArray<FQueuedEdit> Edits;
+	bool bSaveFrameRequested = false;
+};
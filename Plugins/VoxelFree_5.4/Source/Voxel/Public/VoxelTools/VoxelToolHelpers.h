@@ -207,8 +207,15 @@ struct VOXEL_API FVoxelToolHelpers
 	// Avoids having to include the LOD Manager header in every tool file
 	static void UpdateWorld(AVoxelWorld* World, const FVoxelIntBox& Bounds);
 	// If World is null, will start an async on AnyThread. Else will use the voxel world thread pool.
+	// Flushes the world edit batch first so that the task sees the queued edits
 	static void StartAsyncEditTask(AVoxelWorld* World, IVoxelQueuedWork* Work);
 
+	// True if the world batches tool edits, and the caller doesn't need the modified voxels right away
+	static bool CanBatchEdit(AVoxelWorld* World, bool bRecordModifiedVoxels);
+	static void AddBatchedEdit(AVoxelWorld* World, const FVoxelIntBox& Bounds, bool bUpdateRender, TFunction<void(FVoxelData&)>&& Edit);
+	// Must be called before editing the data outside of the batch, to keep edits in order, and before saving the data
+	static void FlushEditBatch(const AVoxelWorld* World);
+
 	static float GetRealDistance(AVoxelWorld* World, float Distance, bool bConvertToVoxelSpace);
 	static FVoxelVector GetRealPosition(AVoxelWorld* World, const FVector& Position, bool bConvertToVoxelSpace);
 	static FTransform GetRealTransform(AVoxelWorld* World, FTransform Transform, bool bConvertToVoxelSpace);
@@ -416,6 +423,11 @@ if (!FVoxelUtilities::CountIs32Bits(Bounds.Size())) \
 ///////////////////////////////////////////////////////////////////////////////
 
 #define VOXEL_TOOL_HELPER_BODY(InLockType, InUpdateRender, ...) \
+	if (EVoxelLockType::InLockType == EVoxelLockType::Write) \
+	{ \
+		/* Read only tools don't see the batched edits until the end of the frame */ \
+		FVoxelToolHelpers::FlushEditBatch(World); \
+	} \
 	auto& Data = World->GetData(); \
 	{ \
 		TVoxelScopeLock<EVoxelLockType::InLockType> Lock(Data, Bounds, FUNCTION_FNAME); \
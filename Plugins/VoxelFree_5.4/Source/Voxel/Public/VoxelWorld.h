@@ -40,6 +40,7 @@ class IVoxelSpawnerManager;
 class FVoxelMultiplayerManager;
 class FVoxelInstancedMeshManager;
 class FVoxelToolRenderingManager;
+class FVoxelEditBatch;
 struct FVoxelLODDynamicSettings;
 struct FVoxelUncompressedWorldSave;
 struct FVoxelRendererDynamicSettings;
@@ -180,6 +181,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - General", meta = (Recreate))
 	bool bEnableUndoRedo = false;
 
+	// If true, sync sphere, surface, box & level tools edits that don't record modified voxels are queued and applied at the end of the frame
+	// Overlapping edits share a single lock, and a single render update is done for all of them
+	// Sync read only tools don't see the queued edits until the end of the frame
+	// Useful when applying many small edits per frame, eg when painting
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - General")
+	bool bBatchToolEdits = false;
+
 	// If true, the voxel world will try to stay near its original coordinates when rebasing, and will offset the voxel coordinates instead
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - General")
 	bool bEnableCustomWorldRebasing = false;
@@ -335,6 +343,12 @@ public:
 	// Visually, it will give a more "sharp" look, 1 being the sharpest, 2 3 etc being less and less sharp
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Rendering", meta = (RecreateRender, UIMin = 0, UIMax = 10, ClampMin = 0))
 	int32 RenderSharpness = 0;
+
+	// For cubic only
+	// If true, coplanar faces with the same material are merged into bigger quads, greatly reducing the triangle count
+	// UVs are still tiled once per voxel
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Rendering", meta = (RecreateRender))
+	bool bGreedyCubicMeshing = false;
 	
 	// If true, a dynamic instance will be created for each chunk. Else, the material will be used directly
 	// Disable this if you want to use dynamic material instances as voxel world materials
@@ -380,6 +394,7 @@ public:
 	// Will generate distance fields on LOD 0 chunks
 	// Has a cost of around 1 ms per chunk (on async thread)
 	// Doesn't work with chunks merging or single/double index material config with different materials per chunk
+	// Only used by the renderer: not built on dedicated servers. Use the voxel data (eg GetValue) for gameplay distance queries
 	// Requires UE 4.23+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Rendering", meta = (RecreateRender))
 	bool bGenerateDistanceFields = false;
@@ -516,6 +531,14 @@ public:
 	// To check the performance improvements: voxel.LogCollisionCookingTimes 1
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Collisions", meta = (RecreateRender, EditCondition = bEnableCollisions))
 	bool bCleanCollisionMeshes = true;
+
+	// Max distance, in voxels, between the collision meshes and the render meshes. 0 to cook the render meshes as is
+	// The collision meshes are decimated up to that error: flat areas end up with a few triangles, reducing cooking time and collision memory
+	// Scales with the chunk LOD, like the render meshes. Chunk borders are never moved so that there are no holes between chunks
+	// Off by default: collisions then no longer exactly match the rendered surface. 0.5 is a good starting point
+	// To check the performance improvements: voxel.collision.LogCookingTimes 1
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Voxel - Collisions", meta = (RecreateRender, ClampMin = 0, UIMin = 0, UIMax = 4, EditCondition = bEnableCollisions))
+	float CollisionSimplificationTolerance = 0.f;
 	
 	//////////////////////////////////////////////////////////////////////////////
 
@@ -618,6 +641,7 @@ public:
 	FVoxelDebugManager& GetDebugManager() const { return *DebugManager; }
 	FVoxelEventManager& GetEventManager() const { return *EventManager; }
 	FVoxelToolRenderingManager& GetToolRenderingManager() const { return *ToolRenderingManager; }
+	FVoxelEditBatch& GetEditBatch() const { return *EditBatch; }
 
 	const UVoxelGeneratorCache& GetGeneratorCache() const { return *GeneratorCache; }
 	
@@ -626,6 +650,8 @@ public:
 	const TVoxelSharedPtr<IVoxelLODManager>& GetLODManagerSharedPtr() const { return LODManager; }
 	const TVoxelSharedPtr<IVoxelPool>& GetPoolSharedPtr() const { return Pool; }
 	const TVoxelSharedRef<FIntVector>& GetWorldOffsetPtr() const { return WorldOffset; }
+	// Incremented to cancel the async data tools in flight (see FVoxelCancelCounter)
+	const TVoxelSharedRef<FThreadSafeCounter64>& GetAsyncToolsCancelCounter() const { return AsyncToolsCancelCounter; }
 	const TVoxelSharedRef<FVoxelRendererDynamicSettings>& GetRendererDynamicSettings() const { return RendererDynamicSettings; }
 	EVoxelPlayType GetPlayType() const { return PlayType; }
 	
@@ -784,8 +810,11 @@ private:
 	TVoxelSharedPtr<IVoxelLODManager> LODManager;
 	TVoxelSharedPtr<FVoxelEventManager> EventManager;
 	TVoxelSharedPtr<FVoxelToolRenderingManager> ToolRenderingManager;
+	TVoxelSharedPtr<FVoxelEditBatch> EditBatch;
+	FDelegateHandle OnWorldPostActorTickHandle;
 
 	TVoxelSharedRef<FIntVector> WorldOffset = MakeVoxelShared<FIntVector>(FIntVector::ZeroValue);
+	TVoxelSharedRef<FThreadSafeCounter64> AsyncToolsCancelCounter = MakeVoxelShared<FThreadSafeCounter64>();
 	TVoxelSharedRef<FVoxelLODDynamicSettings> LODDynamicSettings = TVoxelSharedPtr<FVoxelLODDynamicSettings>().ToSharedRef(); // else the VTABLE constructor doesn't compile...
 	TVoxelSharedRef<FVoxelRendererDynamicSettings> RendererDynamicSettings = TVoxelSharedPtr<FVoxelRendererDynamicSettings>().ToSharedRef();
 	
@@ -793,6 +822,7 @@ private:
 	
 private:
 	void OnWorldLoadedCallback();
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds) const;
 
 	TVoxelSharedRef<FVoxelDebugManager> CreateDebugManager() const;
 	TVoxelSharedRef<FVoxelData> CreateData() const;
@@ -814,6 +844,9 @@ public:
 	void UpdateDynamicRendererSettings() const;
 	void ApplyCollisionSettingsToRoot() const;
 
+	// Applies the edits queued when bBatchToolEdits is true
+	void FlushEditBatch() const;
+
 	void RecreateRender();
 	void RecreateSpawners();
 	void RecreateAll(const FVoxelWorldCreateInfo& Info);
@@ -1,6 +1,13 @@
 // Copyright Voxel Plugin SAS. All Rights Reserved.
 
 #include "VoxelContext.h"
+#include "VoxelGraphGeneratorHelpers.h"
+
+VOXELGRAPH_API TAutoConsoleVariable<int32> CVarCheckGraphBatches(
+	TEXT("voxel.graph.CheckBatches"),
+	0,
+	TEXT("If true, graph voxels computed in batches are computed again one at a time, and an ensure is raised if the results differ. Very slow, for debugging"),
+	ECVF_Default);
 
 const FVoxelContext FVoxelContext::EmptyContext = FVoxelContext(
 	0,
@@ -7,6 +7,7 @@
 #include "VoxelRange.h"
 #include "VoxelIntBox.h"
 #include "VoxelItemStack.h"
+#include "VoxelUtilities/VoxelBaseUtilities.h"
 
 struct VOXELGRAPH_API FVoxelContext
 {
@@ -75,6 +76,42 @@ private:
 	friend class FVoxelGraphPreview;
 };
 
+// Z coordinates of a run of voxels sharing the same X and Y, used by the batched XYZ functions
+// Each node is computed for all the lanes in a plain loop so that the compiler can vectorize it
+// Only used when the local Z only depends on the world Z, ie when the transform has no rotation
+struct FVoxelContextBatch
+{
+	static constexpr int32 Size = 8;
+
+	// Number of lanes actually queried. The other ones repeat the last Z so that they are still valid
+	int32 Num = 0;
+
+	FORCEINLINE v_flt GetWorldZ(int32 Lane) const { checkVoxelSlow(0 <= Lane && Lane < Size); return WorldZ[Lane]; }
+	FORCEINLINE v_flt GetLocalZ(int32 Lane) const { checkVoxelSlow(0 <= Lane && Lane < Size); return LocalZ[Lane]; }
+
+private:
+	v_flt WorldZ[Size];
+	v_flt LocalZ[Size];
+
+	// LocalZ = LocalOffsetZ + WorldZ * LocalScaleZ
+	FORCEINLINE void SetZ(int32 StartZ, int32 Step, int32 EndZ, v_flt LocalOffsetZ, v_flt LocalScaleZ)
+	{
+		Num = FMath::Min(Size, FVoxelUtilities::DivideCeil(EndZ - StartZ, Step));
+		checkVoxelSlow(Num > 0);
+		
+		for (int32 Lane = 0; Lane < Size; Lane++)
+		{
+			WorldZ[Lane] = StartZ + FMath::Min(Lane, Num - 1) * Step;
+			LocalZ[Lane] = LocalOffsetZ + WorldZ[Lane] * LocalScaleZ;
+		}
+	}
+
+	template<typename, typename>
+	friend class TVoxelGraphGeneratorInstanceHelper;
+};
+
+#define VOXEL_BATCH_ITERATE(Lane) int32 Lane = 0; Lane < FVoxelContextBatch::Size; Lane++
+
 struct VOXELGRAPH_API FVoxelContextRange
 {
 	const int32 LOD;
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Containers/StaticArray.h"
+#include "Templates/Models.h"
+#include "HAL/IConsoleManager.h"
 #include "VoxelMinimal.h"
 #include "VoxelContext.h"
 #include "VoxelGraphConstants.h"
@@ -23,6 +25,17 @@ struct FVoxelGraphOutputsInit
 	EVoxelMaterialConfig MaterialConfig;
 };
 
+extern VOXELGRAPH_API TAutoConsoleVariable<int32> CVarCheckGraphBatches;
+
+// Compute structs can implement ComputeXYZWithCache_Batch to compute FVoxelContextBatch::Size voxels along Z at once
+// They must also implement ComputeXYZWithCache, with the same results: see voxel.graph.CheckBatches
+// The others are queried one voxel at a time
+struct CVoxelGraphBatchedTarget
+{
+	template<typename T>
+	auto Requires(const T& Target) -> decltype(&T::ComputeXYZWithCache_Batch);
+};
+
 template<typename TChild, typename UWorldObject>
 class TVoxelGraphGeneratorInstanceHelper : public TVoxelTransformableGeneratorInstanceHelper<TChild, UWorldObject>
 {
@@ -151,6 +164,212 @@ public:
 		return Outputs.template Get<T, Index>();
 	}
 
+	// If voxel.graph.CheckBatches is set, computes the lanes of a batch again one voxel at a time and checks that the outputs match
+	template<typename T, uint32 Index, typename TTarget, typename TBufferX, typename TBufferXY, typename TOutputs>
+	void CheckBatch(
+		const TTarget& Target,
+		FVoxelContext& Context,
+		const FVoxelContextBatch& Batch,
+		const TBufferX& BufferX,
+		const TBufferXY& BufferXY,
+		T DefaultValue,
+		const TOutputs (&BatchOutputs)[FVoxelContextBatch::Size]) const
+	{
+		if (CVarCheckGraphBatches.GetValueOnAnyThread() == 0)
+		{
+			return;
+		}
+		
+		for (int32 Lane = 0; Lane < Batch.Num; Lane++)
+		{
+			Context.WorldZ = Batch.GetWorldZ(Lane);
+			Context.LocalZ = Batch.GetLocalZ(Lane);
+
+			auto Outputs = Target.GetOutputs();
+			Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+			Outputs.template Set<T, Index>(DefaultValue);
+			Target.ComputeXYZWithCache(Context, BufferX, BufferXY, Outputs);
+
+			const T Value = Outputs.template Get<T, Index>();
+			const T BatchValue = BatchOutputs[Lane].template Get<T, Index>();
+
+			bool bSame;
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				// The compiler is free to reorder the vectorized math
+				bSame = FMath::IsNearlyEqual(Value, BatchValue, T(1.e-4) * FMath::Max<T>(1, FMath::Abs(Value)));
+			}
+			else
+			{
+				bSame = Value == BatchValue;
+			}
+			ensureMsgf(bSame, TEXT("Batched graph output %u differs from the per-voxel one at (%f, %f, %f)"),
+				Index, Context.GetWorldX(), Context.GetWorldY(), Context.GetWorldZ());
+		}
+	}
+
+	// Compute all the voxels of QueryZone along Z at X, Y, once the X and XY stages are done
+	template<typename T, typename QueryZoneType, uint32 Index, typename TTarget, typename TBufferX, typename TBufferXY>
+	void ComputeZ(
+		const TTarget& Target,
+		FVoxelContext& Context,
+		const TBufferX& BufferX,
+		const TBufferXY& BufferXY,
+		T DefaultValue,
+		TVoxelQueryZone<QueryZoneType>& QueryZone,
+		int32 X,
+		int32 Y,
+		v_flt LocalOffsetZ,
+		v_flt LocalScaleZ) const
+	{
+		if constexpr (TModels<CVoxelGraphBatchedTarget, TTarget>::Value)
+		{
+			FVoxelContextBatch Batch;
+			for (int32 StartZ = QueryZone.Bounds.Min.Z; StartZ < QueryZone.Bounds.Max.Z; StartZ += FVoxelContextBatch::Size * QueryZone.Step)
+			{
+				Batch.SetZ(StartZ, QueryZone.Step, QueryZone.Bounds.Max.Z, LocalOffsetZ, LocalScaleZ);
+
+				decltype(Target.GetOutputs()) Outputs[FVoxelContextBatch::Size];
+				for (auto& LaneOutputs : Outputs)
+				{
+					LaneOutputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+					LaneOutputs.template Set<T, Index>(DefaultValue);
+				}
+				
+				Target.ComputeXYZWithCache_Batch(Context, Batch, BufferX, BufferXY, Outputs);
+				CheckBatch<T, Index>(Target, Context, Batch, BufferX, BufferXY, DefaultValue, Outputs);
+				
+				for (int32 Lane = 0; Lane < Batch.Num; Lane++)
+				{
+					QueryZone.Set(X, Y, StartZ + Lane * QueryZone.Step, QueryZoneType(Outputs[Lane].template Get<T, Index>()));
+				}
+			}
+		}
+		else
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
+			{
+				Context.WorldZ = Z;
+				Context.LocalZ = LocalOffsetZ + Z * LocalScaleZ;
+
+				auto Outputs = Target.GetOutputs();
+				Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+				Outputs.template Set<T, Index>(DefaultValue);
+				Target.ComputeXYZWithCache(Context, BufferX, BufferXY, Outputs);
+				QueryZone.Set(X, Y, Z, QueryZoneType(Outputs.template Get<T, Index>()));
+			}
+		}
+	}
+
+	// ComputeZ for the value and the material targets at once: the Z coordinates, the context and the loop are shared
+	// Materials are only computed for the Z inside MaterialQueryZone
+	template<typename TValueTarget, typename TMaterialTarget, typename TValueBufferX, typename TValueBufferXY, typename TMaterialBufferX, typename TMaterialBufferXY>
+	void ComputeValuesAndMaterialsZ(
+		const TValueTarget& ValueTarget,
+		const TMaterialTarget& MaterialTarget,
+		FVoxelContext& Context,
+		const TValueBufferX& ValueBufferX,
+		const TValueBufferXY& ValueBufferXY,
+		const TMaterialBufferX& MaterialBufferX,
+		const TMaterialBufferXY& MaterialBufferXY,
+		TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+		TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+		int32 X,
+		int32 Y,
+		v_flt LocalOffsetZ,
+		v_flt LocalScaleZ) const
+	{
+		constexpr uint32 ValueIndex = FVoxelGraphOutputsIndices::ValueIndex;
+		constexpr uint32 MaterialIndex = FVoxelGraphOutputsIndices::MaterialIndex;
+		
+		constexpr bool bValueBatched = TModels<CVoxelGraphBatchedTarget, TValueTarget>::Value;
+		constexpr bool bMaterialBatched = TModels<CVoxelGraphBatchedTarget, TMaterialTarget>::Value;
+
+		const int32 MaterialMinZ = MaterialQueryZone.Bounds.Min.Z;
+		const int32 MaterialMaxZ = MaterialQueryZone.Bounds.Max.Z;
+		
+		if constexpr (bValueBatched && bMaterialBatched)
+		{
+			const int32 Step = ValueQueryZone.Step;
+			
+			FVoxelContextBatch Batch;
+			for (int32 StartZ = ValueQueryZone.Bounds.Min.Z; StartZ < ValueQueryZone.Bounds.Max.Z; StartZ += FVoxelContextBatch::Size * Step)
+			{
+				Batch.SetZ(StartZ, Step, ValueQueryZone.Bounds.Max.Z, LocalOffsetZ, LocalScaleZ);
+				{
+					decltype(ValueTarget.GetOutputs()) Outputs[FVoxelContextBatch::Size];
+					for (auto& LaneOutputs : Outputs)
+					{
+						LaneOutputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+						LaneOutputs.template Set<v_flt, ValueIndex>(1);
+					}
+					
+					ValueTarget.ComputeXYZWithCache_Batch(Context, Batch, ValueBufferX, ValueBufferXY, Outputs);
+					CheckBatch<v_flt, ValueIndex>(ValueTarget, Context, Batch, ValueBufferX, ValueBufferXY, v_flt(1), Outputs);
+					
+					for (int32 Lane = 0; Lane < Batch.Num; Lane++)
+					{
+						ValueQueryZone.Set(X, Y, StartZ + Lane * Step, FVoxelValue(Outputs[Lane].template Get<v_flt, ValueIndex>()));
+					}
+				}
+
+				if (StartZ < MaterialMaxZ && MaterialMinZ < StartZ + Batch.Num * Step)
+				{
+					decltype(MaterialTarget.GetOutputs()) Outputs[FVoxelContextBatch::Size];
+					for (auto& LaneOutputs : Outputs)
+					{
+						LaneOutputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+						LaneOutputs.template Set<FVoxelMaterial, MaterialIndex>(FVoxelMaterial::Default());
+					}
+					
+					MaterialTarget.ComputeXYZWithCache_Batch(Context, Batch, MaterialBufferX, MaterialBufferXY, Outputs);
+					CheckBatch<FVoxelMaterial, MaterialIndex>(MaterialTarget, Context, Batch, MaterialBufferX, MaterialBufferXY, FVoxelMaterial::Default(), Outputs);
+					
+					for (int32 Lane = 0; Lane < Batch.Num; Lane++)
+					{
+						const int32 Z = StartZ + Lane * Step;
+						if (MaterialMinZ <= Z && Z < MaterialMaxZ)
+						{
+							MaterialQueryZone.Set(X, Y, Z, Outputs[Lane].template Get<FVoxelMaterial, MaterialIndex>());
+						}
+					}
+				}
+			}
+		}
+		else if constexpr (!bValueBatched && !bMaterialBatched)
+		{
+			for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Z))
+			{
+				Context.WorldZ = Z;
+				Context.LocalZ = LocalOffsetZ + Z * LocalScaleZ;
+
+				{
+					auto Outputs = ValueTarget.GetOutputs();
+					Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+					Outputs.template Set<v_flt, ValueIndex>(1);
+					ValueTarget.ComputeXYZWithCache(Context, ValueBufferX, ValueBufferXY, Outputs);
+					ValueQueryZone.Set(X, Y, Z, FVoxelValue(Outputs.template Get<v_flt, ValueIndex>()));
+				}
+				if (MaterialMinZ <= Z && Z < MaterialMaxZ)
+				{
+					auto Outputs = MaterialTarget.GetOutputs();
+					Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+					Outputs.template Set<FVoxelMaterial, MaterialIndex>(FVoxelMaterial::Default());
+					MaterialTarget.ComputeXYZWithCache(Context, MaterialBufferX, MaterialBufferXY, Outputs);
+					MaterialQueryZone.Set(X, Y, Z, Outputs.template Get<FVoxelMaterial, MaterialIndex>());
+				}
+			}
+		}
+		else
+		{
+			// Only one of the targets is batched: don't lose the batching by computing them in the same loop
+			ComputeZ<v_flt, FVoxelValue, ValueIndex>(
+				ValueTarget, Context, ValueBufferX, ValueBufferXY, 1, ValueQueryZone, X, Y, LocalOffsetZ, LocalScaleZ);
+			ComputeZ<FVoxelMaterial, FVoxelMaterial, MaterialIndex>(
+				MaterialTarget, Context, MaterialBufferX, MaterialBufferXY, FVoxelMaterial::Default(), MaterialQueryZone, X, Y, LocalOffsetZ, LocalScaleZ);
+		}
+	}
+
 	template<bool bCustomTransform, typename T, typename QueryZoneType, uint32 Index>
 	void GetOutput(const FTransform& LocalToWorld, T DefaultValue, TVoxelQueryZone<QueryZoneType>& QueryZone, int32 LOD, const FVoxelItemStack& Items) const
 	{
@@ -160,55 +379,189 @@ public:
 
 		FVoxelContext Context(LOD, Items, LocalToWorld, bCustomTransform);
 		
-		if (!bCustomTransform)
+		// Without rotation, each local coordinate only depends on the same world coordinate:
+		// the X and XY buffers can be cached
+		if (!bCustomTransform || HasNoRotation(LocalToWorld))
 		{
-			// We can only use the dependencies analysis if we don't have a transform, or if it's only translation + scale
-			// (and thus not changing the axis). Not checking that second case though.
+			// Local = LocalOffset + World * LocalScale
+			const FVector LocalOffset = bCustomTransform ? LocalToWorld.InverseTransformPosition(FVector::ZeroVector) : FVector::ZeroVector;
+			const FVector LocalScale = bCustomTransform ? LocalToWorld.InverseTransformVector(FVector::OneVector) : FVector::OneVector;
+
 			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
 			{
-				Context.LocalX = Context.WorldX = X;
+				Context.WorldX = X;
+				Context.LocalX = LocalOffset.X + X * LocalScale.X;
 				
 				auto BufferX = Target.GetBufferX();
 				Target.ComputeX(Context, BufferX);
 
 				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
 				{
-					Context.LocalY = Context.WorldY = Y;
+					Context.WorldY = Y;
+					Context.LocalY = LocalOffset.Y + Y * LocalScale.Y;
 
 					auto BufferXY = Target.GetBufferXY();
 					Target.ComputeXYWithCache(Context, BufferX, BufferXY);
 
-					for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
-					{
-						Context.LocalZ = Context.WorldZ = Z;
-
-						auto Outputs = Target.GetOutputs();
-						Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
-						Outputs.template Set<T, Index>(DefaultValue);
-						Target.ComputeXYZWithCache(Context, static_cast<const decltype(BufferX)&>(BufferX), static_cast<const decltype(BufferXY)&>(BufferXY), Outputs);
-						QueryZone.Set(X, Y, Z, QueryZoneType(Outputs.template Get<T, Index>()));
-					}
+					ComputeZ<T, QueryZoneType, Index>(Target, Context, BufferX, BufferXY, DefaultValue, QueryZone, X, Y, LocalOffset.Z, LocalScale.Z);
 				}
 			}
 		}
 		else
 		{
-			// Have to query all the voxels individually
+			// With a rotation every local coordinate depends on all the world ones: have to query all the voxels individually
+			// The transform is affine, so instead of transforming each voxel walk the local positions with per-axis deltas
+			const FVector LocalMin = LocalToWorld.InverseTransformPosition(FVector(QueryZone.Bounds.Min));
+			const FVector LocalDeltaX = LocalToWorld.InverseTransformVector(FVector(QueryZone.Step, 0, 0));
+			const FVector LocalDeltaY = LocalToWorld.InverseTransformVector(FVector(0, QueryZone.Step, 0));
+			const FVector LocalDeltaZ = LocalToWorld.InverseTransformVector(FVector(0, 0, QueryZone.Step));
+
+			int32 IndexX = 0;
 			for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, X))
 			{
+				int32 IndexY = 0;
 				for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Y))
 				{
+					// Restart from the exact row position so that errors don't accumulate across rows
+					FVector Local = LocalMin + IndexX * LocalDeltaX + IndexY * LocalDeltaY;
+					
 					for (VOXEL_QUERY_ZONE_ITERATE(QueryZone, Z))
 					{
-						Context.UpdateCoordinates<true>(X, Y, Z);
+						Context.WorldX = X;
+						Context.WorldY = Y;
+						Context.WorldZ = Z;
+						Context.LocalX = Local.X;
+						Context.LocalY = Local.Y;
+						Context.LocalZ = Local.Z;
 
 						auto Outputs = Target.GetOutputs();
 						Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
 						Outputs.template Set<T, Index>(DefaultValue);
 						Target.ComputeXYZWithoutCache(Context, Outputs);
 						QueryZone.Set(X, Y, Z, QueryZoneType(Outputs.template Get<T, Index>()));
+
+						Local += LocalDeltaZ;
 					}
+					IndexY++;
 				}
+				IndexX++;
+			}
+		}
+	}
+
+	// Values and materials in a single traversal: the coordinates and the transform are computed once for both targets,
+	// each X and XY stage is run right before the Z runs using it, and both targets share the Z loop
+	// The value and material targets are compiled separately: nodes used by both are still computed twice
+	template<bool bCustomTransform>
+	void GetValuesAndMaterialsImpl(
+		const FTransform& LocalToWorld,
+		TVoxelQueryZone<FVoxelValue>& ValueQueryZone,
+		TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone,
+		int32 LOD,
+		const FVoxelItemStack& Items) const
+	{
+		ensure(bInit);
+		check(ValueQueryZone.Step == MaterialQueryZone.Step);
+		check(ValueQueryZone.Bounds.Contains(MaterialQueryZone.Bounds));
+		
+		auto&& ValueTarget = This().template GetTarget<FVoxelGraphOutputsIndices::ValueIndex>();
+		auto&& MaterialTarget = This().template GetTarget<FVoxelGraphOutputsIndices::MaterialIndex>();
+
+		const FVoxelIntBox& MaterialBounds = MaterialQueryZone.Bounds;
+
+		FVoxelContext Context(LOD, Items, LocalToWorld, bCustomTransform);
+		
+		if (!bCustomTransform || HasNoRotation(LocalToWorld))
+		{
+			const FVector LocalOffset = bCustomTransform ? LocalToWorld.InverseTransformPosition(FVector::ZeroVector) : FVector::ZeroVector;
+			const FVector LocalScale = bCustomTransform ? LocalToWorld.InverseTransformVector(FVector::OneVector) : FVector::OneVector;
+
+			for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, X))
+			{
+				Context.WorldX = X;
+				Context.LocalX = LocalOffset.X + X * LocalScale.X;
+
+				const bool bMaterialX = MaterialBounds.Min.X <= X && X < MaterialBounds.Max.X;
+				
+				auto ValueBufferX = ValueTarget.GetBufferX();
+				ValueTarget.ComputeX(Context, ValueBufferX);
+				
+				auto MaterialBufferX = MaterialTarget.GetBufferX();
+				if (bMaterialX)
+				{
+					MaterialTarget.ComputeX(Context, MaterialBufferX);
+				}
+
+				for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Y))
+				{
+					Context.WorldY = Y;
+					Context.LocalY = LocalOffset.Y + Y * LocalScale.Y;
+
+					auto ValueBufferXY = ValueTarget.GetBufferXY();
+					ValueTarget.ComputeXYWithCache(Context, ValueBufferX, ValueBufferXY);
+
+					if (bMaterialX && MaterialBounds.Min.Y <= Y && Y < MaterialBounds.Max.Y)
+					{
+						auto MaterialBufferXY = MaterialTarget.GetBufferXY();
+						MaterialTarget.ComputeXYWithCache(Context, MaterialBufferX, MaterialBufferXY);
+						
+						ComputeValuesAndMaterialsZ(
+							ValueTarget, MaterialTarget, Context, ValueBufferX, ValueBufferXY, MaterialBufferX, MaterialBufferXY, ValueQueryZone, MaterialQueryZone, X, Y, LocalOffset.Z, LocalScale.Z);
+					}
+					else
+					{
+						ComputeZ<v_flt, FVoxelValue, FVoxelGraphOutputsIndices::ValueIndex>(
+							ValueTarget, Context, ValueBufferX, ValueBufferXY, 1, ValueQueryZone, X, Y, LocalOffset.Z, LocalScale.Z);
+					}
+				}
+			}
+		}
+		else
+		{
+			const uint32 Step = ValueQueryZone.Step;
+			const FVector LocalMin = LocalToWorld.InverseTransformPosition(FVector(ValueQueryZone.Bounds.Min));
+			const FVector LocalDeltaX = LocalToWorld.InverseTransformVector(FVector(Step, 0, 0));
+			const FVector LocalDeltaY = LocalToWorld.InverseTransformVector(FVector(0, Step, 0));
+			const FVector LocalDeltaZ = LocalToWorld.InverseTransformVector(FVector(0, 0, Step));
+
+			int32 IndexX = 0;
+			for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, X))
+			{
+				int32 IndexY = 0;
+				for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Y))
+				{
+					FVector Local = LocalMin + IndexX * LocalDeltaX + IndexY * LocalDeltaY;
+					
+					for (VOXEL_QUERY_ZONE_ITERATE(ValueQueryZone, Z))
+					{
+						Context.WorldX = X;
+						Context.WorldY = Y;
+						Context.WorldZ = Z;
+						Context.LocalX = Local.X;
+						Context.LocalY = Local.Y;
+						Context.LocalZ = Local.Z;
+
+						{
+							auto Outputs = ValueTarget.GetOutputs();
+							Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+							Outputs.template Set<v_flt, FVoxelGraphOutputsIndices::ValueIndex>(1);
+							ValueTarget.ComputeXYZWithoutCache(Context, Outputs);
+							ValueQueryZone.Set(X, Y, Z, FVoxelValue(Outputs.template Get<v_flt, FVoxelGraphOutputsIndices::ValueIndex>()));
+						}
+						if (MaterialBounds.Contains(X, Y, Z))
+						{
+							auto Outputs = MaterialTarget.GetOutputs();
+							Outputs.Init(FVoxelGraphOutputsInit{ MaterialConfig });
+							Outputs.template Set<FVoxelMaterial, FVoxelGraphOutputsIndices::MaterialIndex>(FVoxelMaterial::Default());
+							MaterialTarget.ComputeXYZWithoutCache(Context, Outputs);
+							MaterialQueryZone.Set(X, Y, Z, Outputs.template Get<FVoxelMaterial, FVoxelGraphOutputsIndices::MaterialIndex>());
+						}
+
+						Local += LocalDeltaZ;
+					}
+					IndexY++;
+				}
+				IndexX++;
 			}
 		}
 	}
@@ -303,6 +656,15 @@ public:
 		GetData<true, FVoxelMaterial, FVoxelMaterial, FVoxelGraphOutputsIndices::MaterialIndex>(LocalToWorld, FVoxelMaterial::Default(), QueryZone, LOD, Items);
 	}
 
+	virtual void GetValuesAndMaterials(TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD, const FVoxelItemStack& Items) const override final
+	{
+		GetValuesAndMaterialsImpl<false>(FTransform(), ValueQueryZone, MaterialQueryZone, LOD, Items);
+	}
+	virtual void GetValuesAndMaterials_Transform(const FTransform& LocalToWorld, TVoxelQueryZone<FVoxelValue>& ValueQueryZone, TVoxelQueryZone<FVoxelMaterial>& MaterialQueryZone, int32 LOD, const FVoxelItemStack& Items) const override final
+	{
+		GetValuesAndMaterialsImpl<true>(LocalToWorld, ValueQueryZone, MaterialQueryZone, LOD, Items);
+	}
+
 	virtual FVector GetUpVector(v_flt X, v_flt Y, v_flt Z) const override final
 	{
 		auto&& Target = This().template GetTarget<
@@ -378,6 +740,14 @@ private:
 	bool bInit = false;
 	EVoxelMaterialConfig MaterialConfig = EVoxelMaterialConfig(-1);
 
+	// Exact check: with even a tiny rotation, the local coordinates would depend on all the world ones
+	// and the X/XY caching would return wrong values
+	static bool HasNoRotation(const FTransform& LocalToWorld)
+	{
+		const FQuat Rotation = LocalToWorld.GetRotation();
+		return Rotation.X == 0 && Rotation.Y == 0 && Rotation.Z == 0;
+	}
+
 	const TChild& This() const
 	{
 		return static_cast<const TChild&>(*this);